@@ -57,4 +57,18 @@ static inline CDF_STATUS bmi_download_firmware(struct ol_softc *scn)
 	return CDF_STATUS_SUCCESS;
 }
 #endif
+
+#if defined(HIF_PCI) && defined(FEATURE_FW_IMAGE_CACHE)
+void ol_fw_cache_invalidate(void);
+uint32_t ol_fw_cache_saved_ms(void);
+#else
+static inline void ol_fw_cache_invalidate(void)
+{
+}
+
+static inline uint32_t ol_fw_cache_saved_ms(void)
+{
+	return 0;
+}
+#endif
 #endif /* _BMI_H_ */
@@ -55,6 +55,67 @@ bmi_command_test(uint32_t command, uint32_t address, uint8_t *data,
 	return CDF_STATUS_SUCCESS;
 }
 
+/**
+ * bmi_alloc_write_window() - allocate the pipelined write slots
+ * @scn: ol_softc
+ *
+ * Failure is not fatal: bmi_write_memory_windowed() falls back to a
+ * single outstanding request on the regular command/response buffers.
+ *
+ * Return: None
+ */
+static void bmi_alloc_write_window(struct ol_softc *scn)
+{
+	if (!scn->bmi_win_cmd_buff) {
+		scn->bmi_win_cmd_buff = cdf_os_mem_alloc_consistent(
+					scn->cdf_dev,
+					BMI_WRITE_WINDOW * MAX_BMI_CMDBUF_SZ,
+					&scn->bmi_win_cmd_da, 0);
+		if (!scn->bmi_win_cmd_buff) {
+			BMI_WARN("No Memory for BMI write window");
+			return;
+		}
+	}
+
+	if (!scn->bmi_win_rsp_buff) {
+		scn->bmi_win_rsp_buff = cdf_os_mem_alloc_consistent(
+					scn->cdf_dev,
+					BMI_WRITE_WINDOW * MAX_BMI_CMDBUF_SZ,
+					&scn->bmi_win_rsp_da, 0);
+		if (!scn->bmi_win_rsp_buff) {
+			BMI_WARN("No Memory for BMI write window response");
+			bmi_free_write_window(scn);
+		}
+	}
+}
+
+/**
+ * bmi_free_write_window() - release the pipelined write slots
+ * @scn: ol_softc
+ *
+ * Return: None
+ */
+void bmi_free_write_window(struct ol_softc *scn)
+{
+	if (scn->bmi_win_cmd_buff) {
+		cdf_os_mem_free_consistent(scn->cdf_dev,
+				    BMI_WRITE_WINDOW * MAX_BMI_CMDBUF_SZ,
+				    scn->bmi_win_cmd_buff,
+				    scn->bmi_win_cmd_da, 0);
+		scn->bmi_win_cmd_buff = NULL;
+		scn->bmi_win_cmd_da = 0;
+	}
+
+	if (scn->bmi_win_rsp_buff) {
+		cdf_os_mem_free_consistent(scn->cdf_dev,
+				    BMI_WRITE_WINDOW * MAX_BMI_CMDBUF_SZ,
+				    scn->bmi_win_rsp_buff,
+				    scn->bmi_win_rsp_da, 0);
+		scn->bmi_win_rsp_buff = NULL;
+		scn->bmi_win_rsp_da = 0;
+	}
+}
+
 CDF_STATUS bmi_init(struct ol_softc *scn)
 {
 	if (!scn) {
@@ -81,6 +142,7 @@ CDF_STATUS bmi_init(struct ol_softc *scn)
 			goto end;
 		}
 	}
+	bmi_alloc_write_window(scn);
 	return CDF_STATUS_SUCCESS;
 end:
 	cdf_os_mem_free_consistent(scn->cdf_dev, MAX_BMI_CMDBUF_SZ,
@@ -104,6 +166,140 @@ void bmi_cleanup(struct ol_softc *scn)
 		scn->bmi_rsp_buff = NULL;
 		scn->bmi_rsp_da = 0;
 	}
+
+	bmi_free_write_window(scn);
+}
+
+/**
+ * bmi_write_memory_windowed() - BMI_WRITE_MEMORY with requests pipelined
+ * @address: target address
+ * @buffer: data to write
+ * @length: length of @buffer
+ * @scn: ol_softc
+ * @need_rsp: target acknowledges every write with a one byte status
+ *
+ * Splits @buffer into BMI_DATASZ_MAX sized commands and keeps up to
+ * BMI_WRITE_WINDOW of them queued on the BMI copy engine, so the copy of
+ * the next chunk into its DMA slot overlaps the transfer of the previous
+ * ones. Requests complete in order; the oldest one is reaped whenever
+ * the window is full.
+ *
+ * Return: CDF_STATUS_SUCCESS if every chunk was written
+ */
+CDF_STATUS bmi_write_memory_windowed(uint32_t address, uint8_t *buffer,
+				     uint32_t length, struct ol_softc *scn,
+				     bool need_rsp)
+{
+	uint32_t cid = BMI_WRITE_MEMORY;
+	const uint32_t header = sizeof(cid) + sizeof(address) + sizeof(length);
+	void *pending[BMI_WRITE_WINDOW];
+	uint32_t window, head = 0, inflight = 0;
+	uint32_t remaining, copy_len, txlen, offset, rsp_len, slot;
+	uint8_t *cmd_base, *rsp_base, *cmd, *rsp, *src;
+	cdf_dma_addr_t cmd_base_da, rsp_base_da;
+	CDF_STATUS status = CDF_STATUS_SUCCESS;
+	CDF_STATUS wait_status;
+	uint8_t ret;
+
+	if (scn->bmi_done) {
+		BMI_ERR("Command disallowed");
+		return CDF_STATUS_E_PERM;
+	}
+
+	if (!scn->bmi_cmd_buff || !scn->bmi_rsp_buff) {
+		BMI_ERR("BMI Initialization is not happened");
+		return CDF_STATUS_NOT_INITIALIZED;
+	}
+
+	bmi_assert(BMI_COMMAND_FITS(BMI_DATASZ_MAX + header));
+
+	if (scn->bmi_win_cmd_buff && scn->bmi_win_rsp_buff) {
+		window = BMI_WRITE_WINDOW;
+		cmd_base = scn->bmi_win_cmd_buff;
+		cmd_base_da = scn->bmi_win_cmd_da;
+		rsp_base = scn->bmi_win_rsp_buff;
+		rsp_base_da = scn->bmi_win_rsp_da;
+	} else {
+		window = 1;
+		cmd_base = scn->bmi_cmd_buff;
+		cmd_base_da = scn->bmi_cmd_da;
+		rsp_base = scn->bmi_rsp_buff;
+		rsp_base_da = scn->bmi_rsp_da;
+	}
+
+	BMI_DBG("BMI Write Memory:device: 0x%p, address: 0x%x, length: %d",
+						scn, address, length);
+
+	remaining = length;
+	while (remaining || inflight) {
+		/* reap the oldest request once the window is full or drained */
+		if (inflight && (inflight == window || !remaining ||
+				 status != CDF_STATUS_SUCCESS)) {
+			slot = (head + window - inflight) % window;
+			rsp_len = sizeof(ret);
+			wait_status = hif_bmi_msg_wait(scn, pending[slot],
+						       &rsp_len);
+			inflight--;
+			if (wait_status != CDF_STATUS_SUCCESS) {
+				BMI_ERR("BMI Write Memory Failed status:%d",
+					wait_status);
+				status = CDF_STATUS_E_FAILURE;
+			} else if (need_rsp) {
+				ret = rsp_base[slot * MAX_BMI_CMDBUF_SZ];
+				if (ret != 0) {
+					BMI_ERR("BMI Write memory response fail: %x",
+						ret);
+					status = CDF_STATUS_E_FAILURE;
+				}
+			}
+			continue;
+		}
+
+		if (status != CDF_STATUS_SUCCESS)
+			break;
+
+		cmd = cmd_base + head * MAX_BMI_CMDBUF_SZ;
+		rsp = rsp_base + head * MAX_BMI_CMDBUF_SZ;
+		src = &buffer[length - remaining];
+		if (remaining < (BMI_DATASZ_MAX - header)) {
+			copy_len = remaining;
+			/* align it with 4 bytes, padding with zeroes */
+			txlen = (remaining + 3) & ~3;
+			if (txlen != copy_len)
+				cdf_mem_zero(&cmd[header + copy_len],
+					     txlen - copy_len);
+		} else {
+			copy_len = txlen = (BMI_DATASZ_MAX - header);
+		}
+		offset = 0;
+		cdf_mem_copy(&cmd[offset], &cid, sizeof(cid));
+		offset += sizeof(cid);
+		cdf_mem_copy(&cmd[offset], &address, sizeof(address));
+		offset += sizeof(address);
+		cdf_mem_copy(&cmd[offset], &txlen, sizeof(txlen));
+		offset += sizeof(txlen);
+		cdf_mem_copy(&cmd[offset], src, copy_len);
+		offset += txlen;
+
+		status = hif_bmi_msg_send(scn, cmd,
+				cmd_base_da + head * MAX_BMI_CMDBUF_SZ, offset,
+				need_rsp ? rsp : NULL,
+				rsp_base_da + head * MAX_BMI_CMDBUF_SZ,
+				&pending[head]);
+		if (status != CDF_STATUS_SUCCESS) {
+			BMI_ERR("Unable to write to the device; status:%d",
+				status);
+			status = CDF_STATUS_E_FAILURE;
+			continue;
+		}
+		head = (head + 1) % window;
+		inflight++;
+		remaining -= copy_len;
+		address += txlen;
+	}
+
+	BMI_DBG("BMI Write Memory: Exit");
+	return status;
 }
 
 
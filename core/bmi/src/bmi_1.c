@@ -104,71 +104,7 @@ CDF_STATUS
 bmi_write_memory(uint32_t address,
 		 uint8_t *buffer, uint32_t length, struct ol_softc *scn)
 {
-	uint32_t cid;
-	int status;
-	uint32_t offset;
-	uint32_t remaining, txlen;
-	const uint32_t header = sizeof(cid) + sizeof(address) + sizeof(length);
-	uint8_t aligned_buffer[BMI_DATASZ_MAX];
-	uint8_t *src;
-	uint8_t *bmi_cmd_buff = scn->bmi_cmd_buff;
-
-	if (scn->bmi_done) {
-		BMI_ERR("Command disallowed");
-		return CDF_STATUS_E_PERM;
-	}
-
-	if (!bmi_cmd_buff) {
-		BMI_ERR("BMI initialization hasn't done");
-		return CDF_STATUS_E_PERM;
-	}
-
-	bmi_assert(BMI_COMMAND_FITS(BMI_DATASZ_MAX + header));
-	cdf_mem_set(bmi_cmd_buff, 0, BMI_DATASZ_MAX + header);
-
-	BMI_DBG("BMI Write Memory:device: 0x%p, address: 0x%x, length: %d",
-						scn, address, length);
-
-	cid = BMI_WRITE_MEMORY;
-
-	remaining = length;
-	while (remaining) {
-		src = &buffer[length - remaining];
-		if (remaining < (BMI_DATASZ_MAX - header)) {
-			if (remaining & 3) {
-				/* align it with 4 bytes */
-				remaining = remaining + (4 - (remaining & 3));
-				memcpy(aligned_buffer, src, remaining);
-				src = aligned_buffer;
-			}
-			txlen = remaining;
-		} else {
-			txlen = (BMI_DATASZ_MAX - header);
-		}
-		offset = 0;
-		cdf_mem_copy(&(bmi_cmd_buff[offset]), &cid, sizeof(cid));
-		offset += sizeof(cid);
-		cdf_mem_copy(&(bmi_cmd_buff[offset]), &address,
-						sizeof(address));
-		offset += sizeof(address);
-		cdf_mem_copy(&(bmi_cmd_buff[offset]), &txlen, sizeof(txlen));
-		offset += sizeof(txlen);
-		cdf_mem_copy(&(bmi_cmd_buff[offset]), src, txlen);
-		offset += txlen;
-		status = hif_exchange_bmi_msg(scn, bmi_cmd_buff, offset,
-					NULL, NULL, BMI_EXCHANGE_TIMEOUT_MS);
-		if (status) {
-			BMI_ERR("Unable to write to the device; status:%d",
-								status);
-			return CDF_STATUS_E_FAILURE;
-		}
-		remaining -= txlen;
-		address += txlen;
-	}
-
-	BMI_DBG("BMI Write Memory: Exit");
-
-	return CDF_STATUS_SUCCESS;
+	return bmi_write_memory_windowed(address, buffer, length, scn, false);
 }
 
 CDF_STATUS
@@ -317,5 +253,7 @@ CDF_STATUS bmi_done_local(struct ol_softc *scn)
 		scn->bmi_rsp_da = 0;
 	}
 
+	bmi_free_write_window(scn);
+
 	return CDF_STATUS_SUCCESS;
 }
@@ -101,6 +101,8 @@
 			sizeof(uint32_t))    /* length */
 #define BMI_COMMAND_FITS(sz) ((sz) <= MAX_BMI_CMDBUF_SZ)
 #define BMI_EXCHANGE_TIMEOUT_MS  1000
+/* BMI_WRITE_MEMORY requests kept in flight by bmi_write_memory_windowed */
+#define BMI_WRITE_WINDOW 4
 
 struct hash_fw {
 	u8 qwlan[SHA256_DIGEST_SIZE];
@@ -132,6 +134,10 @@ CDF_STATUS bmi_read_memory(uint32_t address,
 		uint8_t *buffer, uint32_t length, struct ol_softc *scn);
 CDF_STATUS bmi_write_memory(uint32_t address,
 		uint8_t *buffer, uint32_t length, struct ol_softc *scn);
+CDF_STATUS bmi_write_memory_windowed(uint32_t address, uint8_t *buffer,
+				     uint32_t length, struct ol_softc *scn,
+				     bool need_rsp);
+void bmi_free_write_window(struct ol_softc *scn);
 CDF_STATUS bmi_fast_download(uint32_t address,
 		uint8_t *buffer, uint32_t length, struct ol_softc *scn);
 CDF_STATUS bmi_read_soc_register(uint32_t address,
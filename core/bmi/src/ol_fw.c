@@ -132,6 +132,211 @@ end:
 }
 #endif
 
+#ifdef FEATURE_FW_IMAGE_CACHE
+/* one per file type, plus room for the board data fallback names */
+#define OL_FW_CACHE_ENTRIES	(2 * (ATH_SETUP_FILE + 1))
+#define OL_FW_CACHE_NAME_LEN	64
+
+/**
+ * struct ol_fw_cache_entry - firmware file kept across SSR/re-init
+ * @name: file name the entry was requested with, the cache key
+ * @fw: firmware blob, owned by the cache while set
+ * @hash_ok: blob already passed ol_check_fw_hash
+ * @load_ms: time the request (and hash check) took when first loaded
+ */
+struct ol_fw_cache_entry {
+	char name[OL_FW_CACHE_NAME_LEN];
+	const struct firmware *fw;
+	bool hash_ok;
+	uint32_t load_ms;
+};
+
+/*
+ * Firmware download runs from probe/re-init and the cache is only
+ * invalidated from driver remove, so these are never accessed
+ * concurrently.
+ */
+static struct ol_fw_cache_entry ol_fw_cache[OL_FW_CACHE_ENTRIES];
+static uint32_t ol_fw_cache_hits;
+static uint32_t ol_fw_cache_saved;
+
+static void ol_fw_cache_drop(struct ol_fw_cache_entry *entry)
+{
+	if (entry->fw)
+		release_firmware(entry->fw);
+	cdf_mem_zero(entry, sizeof(*entry));
+}
+
+/**
+ * ol_fw_cache_find() - find the cache entry of a file or blob
+ * @filename: file name to look up, or NULL
+ * @data: blob data to look up when @filename is NULL
+ *
+ * Return: the cache entry, or NULL if the file is not cached
+ */
+static struct ol_fw_cache_entry *ol_fw_cache_find(const char *filename,
+						  const u8 *data)
+{
+	int i;
+
+	for (i = 0; i < OL_FW_CACHE_ENTRIES; i++) {
+		struct ol_fw_cache_entry *entry = &ol_fw_cache[i];
+
+		if (!entry->fw)
+			continue;
+		if (filename ?
+		    !strncmp(entry->name, filename, sizeof(entry->name)) :
+		    entry->fw->data == data)
+			return entry;
+	}
+	return NULL;
+}
+
+/**
+ * ol_request_firmware() - request_firmware() served from the image cache
+ * @fw_entry: filled with the firmware blob
+ * @filename: name of the file to load, the cache key
+ * @dev: device requesting the file
+ *
+ * Files are cached by name, so requesting another file (e.g. the board
+ * data fallback) does not evict the ones already cached. A file that does
+ * not fit in the cache is handed out uncached.
+ *
+ * Return: 0 on success, request_firmware() error otherwise
+ */
+static int ol_request_firmware(const struct firmware **fw_entry,
+			       const char *filename, struct device *dev)
+{
+	struct ol_fw_cache_entry *entry = ol_fw_cache_find(filename, NULL);
+	v_TIME_t start;
+	int ret, i;
+
+	if (entry) {
+		*fw_entry = entry->fw;
+		ol_fw_cache_hits++;
+		ol_fw_cache_saved += entry->load_ms;
+		BMI_INFO("%s: %s from cache (hit %u, saved %u ms)", __func__,
+			 filename, ol_fw_cache_hits, entry->load_ms);
+		return 0;
+	}
+
+	start = cdf_mc_timer_get_system_time();
+	ret = request_firmware(fw_entry, filename, dev);
+	if (ret || !*fw_entry || strlen(filename) >= OL_FW_CACHE_NAME_LEN)
+		return ret;
+
+	for (i = 0; i < OL_FW_CACHE_ENTRIES; i++) {
+		entry = &ol_fw_cache[i];
+		if (entry->fw)
+			continue;
+		strlcpy(entry->name, filename, sizeof(entry->name));
+		entry->fw = *fw_entry;
+		entry->load_ms = cdf_mc_timer_get_system_time() - start;
+		break;
+	}
+	return 0;
+}
+
+/**
+ * ol_release_firmware() - release a blob obtained by ol_request_firmware
+ * @fw_entry: firmware blob
+ * @keep: keep the blob cached; false drops it from the cache as well
+ *
+ * Return: None
+ */
+static void ol_release_firmware(const struct firmware *fw_entry, bool keep)
+{
+	struct ol_fw_cache_entry *entry = ol_fw_cache_find(NULL,
+							   fw_entry->data);
+
+	if (!entry) {
+		release_firmware(fw_entry);
+		return;
+	}
+
+	if (!keep)
+		ol_fw_cache_drop(entry);
+}
+
+#ifdef FEATURE_SECURE_FIRMWARE
+static int ol_check_fw_hash_cached(const u8 *data, u32 fw_size,
+				   ATH_BIN_FILE file)
+{
+	struct ol_fw_cache_entry *entry = ol_fw_cache_find(NULL, data);
+	v_TIME_t start;
+	int ret;
+
+	if (entry && entry->hash_ok)
+		return 0;
+
+	start = cdf_mc_timer_get_system_time();
+	ret = ol_check_fw_hash(data, fw_size, file);
+	if (!ret && entry) {
+		entry->hash_ok = true;
+		entry->load_ms += cdf_mc_timer_get_system_time() - start;
+	}
+	return ret;
+}
+#endif
+
+/**
+ * ol_fw_cache_invalidate() - drop every cached firmware image
+ *
+ * Must be called once the images may have changed on the filesystem and
+ * from driver remove, after which the next download reads them again.
+ *
+ * Return: None
+ */
+void ol_fw_cache_invalidate(void)
+{
+	int i;
+
+	for (i = 0; i < OL_FW_CACHE_ENTRIES; i++)
+		ol_fw_cache_drop(&ol_fw_cache[i]);
+}
+
+/**
+ * ol_fw_cache_saved_ms() - time saved by the cache on the last download
+ *
+ * Return: sum of the original load times of the files served from cache
+ */
+uint32_t ol_fw_cache_saved_ms(void)
+{
+	return ol_fw_cache_saved;
+}
+
+static void ol_fw_cache_stats_reset(void)
+{
+	ol_fw_cache_hits = 0;
+	ol_fw_cache_saved = 0;
+}
+#else
+static inline int ol_request_firmware(const struct firmware **fw_entry,
+				      const char *filename,
+				      struct device *dev)
+{
+	return request_firmware(fw_entry, filename, dev);
+}
+
+static inline void ol_release_firmware(const struct firmware *fw_entry,
+				       bool keep)
+{
+	release_firmware(fw_entry);
+}
+
+#ifdef FEATURE_SECURE_FIRMWARE
+static inline int ol_check_fw_hash_cached(const u8 *data, u32 fw_size,
+					  ATH_BIN_FILE file)
+{
+	return ol_check_fw_hash(data, fw_size, file);
+}
+#endif
+
+static inline void ol_fw_cache_stats_reset(void)
+{
+}
+#endif /* FEATURE_FW_IMAGE_CACHE */
+
 static int __ol_transfer_bin_file(struct ol_softc *scn, ATH_BIN_FILE file,
 				  uint32_t address, bool compressed)
 {
@@ -245,7 +450,8 @@ static int __ol_transfer_bin_file(struct ol_softc *scn, ATH_BIN_FILE file,
 		break;
 	}
 
-	if (request_firmware(&fw_entry, filename, scn->aps_osdev.device) != 0) {
+	if (ol_request_firmware(&fw_entry, filename,
+				scn->aps_osdev.device) != 0) {
 		BMI_ERR("%s: Failed to get %s", __func__, filename);
 
 		if (file == ATH_OTP_FILE)
@@ -258,8 +464,8 @@ static int __ol_transfer_bin_file(struct ol_softc *scn, ATH_BIN_FILE file,
 			filename = scn->fw_files.board_data;
 			BMI_INFO("%s: Trying to load default %s",
 			       __func__, filename);
-			if (request_firmware(&fw_entry, filename,
-					     scn->aps_osdev.device) != 0) {
+			if (ol_request_firmware(&fw_entry, filename,
+						scn->aps_osdev.device) != 0) {
 				BMI_ERR("%s: Failed to get %s",
 				       __func__, filename);
 				return -1;
@@ -282,7 +488,7 @@ static int __ol_transfer_bin_file(struct ol_softc *scn, ATH_BIN_FILE file,
 
 #ifdef FEATURE_SECURE_FIRMWARE
 
-	if (ol_check_fw_hash(fw_entry->data, fw_entry_size, file)) {
+	if (ol_check_fw_hash_cached(fw_entry->data, fw_entry_size, file)) {
 		BMI_ERR("Hash Check failed for file:%s", filename);
 		status = CDF_STATUS_E_FAILURE;
 		goto end;
@@ -296,7 +502,7 @@ static int __ol_transfer_bin_file(struct ol_softc *scn, ATH_BIN_FILE file,
 		temp_eeprom = cdf_mem_malloc(fw_entry_size);
 		if (!temp_eeprom) {
 			BMI_ERR("%s: Memory allocation failed", __func__);
-			release_firmware(fw_entry);
+			ol_release_firmware(fw_entry, true);
 			return CDF_STATUS_E_NOMEM;
 		}
 
@@ -442,11 +648,11 @@ end:
 
 	if (status != EOK) {
 		BMI_ERR("%s, BMI operation failed: %d", __func__, __LINE__);
-		release_firmware(fw_entry);
+		ol_release_firmware(fw_entry, false);
 		return CDF_STATUS_E_FAILURE;
 	}
 
-	release_firmware(fw_entry);
+	ol_release_firmware(fw_entry, true);
 
 	BMI_INFO("transferring file: %s size %d bytes done!",
 		(filename != NULL) ? filename : " ", fw_entry_size);
@@ -458,13 +664,17 @@ static int ol_transfer_bin_file(struct ol_softc *scn, ATH_BIN_FILE file,
 				uint32_t address, bool compressed)
 {
 	int ret;
+	v_TIME_t start;
 
 #ifdef CONFIG_CNSS
 	/* Wait until suspend and resume are completed before loading FW */
 	cnss_lock_pm_sem();
 #endif
 
+	start = cdf_mc_timer_get_system_time();
 	ret = __ol_transfer_bin_file(scn, file, address, compressed);
+	BMI_INFO("%s: file %d status %d took %u ms", __func__, file, ret,
+		 (uint32_t)(cdf_mc_timer_get_system_time() - start));
 
 #ifdef CONFIG_CNSS
 	cnss_release_pm_sem();
@@ -1204,6 +1414,8 @@ CDF_STATUS ol_download_firmware(struct ol_softc *scn)
 		return CDF_STATUS_E_FAILURE;
 	}
 #endif
+	ol_fw_cache_stats_reset();
+
 	/* Transfer Board Data from Target EEPROM to Target RAM */
 	/* Determine where in Target RAM to write Board Data */
 	bmi_read_memory(hif_hia_item_address(scn->target_type,
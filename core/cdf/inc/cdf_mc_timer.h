@@ -225,6 +225,45 @@ CDF_STATUS cdf_mc_timer_start(cdf_mc_timer_t *timer, uint32_t expirationTime);
  */
 CDF_STATUS cdf_mc_timer_stop(cdf_mc_timer_t *timer);
 
+/**
+ * cdf_mc_timer_set_slack() - allow a timer to expire late
+ * @timer:	Pointer to timer object
+ * @slack_ms:	Maximum delay past the requested expiry, in ms
+ *
+ * With the timer wheel enabled, a timer with slack is moved to the
+ * coarsest wheel boundary inside [expiry, expiry + slack] so that it
+ * shares a wakeup with other timers. Takes effect on the next start.
+ *
+ * Return:
+ *	CDF_STATUS_SUCCESS - slack updated
+ *	CDF_STATUS_E_INVAL - timer is not initialized
+ */
+CDF_STATUS cdf_mc_timer_set_slack(cdf_mc_timer_t *timer, uint32_t slack_ms);
+
+/**
+ * cdf_mc_timer_display_stats() - log timer wheel and per call site stats
+ *
+ * Return: none
+ */
+void cdf_mc_timer_display_stats(void);
+
+/**
+ * cdf_mc_timer_clear_stats() - reset timer wheel and per call site stats
+ *
+ * Return: none
+ */
+void cdf_mc_timer_clear_stats(void);
+
+/**
+ * cdf_mc_timer_flush_fired() - drop expiries waiting for the MC thread
+ *
+ * Called when the MC thread message queues are flushed, which also drops
+ * the message that would have delivered these expiries.
+ *
+ * Return: none
+ */
+void cdf_mc_timer_flush_fired(void);
+
 /**
  * cdf_mc_timer_get_system_ticks() - get the system time in 10ms ticks
 
@@ -905,6 +905,60 @@ static inline uint8_t cdf_nbuf_get_tx_parallel_dnload_frm(cdf_nbuf_t buf)
 	return __cdf_nbuf_get_tx_htt2_frm(buf);
 }
 
+/**
+ * cdf_nbuf_set_tx_pkt_class() - cache the tx classification of a frame
+ * @buf: Network buffer
+ * @pkt_class: NBUF_TX_PKT_CLASS_* flags
+ *
+ * The OS shim classifies each tx frame once when it enters the driver;
+ * the result is kept in the control block so that lower layers do not
+ * need to parse the headers again.
+ *
+ * Return: none
+ */
+static inline void
+cdf_nbuf_set_tx_pkt_class(cdf_nbuf_t buf, uint8_t pkt_class)
+{
+	__cdf_nbuf_set_tx_pkt_class(buf, pkt_class);
+}
+
+/**
+ * cdf_nbuf_get_tx_pkt_class() - get the cached tx classification of a frame
+ * @buf: Network buffer
+ *
+ * Return: NBUF_TX_PKT_CLASS_* flags, 0 if the frame was not classified
+ */
+static inline uint8_t cdf_nbuf_get_tx_pkt_class(cdf_nbuf_t buf)
+{
+	return __cdf_nbuf_get_tx_pkt_class(buf);
+}
+
+/**
+ * cdf_nbuf_set_tx_lat_peer() - tag a tx frame with its destination peer
+ * @buf: Network buffer
+ * @peer: local peer id + 1 of the destination, 0 if unknown
+ *
+ * The tag lets tx completion account the frame's latency to its peer
+ * without looking the peer up.
+ *
+ * Return: none
+ */
+static inline void cdf_nbuf_set_tx_lat_peer(cdf_nbuf_t buf, uint8_t peer)
+{
+	__cdf_nbuf_set_tx_lat_peer(buf, peer);
+}
+
+/**
+ * cdf_nbuf_get_tx_lat_peer() - get the destination peer tag of a tx frame
+ * @buf: Network buffer
+ *
+ * Return: local peer id + 1 of the destination, 0 if unknown
+ */
+static inline uint8_t cdf_nbuf_get_tx_lat_peer(cdf_nbuf_t buf)
+{
+	return __cdf_nbuf_get_tx_lat_peer(buf);
+}
+
 /**
  * cdf_invalidate_range() - invalidate the virtual address range specified by
  *			    start and end addresses.
@@ -959,7 +1013,7 @@ static inline uint8_t cdf_nbuf_is_tso(cdf_nbuf_t nbuf)
  * segments to be transmitted by the driver. It chains the TSO
  * segments created into a list.
  *
- * Return: number of TSO segments
+ * Return: number of TSO segments, 0 if the buffer could not be DMA mapped
  */
 static inline uint32_t cdf_nbuf_get_tso_info(cdf_device_t osdev,
 		 cdf_nbuf_t nbuf, struct cdf_tso_info_t *tso_info)
@@ -94,6 +94,19 @@ static inline unsigned long cdf_get_system_timestamp(void)
 	return __cdf_get_system_timestamp();
 }
 
+/**
+ * cdf_system_time_us() - monotonic time in microseconds, truncated to 32 bits
+ *
+ * Cheap enough for per-packet timestamping. Differences between two samples
+ * are valid as long as they are less than ~71 minutes apart.
+ *
+ * Return: current monotonic time in microseconds
+ */
+static inline uint32_t cdf_system_time_us(void)
+{
+	return __cdf_system_time_us();
+}
+
 /**
  * cdf_udelay() - delay in microseconds
  * @usecs: Number of microseconds to delay
@@ -199,4 +212,17 @@ static inline uint64_t cdf_get_monotonic_boottime(void)
 	return __cdf_get_monotonic_boottime();
 }
 
+/**
+ * cdf_get_cycles() - read the CPU cycle counter
+ *
+ * Meant for measuring the cost of short code paths; the counter is not
+ * synchronized across CPUs and its rate is architecture specific.
+ *
+ * Return: current value of the cycle counter
+ */
+static inline uint64_t cdf_get_cycles(void)
+{
+	return __cdf_get_cycles();
+}
+
 #endif
@@ -48,6 +48,31 @@
  */
 #define cdf_likely(_expr)       __cdf_likely(_expr)
 
+/**
+ * cdf_prefetch - Hint the CPU to pull a cache line in for reading
+ * @_addr: address to be prefetched
+ */
+#define cdf_prefetch(_addr)     __cdf_prefetch(_addr)
+
+/**
+ * cdf_get_cpu - id of the CPU the caller runs on
+ *
+ * Only stable while the caller cannot migrate, e.g. in softirq context.
+ */
+#define cdf_get_cpu()           __cdf_get_cpu()
+
+/**
+ * cdf_get_num_cpus - upper bound of the ids returned by cdf_get_cpu()
+ */
+#define cdf_get_num_cpus()      __cdf_get_num_cpus()
+
+/**
+ * cdf_div_u64 - divide a 64-bit value by a 32-bit divisor
+ * @_n: 64-bit dividend
+ * @_d: 32-bit divisor
+ */
+#define cdf_div_u64(_n, _d)     __cdf_div_u64(_n, _d)
+
 CDF_INLINE_FN int cdf_status_to_os_return(CDF_STATUS status)
 {
 	return __cdf_status_to_os_return(status);
@@ -37,6 +37,7 @@
 #include <cds_api.h>
 #include "wlan_qct_sys.h"
 #include "cds_sched.h"
+#include <linux/hash.h>
 
 /* Preprocessor definitions and constants */
 
@@ -52,6 +53,9 @@ static cdf_mutex_t persistent_timer_count_lock;
 
 /* Function declarations and documenation */
 
+static CDF_STATUS cdf_mc_timer_post_msg(cdf_mc_timer_callback_t callback,
+					void *user_data);
+
 /**
  * try_allowing_sleep() - clean up timer states after it has been deactivated
  * @type: Timer type
@@ -75,6 +79,7 @@ static void try_allowing_sleep(CDF_TIMER_TYPE type)
 	}
 }
 
+#ifndef FEATURE_MC_TIMER_WHEEL
 /**
  * cdf_linux_timer_callback() - internal cdf entry point which is
  *				called when the timer interval expires
@@ -95,7 +100,6 @@ static void try_allowing_sleep(CDF_TIMER_TYPE type)
 static void cdf_linux_timer_callback(unsigned long data)
 {
 	cdf_mc_timer_t *timer = (cdf_mc_timer_t *) data;
-	cds_msg_t msg;
 	CDF_STATUS vStatus;
 	unsigned long flags;
 
@@ -176,20 +180,825 @@ static void cdf_linux_timer_callback(unsigned long data)
 	CDF_TRACE(CDF_MODULE_ID_CDF, CDF_TRACE_LEVEL_INFO,
 		  "TIMER callback: running on MC thread");
 
-	/* serialize to the MC thread */
+	cdf_mc_timer_post_msg(callback, userData);
+}
+#endif /* FEATURE_MC_TIMER_WHEEL */
+
+/**
+ * cdf_mc_timer_post_msg() - serialize a timer callback to the MC thread
+ * @callback: client callback
+ * @user_data: client context passed to @callback
+ *
+ * Return: CDF_STATUS_SUCCESS if the message was posted
+ */
+static CDF_STATUS cdf_mc_timer_post_msg(cdf_mc_timer_callback_t callback,
+					void *user_data)
+{
+	cds_msg_t msg;
+	CDF_STATUS status;
+
 	sys_build_message_header(SYS_MSG_ID_MC_TIMER, &msg);
 	msg.callback = callback;
-	msg.bodyptr = userData;
+	msg.bodyptr = user_data;
 	msg.bodyval = 0;
 
-	if (cds_mq_post_message(CDS_MQ_ID_SYS, &msg) == CDF_STATUS_SUCCESS)
-		return;
+	status = cds_mq_post_message(CDS_MQ_ID_SYS, &msg);
+	if (status == CDF_STATUS_SUCCESS)
+		return status;
 
 	CDF_TRACE(CDF_MODULE_ID_CDF, CDF_TRACE_LEVEL_ERROR,
 		  "%s: Could not enqueue timer to any queue", __func__);
 	CDF_ASSERT(0);
+	return status;
+}
+
+#ifdef FEATURE_MC_TIMER_WHEEL
+/*
+ * Timer wheel
+ *
+ * Instead of one kernel timer per CDF timer, running timers are hashed
+ * into a three level wheel of CDF_MC_TIMER_WHEEL_GRAN_MS ticks, one
+ * wheel per timer type (deferrable SW timers and WAKE_APPS timers).
+ * Each wheel owns a single kernel timer armed for the next non-empty
+ * bucket, so all CDF timers due in the same tick share one wakeup and
+ * their callbacks are delivered to the MC thread in a single message.
+ *
+ * The wheel counts its own ticks in clk; clk_jiffies is the jiffies
+ * value at which tick clk is due and moves forward by one tick worth of
+ * jiffies per tick. Timer expiries are kept in raw jiffies and turned
+ * into a tick only relative to clk_jiffies when they are hashed, so the
+ * wheel keeps running across a jiffies wrap whatever the tick length.
+ *
+ * Lock order: timer->platformInfo.spinlock -> wheel->lock ->
+ * cdf_timer_fire_lock. The wheel kernel timer runs with wheel->lock
+ * held and therefore only trylocks timer locks; a timer is taken off
+ * the wheel and marked stopped under both locks, so nothing refers to
+ * it once wheel->lock is dropped and it may be destroyed right away.
+ */
+#define CDF_MC_TIMER_WHEEL_GRAN_MS      10
+#define CDF_MC_TIMER_WHEEL_BITS         6
+#define CDF_MC_TIMER_WHEEL_SIZE         (1 << CDF_MC_TIMER_WHEEL_BITS)
+#define CDF_MC_TIMER_WHEEL_MASK         (CDF_MC_TIMER_WHEEL_SIZE - 1)
+#define CDF_MC_TIMER_WHEEL_LEVELS       3
+#define CDF_MC_TIMER_WHEEL_MAX_TICKS \
+	((1UL << (CDF_MC_TIMER_WHEEL_BITS * CDF_MC_TIMER_WHEEL_LEVELS)) - 1)
+#define CDF_MC_TIMER_WHEEL_LVL_SHIFT(lvl) ((lvl) * CDF_MC_TIMER_WHEEL_BITS)
+#define CDF_MC_TIMER_FIRE_BATCH         32
+#define CDF_MC_TIMER_FIRE_RING_SIZE     256
+#define CDF_MC_TIMER_SITE_BITS          6
+#define CDF_MC_TIMER_SITE_NUM           (1 << CDF_MC_TIMER_SITE_BITS)
+
+struct cdf_mc_timer_wheel {
+	spinlock_t lock;
+	struct timer_list kt;
+	unsigned long clk;
+	unsigned long clk_jiffies;
+	unsigned long kt_expires;
+	bool kt_armed;
+	uint32_t pending;
+	struct list_head expired;
+	struct list_head vec[CDF_MC_TIMER_WHEEL_LEVELS][CDF_MC_TIMER_WHEEL_SIZE];
+	uint32_t kt_fires;
+	uint32_t timers_fired;
+	uint32_t max_batch;
+};
+
+/**
+ * struct cdf_mc_timer_site_stats - per call site timer statistics
+ * @callback: timer callback, used as the call site key
+ * @starts: number of cdf_mc_timer_start() calls
+ * @slacked: starts whose expiry was moved by the timer slack
+ * @fires: number of expiries delivered
+ * @batched: expiries that shared a wakeup with another timer
+ * @late_ms_total: accumulated delivery delay past the requested expiry
+ * @late_ms_max: worst delivery delay past the requested expiry
+ */
+struct cdf_mc_timer_site_stats {
+	cdf_mc_timer_callback_t callback;
+	uint32_t starts;
+	uint32_t slacked;
+	uint32_t fires;
+	uint32_t batched;
+	uint32_t late_ms_total;
+	uint32_t late_ms_max;
+};
+
+struct cdf_mc_timer_fire {
+	cdf_mc_timer_callback_t callback;
+	void *user_data;
+};
+
+struct cdf_mc_timer_expired {
+	cdf_mc_timer_callback_t callback;
+	void *user_data;
+	CDF_TIMER_TYPE type;
+	unsigned long due;
+};
+
+static struct cdf_mc_timer_wheel cdf_timer_wheel[2];
+/* non-zero before cdf_mc_timer_wheel_init() so it is always a safe divisor */
+static unsigned long cdf_timer_wheel_tick = 1;
+static bool cdf_timer_wheel_inited;
+
+static DEFINE_SPINLOCK(cdf_timer_fire_lock);
+static struct cdf_mc_timer_fire cdf_timer_fire_ring[CDF_MC_TIMER_FIRE_RING_SIZE];
+static uint32_t cdf_timer_fire_head;
+static uint32_t cdf_timer_fire_count;
+static bool cdf_timer_dispatch_posted;
+static uint32_t cdf_timer_fire_overflow;
+static struct cdf_mc_timer_site_stats cdf_timer_sites[CDF_MC_TIMER_SITE_NUM];
+static uint32_t cdf_timer_sites_dropped;
+
+static inline struct cdf_mc_timer_wheel *
+cdf_mc_timer_get_wheel(CDF_TIMER_TYPE type)
+{
+	return &cdf_timer_wheel[type == CDF_TIMER_TYPE_WAKE_APPS];
+}
+
+/**
+ * cdf_mc_timer_get_site() - find or claim the stats slot of a call site
+ * @callback: timer callback identifying the call site
+ *
+ * Must be called with cdf_timer_fire_lock held.
+ *
+ * Return: stats slot, or NULL if the table is full
+ */
+static struct cdf_mc_timer_site_stats *
+cdf_mc_timer_get_site(cdf_mc_timer_callback_t callback)
+{
+	uint32_t idx = hash_ptr(callback, CDF_MC_TIMER_SITE_BITS);
+	uint32_t i;
+	struct cdf_mc_timer_site_stats *site;
+
+	for (i = 0; i < CDF_MC_TIMER_SITE_NUM; i++) {
+		site = &cdf_timer_sites[(idx + i) & (CDF_MC_TIMER_SITE_NUM - 1)];
+		if (site->callback == callback)
+			return site;
+		if (!site->callback) {
+			site->callback = callback;
+			return site;
+		}
+	}
+	cdf_timer_sites_dropped++;
+	return NULL;
+}
+
+static void cdf_mc_timer_site_start(cdf_mc_timer_callback_t callback,
+				    bool slacked)
+{
+	struct cdf_mc_timer_site_stats *site;
+
+	spin_lock(&cdf_timer_fire_lock);
+	site = cdf_mc_timer_get_site(callback);
+	if (site) {
+		site->starts++;
+		if (slacked)
+			site->slacked++;
+	}
+	spin_unlock(&cdf_timer_fire_lock);
+}
+
+/**
+ * cdf_mc_timer_dispatch() - run wheel expiries on the MC thread
+ * @arg: unused
+ *
+ * Drains every callback queued by the wheel since the message was
+ * posted, so a burst of expiries costs one MC message.
+ *
+ * Return: none
+ */
+static void cdf_mc_timer_dispatch(void *arg)
+{
+	struct cdf_mc_timer_fire fire;
+	unsigned long flags;
+
+	while (true) {
+		spin_lock_irqsave(&cdf_timer_fire_lock, flags);
+		if (!cdf_timer_fire_count) {
+			cdf_timer_dispatch_posted = false;
+			spin_unlock_irqrestore(&cdf_timer_fire_lock, flags);
+			break;
+		}
+		fire = cdf_timer_fire_ring[cdf_timer_fire_head];
+		cdf_timer_fire_head = (cdf_timer_fire_head + 1) &
+				      (CDF_MC_TIMER_FIRE_RING_SIZE - 1);
+		cdf_timer_fire_count--;
+		spin_unlock_irqrestore(&cdf_timer_fire_lock, flags);
+
+		fire.callback(fire.user_data);
+	}
+}
+
+/**
+ * cdf_mc_timer_reset_fire_ring() - drop every queued wheel expiry
+ *
+ * Used when the dispatch message is lost, so that the next expiry posts
+ * a new one instead of waiting forever for a dispatch that never runs.
+ *
+ * Return: number of expiries dropped
+ */
+static uint32_t cdf_mc_timer_reset_fire_ring(void)
+{
+	unsigned long flags;
+	uint32_t dropped;
+
+	spin_lock_irqsave(&cdf_timer_fire_lock, flags);
+	dropped = cdf_timer_fire_count;
+	cdf_timer_fire_head = 0;
+	cdf_timer_fire_count = 0;
+	cdf_timer_dispatch_posted = false;
+	spin_unlock_irqrestore(&cdf_timer_fire_lock, flags);
+
+	return dropped;
+}
+
+/**
+ * cdf_mc_timer_flush_fired() - drop expiries waiting for the MC thread
+ *
+ * Return: none
+ */
+void cdf_mc_timer_flush_fired(void)
+{
+	uint32_t dropped = cdf_mc_timer_reset_fire_ring();
+
+	if (dropped)
+		CDF_TRACE(CDF_MODULE_ID_CDF, CDF_TRACE_LEVEL_INFO,
+			  "%s: dropped %u timer expiries", __func__, dropped);
+}
+
+/**
+ * cdf_mc_timer_queue_fire() - queue an expired callback for the MC thread
+ * @callback: client callback
+ * @user_data: client context
+ * @late_ms: delivery delay past the requested expiry
+ * @batched: true if the expiry shared a wakeup with other timers
+ *
+ * Return: true if the dispatch message needs to be posted
+ */
+static bool cdf_mc_timer_queue_fire(cdf_mc_timer_callback_t callback,
+				    void *user_data, uint32_t late_ms,
+				    bool batched)
+{
+	struct cdf_mc_timer_site_stats *site;
+	unsigned long flags;
+	uint32_t tail;
+	bool post = false;
+
+	spin_lock_irqsave(&cdf_timer_fire_lock, flags);
+	site = cdf_mc_timer_get_site(callback);
+	if (site) {
+		site->fires++;
+		if (batched)
+			site->batched++;
+		site->late_ms_total += late_ms;
+		if (late_ms > site->late_ms_max)
+			site->late_ms_max = late_ms;
+	}
+
+	if (cdf_timer_fire_count == CDF_MC_TIMER_FIRE_RING_SIZE) {
+		cdf_timer_fire_overflow++;
+		spin_unlock_irqrestore(&cdf_timer_fire_lock, flags);
+		/* ring full, fall back to one message per expiry */
+		cdf_mc_timer_post_msg(callback, user_data);
+		return false;
+	}
+
+	tail = (cdf_timer_fire_head + cdf_timer_fire_count) &
+	       (CDF_MC_TIMER_FIRE_RING_SIZE - 1);
+	cdf_timer_fire_ring[tail].callback = callback;
+	cdf_timer_fire_ring[tail].user_data = user_data;
+	cdf_timer_fire_count++;
+	if (!cdf_timer_dispatch_posted) {
+		cdf_timer_dispatch_posted = true;
+		post = true;
+	}
+	spin_unlock_irqrestore(&cdf_timer_fire_lock, flags);
+
+	return post;
+}
+
+/**
+ * cdf_mc_timer_wheel_tick_of() - wheel tick at which a jiffies value is due
+ * @wheel: wheel, with wheel->lock held
+ * @due: expiry in jiffies
+ *
+ * Return: the first tick not earlier than @due, or the current tick if
+ *	   @due has already passed
+ */
+static unsigned long
+cdf_mc_timer_wheel_tick_of(struct cdf_mc_timer_wheel *wheel, unsigned long due)
+{
+	if (!time_after(due, wheel->clk_jiffies))
+		return wheel->clk;
+
+	return wheel->clk + DIV_ROUND_UP(due - wheel->clk_jiffies,
+					 cdf_timer_wheel_tick);
+}
+
+/**
+ * cdf_mc_timer_wheel_add() - hash a timer into the wheel
+ * @wheel: wheel the timer belongs to
+ * @pinfo: platform info of the timer, wheel_expires already set
+ *
+ * Must be called with wheel->lock held.
+ *
+ * Return: none
+ */
+static void cdf_mc_timer_wheel_add(struct cdf_mc_timer_wheel *wheel,
+				   cdf_mc_timer_platform_t *pinfo)
+{
+	unsigned long expires = cdf_mc_timer_wheel_tick_of(wheel,
+							pinfo->wheel_expires);
+	unsigned long idx = expires - wheel->clk;
+	int lvl;
+
+	if (idx > CDF_MC_TIMER_WHEEL_MAX_TICKS) {
+		/* far timers sit in the last slot and cascade again */
+		expires = wheel->clk + CDF_MC_TIMER_WHEEL_MAX_TICKS;
+		idx = CDF_MC_TIMER_WHEEL_MAX_TICKS;
+	}
+
+	for (lvl = 0; lvl < CDF_MC_TIMER_WHEEL_LEVELS - 1; lvl++)
+		if (idx < (1UL << CDF_MC_TIMER_WHEEL_LVL_SHIFT(lvl + 1)))
+			break;
+
+	list_add_tail(&pinfo->wheel_node,
+		      &wheel->vec[lvl][(expires >>
+				CDF_MC_TIMER_WHEEL_LVL_SHIFT(lvl)) &
+				CDF_MC_TIMER_WHEEL_MASK]);
+}
+
+/**
+ * cdf_mc_timer_wheel_cascade() - move one upper level slot down
+ * @wheel: wheel
+ * @lvl: level to cascade from
+ * @slot: slot within @lvl
+ *
+ * Return: @slot, so that a zero return means the next level is due
+ */
+static int cdf_mc_timer_wheel_cascade(struct cdf_mc_timer_wheel *wheel,
+				      int lvl, int slot)
+{
+	cdf_mc_timer_platform_t *pinfo, *tmp;
+	LIST_HEAD(list);
+
+	list_splice_init(&wheel->vec[lvl][slot], &list);
+	list_for_each_entry_safe(pinfo, tmp, &list, wheel_node)
+		cdf_mc_timer_wheel_add(wheel, pinfo);
+
+	return slot;
+}
+
+/**
+ * cdf_mc_timer_wheel_next() - first tick at which the wheel has work
+ * @wheel: wheel with at least one pending timer
+ *
+ * This is either the first non-empty level 0 bucket or the first
+ * cascade point of a non-empty upper level bucket, whichever is first.
+ *
+ * Return: tick to arm the kernel timer for
+ */
+static unsigned long cdf_mc_timer_wheel_next(struct cdf_mc_timer_wheel *wheel)
+{
+	unsigned long clk = wheel->clk;
+	unsigned long next = clk + CDF_MC_TIMER_WHEEL_MAX_TICKS;
+	unsigned long t, step;
+	int lvl, i;
+
+	if (!list_empty(&wheel->expired))
+		return clk;
+
+	for (i = 0; i < CDF_MC_TIMER_WHEEL_SIZE; i++) {
+		t = clk + i;
+		if (!list_empty(&wheel->vec[0][t & CDF_MC_TIMER_WHEEL_MASK])) {
+			next = t;
+			break;
+		}
+	}
+
+	for (lvl = 1; lvl < CDF_MC_TIMER_WHEEL_LEVELS; lvl++) {
+		step = 1UL << CDF_MC_TIMER_WHEEL_LVL_SHIFT(lvl);
+		t = ALIGN(clk, step);
+		for (i = 0; i < CDF_MC_TIMER_WHEEL_SIZE; i++, t += step) {
+			if ((long)(t - next) >= 0)
+				break;
+			if (!list_empty(&wheel->vec[lvl][(t >>
+				CDF_MC_TIMER_WHEEL_LVL_SHIFT(lvl)) &
+				CDF_MC_TIMER_WHEEL_MASK])) {
+				next = t;
+				break;
+			}
+		}
+	}
+
+	return next;
+}
+
+/**
+ * cdf_mc_timer_wheel_program() - (re)arm or cancel the wheel kernel timer
+ * @wheel: wheel
+ *
+ * Must be called with wheel->lock held.
+ *
+ * Return: none
+ */
+static void cdf_mc_timer_wheel_program(struct cdf_mc_timer_wheel *wheel)
+{
+	unsigned long next;
+
+	if (!cdf_timer_wheel_inited)
+		return;
+
+	if (!wheel->pending) {
+		if (wheel->kt_armed) {
+			del_timer(&wheel->kt);
+			wheel->kt_armed = false;
+		}
+		return;
+	}
+
+	next = cdf_mc_timer_wheel_next(wheel);
+	if (wheel->kt_armed && wheel->kt_expires == next)
+		return;
+
+	wheel->kt_expires = next;
+	wheel->kt_armed = true;
+	mod_timer(&wheel->kt, wheel->clk_jiffies +
+		  (next - wheel->clk) * cdf_timer_wheel_tick);
+}
+
+/**
+ * cdf_mc_timer_wheel_pop() - take a batch of due timers off a wheel
+ * @wheel: wheel, with wheel->lock held
+ * @expired: filled with the callbacks of the popped timers
+ * @busy: set if a timer was skipped because its lock was contended
+ *
+ * Each timer is removed from the wheel and moved to the stopped state
+ * under its own lock, and only its callback, context, type and due time
+ * are kept, so the timer itself is not touched after wheel->lock is
+ * released. Timers whose lock is held are left on the expired list: the
+ * holder may be stopping or destroying the timer and be waiting for
+ * wheel->lock.
+ *
+ * Return: number of entries filled in @expired
+ */
+static int cdf_mc_timer_wheel_pop(struct cdf_mc_timer_wheel *wheel,
+				  struct cdf_mc_timer_expired *expired,
+				  bool *busy)
+{
+	cdf_mc_timer_platform_t *pinfo, *tmp;
+	cdf_mc_timer_t *timer;
+	int num = 0;
+
+	list_for_each_entry_safe(pinfo, tmp, &wheel->expired, wheel_node) {
+		if (num == CDF_MC_TIMER_FIRE_BATCH)
+			break;
+		if (!spin_trylock(&pinfo->spinlock)) {
+			*busy = true;
+			continue;
+		}
+		list_del_init(&pinfo->wheel_node);
+		wheel->pending--;
+		timer = container_of(pinfo, cdf_mc_timer_t, platformInfo);
+		if (timer->state == CDF_TIMER_STATE_RUNNING) {
+			timer->state = CDF_TIMER_STATE_STOPPED;
+			expired[num].callback = timer->callback;
+			expired[num].user_data = timer->userData;
+			expired[num].type = timer->type;
+			expired[num].due = pinfo->due_jiffies;
+			num++;
+		}
+		spin_unlock(&pinfo->spinlock);
+	}
+
+	return num;
+}
+
+/**
+ * cdf_mc_timer_wheel_fire() - queue the callbacks of popped timers
+ * @expired: callbacks popped by cdf_mc_timer_wheel_pop()
+ * @num: number of entries in @expired
+ * @batched: true if the kernel timer expiry fired more than one timer
+ *
+ * Return: true if the dispatch message needs to be posted
+ */
+static bool cdf_mc_timer_wheel_fire(struct cdf_mc_timer_expired *expired,
+				    int num, bool batched)
+{
+	uint32_t late_ms;
+	bool post = false;
+	int i;
+
+	for (i = 0; i < num; i++) {
+		try_allowing_sleep(expired[i].type);
+
+		if (expired[i].callback == NULL) {
+			CDF_ASSERT(0);
+			continue;
+		}
+		late_ms = time_after(jiffies, expired[i].due) ?
+			  jiffies_to_msecs(jiffies - expired[i].due) : 0;
+		post |= cdf_mc_timer_queue_fire(expired[i].callback,
+						expired[i].user_data, late_ms,
+						batched);
+	}
+
+	return post;
+}
+
+/**
+ * cdf_mc_timer_wheel_expire() - kernel timer handler of a wheel
+ * @data: the wheel
+ *
+ * Advances the wheel to the current tick, cascading upper levels as
+ * their boundaries are crossed, and fires everything that is due.
+ *
+ * Return: none
+ */
+static void cdf_mc_timer_wheel_expire(unsigned long data)
+{
+	struct cdf_mc_timer_wheel *wheel = (struct cdf_mc_timer_wheel *)data;
+	struct cdf_mc_timer_expired expired[CDF_MC_TIMER_FIRE_BATCH];
+	cdf_mc_timer_platform_t *pinfo;
+	unsigned long now = jiffies;
+	unsigned long flags;
+	uint32_t fired = 0, total;
+	bool post = false, busy;
+	int idx, num;
+
+	spin_lock_irqsave(&wheel->lock, flags);
+	wheel->kt_armed = false;
+	wheel->kt_fires++;
+
+	while (time_after_eq(now, wheel->clk_jiffies)) {
+		idx = wheel->clk & CDF_MC_TIMER_WHEEL_MASK;
+		if (!idx &&
+		    !cdf_mc_timer_wheel_cascade(wheel, 1,
+				(wheel->clk >> CDF_MC_TIMER_WHEEL_LVL_SHIFT(1)) &
+				CDF_MC_TIMER_WHEEL_MASK))
+			cdf_mc_timer_wheel_cascade(wheel, 2,
+				(wheel->clk >> CDF_MC_TIMER_WHEEL_LVL_SHIFT(2)) &
+				CDF_MC_TIMER_WHEEL_MASK);
+		list_splice_tail_init(&wheel->vec[0][idx], &wheel->expired);
+		wheel->clk++;
+		wheel->clk_jiffies += cdf_timer_wheel_tick;
+	}
+
+	total = 0;
+	list_for_each_entry(pinfo, &wheel->expired, wheel_node)
+		total++;
+
+	while (!list_empty(&wheel->expired)) {
+		busy = false;
+		num = cdf_mc_timer_wheel_pop(wheel, expired, &busy);
+		fired += num;
+		spin_unlock_irqrestore(&wheel->lock, flags);
+		post |= cdf_mc_timer_wheel_fire(expired, num, total > 1);
+		/* let a contended timer lock holder take wheel->lock */
+		if (busy && !num)
+			cpu_relax();
+		spin_lock_irqsave(&wheel->lock, flags);
+	}
+
+	wheel->timers_fired += fired;
+	if (fired > wheel->max_batch)
+		wheel->max_batch = fired;
+	cdf_mc_timer_wheel_program(wheel);
+	spin_unlock_irqrestore(&wheel->lock, flags);
+
+	if (post && cdf_mc_timer_post_msg(cdf_mc_timer_dispatch, NULL) !=
+		    CDF_STATUS_SUCCESS)
+		cdf_mc_timer_reset_fire_ring();
+}
+
+/**
+ * cdf_mc_timer_os_init() - set up the OS part of a CDF timer
+ * @timer: timer
+ * @type: timer type
+ *
+ * Return: none
+ */
+static void cdf_mc_timer_os_init(cdf_mc_timer_t *timer, CDF_TIMER_TYPE type)
+{
+	INIT_LIST_HEAD(&timer->platformInfo.wheel_node);
+	timer->platformInfo.slack_ms = 0;
+}
+
+/**
+ * cdf_mc_timer_os_arm() - queue a timer on its wheel
+ * @timer: timer, platformInfo.spinlock held
+ * @msec: expiry in ms
+ *
+ * Return: false if the wheel is not initialized yet
+ */
+static bool cdf_mc_timer_os_arm(cdf_mc_timer_t *timer, uint32_t msec)
+{
+	struct cdf_mc_timer_wheel *wheel = cdf_mc_timer_get_wheel(timer->type);
+	cdf_mc_timer_platform_t *pinfo = &timer->platformInfo;
+	unsigned long now = jiffies;
+	unsigned long expires, limit, mask;
+	bool slacked = false;
+
+	if (!cdf_timer_wheel_inited)
+		return false;
+
+	pinfo->due_jiffies = now + msecs_to_jiffies(msec);
+
+	spin_lock(&wheel->lock);
+	if (!wheel->pending)
+		wheel->clk_jiffies = now;
+	expires = cdf_mc_timer_wheel_tick_of(wheel, pinfo->due_jiffies);
+	if (pinfo->slack_ms) {
+		/* pick the coarsest tick boundary within the slack */
+		limit = pinfo->due_jiffies + msecs_to_jiffies(pinfo->slack_ms);
+		limit = time_after(limit, wheel->clk_jiffies) ?
+			wheel->clk + (limit - wheel->clk_jiffies) /
+				     cdf_timer_wheel_tick :
+			wheel->clk;
+		mask = expires ^ limit;
+		if ((long)(limit - expires) > 0) {
+			mask = (1UL << __fls(mask)) - 1;
+			expires = limit & ~mask;
+			slacked = true;
+		}
+	}
+	pinfo->wheel_expires = wheel->clk_jiffies +
+			       (expires - wheel->clk) * cdf_timer_wheel_tick;
+	cdf_mc_timer_wheel_add(wheel, pinfo);
+	wheel->pending++;
+	cdf_mc_timer_wheel_program(wheel);
+	spin_unlock(&wheel->lock);
+
+	cdf_mc_timer_site_start(timer->callback, slacked);
+	return true;
+}
+
+/**
+ * cdf_mc_timer_os_disarm() - remove a timer from its wheel
+ * @timer: timer, platformInfo.spinlock held
+ *
+ * Return: none
+ */
+static void cdf_mc_timer_os_disarm(cdf_mc_timer_t *timer)
+{
+	struct cdf_mc_timer_wheel *wheel = cdf_mc_timer_get_wheel(timer->type);
+
+	spin_lock(&wheel->lock);
+	if (!list_empty(&timer->platformInfo.wheel_node)) {
+		list_del_init(&timer->platformInfo.wheel_node);
+		wheel->pending--;
+		cdf_mc_timer_wheel_program(wheel);
+	}
+	spin_unlock(&wheel->lock);
+}
+
+static void cdf_mc_timer_wheel_init(void)
+{
+	struct cdf_mc_timer_wheel *wheel;
+	int i, lvl, slot;
+
+	if (cdf_timer_wheel_inited)
+		return;
+
+	cdf_timer_wheel_tick = msecs_to_jiffies(CDF_MC_TIMER_WHEEL_GRAN_MS);
+	if (!cdf_timer_wheel_tick)
+		cdf_timer_wheel_tick = 1;
+
+	for (i = 0; i < ARRAY_SIZE(cdf_timer_wheel); i++) {
+		wheel = &cdf_timer_wheel[i];
+		memset(wheel, 0, sizeof(*wheel));
+		spin_lock_init(&wheel->lock);
+		INIT_LIST_HEAD(&wheel->expired);
+		for (lvl = 0; lvl < CDF_MC_TIMER_WHEEL_LEVELS; lvl++)
+			for (slot = 0; slot < CDF_MC_TIMER_WHEEL_SIZE; slot++)
+				INIT_LIST_HEAD(&wheel->vec[lvl][slot]);
+		/* only the WAKE_APPS wheel may wake the CPU up */
+		if (wheel == cdf_mc_timer_get_wheel(CDF_TIMER_TYPE_SW))
+			init_timer_deferrable(&wheel->kt);
+		else
+			init_timer(&wheel->kt);
+		wheel->kt.function = cdf_mc_timer_wheel_expire;
+		wheel->kt.data = (unsigned long)wheel;
+		wheel->clk_jiffies = jiffies;
+	}
+	cdf_timer_wheel_inited = true;
+}
+
+static void cdf_mc_timer_wheel_deinit(void)
+{
+	int i;
+
+	if (!cdf_timer_wheel_inited)
+		return;
+
+	for (i = 0; i < ARRAY_SIZE(cdf_timer_wheel); i++) {
+		del_timer_sync(&cdf_timer_wheel[i].kt);
+		if (cdf_timer_wheel[i].pending)
+			CDF_TRACE(CDF_MODULE_ID_CDF, CDF_TRACE_LEVEL_ERROR,
+				  "%s: wheel %d still has %u timers",
+				  __func__, i, cdf_timer_wheel[i].pending);
+	}
+	cdf_timer_wheel_inited = false;
+}
+
+void cdf_mc_timer_display_stats(void)
+{
+	struct cdf_mc_timer_site_stats *site;
+	unsigned long flags;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(cdf_timer_wheel); i++)
+		CDF_TRACE(CDF_MODULE_ID_CDF, CDF_TRACE_LEVEL_ERROR,
+			  "MC timer wheel %s: pending %u wakeups %u fired %u max batch %u",
+			  i ? "wake_apps" : "sw", cdf_timer_wheel[i].pending,
+			  cdf_timer_wheel[i].kt_fires,
+			  cdf_timer_wheel[i].timers_fired,
+			  cdf_timer_wheel[i].max_batch);
+
+	spin_lock_irqsave(&cdf_timer_fire_lock, flags);
+	CDF_TRACE(CDF_MODULE_ID_CDF, CDF_TRACE_LEVEL_ERROR,
+		  "MC timer dispatch: queued %u overflow %u untracked sites %u",
+		  cdf_timer_fire_count, cdf_timer_fire_overflow,
+		  cdf_timer_sites_dropped);
+	for (i = 0; i < CDF_MC_TIMER_SITE_NUM; i++) {
+		site = &cdf_timer_sites[i];
+		if (!site->callback)
+			continue;
+		CDF_TRACE(CDF_MODULE_ID_CDF, CDF_TRACE_LEVEL_ERROR,
+			  "%pS: starts %u slacked %u fires %u batched %u late avg %u max %u ms",
+			  site->callback, site->starts, site->slacked,
+			  site->fires, site->batched,
+			  site->fires ? site->late_ms_total / site->fires : 0,
+			  site->late_ms_max);
+	}
+	spin_unlock_irqrestore(&cdf_timer_fire_lock, flags);
+}
+
+void cdf_mc_timer_clear_stats(void)
+{
+	unsigned long flags;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(cdf_timer_wheel); i++) {
+		spin_lock_irqsave(&cdf_timer_wheel[i].lock, flags);
+		cdf_timer_wheel[i].kt_fires = 0;
+		cdf_timer_wheel[i].timers_fired = 0;
+		cdf_timer_wheel[i].max_batch = 0;
+		spin_unlock_irqrestore(&cdf_timer_wheel[i].lock, flags);
+	}
+
+	spin_lock_irqsave(&cdf_timer_fire_lock, flags);
+	memset(cdf_timer_sites, 0, sizeof(cdf_timer_sites));
+	cdf_timer_fire_overflow = 0;
+	cdf_timer_sites_dropped = 0;
+	spin_unlock_irqrestore(&cdf_timer_fire_lock, flags);
+}
+#else
+static void cdf_mc_timer_os_init(cdf_mc_timer_t *timer, CDF_TIMER_TYPE type)
+{
+	if (CDF_TIMER_TYPE_SW == type)
+		init_timer_deferrable(&(timer->platformInfo.Timer));
+	else
+		init_timer(&(timer->platformInfo.Timer));
+	timer->platformInfo.Timer.function = cdf_linux_timer_callback;
+	timer->platformInfo.Timer.data = (unsigned long)timer;
+}
+
+static bool cdf_mc_timer_os_arm(cdf_mc_timer_t *timer, uint32_t msec)
+{
+	mod_timer(&(timer->platformInfo.Timer),
+		  jiffies + msecs_to_jiffies(msec));
+	return true;
+}
+
+static void cdf_mc_timer_os_disarm(cdf_mc_timer_t *timer)
+{
+	del_timer(&(timer->platformInfo.Timer));
+}
+
+static void cdf_mc_timer_wheel_init(void)
+{
+}
+
+static void cdf_mc_timer_wheel_deinit(void)
+{
+}
+
+void cdf_mc_timer_display_stats(void)
+{
+	CDF_TRACE(CDF_MODULE_ID_CDF, CDF_TRACE_LEVEL_ERROR,
+		  "%s: MC timer wheel is not enabled", __func__);
 }
 
+void cdf_mc_timer_clear_stats(void)
+{
+}
+
+void cdf_mc_timer_flush_fired(void)
+{
+}
+#endif /* FEATURE_MC_TIMER_WHEEL */
+
 /**
  * cdf_mc_timer_get_current_state() - get the current state of the timer
  * @pTimer: Pointer to timer object
@@ -229,6 +1038,19 @@ void cdf_timer_module_init(void)
 	CDF_TRACE(CDF_MODULE_ID_CDF, CDF_TRACE_LEVEL_INFO,
 		  "Initializing the CDF timer module");
 	cdf_mutex_init(&persistent_timer_count_lock);
+	cdf_mc_timer_wheel_init();
+}
+
+/**
+ * cdf_timer_module_deinit() - tear down the CDF timer module
+ *
+ * All CDF timers must have been destroyed before this is called.
+ *
+ * Return: none
+ */
+void cdf_timer_module_deinit(void)
+{
+	cdf_mc_timer_wheel_deinit();
 }
 
 #ifdef TIMER_MANAGER
@@ -386,12 +1208,7 @@ CDF_STATUS cdf_mc_timer_init_debug(cdf_mc_timer_t *timer,
 	 * with arguments passed or with default values
 	 */
 	spin_lock_init(&timer->platformInfo.spinlock);
-	if (CDF_TIMER_TYPE_SW == timerType)
-		init_timer_deferrable(&(timer->platformInfo.Timer));
-	else
-		init_timer(&(timer->platformInfo.Timer));
-	timer->platformInfo.Timer.function = cdf_linux_timer_callback;
-	timer->platformInfo.Timer.data = (unsigned long)timer;
+	cdf_mc_timer_os_init(timer, timerType);
 	timer->callback = callback;
 	timer->userData = userData;
 	timer->type = timerType;
@@ -418,12 +1235,7 @@ CDF_STATUS cdf_mc_timer_init(cdf_mc_timer_t *timer, CDF_TIMER_TYPE timerType,
 	 * with arguments passed or with default values
 	 */
 	spin_lock_init(&timer->platformInfo.spinlock);
-	if (CDF_TIMER_TYPE_SW == timerType)
-		init_timer_deferrable(&(timer->platformInfo.Timer));
-	else
-		init_timer(&(timer->platformInfo.Timer));
-	timer->platformInfo.Timer.function = cdf_linux_timer_callback;
-	timer->platformInfo.Timer.data = (unsigned long)timer;
+	cdf_mc_timer_os_init(timer, timerType);
 	timer->callback = callback;
 	timer->userData = userData;
 	timer->type = timerType;
@@ -498,7 +1310,7 @@ CDF_STATUS cdf_mc_timer_destroy(cdf_mc_timer_t *timer)
 
 	case CDF_TIMER_STATE_RUNNING:
 		/* Stop the timer first */
-		del_timer(&(timer->platformInfo.Timer));
+		cdf_mc_timer_os_disarm(timer);
 		vStatus = CDF_STATUS_SUCCESS;
 		break;
 	case CDF_TIMER_STATE_STOPPED:
@@ -584,7 +1396,7 @@ CDF_STATUS cdf_mc_timer_destroy(cdf_mc_timer_t *timer)
 
 	case CDF_TIMER_STATE_RUNNING:
 		/* Stop the timer first */
-		del_timer(&(timer->platformInfo.Timer));
+		cdf_mc_timer_os_disarm(timer);
 		vStatus = CDF_STATUS_SUCCESS;
 		break;
 
@@ -682,9 +1494,13 @@ CDF_STATUS cdf_mc_timer_start(cdf_mc_timer_t *timer, uint32_t expirationTime)
 	}
 
 	/* start the timer */
-	mod_timer(&(timer->platformInfo.Timer),
-		  jiffies + msecs_to_jiffies(expirationTime));
-
+	if (!cdf_mc_timer_os_arm(timer, expirationTime)) {
+		spin_unlock_irqrestore(&timer->platformInfo.spinlock, flags);
+		CDF_TRACE(CDF_MODULE_ID_CDF, CDF_TRACE_LEVEL_ERROR,
+			  "%s: timer module is not initialized", __func__);
+		CDF_ASSERT(0);
+		return CDF_STATUS_E_FAILURE;
+	}
 	timer->state = CDF_TIMER_STATE_RUNNING;
 
 	/* get the thread ID on which the timer is being started */
@@ -755,7 +1571,7 @@ CDF_STATUS cdf_mc_timer_stop(cdf_mc_timer_t *timer)
 
 	timer->state = CDF_TIMER_STATE_STOPPED;
 
-	del_timer(&(timer->platformInfo.Timer));
+	cdf_mc_timer_os_disarm(timer);
 
 	spin_unlock_irqrestore(&timer->platformInfo.spinlock, flags);
 
@@ -764,6 +1580,32 @@ CDF_STATUS cdf_mc_timer_stop(cdf_mc_timer_t *timer)
 	return CDF_STATUS_SUCCESS;
 }
 
+/**
+ * cdf_mc_timer_set_slack() - allow a timer to expire late
+ * @timer:	Pointer to timer object
+ * @slack_ms:	Maximum delay past the requested expiry, in ms
+ *
+ * Return:
+ *	CDF_STATUS_SUCCESS - slack updated
+ *	CDF_STATUS_E_INVAL - timer is not initialized
+ */
+CDF_STATUS cdf_mc_timer_set_slack(cdf_mc_timer_t *timer, uint32_t slack_ms)
+{
+	unsigned long flags;
+
+	if (NULL == timer ||
+	    LINUX_TIMER_COOKIE != timer->platformInfo.cookie) {
+		CDF_ASSERT(0);
+		return CDF_STATUS_E_INVAL;
+	}
+
+	spin_lock_irqsave(&timer->platformInfo.spinlock, flags);
+	timer->platformInfo.slack_ms = slack_ms;
+	spin_unlock_irqrestore(&timer->platformInfo.spinlock, flags);
+
+	return CDF_STATUS_SUCCESS;
+}
+
 /**
  * cdf_mc_timer_get_system_ticks() - get the system time in 10ms ticks
 
@@ -226,6 +226,39 @@ void __cdf_nbuf_free(struct sk_buff *skb)
 		dev_kfree_skb_any(skb);
 }
 
+/**
+ * __cdf_nbuf_tx_free() - free a list of tx completed skbs
+ * @bufs: list of skbs, linked through skb->next
+ * @tx_err: TX error
+ *
+ * Buffers owned by IPA are handed back through their owner callback. The
+ * rest are consumed rather than dropped when the tx succeeded, so that
+ * completed frames do not show up as drops in skb drop monitoring.
+ *
+ * Return: none
+ */
+void __cdf_nbuf_tx_free(struct sk_buff *bufs, int tx_err)
+{
+	struct sk_buff *next;
+
+	while (bufs) {
+		next = bufs->next;
+		bufs->next = NULL;
+		if ((NBUF_OWNER_ID(bufs) == IPA_NBUF_OWNER_ID) &&
+		    NBUF_CALLBACK_FN(bufs))
+			NBUF_CALLBACK_FN_EXEC(bufs);
+		else if (tx_err)
+			dev_kfree_skb_any(bufs);
+		else
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 18, 0))
+			dev_consume_skb_any(bufs);
+#else
+			dev_kfree_skb_any(bufs);
+#endif
+		bufs = next;
+	}
+}
+
 /**
  * __cdf_nbuf_map() - get the dma map of the nbuf
  * @osdev: OS device
@@ -808,58 +841,82 @@ uint8_t __cdf_nbuf_get_tso_cmn_seg_info(struct sk_buff *skb,
  * segments to be transmitted by the driver. It chains the TSO
  * segments created into a list.
  *
- * Return: number of TSO segments
+ * The linear part of the skb and each page fragment are DMA mapped
+ * exactly once per jumbo packet.  The mapping of the linear part is
+ * shared by the EIT header fragment of every segment, and the payload
+ * fragments of the segments point at offsets within these mappings.
+ *
+ * Return: number of TSO segments, 0 on failure
  */
 uint32_t __cdf_nbuf_get_tso_info(cdf_device_t osdev, struct sk_buff *skb,
 		struct cdf_tso_info_t *tso_info)
 {
 	/* common accross all segments */
 	struct cdf_tso_cmn_seg_info_t tso_cmn_info;
+	dma_addr_t frag_paddr[MAX_SKB_FRAGS];
+	dma_addr_t head_paddr;
+	int nr_frags = skb_shinfo(skb)->nr_frags;
+	int j;
 
 	/* segment specific */
-	char *tso_frag_vaddr;
-	uint32_t tso_frag_paddr_32 = 0;
-	uint32_t num_seg = 0;
 	struct cdf_tso_seg_elem_t *curr_seg;
-	const struct skb_frag_struct *frag = NULL;
-	uint32_t tso_frag_len = 0; /* tso segment's fragment length*/
-	uint32_t skb_frag_len = 0; /* skb's fragment length (continous memory)*/
-	uint32_t foffset = 0; /* offset into the skb's fragment */
-	uint32_t skb_proc = 0; /* bytes of the skb that have been processed*/
+	uint32_t num_seg = 0;
 	uint32_t tso_seg_size = skb_shinfo(skb)->gso_size;
 
+	/* the part of the current skb chunk not yet placed in a segment */
+	unsigned char *chunk_vaddr;
+	dma_addr_t chunk_paddr;
+	uint32_t chunk_len;
+	int next_frag = 0; /* next skb fragment to take payload from */
+
 	memset(&tso_cmn_info, 0x0, sizeof(tso_cmn_info));
 
 	if (cdf_unlikely(__cdf_nbuf_get_tso_cmn_seg_info(skb, &tso_cmn_info))) {
 		cdf_print("TSO: error getting common segment info\n");
 		return 0;
 	}
-	curr_seg = tso_info->tso_seg_list;
 
-	/* length of the first chunk of data in the skb */
-	skb_proc = skb_frag_len = skb->len - skb->data_len;
+	/* map the EIT header and the rest of the linear data once */
+	head_paddr = dma_map_single(osdev->dev, skb->data, skb_headlen(skb),
+				    DMA_TO_DEVICE);
+	if (cdf_unlikely(dma_mapping_error(osdev->dev, head_paddr))) {
+		cdf_print("TSO: DMA mapping of the skb head failed\n");
+		return 0;
+	}
 
-	/* the 0th tso segment's 0th fragment always contains the EIT header */
-	/* update the remaining skb fragment length and TSO segment length */
-	skb_frag_len -= tso_cmn_info.eit_hdr_len;
-	skb_proc -= tso_cmn_info.eit_hdr_len;
+	for (j = 0; j < nr_frags; j++) {
+		const struct skb_frag_struct *frag = &skb_shinfo(skb)->frags[j];
+
+		frag_paddr[j] = skb_frag_dma_map(osdev->dev, frag, 0,
+						 skb_frag_size(frag),
+						 DMA_TO_DEVICE);
+		if (cdf_unlikely(dma_mapping_error(osdev->dev,
+						   frag_paddr[j]))) {
+			cdf_print("TSO: DMA mapping of skb frag %d failed\n",
+				  j);
+			while (j--)
+				dma_unmap_page(osdev->dev, frag_paddr[j],
+					skb_frag_size(&skb_shinfo(skb)->frags[j]),
+					DMA_TO_DEVICE);
+			dma_unmap_single(osdev->dev, head_paddr,
+					 skb_headlen(skb), DMA_TO_DEVICE);
+			return 0;
+		}
+	}
 
-	/* get the address to the next tso fragment */
-	tso_frag_vaddr = skb->data + tso_cmn_info.eit_hdr_len;
-	/* get the length of the next tso fragment */
-	tso_frag_len = min(skb_frag_len, tso_seg_size);
-	tso_frag_paddr_32 = dma_map_single(osdev->dev,
-		 tso_frag_vaddr, tso_frag_len, DMA_TO_DEVICE);
+	/* the payload starts right after the EIT header */
+	chunk_vaddr = skb->data + tso_cmn_info.eit_hdr_len;
+	chunk_paddr = head_paddr + tso_cmn_info.eit_hdr_len;
+	chunk_len = skb_headlen(skb) - tso_cmn_info.eit_hdr_len;
 
+	curr_seg = tso_info->tso_seg_list;
 	num_seg = tso_info->num_segs;
 	tso_info->num_segs = 0;
 	tso_info->is_tso = 1;
 
 	while (num_seg && curr_seg) {
 		int i = 1; /* tso fragment index */
-		int j = 0; /* skb fragment index */
-		uint8_t more_tso_frags = 1;
-		uint8_t from_frag_table = 0;
+		uint32_t seg_left = tso_seg_size; /* payload still to place */
 
 		/* Initialize the flags to 0 */
 		memset(&curr_seg->seg, 0x0, sizeof(curr_seg->seg));
@@ -894,80 +951,52 @@ uint32_t __cdf_nbuf_get_tso_info(cdf_device_t osdev, struct sk_buff *skb,
 		curr_seg->seg.tso_flags.tcp_seq_num = tso_cmn_info.tcp_seq_num;
 
 		/* First fragment for each segment always contains the ethernet,
-		IP and TCP header */
+		IP and TCP header, all sharing the mapping of the skb head */
 		curr_seg->seg.tso_frags[0].vaddr = tso_cmn_info.eit_hdr;
 		curr_seg->seg.tso_frags[0].length = tso_cmn_info.eit_hdr_len;
 		tso_info->total_len = curr_seg->seg.tso_frags[0].length;
-		curr_seg->seg.tso_frags[0].paddr_low_32 =
-			 dma_map_single(osdev->dev, tso_cmn_info.eit_hdr,
-				tso_cmn_info.eit_hdr_len, DMA_TO_DEVICE);
+		curr_seg->seg.tso_frags[0].paddr_low_32 = (uint32_t)head_paddr;
 		curr_seg->seg.tso_flags.ip_len = tso_cmn_info.ip_tcp_hdr_len;
 		curr_seg->seg.num_frags++;
 
-		while (more_tso_frags) {
-			curr_seg->seg.tso_frags[i].vaddr = tso_frag_vaddr;
+		while (seg_left && i < FRAG_NUM_MAX) {
+			uint32_t tso_frag_len;
+
+			/* move on to the next skb fragment */
+			while (!chunk_len && next_frag < nr_frags) {
+				const struct skb_frag_struct *frag =
+					&skb_shinfo(skb)->frags[next_frag];
+
+				chunk_vaddr = skb_frag_address(frag);
+				chunk_paddr = frag_paddr[next_frag];
+				chunk_len = skb_frag_size(frag);
+				next_frag++;
+			}
+
+			/* if there is no more data left in the skb */
+			if (!chunk_len)
+				break;
+
+			tso_frag_len = min(chunk_len, seg_left);
+			curr_seg->seg.tso_frags[i].vaddr = chunk_vaddr;
 			curr_seg->seg.tso_frags[i].length = tso_frag_len;
-			tso_info->total_len +=
-				 curr_seg->seg.tso_frags[i].length;
-			curr_seg->seg.tso_flags.ip_len +=
-				 curr_seg->seg.tso_frags[i].length;
+			curr_seg->seg.tso_frags[i].paddr_upper_16 = 0;
+			curr_seg->seg.tso_frags[i].paddr_low_32 =
+				 (uint32_t)chunk_paddr;
+			tso_info->total_len += tso_frag_len;
+			curr_seg->seg.tso_flags.ip_len += tso_frag_len;
 			curr_seg->seg.num_frags++;
-			skb_proc = skb_proc - curr_seg->seg.tso_frags[i].length;
 
 			/* increment the TCP sequence number */
 			tso_cmn_info.tcp_seq_num += tso_frag_len;
-			curr_seg->seg.tso_frags[i].paddr_upper_16 = 0;
-			curr_seg->seg.tso_frags[i].paddr_low_32 =
-				 tso_frag_paddr_32;
 
-			/* if there is no more data left in the skb */
-			if (!skb_proc)
-				return tso_info->num_segs;
-
-			/* get the next payload fragment information */
-			/* check if there are more fragments in this segment */
-			if ((tso_seg_size - tso_frag_len)) {
-				more_tso_frags = 1;
-				i++;
-			} else {
-				more_tso_frags = 0;
-				/* reset i and the tso payload size */
-				i = 1;
-				tso_seg_size = skb_shinfo(skb)->gso_size;
-			}
-
-			/* if the next fragment is contiguous */
-			if (tso_frag_len < skb_frag_len) {
-				skb_frag_len = skb_frag_len - tso_frag_len;
-				tso_frag_len = min(skb_frag_len, tso_seg_size);
-				tso_frag_vaddr = tso_frag_vaddr + tso_frag_len;
-				if (from_frag_table) {
-					tso_frag_paddr_32 =
-						 skb_frag_dma_map(osdev->dev,
-							 frag, foffset,
-							 tso_frag_len,
-							 DMA_TO_DEVICE);
-				} else {
-					tso_frag_paddr_32 =
-						 dma_map_single(osdev->dev,
-							 tso_frag_vaddr,
-							 tso_frag_len,
-							 DMA_TO_DEVICE);
-				}
-			} else { /* the next fragment is not contiguous */
-				tso_frag_len = min(skb_frag_len, tso_seg_size);
-				frag = &skb_shinfo(skb)->frags[j];
-				skb_frag_len = skb_frag_size(frag);
-
-				tso_frag_vaddr = skb_frag_address(frag);
-				tso_frag_paddr_32 = skb_frag_dma_map(osdev->dev,
-					 frag, 0, tso_frag_len,
-					 DMA_TO_DEVICE);
-				foffset += tso_frag_len;
-				from_frag_table = 1;
-				j++;
-			}
+			chunk_vaddr += tso_frag_len;
+			chunk_paddr += tso_frag_len;
+			chunk_len -= tso_frag_len;
+			seg_left -= tso_frag_len;
+			i++;
 		}
+
 		num_seg--;
 		/* if TCP FIN flag was set, set it in the last segment */
 		if (!num_seg)
@@ -40,6 +40,7 @@
 #include <linux/timer.h>
 #include <linux/time.h>
 #include <linux/jiffies.h>
+#include <linux/list.h>
 
 /* Preprocessor definitions and constants */
 
@@ -53,6 +54,11 @@ typedef struct cdf_mc_timer_platform_s {
 	int threadID;
 	uint32_t cookie;
 	spinlock_t spinlock;
+	/* timer wheel bookkeeping, see cdf_mc_timer.c */
+	struct list_head wheel_node;
+	unsigned long wheel_expires;
+	unsigned long due_jiffies;
+	uint32_t slack_ms;
 } cdf_mc_timer_platform_t;
 
 #ifdef __cplusplus
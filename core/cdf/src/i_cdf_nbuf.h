@@ -76,6 +76,7 @@ typedef void (*cdf_nbuf_trace_update_t)(char *);
  *		2) Pkt type (802.3 or Ethernet Type II)
  *		3) Pkt Offset (Usually the length of HTT/HTC desc.)
  * @trace: info for DP tracing
+ * @tx_pkt_class: tx classification cached by the OS shim (NBUF_TX_PKT_CLASS_*)
  * @mapped_paddr_lo: DMA mapping info
  * @extra_frags: Extra tx fragments
  * @owner_id: Owner id
@@ -85,6 +86,7 @@ typedef void (*cdf_nbuf_trace_update_t)(char *);
  * @vdev_id: vdev id
  * @tx_htt2_frm: HTT 2 frame
  * @tx_htt2_reserved: HTT 2 reserved bits
+ * @tx_lat_peer: local peer id + 1 of the tx destination, 0 if unknown
  */
 struct cvg_nbuf_cb {
 	uint32_t data_attr;
@@ -96,6 +98,8 @@ struct cvg_nbuf_cb {
 		uint8_t packet_track;
 		uint8_t dp_trace;
 	} trace;
+	/* fits in the padding ahead of mapped_paddr_lo */
+	uint8_t tx_pkt_class;
 
 	/*
 	 * Store the DMA mapping info for the network buffer fragments
@@ -139,6 +143,9 @@ wordstream_flags:CVG_NBUF_MAX_EXTRA_FRAGS + 1;
 	unsigned char tx_htt2_frm:1;
 	unsigned char tx_htt2_reserved:7;
 #endif /* QCA_TX_HTT2_SUPPORT */
+#ifdef QCA_TX_PEER_LATENCY
+	unsigned char tx_lat_peer;
+#endif /* QCA_TX_PEER_LATENCY */
 };
 #ifdef DEBUG_RX_RING_BUFFER
 #define NBUF_MAP_ID(skb) \
@@ -165,6 +172,14 @@ wordstream_flags:CVG_NBUF_MAX_EXTRA_FRAGS + 1;
 #define NBUF_EXTRA_FRAG_WORDSTREAM_FLAGS(skb) \
 	(((struct cvg_nbuf_cb *)((skb)->cb))->extra_frags.wordstream_flags)
 
+#define NBUF_TX_PKT_CLASS_VALID 0x80
+#define NBUF_TX_PKT_CLASS_EAPOL 0x01
+#define NBUF_TX_PKT_CLASS_WAI   0x02
+#define NBUF_SET_TX_PKT_CLASS(skb, pkt_class) \
+	(((struct cvg_nbuf_cb *)((skb)->cb))->tx_pkt_class = (pkt_class))
+#define NBUF_GET_TX_PKT_CLASS(skb) \
+	(((struct cvg_nbuf_cb *)((skb)->cb))->tx_pkt_class)
+
 #ifdef QCA_PKT_PROTO_TRACE
 #define NBUF_SET_PROTO_TYPE(skb, proto_type) \
 	(((struct cvg_nbuf_cb *)((skb)->cb))->proto_type = proto_type)
@@ -185,6 +200,16 @@ wordstream_flags:CVG_NBUF_MAX_EXTRA_FRAGS + 1;
 #define NBUF_GET_TX_HTT2_FRM(skb) 0
 #endif /* QCA_TX_HTT2_SUPPORT */
 
+#ifdef QCA_TX_PEER_LATENCY
+#define NBUF_SET_TX_LAT_PEER(skb, peer) \
+	(((struct cvg_nbuf_cb *)((skb)->cb))->tx_lat_peer = peer)
+#define NBUF_GET_TX_LAT_PEER(skb) \
+	(((struct cvg_nbuf_cb *)((skb)->cb))->tx_lat_peer)
+#else
+#define NBUF_SET_TX_LAT_PEER(skb, peer)
+#define NBUF_GET_TX_LAT_PEER(skb) 0
+#endif /* QCA_TX_PEER_LATENCY */
+
 #define NBUF_DATA_ATTR_SET(skb, data_attr)	\
 	(((struct cvg_nbuf_cb *)((skb)->cb))->data_attr = data_attr)
 
@@ -369,6 +394,7 @@ typedef struct __cdf_nbuf_qhead {
 __cdf_nbuf_t __cdf_nbuf_alloc(__cdf_device_t osdev, size_t size, int reserve,
 			      int align, int prio);
 void __cdf_nbuf_free(struct sk_buff *skb);
+void __cdf_nbuf_tx_free(struct sk_buff *bufs, int tx_err);
 CDF_STATUS __cdf_nbuf_map(__cdf_device_t osdev,
 			  struct sk_buff *skb, cdf_dma_dir_t dir);
 void __cdf_nbuf_unmap(__cdf_device_t osdev,
@@ -894,22 +920,6 @@ __cdf_nbuf_append_ext_list(struct sk_buff *skb_head,
 	skb_head->len += skb_head->data_len;
 }
 
-/**
- * __cdf_nbuf_tx_free() - free skb list
- * @skb: Pointer to network buffer
- * @tx_err: TX error
- *
- * Return: none
- */
-static inline void __cdf_nbuf_tx_free(struct sk_buff *bufs, int tx_err)
-{
-	while (bufs) {
-		struct sk_buff *next = __cdf_nbuf_next(bufs);
-		__cdf_nbuf_free(bufs);
-		bufs = next;
-	}
-}
-
 /**
  * __cdf_nbuf_get_age() - return the checksum value of the skb
  * @skb: Pointer to network buffer
@@ -1002,6 +1012,17 @@ __cdf_nbuf_set_protocol(struct sk_buff *skb, uint16_t protocol)
 #define __cdf_nbuf_get_tx_htt2_frm(skb)	\
 	NBUF_GET_TX_HTT2_FRM(skb)
 
+#define __cdf_nbuf_set_tx_pkt_class(skb, pkt_class) \
+	NBUF_SET_TX_PKT_CLASS(skb, pkt_class)
+
+#define __cdf_nbuf_get_tx_pkt_class(skb) \
+	NBUF_GET_TX_PKT_CLASS(skb)
+
+#define __cdf_nbuf_set_tx_lat_peer(skb, peer) \
+	NBUF_SET_TX_LAT_PEER(skb, peer)
+#define __cdf_nbuf_get_tx_lat_peer(skb) \
+	NBUF_GET_TX_LAT_PEER(skb)
+
 #if defined(FEATURE_TSO)
 uint32_t __cdf_nbuf_get_tso_info(cdf_device_t osdev, struct sk_buff *skb,
 	struct cdf_tso_info_t *tso_info);
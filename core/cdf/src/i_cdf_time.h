@@ -36,6 +36,8 @@
 
 #include <linux/jiffies.h>
 #include <linux/delay.h>
+#include <linux/ktime.h>
+#include <linux/timex.h>
 #include <asm/arch_timer.h>
 #ifdef CONFIG_CNSS
 #include <net/cnss.h>
@@ -90,6 +92,11 @@ static inline __cdf_time_t __cdf_get_system_timestamp(void)
 	return (jiffies / HZ) * 1000 + (jiffies % HZ) * (1000 / HZ);
 }
 
+static inline uint32_t __cdf_system_time_us(void)
+{
+	return (uint32_t)ktime_to_us(ktime_get());
+}
+
 /**
  * __cdf_udelay() - delay execution for given microseconds
  * @usecs: Micro seconds to delay
@@ -199,6 +206,16 @@ static inline uint64_t __cdf_get_monotonic_boottime(void)
 }
 #endif /* CONFIG_CNSS */
 
+/**
+ * __cdf_get_cycles() - read the CPU cycle counter
+ *
+ * Return: current value of the architecture cycle counter
+ */
+static inline uint64_t __cdf_get_cycles(void)
+{
+	return get_cycles();
+}
+
 #ifdef QCA_WIFI_3_0_ADRASTEA
 /**
  * __cdf_get_qtimer_ticks() - get QTIMER ticks
@@ -34,6 +34,9 @@
 #include <errno.h>
 
 #include <linux/random.h>
+#include <linux/prefetch.h>
+#include <linux/smp.h>
+#include <linux/cpumask.h>
 
 #include <cdf_types.h>
 #include <cdf_status.h>
@@ -44,6 +47,10 @@
 
 #define __cdf_unlikely(_expr)   unlikely(_expr)
 #define __cdf_likely(_expr)     likely(_expr)
+#define __cdf_prefetch(_addr)   prefetch(_addr)
+#define __cdf_get_cpu()         smp_processor_id()
+#define __cdf_get_num_cpus()    nr_cpu_ids
+#define __cdf_div_u64(_n, _d)   div_u64(_n, _d)
 
 /**
  * cdf_status_to_os_return(): translates cdf_status types to linux return types
@@ -669,6 +669,7 @@ void cds_decr_session_set_pcl(hdd_context_t *hdd_ctx,
 CDF_STATUS cds_init_policy_mgr(hdd_context_t *hdd_ctx);
 CDF_STATUS cds_get_pcl(hdd_context_t *hdd_ctx, enum cds_con_mode mode,
 				uint8_t *pcl_Channels, uint32_t *len);
+void cds_conc_reg_changed(void);
 bool cds_allow_concurrency(hdd_context_t *hdd_ctx, enum cds_con_mode mode,
 				uint8_t channel, enum hw_mode_bandwidth bw);
 enum cds_conc_priority_mode cds_get_first_connection_pcl_table_index(
@@ -710,6 +711,7 @@ enum cds_pcl_type get_pcl_from_second_conn_table(
 enum cds_pcl_type get_pcl_from_third_conn_table(
 	enum cds_two_connection_mode idx, enum cds_con_mode type,
 	enum cds_conc_priority_mode sys_pref, uint8_t dbs_capable);
+void cds_conc_invalidate_cache(void);
 #else
 static inline CDF_STATUS cds_incr_connection_count_utfw(
 		hdd_context_t *hdd_ctx, uint32_t vdev_id,
@@ -738,6 +740,9 @@ static inline struct cds_conc_connection_info *cds_get_conn_info(
 {
 	return NULL;
 }
+static inline void cds_conc_invalidate_cache(void)
+{
+}
 #endif
 enum cds_con_mode cds_convert_device_mode_to_hdd_type(
 				device_mode_t device_mode);
@@ -56,6 +56,7 @@
 #include <linux/semaphore.h>
 #include <linux/ctype.h>
 #include <linux/compat.h>
+#include <linux/seqlock.h>
 #include "cfg_api.h"
 #include "qwlan_version.h"
 #include "wma_types.h"
@@ -1908,6 +1909,95 @@ next_action_three_connection_table[CDS_MAX_TWO_CONNECTION_MODE]
 
 };
 
+/**
+ * struct cds_conc_snapshot - decisions derived from conc_connection_list
+ * @gen: conc_list_gen value the snapshot was built from
+ * @pref: conc_system_pref the snapshot was built for
+ * @dbs: whether the snapshot was built for a DBS capable target
+ * @num_connections: number of connections
+ * @pcl_found: a PCL table row exists for the current connections
+ * @pcl: PCL type for a new connection of each mode
+ * @action_found: a next action table row exists for the current connections
+ * @next_action: next action for a new connection on each band
+ * @conn_chan: connection channels for each cds_get_connection_channels order
+ * @conn_chan_len: number of channels in each @conn_chan row
+ *
+ * The PCL and next action tables are looked up once per change of the
+ * connection list instead of on every connect, scan and channel switch
+ * decision.
+ */
+struct cds_conc_snapshot {
+	uint32_t gen;
+	uint8_t pref;
+	bool dbs;
+	uint32_t num_connections;
+	bool pcl_found;
+	enum cds_pcl_type pcl[CDS_MAX_NUM_OF_MODE];
+	bool action_found;
+	enum cds_conc_next_action next_action[CDS_MAX_BAND];
+	uint8_t conn_chan[3][MAX_NUMBER_OF_CONC_CONNECTIONS];
+	uint32_t conn_chan_len[3];
+};
+
+#define CDS_ALLOW_MEMO_SIZE 64
+
+/**
+ * struct cds_allow_memo - cached cds_allow_concurrency() result
+ * @gen: conc_list_gen value the result is valid for, 0 if unused
+ * @mode: new connection mode
+ * @channel: new connection channel
+ * @wide: bandwidth of the new connection is 160 or 80+80 MHz
+ * @dbs: whether the result was computed for a DBS capable target
+ * @allow: result
+ */
+struct cds_allow_memo {
+	uint32_t gen;
+	uint8_t mode;
+	uint8_t channel;
+	bool wide;
+	bool dbs;
+	bool allow;
+};
+
+/*
+ * conc_list_gen is bumped on every change of conc_connection_list. The
+ * snapshot and the memo are rebuilt under conc_cache_lock and read
+ * without locks under conc_cache_seq.
+ */
+static cdf_atomic_t conc_list_gen;
+static cdf_spinlock_t conc_cache_lock;
+static seqcount_t conc_cache_seq;
+static struct cds_conc_snapshot conc_snapshot;
+static struct cds_allow_memo conc_allow_memo[CDS_ALLOW_MEMO_SIZE];
+
+/**
+ * cds_conc_list_changed() - invalidate the concurrency decision caches
+ *
+ * Called after conc_connection_list is modified
+ *
+ * Return: None
+ */
+static void cds_conc_list_changed(void)
+{
+	cdf_atomic_inc(&conc_list_gen);
+	/* 0 marks an unused memo entry */
+	if (!cdf_atomic_read(&conc_list_gen))
+		cdf_atomic_inc(&conc_list_gen);
+}
+
+/**
+ * cds_conc_reg_changed() - invalidate the concurrency decision caches
+ *
+ * Called after the regulatory channel states are updated: the memoized
+ * cds_allow_concurrency() results depend on which channels are DFS.
+ *
+ * Return: None
+ */
+void cds_conc_reg_changed(void)
+{
+	cds_conc_list_changed();
+}
+
 /**
  * cds_update_conc_list() - Update the concurrent connection list
  * @conn_index: Connection index
@@ -1949,6 +2039,7 @@ static void cds_update_conc_list(uint32_t conn_index,
 	conc_connection_list[conn_index].original_nss = original_nss;
 	conc_connection_list[conn_index].vdev_id = vdev_id;
 	conc_connection_list[conn_index].in_use = in_use;
+	cds_conc_list_changed();
 }
 
 /**
@@ -2047,6 +2138,7 @@ static void cds_restore_deleted_conn_info(hdd_context_t *hdd_ctx,
 	}
 
 	conc_connection_list[conn_index] = *info;
+	cds_conc_list_changed();
 
 	cds_info("Restored the deleleted conn info, vdev:%d, index:%d",
 		info->vdev_id, conn_index);
@@ -2108,6 +2200,7 @@ static void cds_update_hw_mode_conn_info(uint32_t num_vdev_mac_entries,
 			  conc_connection_list[conn_index].rx_spatial_stream);
 		}
 	}
+	cds_conc_list_changed();
 	cdf_mutex_release(&hdd_ctx->hdd_conc_list_lock);
 }
 
@@ -3621,6 +3714,10 @@ CDF_STATUS cds_init_policy_mgr(hdd_context_t *hdd_ctx)
 	/* init conc_connection_list */
 	cdf_mem_zero(conc_connection_list, sizeof(conc_connection_list));
 
+	cdf_spinlock_init(&conc_cache_lock);
+	seqcount_init(&conc_cache_seq);
+	cds_conc_list_changed();
+
 	if (!CDF_IS_STATUS_SUCCESS(cdf_mutex_init(
 					&hdd_ctx->hdd_conc_list_lock))) {
 		cds_err("Failed to init hdd_conc_list_lock");
@@ -3919,6 +4016,7 @@ CDF_STATUS cds_decr_connection_count(hdd_context_t *hdd_ctx,
 	/* clean up the entry */
 	cdf_mem_zero(&conc_connection_list[next_conn_index - 1],
 		sizeof(*conc_connection_list));
+	cds_conc_list_changed();
 	return CDF_STATUS_SUCCESS;
 }
 
@@ -4077,20 +4175,176 @@ void cds_update_with_safe_channel_list(hdd_context_t *hdd_ctx,
 }
 #endif
 /**
- * cds_get_channel_list() - provides the channel list
- * suggestion for new connection
+ * cds_conc_build_snapshot() - look up the decision tables for the current
+ * connections
+ * @hdd_ctx: HDD Context
+ * @snap: snapshot to fill
+ *
+ * Return: None
+ */
+static void cds_conc_build_snapshot(hdd_context_t *hdd_ctx,
+				    struct cds_conc_snapshot *snap)
+{
+	enum cds_conc_priority_mode pref;
+	enum cds_one_connection_mode second_index;
+	enum cds_two_connection_mode third_index;
+	enum cds_con_mode mode;
+	uint8_t order;
+
+	cdf_mem_zero(snap, sizeof(*snap));
+	snap->pref = hdd_ctx->config->conc_system_pref;
+	snap->dbs = wma_is_hw_dbs_capable();
+	snap->num_connections = cds_get_connection_count(hdd_ctx);
+	snap->pcl_found = true;
+	snap->action_found = true;
+
+	if (snap->pref < CDS_MAX_CONC_PRIORITY_MODE) {
+		pref = snap->pref;
+	} else {
+		cds_err("unknown conc_system_pref value %d", snap->pref);
+		pref = CDS_THROUGHPUT;
+	}
+
+	switch (snap->num_connections) {
+	case 0:
+		pref = cds_get_first_connection_pcl_table_index(hdd_ctx);
+		for (mode = 0; mode < CDS_MAX_NUM_OF_MODE; mode++)
+			snap->pcl[mode] = first_connection_pcl_table[mode][pref];
+#ifdef QCA_WIFI_3_0_EMU
+		/* For emulation only: a connection on 2.4 requests DBS */
+		snap->next_action[CDS_BAND_24] = CDS_DBS;
+#endif
+		break;
+	case 1:
+		second_index =
+			cds_get_second_connection_pcl_table_index(hdd_ctx);
+		if (CDS_MAX_ONE_CONNECTION_MODE == second_index) {
+			snap->pcl_found = false;
+			snap->action_found = false;
+			break;
+		}
+		for (mode = 0; mode < CDS_MAX_NUM_OF_MODE; mode++)
+			snap->pcl[mode] = snap->dbs ?
+				second_connection_pcl_dbs_table
+					[second_index][mode][pref] :
+				second_connection_pcl_nodbs_table
+					[second_index][mode][pref];
+		snap->next_action[CDS_BAND_24] =
+			next_action_two_connection_table[second_index]
+				[CDS_BAND_24];
+		snap->next_action[CDS_BAND_5] =
+			next_action_two_connection_table[second_index]
+				[CDS_BAND_5];
+		break;
+	case 2:
+		third_index =
+			cds_get_third_connection_pcl_table_index(hdd_ctx);
+		if (CDS_MAX_TWO_CONNECTION_MODE == third_index) {
+			snap->pcl_found = false;
+			snap->action_found = false;
+			break;
+		}
+		for (mode = 0; mode < CDS_MAX_NUM_OF_MODE; mode++)
+			snap->pcl[mode] = snap->dbs ?
+				third_connection_pcl_dbs_table
+					[third_index][mode][pref] :
+				third_connection_pcl_nodbs_table
+					[third_index][mode][pref];
+		snap->next_action[CDS_BAND_24] =
+			next_action_three_connection_table[third_index]
+				[CDS_BAND_24];
+		snap->next_action[CDS_BAND_5] =
+			next_action_three_connection_table[third_index]
+				[CDS_BAND_5];
+		break;
+	default:
+		cds_err("unexpected num_connections value %d",
+			snap->num_connections);
+		break;
+	}
+
+	for (order = 0; order < 3; order++)
+		cds_get_connection_channels(hdd_ctx, snap->conn_chan[order],
+					    &snap->conn_chan_len[order], order);
+}
+
+/**
+ * cds_conc_get_snapshot() - get the decision snapshot for the current
+ * connections
+ * @hdd_ctx: HDD Context
+ * @snap: copy of the snapshot
+ *
+ * The snapshot is only rebuilt after the connection list, the system
+ * preference or the DBS capability changed; otherwise this is a lock-free
+ * copy.
+ *
+ * Return: None
+ */
+static void cds_conc_get_snapshot(hdd_context_t *hdd_ctx,
+				  struct cds_conc_snapshot *snap)
+{
+	uint32_t gen = cdf_atomic_read(&conc_list_gen);
+	uint8_t pref = hdd_ctx->config->conc_system_pref;
+	bool dbs = wma_is_hw_dbs_capable();
+	unsigned int seq;
+
+	do {
+		seq = read_seqcount_begin(&conc_cache_seq);
+		*snap = conc_snapshot;
+	} while (read_seqcount_retry(&conc_cache_seq, seq));
+
+	if (gen && snap->gen == gen && snap->pref == pref && snap->dbs == dbs)
+		return;
+
+	/*
+	 * The generation is read before the list, so a change racing with
+	 * the rebuild leaves a snapshot that the next lookup rebuilds again.
+	 */
+	cds_conc_build_snapshot(hdd_ctx, snap);
+	snap->gen = gen;
+
+	cdf_spin_lock_bh(&conc_cache_lock);
+	write_seqcount_begin(&conc_cache_seq);
+	conc_snapshot = *snap;
+	write_seqcount_end(&conc_cache_seq);
+	cdf_spin_unlock_bh(&conc_cache_lock);
+}
+
+/* Copy the connection channels of the given order out of a snapshot */
+static uint32_t cds_snapshot_conn_channels(struct cds_conc_snapshot *snap,
+					   uint8_t *channels, uint8_t order)
+{
+	cdf_mem_copy(channels, snap->conn_chan[order],
+		     snap->conn_chan_len[order]);
+	return snap->conn_chan_len[order];
+}
+
+#ifdef MPC_UT_FRAMEWORK
+/**
+ * cds_conc_invalidate_cache() - drop the concurrency decision caches
+ *
+ * Used by the unit test framework to time cold lookups.
+ *
+ * Return: None
+ */
+void cds_conc_invalidate_cache(void)
+{
+	cds_conc_list_changed();
+}
+#endif
+
+/**
+ * cds_build_channel_list() - channel list for a PCL type
  * @hdd_ctx:	HDD Context
+ * @snap: decision snapshot providing the connection channels
  * @pcl:	The preferred channel list enum
  * @pcl_channels: PCL channels
  * @len: lenght of the PCL
  *
- * This function provides the actual channel list based on the
- * current regulatory domain derived using preferred channel
- * list enum obtained from one of the pcl_table
- *
- * Return: Channel List
+ * Return: CDF_STATUS
  */
-CDF_STATUS cds_get_channel_list(hdd_context_t *hdd_ctx,
+static CDF_STATUS cds_build_channel_list(hdd_context_t *hdd_ctx,
+			struct cds_conc_snapshot *snap,
 			enum cds_pcl_type pcl,
 			uint8_t *pcl_channels, uint32_t *len)
 {
@@ -4101,12 +4355,6 @@ CDF_STATUS cds_get_channel_list(hdd_context_t *hdd_ctx,
 	uint8_t channel_list_24[MAX_NUM_CHAN] = {0};
 	uint8_t channel_list_5[MAX_NUM_CHAN] = {0};
 
-	if (NULL == hdd_ctx) {
-		/* err msg*/
-		cds_err("hdd_ctx is NULL");
-		return status;
-	}
-
 	if ((NULL == pcl_channels) || (NULL == len)) {
 		/* err msg*/
 		cds_err("pcl_channels or len is NULL");
@@ -4166,16 +4414,16 @@ CDF_STATUS cds_get_channel_list(hdd_context_t *hdd_ctx,
 		break;
 	case CDS_SCC_CH:
 	case CDS_MCC_CH:
-		cds_get_connection_channels(hdd_ctx,
-			channel_list, &num_channels, 0);
+		num_channels = cds_snapshot_conn_channels(snap,
+			channel_list, 0);
 		cdf_mem_copy(pcl_channels, channel_list, num_channels);
 		*len = num_channels;
 		status = CDF_STATUS_SUCCESS;
 		break;
 	case CDS_SCC_CH_24G:
 	case CDS_MCC_CH_24G:
-		cds_get_connection_channels(hdd_ctx,
-			channel_list, &num_channels, 0);
+		num_channels = cds_snapshot_conn_channels(snap,
+			channel_list, 0);
 		cdf_mem_copy(pcl_channels, channel_list, num_channels);
 		*len = num_channels;
 		cdf_mem_copy(&pcl_channels[num_channels],
@@ -4185,8 +4433,8 @@ CDF_STATUS cds_get_channel_list(hdd_context_t *hdd_ctx,
 		break;
 	case CDS_SCC_CH_5G:
 	case CDS_MCC_CH_5G:
-		cds_get_connection_channels(hdd_ctx,
-			channel_list, &num_channels, 0);
+		num_channels = cds_snapshot_conn_channels(snap,
+			channel_list, 0);
 		cdf_mem_copy(pcl_channels, channel_list,
 			num_channels);
 		*len = num_channels;
@@ -4200,8 +4448,8 @@ CDF_STATUS cds_get_channel_list(hdd_context_t *hdd_ctx,
 		cdf_mem_copy(pcl_channels, channel_list_24,
 			chan_index_24);
 		*len = chan_index_24;
-		cds_get_connection_channels(hdd_ctx,
-			channel_list, &num_channels, 0);
+		num_channels = cds_snapshot_conn_channels(snap,
+			channel_list, 0);
 		cdf_mem_copy(&pcl_channels[chan_index_24],
 			channel_list, num_channels);
 		*len += num_channels;
@@ -4212,31 +4460,31 @@ CDF_STATUS cds_get_channel_list(hdd_context_t *hdd_ctx,
 		cdf_mem_copy(pcl_channels, channel_list_5,
 			chan_index_5);
 		*len = chan_index_5;
-		cds_get_connection_channels(hdd_ctx,
-			channel_list, &num_channels, 0);
+		num_channels = cds_snapshot_conn_channels(snap,
+			channel_list, 0);
 		cdf_mem_copy(&pcl_channels[chan_index_5],
 			channel_list, num_channels);
 		*len += num_channels;
 		status = CDF_STATUS_SUCCESS;
 		break;
 	case CDS_SCC_ON_24_SCC_ON_5:
-		cds_get_connection_channels(hdd_ctx,
-			channel_list, &num_channels, 1);
+		num_channels = cds_snapshot_conn_channels(snap,
+			channel_list, 1);
 		cdf_mem_copy(pcl_channels, channel_list,
 			num_channels);
 		*len = num_channels;
 		status = CDF_STATUS_SUCCESS;
 		break;
 	case CDS_SCC_ON_5_SCC_ON_24:
-		cds_get_connection_channels(hdd_ctx,
-			channel_list, &num_channels, 2);
+		num_channels = cds_snapshot_conn_channels(snap,
+			channel_list, 2);
 		cdf_mem_copy(pcl_channels, channel_list, num_channels);
 		*len = num_channels;
 		status = CDF_STATUS_SUCCESS;
 		break;
 	case CDS_SCC_ON_24_SCC_ON_5_24G:
-		cds_get_connection_channels(hdd_ctx,
-			channel_list, &num_channels, 1);
+		num_channels = cds_snapshot_conn_channels(snap,
+			channel_list, 1);
 		cdf_mem_copy(pcl_channels, channel_list, num_channels);
 		*len = num_channels;
 		cdf_mem_copy(&pcl_channels[num_channels],
@@ -4245,8 +4493,8 @@ CDF_STATUS cds_get_channel_list(hdd_context_t *hdd_ctx,
 		status = CDF_STATUS_SUCCESS;
 		break;
 	case CDS_SCC_ON_24_SCC_ON_5_5G:
-		cds_get_connection_channels(hdd_ctx,
-			channel_list, &num_channels, 1);
+		num_channels = cds_snapshot_conn_channels(snap,
+			channel_list, 1);
 		cdf_mem_copy(pcl_channels, channel_list, num_channels);
 		*len = num_channels;
 		cdf_mem_copy(&pcl_channels[num_channels],
@@ -4255,8 +4503,8 @@ CDF_STATUS cds_get_channel_list(hdd_context_t *hdd_ctx,
 		status = CDF_STATUS_SUCCESS;
 		break;
 	case CDS_SCC_ON_5_SCC_ON_24_24G:
-		cds_get_connection_channels(hdd_ctx,
-			channel_list, &num_channels, 2);
+		num_channels = cds_snapshot_conn_channels(snap,
+			channel_list, 2);
 		cdf_mem_copy(pcl_channels, channel_list, num_channels);
 		*len = num_channels;
 		cdf_mem_copy(&pcl_channels[num_channels],
@@ -4265,8 +4513,8 @@ CDF_STATUS cds_get_channel_list(hdd_context_t *hdd_ctx,
 		status = CDF_STATUS_SUCCESS;
 		break;
 	case CDS_SCC_ON_5_SCC_ON_24_5G:
-		cds_get_connection_channels(hdd_ctx,
-			channel_list, &num_channels, 2);
+		num_channels = cds_snapshot_conn_channels(snap,
+			channel_list, 2);
 		cdf_mem_copy(pcl_channels, channel_list, num_channels);
 		*len = num_channels;
 		cdf_mem_copy(&pcl_channels[num_channels],
@@ -4286,6 +4534,36 @@ CDF_STATUS cds_get_channel_list(hdd_context_t *hdd_ctx,
 	return status;
 }
 
+/**
+ * cds_get_channel_list() - provides the channel list
+ * suggestion for new connection
+ * @hdd_ctx:	HDD Context
+ * @pcl:	The preferred channel list enum
+ * @pcl_channels: PCL channels
+ * @len: lenght of the PCL
+ *
+ * This function provides the actual channel list based on the
+ * current regulatory domain derived using preferred channel
+ * list enum obtained from one of the pcl_table
+ *
+ * Return: Channel List
+ */
+CDF_STATUS cds_get_channel_list(hdd_context_t *hdd_ctx,
+			enum cds_pcl_type pcl,
+			uint8_t *pcl_channels, uint32_t *len)
+{
+	struct cds_conc_snapshot snap;
+
+	if (NULL == hdd_ctx) {
+		/* err msg*/
+		cds_err("hdd_ctx is NULL");
+		return CDF_STATUS_E_FAILURE;
+	}
+
+	cds_conc_get_snapshot(hdd_ctx, &snap);
+	return cds_build_channel_list(hdd_ctx, &snap, pcl, pcl_channels, len);
+}
+
 /**
  * cds_map_concurrency_mode() - to map concurrency mode between sme and hdd
  * @hdd_ctx: hdd context
@@ -4350,88 +4628,34 @@ CDF_STATUS cds_get_pcl(hdd_context_t *hdd_ctx, enum cds_con_mode mode,
 			uint8_t *pcl_channels, uint32_t *len)
 {
 	CDF_STATUS status = CDF_STATUS_E_FAILURE;
-	uint32_t num_connections = 0;
-	enum cds_conc_priority_mode first_index = 0;
-	enum cds_one_connection_mode second_index = 0;
-	enum cds_two_connection_mode third_index = 0;
-	enum cds_pcl_type pcl = CDS_NONE;
-	enum cds_conc_priority_mode conc_system_pref = 0;
-	/* find the current connection state from conc_connection_list*/
-	num_connections = cds_get_connection_count(hdd_ctx);
-	cds_debug("connections:%d pref:%d requested mode:%d",
-		num_connections, hdd_ctx->config->conc_system_pref, mode);
+	struct cds_conc_snapshot snap;
+	enum cds_pcl_type pcl;
 
-	switch (hdd_ctx->config->conc_system_pref) {
-	case 0:
-		conc_system_pref = CDS_THROUGHPUT;
-		break;
-	case 1:
-		conc_system_pref = CDS_POWERSAVE;
-		break;
-	case 2:
-		conc_system_pref = CDS_LATENCY;
-		break;
-	default:
-		/* err msg */
-		cds_err("unknown conc_system_pref value %d",
-			hdd_ctx->config->conc_system_pref);
-		break;
+	if (mode >= CDS_MAX_NUM_OF_MODE) {
+		cds_err("unknown mode %d", mode);
+		return status;
 	}
 
-	switch (num_connections) {
-	case 0:
-		first_index =
-			cds_get_first_connection_pcl_table_index(hdd_ctx);
-		pcl = first_connection_pcl_table[mode][first_index];
-		break;
-	case 1:
-		second_index =
-			cds_get_second_connection_pcl_table_index(hdd_ctx);
-		if (CDS_MAX_ONE_CONNECTION_MODE == second_index) {
-			/* err msg */
-			cds_err("couldn't find index for 2nd connection pcl table");
-			return status;
-		}
-		if (wma_is_hw_dbs_capable() == true) {
-			pcl = second_connection_pcl_dbs_table
-				[second_index][mode][conc_system_pref];
-		} else {
-			pcl = second_connection_pcl_nodbs_table
-				[second_index][mode][conc_system_pref];
-		}
+	/* the table lookups for the current connections are cached */
+	cds_conc_get_snapshot(hdd_ctx, &snap);
+	cds_debug("connections:%d pref:%d requested mode:%d",
+		snap.num_connections, snap.pref, mode);
 
-		break;
-	case 2:
-		third_index =
-			cds_get_third_connection_pcl_table_index(hdd_ctx);
-		if (CDS_MAX_TWO_CONNECTION_MODE == third_index) {
-			/* err msg */
-			cds_err("couldn't find index for 3rd connection pcl table");
-			return status;
-		}
-		if (wma_is_hw_dbs_capable() == true) {
-			pcl = third_connection_pcl_dbs_table
-				[third_index][mode][conc_system_pref];
-		} else {
-			pcl = third_connection_pcl_nodbs_table
-				[third_index][mode][conc_system_pref];
-		}
-		break;
-	default:
+	if (!snap.pcl_found) {
 		/* err msg */
-		cds_err("unexpected num_connections value %d",
-			num_connections);
-		break;
+		cds_err("couldn't find index for connection %d pcl table",
+			snap.num_connections + 1);
+		return status;
 	}
+	pcl = snap.pcl[mode];
 
-	cds_debug("index1:%d index2:%d index3:%d pcl:%d dbs:%d",
-		first_index, second_index, third_index,
-		pcl, wma_is_hw_dbs_capable());
+	cds_debug("pcl:%d dbs:%d", pcl, snap.dbs);
 
 	/* once the PCL enum is obtained find out the exact channel list with
 	 * help from sme_get_cfg_valid_channels
 	 */
-	status = cds_get_channel_list(hdd_ctx, pcl, pcl_channels, len);
+	status = cds_build_channel_list(hdd_ctx, &snap, pcl, pcl_channels,
+					len);
 	if (status == CDF_STATUS_SUCCESS) {
 		uint32_t i;
 		cds_debug("pcl len:%d", *len);
@@ -4541,6 +4765,74 @@ bool cds_allow_new_home_channel(hdd_context_t *hdd_ctx,
 	return status;
 }
 
+/* Direct mapped slot of a cds_allow_concurrency() result */
+static inline uint32_t cds_allow_memo_slot(uint8_t mode, uint8_t channel,
+					   bool wide)
+{
+	return (channel ^ (mode << 3) ^ (wide << 2)) &
+		(CDS_ALLOW_MEMO_SIZE - 1);
+}
+
+/**
+ * cds_allow_memo_lookup() - look up a cached cds_allow_concurrency() result
+ * @mode: new connection mode
+ * @channel: new connection channel
+ * @wide: bandwidth of the new connection is 160 or 80+80 MHz
+ * @allow: cached result
+ *
+ * Return: true if a result for the current connections was cached
+ */
+static bool cds_allow_memo_lookup(enum cds_con_mode mode, uint8_t channel,
+				  bool wide, bool *allow)
+{
+	uint32_t gen = cdf_atomic_read(&conc_list_gen);
+	struct cds_allow_memo *slot, memo;
+	unsigned int seq;
+
+	slot = &conc_allow_memo[cds_allow_memo_slot(mode, channel, wide)];
+	do {
+		seq = read_seqcount_begin(&conc_cache_seq);
+		memo = *slot;
+	} while (read_seqcount_retry(&conc_cache_seq, seq));
+
+	if (!gen || memo.gen != gen || memo.mode != mode ||
+	    memo.channel != channel || memo.wide != wide ||
+	    memo.dbs != wma_is_hw_dbs_capable())
+		return false;
+
+	*allow = memo.allow;
+	return true;
+}
+
+/**
+ * cds_allow_memo_store() - cache a cds_allow_concurrency() result
+ * @gen: conc_list_gen value read under hdd_conc_list_lock before the
+ *	result was computed
+ * @mode: new connection mode
+ * @channel: new connection channel
+ * @wide: bandwidth of the new connection is 160 or 80+80 MHz
+ * @allow: result
+ *
+ * Return: None
+ */
+static void cds_allow_memo_store(uint32_t gen, enum cds_con_mode mode,
+				 uint8_t channel, bool wide, bool allow)
+{
+	struct cds_allow_memo *slot;
+
+	slot = &conc_allow_memo[cds_allow_memo_slot(mode, channel, wide)];
+	cdf_spin_lock_bh(&conc_cache_lock);
+	write_seqcount_begin(&conc_cache_seq);
+	slot->gen = gen;
+	slot->mode = mode;
+	slot->channel = channel;
+	slot->wide = wide;
+	slot->dbs = wma_is_hw_dbs_capable();
+	slot->allow = allow;
+	write_seqcount_end(&conc_cache_seq);
+	cdf_spin_unlock_bh(&conc_cache_lock);
+}
+
 /**
  * cds_allow_concurrency() - Check for allowed concurrency
  * combination
@@ -4552,7 +4844,8 @@ bool cds_allow_new_home_channel(hdd_context_t *hdd_ctx,
  *
  * When a new connection is about to come up check if current
  * concurrency combination including the new connection is
- * allowed or not based on the HW capability
+ * allowed or not based on the HW capability. The answer for the current
+ * connections is cached, so repeated queries do not take the list lock.
  *
  * Return: True/False
  */
@@ -4562,17 +4855,29 @@ bool cds_allow_concurrency(hdd_context_t *hdd_ctx, enum cds_con_mode mode,
 	uint32_t num_connections = 0, count = 0, index = 0;
 	bool status = false, match = false;
 	uint32_t list[MAX_NUMBER_OF_CONC_CONNECTIONS];
+	bool wide = (bw == HW_MODE_80_PLUS_80_MHZ) || (bw == HW_MODE_160_MHZ);
+	bool memo = mode < CDS_MAX_NUM_OF_MODE;
+	uint32_t gen;
 
-	cdf_mutex_acquire(&hdd_ctx->hdd_conc_list_lock);
-	/* find the current connection state from conc_connection_list*/
-	num_connections = cds_get_connection_count(hdd_ctx);
-
+	/* depends on the session counts, not on conc_connection_list */
 	if (cds_max_concurrent_connections_reached()) {
 		cds_err("Reached max concurrent connections: %d",
 			hdd_ctx->config->gMaxConcurrentActiveSessions);
-		goto done;
+		return status;
 	}
 
+	if (memo && cds_allow_memo_lookup(mode, channel, wide, &status)) {
+		if (!status)
+			cds_err("mode %d on channel %d not allowed",
+				mode, channel);
+		return status;
+	}
+
+	cdf_mutex_acquire(&hdd_ctx->hdd_conc_list_lock);
+	gen = cdf_atomic_read(&conc_list_gen);
+	/* find the current connection state from conc_connection_list*/
+	num_connections = cds_get_connection_count(hdd_ctx);
+
 	if (channel) {
 		/* don't allow 3rd home channel on same MAC */
 		if (!cds_allow_new_home_channel(hdd_ctx, channel,
@@ -4708,8 +5013,7 @@ bool cds_allow_concurrency(hdd_context_t *hdd_ctx, enum cds_con_mode mode,
 	}
 
 	/* can we allow vht160 */
-	if (num_connections &&
-		((bw == HW_MODE_80_PLUS_80_MHZ) || (bw == HW_MODE_160_MHZ))) {
+	if (num_connections && wide) {
 		/* err msg */
 		cds_err("No VHT160, we have one connection already");
 		goto done;
@@ -4733,6 +5037,8 @@ bool cds_allow_concurrency(hdd_context_t *hdd_ctx, enum cds_con_mode mode,
 	status = true;
 
 done:
+	if (memo)
+		cds_allow_memo_store(gen, mode, channel, wide, status);
 	cdf_mutex_release(&hdd_ctx->hdd_conc_list_lock);
 	return status;
 }
@@ -5243,9 +5549,7 @@ CDF_STATUS cds_current_connections_update(uint32_t session_id,
 				enum cds_conn_update_reason reason)
 {
 	enum cds_conc_next_action next_action = CDS_NOP;
-	uint32_t num_connections = 0;
-	enum cds_one_connection_mode second_index = 0;
-	enum cds_two_connection_mode third_index = 0;
+	struct cds_conc_snapshot snap;
 	enum cds_band band;
 	hdd_context_t *hdd_ctx;
 	CDF_STATUS status = CDF_STATUS_E_FAILURE;
@@ -5265,50 +5569,28 @@ CDF_STATUS cds_current_connections_update(uint32_t session_id,
 	else
 		band = CDS_BAND_5;
 
+	/* Most decisions are a NOP, answer those without the list lock */
+	cds_conc_get_snapshot(hdd_ctx, &snap);
+	if (snap.action_found && CDS_NOP == snap.next_action[band]) {
+		cds_debug("num_connections=%d channel=%d next_action=%d",
+			snap.num_connections, channel, CDS_NOP);
+		return CDF_STATUS_E_NOSUPPORT;
+	}
+
 	cdf_mutex_acquire(&hdd_ctx->hdd_conc_list_lock);
-	num_connections = cds_get_connection_count(hdd_ctx);
+	/* the list may have changed before the lock was taken */
+	cds_conc_get_snapshot(hdd_ctx, &snap);
 
 	cds_debug("num_connections=%d channel=%d",
-		num_connections, channel);
+		snap.num_connections, channel);
 
-	switch (num_connections) {
-	case 0:
-		next_action = CDS_NOP;
-#ifdef QCA_WIFI_3_0_EMU
-		/* For emulation only: if it is a connection on 2.4,
-		 * request DBS
-		 */
-		if (CDS_IS_CHANNEL_24GHZ(channel))
-			next_action = CDS_DBS;
-#endif
-		break;
-	case 1:
-		second_index =
-			cds_get_second_connection_pcl_table_index(hdd_ctx);
-		if (CDS_MAX_ONE_CONNECTION_MODE == second_index) {
-			/* err msg */
-			cds_err("couldn't find index for 2nd connection next action table");
-			goto done;
-		}
-		next_action =
-			next_action_two_connection_table[second_index][band];
-		break;
-	case 2:
-		third_index =
-			cds_get_third_connection_pcl_table_index(hdd_ctx);
-		if (CDS_MAX_TWO_CONNECTION_MODE == third_index) {
-			/* err msg */
-			cds_err("couldn't find index for 3rd connection next action table");
-			goto done;
-		}
-		next_action =
-			next_action_three_connection_table[third_index][band];
-		break;
-	default:
+	if (!snap.action_found) {
 		/* err msg */
-		cds_err("unexpected num_connections value %d", num_connections);
-		break;
+		cds_err("couldn't find index for connection %d next action table",
+			snap.num_connections + 1);
+		goto done;
 	}
+	next_action = snap.next_action[band];
 
 	if (CDS_NOP != next_action)
 		status = cds_next_actions(hdd_ctx, session_id,
@@ -5316,9 +5598,8 @@ CDF_STATUS cds_current_connections_update(uint32_t session_id,
 	else
 		status = CDF_STATUS_E_NOSUPPORT;
 
-	cds_debug("index2=%d index3=%d next_action=%d, band=%d status=%d reason=%d session_id=%d",
-		second_index, third_index, next_action, band, status,
-		reason, session_id);
+	cds_debug("next_action=%d, band=%d status=%d reason=%d session_id=%d",
+		next_action, band, status, reason, session_id);
 
 done:
 	cdf_mutex_release(&hdd_ctx->hdd_conc_list_lock);
@@ -5434,6 +5715,7 @@ void cds_nss_update_cb(void *context, uint8_t tx_status, uint8_t vdev_id,
 		cds_err("unexpected action %d", next_action);
 		break;
 	}
+	cds_conc_list_changed();
 	if (!wait)
 		cds_next_actions(hdd_ctx, vdev_id,
 				next_action,
@@ -39,6 +39,7 @@
 #include "wlan_hdd_main.h"
 #include "cds_regdomain.h"
 #include "cds_regdomain_common.h"
+#include "cds_concurrency.h"
 
 #define WORLD_SKU_MASK          0x00F0
 #define WORLD_SKU_PREFIX        0x0060
@@ -1174,6 +1175,9 @@ static int cds_process_regulatory_data(struct wiphy *wiphy,
 			CHANNEL_STATE_DISABLE;
 	}
 
+	/* cached concurrency decisions depend on the DFS channel states */
+	cds_conc_reg_changed();
+
 	if (k == 0)
 		return -1;
 
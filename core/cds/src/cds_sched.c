@@ -1057,6 +1057,8 @@ void cds_sched_flush_mc_mqs(p_cds_sched_context pSchedContext)
 			  pMsgWrapper->pVosMsg->type);
 		cds_core_return_msg(pSchedContext->pVContext, pMsgWrapper);
 	}
+	/* The timer wheel dispatch message may have been dropped above */
+	cdf_mc_timer_flush_fired();
 	/* Flush the WMA Mq */
 	while (NULL != (pMsgWrapper = cds_mq_get(&pSchedContext->wmaMcMq))) {
 		if (pMsgWrapper->pVosMsg != NULL) {
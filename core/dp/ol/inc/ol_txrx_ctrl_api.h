@@ -136,6 +136,7 @@ enum netif_reason_type {
 #define WLAN_HDD_NETIF_OPER_HISTORY 4
 #define WLAN_DUMP_TX_FLOW_POOL_INFO 5
 #define WLAN_TXRX_DESC_STATS  6
+#define WLAN_MC_TIMER_STATS   7
 
 ol_txrx_pdev_handle
 ol_txrx_pdev_alloc(ol_pdev_handle ctrl_pdev,
@@ -947,6 +948,35 @@ int16_t ol_txrx_peer_rssi(ol_txrx_peer_handle peer);
 #define ol_txrx_peer_rssi(peer) OL_TXRX_RSSI_INVALID
 #endif /* QCA_SUPPORT_PEER_DATA_RX_RSSI */
 
+/**
+ * @brief Per-peer data frame counters for control-path heuristics.
+ * @details
+ *  The txrx layer counts frames in per-CPU counters on the peer where the
+ *  peer is already resolved: tx frames in ol_tx_send_data_frame and rx
+ *  frames once per delivered batch.  The counters only grow; consumers
+ *  such as the TDLS tracking logic sample them on their own timer and
+ *  keep a baseline to count frames over an interval.
+ *
+ * @param pdev - the data physical device object
+ * @param local_peer_id - local ID (station ID) of the peer
+ * @param tx_cnt - filled with the number of frames sent to the peer
+ * @param rx_cnt - filled with the number of frames received from the peer
+ */
+#ifdef QCA_SUPPORT_TXRX_LOCAL_PEER_ID
+CDF_STATUS ol_txrx_peer_pkt_cnt_get(ol_txrx_pdev_handle pdev,
+				    uint8_t local_peer_id,
+				    uint32_t *tx_cnt, uint32_t *rx_cnt);
+#else
+static inline CDF_STATUS
+ol_txrx_peer_pkt_cnt_get(ol_txrx_pdev_handle pdev, uint8_t local_peer_id,
+			 uint32_t *tx_cnt, uint32_t *rx_cnt)
+{
+	*tx_cnt = 0;
+	*rx_cnt = 0;
+	return CDF_STATUS_E_NOSUPPORT;
+}
+#endif /* QCA_SUPPORT_TXRX_LOCAL_PEER_ID */
+
 #define OL_TXRX_INVALID_LOCAL_PEER_ID 0xffff
 #if QCA_SUPPORT_TXRX_LOCAL_PEER_ID
 uint16_t ol_txrx_local_peer_id(ol_txrx_peer_handle peer);
@@ -1050,6 +1080,77 @@ ol_tx_delay_hist(ol_txrx_pdev_handle pdev, uint16_t *bin_values, int category)
 }
 #endif
 
+/*
+ * Bins used for the per-peer tx latency histogram, in microseconds:
+ * bin 0:        0 - 128 us
+ * bin n:  128 << (n - 1) - 128 << n us, for 0 < n < last bin
+ * last bin:    >= 128 << (OL_TXRX_TX_LAT_NUM_BINS - 2) us (~2 s)
+ */
+#define OL_TXRX_TX_LAT_NUM_BINS 16
+#define OL_TXRX_TX_LAT_BIN0_SHIFT 7
+/* QoS TIDs 0-7, plus one slot for frames without a QoS TID */
+#define OL_TXRX_TX_LAT_NUM_TIDS 9
+#define OL_TXRX_TX_LAT_NON_QOS_TID (OL_TXRX_TX_LAT_NUM_TIDS - 1)
+
+/**
+ * struct ol_txrx_tx_latency - tx latency of one peer and TID
+ * @count: number of frames completed successfully
+ * @dropped: number of frames completed with a failure status
+ * @avg_us: average enqueue to completion latency
+ * @max_us: largest enqueue to completion latency
+ * @p50_us: upper bound of the bin holding the 50th percentile
+ * @p90_us: upper bound of the bin holding the 90th percentile
+ * @p99_us: upper bound of the bin holding the 99th percentile
+ * @bins: latency histogram, see OL_TXRX_TX_LAT_NUM_BINS
+ */
+struct ol_txrx_tx_latency {
+	uint32_t count;
+	uint32_t dropped;
+	uint32_t avg_us;
+	uint32_t max_us;
+	uint32_t p50_us;
+	uint32_t p90_us;
+	uint32_t p99_us;
+	uint32_t bins[OL_TXRX_TX_LAT_NUM_BINS];
+};
+
+/**
+ * @brief Provide the tx latency histogram of a peer for one TID.
+ * @details
+ *  The latency is measured from tx descriptor allocation to tx completion,
+ *  per peer and per TID, using per-CPU counters that are updated without
+ *  locks in the tx completion path.  This call folds the per-CPU counters
+ *  together and derives the percentiles; it is meant for the slow path
+ *  (debugfs, periodic stats reporting).
+ *
+ * @param pdev - the data physical device instance
+ * @param local_peer_id - local ID (station ID) of the peer
+ * @param tid - 0-7 for QoS data, OL_TXRX_TX_LAT_NON_QOS_TID otherwise
+ * @param lat - filled with the latency report
+ * @return CDF_STATUS_SUCCESS, or an error if the peer does not exist
+ */
+#ifdef QCA_TX_PEER_LATENCY
+CDF_STATUS
+ol_txrx_peer_tx_latency_get(ol_txrx_pdev_handle pdev, uint8_t local_peer_id,
+			    uint8_t tid, struct ol_txrx_tx_latency *lat);
+void
+ol_txrx_peer_tx_latency_reset(ol_txrx_pdev_handle pdev,
+			      uint8_t local_peer_id);
+#else
+static inline CDF_STATUS
+ol_txrx_peer_tx_latency_get(ol_txrx_pdev_handle pdev, uint8_t local_peer_id,
+			    uint8_t tid, struct ol_txrx_tx_latency *lat)
+{
+	return CDF_STATUS_E_NOSUPPORT;
+}
+
+static inline void
+ol_txrx_peer_tx_latency_reset(ol_txrx_pdev_handle pdev,
+			      uint8_t local_peer_id)
+{
+}
+#endif
+
 #if defined(QCA_SUPPORT_TX_THROTTLE)
 /**
  * @brief Set the thermal mitgation throttling level.
@@ -260,6 +260,8 @@ cdf_nbuf_t ol_tx_send_data_frame(uint8_t sta_id, cdf_nbuf_t skb,
 #ifdef IPA_OFFLOAD
 cdf_nbuf_t ol_tx_send_ipa_data_frame(void *vdev,
 			cdf_nbuf_t skb);
+cdf_nbuf_t ol_tx_send_ipa_data_frame_list(void *vdev,
+			cdf_nbuf_t msdu_list);
 #endif
 
 CDF_STATUS ol_txrx_register_peer(ol_rx_callback_fp rxcb,
@@ -55,6 +55,20 @@ struct ol_txrx_stats_tso_msdu {
 	uint32_t tso_seg_idx;
 };
 
+/**
+ * struct ol_txrx_stats_tso_perf - cost of preparing TSO jumbo packets
+ * @bytes: bytes of the jumbo packets accepted for segmentation
+ * @prep_cycles: CPU cycles spent allocating and DMA mapping the segments
+ * @first_ticks: system ticks when the first jumbo packet was prepared
+ * @last_ticks: system ticks when the latest jumbo packet was prepared
+ */
+struct ol_txrx_stats_tso_perf {
+	uint64_t bytes;
+	uint64_t prep_cycles;
+	unsigned long first_ticks;
+	unsigned long last_ticks;
+};
+
 struct ol_txrx_stats_tso_info {
 	struct ol_txrx_stats_tso_msdu tso_msdu_info[NUM_MAX_TSO_MSDUS];
 	uint32_t tso_msdu_idx;
@@ -96,6 +110,7 @@ struct ol_txrx_stats {
 		struct {
 			struct ol_txrx_stats_elem tso_pkts;
 #if defined(FEATURE_TSO)
+			struct ol_txrx_stats_tso_perf perf;
 			struct ol_txrx_stats_tso_info tso_info;
 #endif
 		} tso;
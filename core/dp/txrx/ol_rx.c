@@ -971,6 +971,7 @@ ol_rx_deliver(struct ol_txrx_vdev_t *vdev,
 	cdf_nbuf_t deliver_list_tail = NULL;
 	cdf_nbuf_t msdu;
 	bool filter = false;
+	int rx_cnt = 0;
 #ifdef QCA_SUPPORT_SW_TXRX_ENCAP
 	struct ol_rx_decap_info_t info;
 	cdf_mem_set(&info, sizeof(info), 0);
@@ -1136,6 +1137,7 @@ DONE:
 				}
 			}
 			OL_RX_PEER_STATS_UPDATE(peer, msdu);
+			rx_cnt++;
 			OL_RX_ERR_STATISTICS_1(pdev, vdev, peer, rx_desc,
 					       OL_RX_ERR_NONE);
 			TXRX_STATS_MSDU_INCR(vdev->pdev, rx.delivered, msdu);
@@ -1144,6 +1146,7 @@ DONE:
 		}
 		msdu = next;
 	}
+	OL_TXRX_PEER_PKT_CNT_ADD(peer, rx, rx_cnt);
 	/* sanity check - are there any frames left to give to the OS shim? */
 	if (!deliver_list_head)
 		return;
@@ -1304,6 +1307,7 @@ ol_rx_in_order_deliver(struct ol_txrx_vdev_t *vdev,
 		       unsigned tid, cdf_nbuf_t msdu_list)
 {
 	cdf_nbuf_t msdu;
+	int rx_cnt = 0;
 
 	msdu = msdu_list;
 	/*
@@ -1320,9 +1324,11 @@ ol_rx_in_order_deliver(struct ol_txrx_vdev_t *vdev,
 		OL_RX_ERR_STATISTICS_1(vdev->pdev, vdev, peer, rx_desc,
 				       OL_RX_ERR_NONE);
 		TXRX_STATS_MSDU_INCR(vdev->pdev, rx.delivered, msdu);
+		rx_cnt++;
 
 		msdu = next;
 	}
+	OL_TXRX_PEER_PKT_CNT_ADD(peer, rx, rx_cnt);
 
 	ol_txrx_frms_dump("rx delivering:",
 			  pdev, deliver_list_head,
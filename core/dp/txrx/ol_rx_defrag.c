@@ -204,6 +204,8 @@ ol_rx_reorder_flush_frag(htt_pdev_handle htt_pdev,
 		ol_rx_frames_free(htt_pdev, rx_reorder_array_elem->head);
 		rx_reorder_array_elem->head = NULL;
 		rx_reorder_array_elem->tail = NULL;
+		ol_rx_reorder_occupancy_clear(&peer->tids_rx_reorder[tid],
+					      seq);
 	}
 }
 
@@ -268,6 +270,7 @@ ol_rx_reorder_store_frag(ol_txrx_pdev_handle pdev,
 	ol_rx_fraglist_insert(htt_pdev, &rx_reorder_array_elem->head,
 			      &rx_reorder_array_elem->tail, frag,
 			      &all_frag_present);
+	ol_rx_reorder_occupancy_set(&peer->tids_rx_reorder[tid], seq);
 
 	if (pdev->rx.flags.defrag_timeout_check)
 		ol_rx_defrag_waitlist_remove(peer, tid);
@@ -276,6 +279,8 @@ ol_rx_reorder_store_frag(ol_txrx_pdev_handle pdev,
 		ol_rx_defrag(pdev, peer, tid, rx_reorder_array_elem->head);
 		rx_reorder_array_elem->head = NULL;
 		rx_reorder_array_elem->tail = NULL;
+		ol_rx_reorder_occupancy_clear(&peer->tids_rx_reorder[tid],
+					      seq);
 		peer->tids_rx_reorder[tid].defrag_timeout_ms = 0;
 		peer->tids_last_seq[tid] = seq_num;
 	} else if (pdev->rx.flags.defrag_timeout_check) {
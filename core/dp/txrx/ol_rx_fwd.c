@@ -107,7 +107,16 @@ static inline void ol_ap_fwd_check(struct ol_txrx_vdev_t *vdev, cdf_nbuf_t msdu)
 	}
 }
 
-static inline void ol_rx_fwd_to_tx(struct ol_txrx_vdev_t *vdev, cdf_nbuf_t msdu)
+/*
+ * Maximum number of forwarded frames held, still DMA mapped, per vdev
+ * while the tx path has no descriptors for them, and the period at which
+ * they are retried when no new forwarded batch comes to flush them.
+ */
+#define OL_RX_FWD_DEFER_MAX_DEPTH 64
+#define OL_RX_FWD_DEFER_RETRY_MS 5
+
+static inline void
+ol_rx_fwd_prepare(struct ol_txrx_vdev_t *vdev, cdf_nbuf_t msdu)
 {
 	struct ol_txrx_pdev_t *pdev = vdev->pdev;
 
@@ -119,18 +128,159 @@ static inline void ol_rx_fwd_to_tx(struct ol_txrx_vdev_t *vdev, cdf_nbuf_t msdu)
 	 * sends it to the target.
 	 */
 	cdf_nbuf_map_single(pdev->osdev, msdu, CDF_DMA_TO_DEVICE);
-	cdf_nbuf_set_next(msdu, NULL);  /* add NULL terminator */
+}
 
-	msdu = OL_TX_LL(vdev, msdu);
+/**
+ * ol_rx_fwd_defer() - hold forwarded frames the tx path did not accept
+ * @vdev: virtual device the frames are forwarded on
+ * @msdu_list: NULL-terminated list of mapped frames
+ *
+ * The frames are retried ahead of the next forwarded batch of the vdev,
+ * or by the vdev's forwarding timer after OL_RX_FWD_DEFER_RETRY_MS if no
+ * batch comes first. Frames that do not fit in the deferral queue are
+ * dropped.
+ *
+ * Return: none
+ */
+static void
+ol_rx_fwd_defer(struct ol_txrx_vdev_t *vdev, cdf_nbuf_t msdu_list)
+{
+	struct ol_txrx_pdev_t *pdev = vdev->pdev;
+	cdf_nbuf_t msdu;
+
+	cdf_spin_lock_bh(&vdev->fwd.mutex);
+	while (msdu_list &&
+	       vdev->fwd.deferred.depth < OL_RX_FWD_DEFER_MAX_DEPTH) {
+		cdf_nbuf_t next = cdf_nbuf_next(msdu_list);
+
+		cdf_nbuf_set_next(msdu_list, NULL);
+		if (!vdev->fwd.deferred.head)
+			vdev->fwd.deferred.head = msdu_list;
+		else
+			cdf_nbuf_set_next(vdev->fwd.deferred.tail, msdu_list);
+		vdev->fwd.deferred.tail = msdu_list;
+		vdev->fwd.deferred.depth++;
+		vdev->fwd.stats.deferred++;
+		msdu_list = next;
+	}
+	for (msdu = msdu_list; msdu; msdu = cdf_nbuf_next(msdu))
+		vdev->fwd.stats.dropped++;
+	if (vdev->fwd.deferred.head && !vdev->fwd.is_timer_on) {
+		cdf_softirq_timer_start(&vdev->fwd.timer,
+					OL_RX_FWD_DEFER_RETRY_MS);
+		vdev->fwd.is_timer_on = true;
+	}
+	cdf_spin_unlock_bh(&vdev->fwd.mutex);
+
+	while (msdu_list) {
+		cdf_nbuf_t next = cdf_nbuf_next(msdu_list);
+
+		cdf_nbuf_set_next(msdu_list, NULL);
+		cdf_nbuf_unmap_single(pdev->osdev, msdu_list,
+				      CDF_DMA_TO_DEVICE);
+		cdf_nbuf_tx_free(msdu_list, NBUF_PKT_ERROR);
+		msdu_list = next;
+	}
+}
+
+/**
+ * ol_rx_fwd_to_tx() - hand a batch of forwarded frames to the tx path
+ * @vdev: virtual device the frames are forwarded on
+ * @head: first frame of the batch, or NULL
+ * @tail: last frame of the batch
+ * @num_msdus: number of frames in the batch
+ *
+ * Frames deferred by an earlier batch are sent first, to preserve the
+ * order, and the combined list goes to the tx path in a single call.
+ *
+ * Return: none
+ */
+static void
+ol_rx_fwd_to_tx(struct ol_txrx_vdev_t *vdev, cdf_nbuf_t head,
+		cdf_nbuf_t tail, uint32_t num_msdus)
+{
+	cdf_spin_lock_bh(&vdev->fwd.mutex);
+	if (vdev->fwd.deferred.head) {
+		if (head)
+			cdf_nbuf_set_next(vdev->fwd.deferred.tail, head);
+		else
+			tail = vdev->fwd.deferred.tail;
+		head = vdev->fwd.deferred.head;
+		num_msdus += vdev->fwd.deferred.depth;
+		vdev->fwd.deferred.head = NULL;
+		vdev->fwd.deferred.tail = NULL;
+		vdev->fwd.deferred.depth = 0;
+	}
+	if (head) {
+		vdev->fwd.stats.batches++;
+		vdev->fwd.stats.msdus += num_msdus;
+		if (num_msdus > vdev->fwd.stats.max_batch)
+			vdev->fwd.stats.max_batch = num_msdus;
+	}
+	cdf_spin_unlock_bh(&vdev->fwd.mutex);
+	if (!head)
+		return;
 
-	if (msdu) {
+	cdf_nbuf_set_next(tail, NULL);  /* add NULL terminator */
+	head = OL_TX_LL(vdev, head);
+	if (head) {
 		/*
-		 * The frame was not accepted by the tx.
-		 * We could store the frame and try again later,
-		 * but the simplest solution is to discard the frames.
+		 * The tx path ran out of descriptors.  Keep the remaining
+		 * frames, still mapped, and retry them later.
 		 */
+		ol_rx_fwd_defer(vdev, head);
+	}
+}
+
+/**
+ * ol_rx_fwd_defer_timer() - retry the deferred forwarded frames of a vdev
+ * @context: vdev
+ *
+ * Return: none
+ */
+static void ol_rx_fwd_defer_timer(void *context)
+{
+	struct ol_txrx_vdev_t *vdev = context;
+
+	cdf_spin_lock_bh(&vdev->fwd.mutex);
+	vdev->fwd.is_timer_on = false;
+	cdf_spin_unlock_bh(&vdev->fwd.mutex);
+
+	ol_rx_fwd_to_tx(vdev, NULL, NULL, 0);
+}
+
+void ol_rx_fwd_vdev_init(struct ol_txrx_vdev_t *vdev)
+{
+	cdf_mem_zero(&vdev->fwd, sizeof(vdev->fwd));
+	cdf_spinlock_init(&vdev->fwd.mutex);
+	cdf_softirq_timer_init(vdev->pdev->osdev, &vdev->fwd.timer,
+			       ol_rx_fwd_defer_timer, vdev,
+			       CDF_TIMER_TYPE_SW);
+}
+
+void ol_rx_fwd_vdev_deinit(struct ol_txrx_vdev_t *vdev)
+{
+	struct ol_txrx_pdev_t *pdev = vdev->pdev;
+	cdf_nbuf_t msdu;
+
+	cdf_softirq_timer_free(&vdev->fwd.timer);
+
+	cdf_spin_lock_bh(&vdev->fwd.mutex);
+	msdu = vdev->fwd.deferred.head;
+	vdev->fwd.deferred.head = NULL;
+	vdev->fwd.deferred.tail = NULL;
+	vdev->fwd.deferred.depth = 0;
+	vdev->fwd.is_timer_on = false;
+	cdf_spin_unlock_bh(&vdev->fwd.mutex);
+	cdf_spinlock_destroy(&vdev->fwd.mutex);
+
+	while (msdu) {
+		cdf_nbuf_t next = cdf_nbuf_next(msdu);
+
+		cdf_nbuf_set_next(msdu, NULL);
 		cdf_nbuf_unmap_single(pdev->osdev, msdu, CDF_DMA_TO_DEVICE);
 		cdf_nbuf_tx_free(msdu, NBUF_PKT_ERROR);
+		msdu = next;
 	}
 }
 
@@ -141,6 +291,9 @@ ol_rx_fwd_check(struct ol_txrx_vdev_t *vdev,
 	struct ol_txrx_pdev_t *pdev = vdev->pdev;
 	cdf_nbuf_t deliver_list_head = NULL;
 	cdf_nbuf_t deliver_list_tail = NULL;
+	cdf_nbuf_t fwd_list_head = NULL;
+	cdf_nbuf_t fwd_list_tail = NULL;
+	uint32_t num_fwd = 0;
 	cdf_nbuf_t msdu;
 
 	msdu = msdu_list;
@@ -196,15 +349,23 @@ ol_rx_fwd_check(struct ol_txrx_vdev_t *vdev,
 			if (htt_rx_msdu_discard(pdev->htt_pdev, rx_desc)) {
 				htt_rx_msdu_desc_free(pdev->htt_pdev, msdu);
 				cdf_net_buf_debug_release_skb(msdu);
-				ol_rx_fwd_to_tx(tx_vdev, msdu);
+				ol_rx_fwd_prepare(tx_vdev, msdu);
+				OL_TXRX_LIST_APPEND(fwd_list_head,
+						    fwd_list_tail, msdu);
+				num_fwd++;
 				msdu = NULL;    /* already handled this MSDU */
 				TXRX_STATS_ADD(pdev,
 					 pub.rx.intra_bss_fwd.packets_fwd, 1);
 			} else {
 				cdf_nbuf_t copy;
 				copy = cdf_nbuf_copy(msdu);
-				if (copy)
-					ol_rx_fwd_to_tx(tx_vdev, copy);
+				if (copy) {
+					ol_rx_fwd_prepare(tx_vdev, copy);
+					OL_TXRX_LIST_APPEND(fwd_list_head,
+							    fwd_list_tail,
+							    copy);
+					num_fwd++;
+				}
 				TXRX_STATS_ADD(pdev,
 				   pub.rx.intra_bss_fwd.packets_stack_n_fwd, 1);
 			}
@@ -219,6 +380,13 @@ ol_rx_fwd_check(struct ol_txrx_vdev_t *vdev,
 		}
 		msdu = msdu_list;
 	}
+	/*
+	 * Forward all the frames of this call in one tx call.  The tx vdev
+	 * is always the rx vdev, see above.
+	 */
+	if (fwd_list_head || vdev->fwd.deferred.head)
+		ol_rx_fwd_to_tx(vdev, fwd_list_head, fwd_list_tail, num_fwd);
+
 	if (deliver_list_head) {
 		/* add NULL terminator */
 		cdf_nbuf_set_next(deliver_list_tail, NULL);
@@ -72,4 +72,21 @@ ol_rx_fwd_check(struct ol_txrx_vdev_t *vdev,
 		struct ol_txrx_peer_t *peer,
 		unsigned tid, cdf_nbuf_t msdu_list);
 
+/**
+ * ol_rx_fwd_vdev_init() - initialize the intra-BSS forwarding state of a vdev
+ * @vdev: virtual device being attached
+ *
+ * Return: none
+ */
+void ol_rx_fwd_vdev_init(struct ol_txrx_vdev_t *vdev);
+
+/**
+ * ol_rx_fwd_vdev_deinit() - stop the forwarding retry timer and free the
+ *	frames still deferred for forwarding
+ * @vdev: virtual device being detached
+ *
+ * Return: none
+ */
+void ol_rx_fwd_vdev_deinit(struct ol_txrx_vdev_t *vdev);
+
 #endif /* _OL_RX_FWD_H_ */
@@ -81,16 +81,6 @@ static char g_log2ceil[] = {
 
 /*---*/
 
-/* reorder array elements are known to be non-NULL */
-#define OL_RX_REORDER_PTR_CHECK(ptr)    /* no-op */
-#define OL_RX_REORDER_LIST_APPEND(head_msdu, tail_msdu, rx_reorder_array_elem) \
-	do {								\
-		if (tail_msdu) {					\
-			cdf_nbuf_set_next(tail_msdu,			\
-					  rx_reorder_array_elem->head); \
-		}							\
-	} while (0)
-
 /* functions called by txrx components */
 
 void ol_rx_reorder_init(struct ol_rx_reorder_t *rx_reorder, uint8_t tid)
@@ -99,6 +89,7 @@ void ol_rx_reorder_init(struct ol_rx_reorder_t *rx_reorder, uint8_t tid)
 	rx_reorder->win_sz_mask = 0;
 	rx_reorder->array = &rx_reorder->base;
 	rx_reorder->base.head = rx_reorder->base.tail = NULL;
+	rx_reorder->occupancy = 0;
 	rx_reorder->tid = tid;
 	rx_reorder->defrag_timeout_ms = 0;
 
@@ -233,19 +224,86 @@ ol_rx_reorder_store(struct ol_txrx_pdev_t *pdev,
 		cdf_nbuf_set_next(rx_reorder_array_elem->tail, head_msdu);
 	} else {
 		rx_reorder_array_elem->head = head_msdu;
+		ol_rx_reorder_occupancy_set(&peer->tids_rx_reorder[tid], idx);
 		OL_RX_REORDER_MPDU_CNT_INCR(&peer->tids_rx_reorder[tid], 1);
 	}
 	rx_reorder_array_elem->tail = tail_msdu;
 }
 
+/**
+ * ol_rx_reorder_collect() - unlink the MPDUs held in a range of the
+ *	reorder array
+ * @rx_reorder: reorder state of the peer-TID
+ * @idx_start: first slot of the range, already wrapped to the array size
+ * @idx_end: slot following the last slot of the range, already wrapped to
+ *	the array size; the whole array is collected if equal to @idx_start
+ * @tail_msdu: set to the last MSDU collected
+ *
+ * Only the occupied slots are visited: the occupancy bitmap is scanned for
+ * runs of consecutive present MPDUs, each run is chained on to the output
+ * list in one pass, and the run's occupancy bits are then cleared in one
+ * go.  The output list is not NULL-terminated.
+ *
+ * Return: first MSDU collected, or NULL if the range held no MPDUs
+ */
+static cdf_nbuf_t
+ol_rx_reorder_collect(struct ol_rx_reorder_t *rx_reorder,
+		      unsigned idx_start, unsigned idx_end,
+		      cdf_nbuf_t *tail_msdu)
+{
+	unsigned win_sz_mask = rx_reorder->win_sz_mask;
+	struct ol_rx_reorder_array_elem_t *rx_reorder_array_elem;
+	cdf_nbuf_t head = NULL;
+	cdf_nbuf_t tail = NULL;
+	uint64_t pending;
+	unsigned len;
+
+	len = (idx_end - idx_start) & win_sz_mask;
+	if (len == 0)
+		len = win_sz_mask + 1;
+
+	pending = ol_rx_reorder_bitmap_rotate(rx_reorder->occupancy,
+					      idx_start, win_sz_mask) &
+		  ol_rx_reorder_bitmap_len_mask(len);
+	while (pending) {
+		unsigned off, run, idx;
+
+		off = __builtin_ctzll(pending);
+		run = ol_rx_reorder_bitmap_run_len(pending >> off);
+
+		idx = idx_start + off;
+		OL_RX_REORDER_IDX_WRAP(idx, rx_reorder->win_sz, win_sz_mask);
+		rx_reorder->occupancy &=
+			~ol_rx_reorder_bitmap_range(idx, run, win_sz_mask);
+		OL_RX_REORDER_MPDU_CNT_DECR(rx_reorder, run);
+
+		pending &= ~(ol_rx_reorder_bitmap_len_mask(run) << off);
+		while (run--) {
+			rx_reorder_array_elem = &rx_reorder->array[idx];
+			if (tail)
+				cdf_nbuf_set_next(tail,
+						  rx_reorder_array_elem->head);
+			else
+				head = rx_reorder_array_elem->head;
+			tail = rx_reorder_array_elem->tail;
+			rx_reorder_array_elem->head = NULL;
+			rx_reorder_array_elem->tail = NULL;
+			idx++;
+			OL_RX_REORDER_IDX_WRAP(idx, rx_reorder->win_sz,
+					       win_sz_mask);
+		}
+	}
+
+	*tail_msdu = tail;
+	return head;
+}
+
 void
 ol_rx_reorder_release(struct ol_txrx_vdev_t *vdev,
 		      struct ol_txrx_peer_t *peer,
 		      unsigned tid, unsigned idx_start, unsigned idx_end)
 {
-	unsigned idx;
-	unsigned win_sz, win_sz_mask;
-	struct ol_rx_reorder_array_elem_t *rx_reorder_array_elem;
+	unsigned win_sz_mask;
 	cdf_nbuf_t head_msdu;
 	cdf_nbuf_t tail_msdu;
 
@@ -253,36 +311,13 @@ ol_rx_reorder_release(struct ol_txrx_vdev_t *vdev,
 	/* may get reset below */
 	peer->tids_next_rel_idx[tid] = (uint16_t) idx_end;
 
-	win_sz = peer->tids_rx_reorder[tid].win_sz;
 	win_sz_mask = peer->tids_rx_reorder[tid].win_sz_mask;
 	idx_start &= win_sz_mask;
 	idx_end &= win_sz_mask;
-	rx_reorder_array_elem = &peer->tids_rx_reorder[tid].array[idx_start];
-
-	head_msdu = rx_reorder_array_elem->head;
-	tail_msdu = rx_reorder_array_elem->tail;
-	rx_reorder_array_elem->head = rx_reorder_array_elem->tail = NULL;
-	OL_RX_REORDER_PTR_CHECK(head_msdu) {
-		OL_RX_REORDER_MPDU_CNT_DECR(&peer->tids_rx_reorder[tid], 1);
-	}
 
-	idx = (idx_start + 1);
-	OL_RX_REORDER_IDX_WRAP(idx, win_sz, win_sz_mask);
-	while (idx != idx_end) {
-		rx_reorder_array_elem = &peer->tids_rx_reorder[tid].array[idx];
-		OL_RX_REORDER_PTR_CHECK(rx_reorder_array_elem->head) {
-			OL_RX_REORDER_MPDU_CNT_DECR(&peer->tids_rx_reorder[tid],
-						    1);
-			OL_RX_REORDER_LIST_APPEND(head_msdu, tail_msdu,
-						  rx_reorder_array_elem);
-			tail_msdu = rx_reorder_array_elem->tail;
-		}
-		rx_reorder_array_elem->head = rx_reorder_array_elem->tail =
-						      NULL;
-		idx++;
-		OL_RX_REORDER_IDX_WRAP(idx, win_sz, win_sz_mask);
-	}
-	OL_RX_REORDER_PTR_CHECK(head_msdu) {
+	head_msdu = ol_rx_reorder_collect(&peer->tids_rx_reorder[tid],
+					  idx_start, idx_end, &tail_msdu);
+	if (head_msdu) {
 		uint16_t seq_num;
 		htt_pdev_handle htt_pdev = vdev->pdev->htt_pdev;
 
@@ -326,9 +361,8 @@ ol_rx_reorder_flush(struct ol_txrx_vdev_t *vdev,
 	struct ol_txrx_pdev_t *pdev;
 	unsigned win_sz;
 	uint8_t win_sz_mask;
-	struct ol_rx_reorder_array_elem_t *rx_reorder_array_elem;
-	cdf_nbuf_t head_msdu = NULL;
-	cdf_nbuf_t tail_msdu = NULL;
+	cdf_nbuf_t head_msdu;
+	cdf_nbuf_t tail_msdu;
 
 	pdev = vdev->pdev;
 	win_sz = peer->tids_rx_reorder[tid].win_sz;
@@ -355,29 +389,8 @@ ol_rx_reorder_flush(struct ol_txrx_vdev_t *vdev,
 	idx_start &= win_sz_mask;
 	idx_end &= win_sz_mask;
 
-	do {
-		rx_reorder_array_elem =
-			&peer->tids_rx_reorder[tid].array[idx_start];
-		idx_start = (idx_start + 1);
-		OL_RX_REORDER_IDX_WRAP(idx_start, win_sz, win_sz_mask);
-
-		if (rx_reorder_array_elem->head) {
-			OL_RX_REORDER_MPDU_CNT_DECR(&peer->tids_rx_reorder[tid],
-						    1);
-			if (head_msdu == NULL) {
-				head_msdu = rx_reorder_array_elem->head;
-				tail_msdu = rx_reorder_array_elem->tail;
-				rx_reorder_array_elem->head = NULL;
-				rx_reorder_array_elem->tail = NULL;
-				continue;
-			}
-			cdf_nbuf_set_next(tail_msdu,
-					  rx_reorder_array_elem->head);
-			tail_msdu = rx_reorder_array_elem->tail;
-			rx_reorder_array_elem->head =
-				rx_reorder_array_elem->tail = NULL;
-		}
-	} while (idx_start != idx_end);
+	head_msdu = ol_rx_reorder_collect(&peer->tids_rx_reorder[tid],
+					  idx_start, idx_end, &tail_msdu);
 
 	ol_rx_defrag_waitlist_remove(peer, tid);
 
@@ -418,34 +431,20 @@ void
 ol_rx_reorder_first_hole(struct ol_txrx_peer_t *peer,
 			 unsigned tid, unsigned *idx_end)
 {
-	unsigned win_sz, win_sz_mask;
-	unsigned idx_start = 0, tmp_idx = 0;
-
-	win_sz = peer->tids_rx_reorder[tid].win_sz;
-	win_sz_mask = peer->tids_rx_reorder[tid].win_sz_mask;
+	unsigned idx_start = 0;
 
 	OL_RX_REORDER_IDX_START_SELF_SELECT(peer, tid, &idx_start);
-	tmp_idx++;
-	OL_RX_REORDER_IDX_WRAP(tmp_idx, win_sz, win_sz_mask);
-	/* bypass the initial hole */
-	while (tmp_idx != idx_start &&
-	       !peer->tids_rx_reorder[tid].array[tmp_idx].head) {
-		tmp_idx++;
-		OL_RX_REORDER_IDX_WRAP(tmp_idx, win_sz, win_sz_mask);
-	}
-	/* bypass the present frames following the initial hole */
-	while (tmp_idx != idx_start &&
-	       peer->tids_rx_reorder[tid].array[tmp_idx].head) {
-		tmp_idx++;
-		OL_RX_REORDER_IDX_WRAP(tmp_idx, win_sz, win_sz_mask);
-	}
 	/*
+	 * Bypass the initial hole and the present frames following it,
+	 * using the occupancy bitmap rather than the array itself.
 	 * idx_end is exclusive rather than inclusive.
 	 * In other words, it is the index of the first slot of the second
 	 * hole, rather than the index of the final present frame following
 	 * the first hole.
 	 */
-	*idx_end = tmp_idx;
+	*idx_end = ol_rx_reorder_bitmap_first_hole_end(
+		peer->tids_rx_reorder[tid].occupancy,
+		peer->tids_rx_reorder[tid].win_sz_mask);
 }
 
 void
@@ -498,6 +497,7 @@ ol_rx_addba_handler(ol_txrx_pdev_handle pdev,
 
 	rx_reorder->win_sz_mask = round_pwr2_win_sz - 1;
 	rx_reorder->num_mpdus = 0;
+	rx_reorder->occupancy = 0;
 
 	peer->tids_next_rel_idx[tid] =
 		OL_RX_REORDER_IDX_INIT(start_seq_num, rx_reorder->win_sz,
@@ -712,6 +712,8 @@ ol_rx_pn_ind_handler(ol_txrx_pdev_handle pdev,
 			}
 			rx_reorder_array_elem->head = NULL;
 			rx_reorder_array_elem->tail = NULL;
+			ol_rx_reorder_occupancy_clear(
+				&peer->tids_rx_reorder[tid], seq_num);
 		}
 		seq_num = (seq_num + 1) & win_sz_mask;
 	} while (seq_num != seq_num_end);
@@ -33,6 +33,34 @@
 #include <ol_txrx_api.h>        /* ol_txrx_peer_t, etc. */
 
 #include <ol_txrx_types.h>      /* ol_rx_reorder_t */
+#include <ol_rx_reorder_bitmap.h>
+
+/**
+ * ol_rx_reorder_occupancy_set() - mark a reorder array slot as holding MPDUs
+ * @rx_reorder: reorder state of the peer-TID
+ * @idx: reorder array index, already wrapped to the array size
+ *
+ * Return: None
+ */
+static inline void
+ol_rx_reorder_occupancy_set(struct ol_rx_reorder_t *rx_reorder, unsigned idx)
+{
+	rx_reorder->occupancy |= 1ULL << idx;
+}
+
+/**
+ * ol_rx_reorder_occupancy_clear() - mark a reorder array slot as empty
+ * @rx_reorder: reorder state of the peer-TID
+ * @idx: reorder array index, already wrapped to the array size
+ *
+ * Return: None
+ */
+static inline void
+ol_rx_reorder_occupancy_clear(struct ol_rx_reorder_t *rx_reorder,
+			      unsigned idx)
+{
+	rx_reorder->occupancy &= ~(1ULL << idx);
+}
 
 void
 ol_rx_reorder_store(struct ol_txrx_pdev_t *pdev,
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2015 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Occupancy bitmap arithmetic for the rx reorder array.
+ *
+ * Bit n of the bitmap is set while slot n of the reorder array holds
+ * MPDUs.  Block ack windows are at most 64 MPDUs, so a window always fits
+ * in one 64-bit word.  The reorder array is circular, so the helpers below
+ * work on the bitmap rotated such that a given start index becomes bit 0;
+ * the first present or missing slot after the start index is then a single
+ * count-trailing-zeros.
+ *
+ * This file has no dependencies beyond uint64_t, so that the same code can
+ * be built into the userspace benchmark under tools/.
+ */
+
+#ifndef _OL_RX_REORDER_BITMAP__H_
+#define _OL_RX_REORDER_BITMAP__H_
+
+#define OL_RX_REORDER_BITMAP_MAX_WIN 64
+
+/**
+ * ol_rx_reorder_bitmap_len_mask() - mask of the low @len bits
+ * @len: number of bits, 0 to 64
+ *
+ * Return: bitmap with bits 0 to @len - 1 set
+ */
+static inline uint64_t ol_rx_reorder_bitmap_len_mask(unsigned len)
+{
+	if (len >= OL_RX_REORDER_BITMAP_MAX_WIN)
+		return ~0ULL;
+	return (1ULL << len) - 1;
+}
+
+/**
+ * ol_rx_reorder_bitmap_rotate() - rotate a bitmap so @idx becomes bit 0
+ * @bitmap: occupancy bitmap of the reorder array
+ * @idx: array index to rotate down to bit 0
+ * @win_sz_mask: reorder array size - 1
+ *
+ * Return: rotated bitmap, limited to the reorder array size
+ */
+static inline uint64_t
+ol_rx_reorder_bitmap_rotate(uint64_t bitmap, unsigned idx,
+			    unsigned win_sz_mask)
+{
+	unsigned width = win_sz_mask + 1;
+
+	bitmap &= ol_rx_reorder_bitmap_len_mask(width);
+	if (idx == 0)
+		return bitmap;
+	return ((bitmap >> idx) | (bitmap << (width - idx))) &
+		ol_rx_reorder_bitmap_len_mask(width);
+}
+
+/**
+ * ol_rx_reorder_bitmap_range() - bitmap of a range of reorder array slots
+ * @idx_start: first slot of the range
+ * @len: number of slots in the range, wrapping around the array end
+ * @win_sz_mask: reorder array size - 1
+ *
+ * Return: bitmap with the bits of the slots in the range set
+ */
+static inline uint64_t
+ol_rx_reorder_bitmap_range(unsigned idx_start, unsigned len,
+			   unsigned win_sz_mask)
+{
+	unsigned width = win_sz_mask + 1;
+	uint64_t range = ol_rx_reorder_bitmap_len_mask(len);
+
+	if (idx_start == 0)
+		return range;
+	/* rotate left: the inverse of ol_rx_reorder_bitmap_rotate */
+	return ((range << idx_start) | (range >> (width - idx_start))) &
+		ol_rx_reorder_bitmap_len_mask(width);
+}
+
+/**
+ * ol_rx_reorder_bitmap_run_len() - length of the run of set bits at bit 0
+ * @bitmap: rotated bitmap
+ *
+ * Return: number of consecutive set bits starting from bit 0
+ */
+static inline unsigned ol_rx_reorder_bitmap_run_len(uint64_t bitmap)
+{
+	if (bitmap == ~0ULL)
+		return OL_RX_REORDER_BITMAP_MAX_WIN;
+	return __builtin_ctzll(~bitmap);
+}
+
+/**
+ * ol_rx_reorder_bitmap_first_hole_end() - find the end of the first run of
+ *	present slots following the initial hole
+ * @bitmap: occupancy bitmap of the reorder array
+ * @win_sz_mask: reorder array size - 1
+ *
+ * The scan starts at slot 1 and stops at slot 0, in the same way as the
+ * linear search it replaces.
+ *
+ * Return: index of the first slot of the second hole, 0 if the scan wrapped
+ */
+static inline unsigned
+ol_rx_reorder_bitmap_first_hole_end(uint64_t bitmap, unsigned win_sz_mask)
+{
+	unsigned len = win_sz_mask;     /* slots 1 .. win_sz_mask */
+	uint64_t scan;
+	unsigned off;
+
+	scan = ol_rx_reorder_bitmap_rotate(bitmap, 1, win_sz_mask) &
+		ol_rx_reorder_bitmap_len_mask(len);
+	if (!scan)
+		return 0;
+	off = __builtin_ctzll(scan);
+	off += ol_rx_reorder_bitmap_run_len(scan >> off);
+	if (off > len)
+		off = len;
+	return (1 + off) & win_sz_mask;
+}
+
+#endif /* _OL_RX_REORDER_BITMAP__H_ */
@@ -29,6 +29,7 @@
 #include <cdf_nbuf.h>           /* cdf_nbuf_t, etc. */
 #include <cdf_atomic.h>         /* cdf_atomic_read, etc. */
 #include <cdf_util.h>           /* cdf_unlikely */
+#include <cdf_time.h>           /* cdf_get_cycles */
 
 /* APIs for other modules */
 #include <htt.h>                /* HTT_TX_EXT_TID_MGMT */
@@ -80,31 +81,39 @@ int ce_send_fast(struct CE_handle *copyeng, cdf_nbuf_t *msdus,
 		}							\
 	} while (0)
 
+/*
+ * All segments of a jumbo packet are taken from the TSO segment pool in
+ * one batch.  If the pool cannot supply them, or the jumbo packet cannot
+ * be DMA mapped, the remaining MSDUs are handed back as unaccepted, the
+ * same way ol_tx_prepare_ll treats a descriptor shortage.
+ */
 #define ol_tx_prepare_tso(vdev, msdu, msdu_info) \
 	do { \
 		msdu_info.tso_info.curr_seg = NULL; \
 		if (cdf_nbuf_is_tso(msdu)) { \
+			uint64_t tso_prep_start = cdf_get_cycles(); \
 			int num_seg = cdf_nbuf_get_tso_num_seg(msdu); \
-			msdu_info.tso_info.tso_seg_list = NULL; \
-		    msdu_info.tso_info.num_segs = num_seg; \
-			while (num_seg) { \
-				struct cdf_tso_seg_elem_t *tso_seg = \
-					ol_tso_alloc_segment(vdev->pdev); \
-				if (tso_seg) { \
-					tso_seg->next = \
-						msdu_info.tso_info.tso_seg_list; \
-					msdu_info.tso_info.tso_seg_list \
-						= tso_seg; \
-					num_seg--; \
-				} else {\
-					cdf_print("TSO seg alloc failed!\n"); \
-				} \
+			msdu_info.tso_info.tso_seg_list = \
+				ol_tso_alloc_segments(vdev->pdev, num_seg); \
+			if (cdf_unlikely(!msdu_info.tso_info.tso_seg_list)) { \
+				TXRX_STATS_MSDU_LIST_INCR(vdev->pdev, \
+					tx.dropped.host_reject, msdu); \
+				return msdu; \
+			} \
+			msdu_info.tso_info.num_segs = num_seg; \
+			if (cdf_unlikely(!cdf_nbuf_get_tso_info( \
+					vdev->pdev->osdev, msdu, \
+					&msdu_info.tso_info))) { \
+				ol_tso_free_segments(vdev->pdev, \
+					msdu_info.tso_info.tso_seg_list); \
+				TXRX_STATS_MSDU_LIST_INCR(vdev->pdev, \
+					tx.dropped.host_reject, msdu); \
+				return msdu; \
 			} \
-			cdf_nbuf_get_tso_info(vdev->pdev->osdev, \
-				msdu, &msdu_info.tso_info); \
 			msdu_info.tso_info.curr_seg = \
 				msdu_info.tso_info.tso_seg_list; \
-		    num_seg = msdu_info.tso_info.num_segs; \
+			TXRX_STATS_TSO_PERF_UPDATE(vdev->pdev, msdu, \
+				cdf_get_cycles() - tso_prep_start); \
 		} else { \
 			msdu_info.tso_info.is_tso = 0; \
 			msdu_info.tso_info.num_segs = 1; \
@@ -166,6 +175,8 @@ cdf_nbuf_t ol_tx_send_data_frame(uint8_t sta_id, cdf_nbuf_t skb,
 	}
 
 	cdf_nbuf_trace_set_proto_type(skb, proto_type);
+	/* lets tx completion account latency without a peer lookup */
+	cdf_nbuf_set_tx_lat_peer(skb, sta_id + 1);
 
 	if ((ol_cfg_is_ip_tcp_udp_checksum_offload_enabled(pdev->ctrl_pdev))
 		&& (cdf_nbuf_get_protocol(skb) == htons(ETH_P_IP))
@@ -181,6 +192,7 @@ cdf_nbuf_t ol_tx_send_data_frame(uint8_t sta_id, cdf_nbuf_t skb,
 		cdf_nbuf_unmap_single(cdf_ctx, ret, CDF_DMA_TO_DEVICE);
 		return ret;
 	}
+	OL_TXRX_PEER_PKT_CNT_ADD(peer, tx, 1);
 
 	return NULL;
 }
@@ -221,6 +233,48 @@ cdf_nbuf_t ol_tx_send_ipa_data_frame(void *vdev,
 
 	return NULL;
 }
+
+/**
+ * ol_tx_send_ipa_data_frame_list() - send a list of IPA data frames
+ * @vdev: vdev
+ * @msdu_list: NULL-terminated list of skbs, all for @vdev
+ *
+ * Batched form of ol_tx_send_ipa_data_frame(): the whole list is handed
+ * to the LL tx path in one call, so the per-call pdev lookup and tx setup
+ * are paid once per batch rather than once per frame.
+ *
+ * Return: list of frames that were not accepted, NULL if all were sent
+ */
+cdf_nbuf_t ol_tx_send_ipa_data_frame_list(void *vdev,
+			cdf_nbuf_t msdu_list)
+{
+	ol_txrx_pdev_handle pdev = cds_get_context(CDF_MODULE_ID_TXRX);
+	cdf_nbuf_t msdu;
+	cdf_nbuf_t ret;
+	bool csum_offload;
+
+	if (cdf_unlikely(!pdev)) {
+		TXRX_PRINT(TXRX_PRINT_LEVEL_ERR,
+			"%s: pdev is NULL", __func__);
+		return msdu_list;
+	}
+
+	csum_offload =
+		ol_cfg_is_ip_tcp_udp_checksum_offload_enabled(pdev->ctrl_pdev);
+	for (msdu = msdu_list; csum_offload && msdu;
+	     msdu = cdf_nbuf_next(msdu)) {
+		if ((cdf_nbuf_get_protocol(msdu) == htons(ETH_P_IP))
+			&& (cdf_nbuf_get_ip_summed(msdu) == CHECKSUM_PARTIAL))
+			cdf_nbuf_set_ip_summed(msdu, CHECKSUM_COMPLETE);
+	}
+
+	ret = OL_TX_LL((struct ol_txrx_vdev_t *)vdev, msdu_list);
+	if (ret)
+		TXRX_PRINT(TXRX_PRINT_LEVEL_WARN,
+			"%s: Failed to tx part of the list", __func__);
+
+	return ret;
+}
 #endif
 
 
@@ -473,6 +527,53 @@ ol_tx_prepare_ll_fast(struct ol_txrx_pdev_t *pdev,
 
 	return tx_desc;
 }
+/*
+ * Maximum number of MSDUs posted to the CE source ring with a single
+ * write of the ring write index.
+ */
+#define OL_TX_FAST_BATCH_MAX 16
+
+/**
+ * ol_tx_ll_fast_flush() - post a batch of prepared MSDUs to the CE
+ * @pdev: txrx pdev
+ * @msdus: MSDUs whose tx descriptors have been prepared
+ * @tx_descs: tx descriptors of @msdus
+ * @num_msdus: number of MSDUs in the batch
+ * @ep_id: HTT endpoint
+ * @rest: MSDUs of the caller's list that follow the batch
+ *
+ * The whole batch is posted with a single update of the CE write index.
+ *
+ * Return: @rest if the whole batch was posted, otherwise the MSDUs that
+ *	   could not be posted chained in front of @rest
+ */
+static cdf_nbuf_t
+ol_tx_ll_fast_flush(struct ol_txrx_pdev_t *pdev, cdf_nbuf_t *msdus,
+		    struct ol_tx_desc_t **tx_descs, int num_msdus,
+		    uint32_t ep_id, cdf_nbuf_t rest)
+{
+	int sent;
+	int i;
+
+	if (!num_msdus)
+		return rest;
+
+	sent = ce_send_fast(pdev->ce_tx_hdl, msdus, num_msdus, ep_id);
+	if (cdf_likely(sent == num_msdus))
+		return rest;
+
+	/*
+	 * Free the descriptors of the MSDUs that could not be sent and
+	 * return the MSDUs to the caller in their original order.
+	 */
+	for (i = num_msdus - 1; i >= sent; i--) {
+		ol_tx_desc_free(pdev, tx_descs[i]);
+		cdf_nbuf_set_next(msdus[i], rest);
+		rest = msdus[i];
+	}
+	return rest;
+}
+
 #if defined(FEATURE_TSO)
 /**
  * ol_tx_ll_fast() Update metadata information and send msdu to HIF/CE
@@ -491,6 +592,9 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, cdf_nbuf_t msdu_list)
 		((struct htt_pdev_t *)(pdev->htt_pdev))->download_len;
 	uint32_t ep_id = HTT_EPID_GET(pdev->htt_pdev);
 	struct ol_txrx_msdu_info_t msdu_info;
+	cdf_nbuf_t batch_msdus[OL_TX_FAST_BATCH_MAX];
+	struct ol_tx_desc_t *batch_descs[OL_TX_FAST_BATCH_MAX];
+	int num_batch = 0;
 
 	msdu_info.htt.info.l2_hdr_type = vdev->pdev->htt_pkt_type;
 	msdu_info.htt.action.tx_comp_req = 0;
@@ -502,12 +606,26 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, cdf_nbuf_t msdu_list)
 	 */
 	while (msdu) {
 		cdf_nbuf_t next;
+		cdf_nbuf_t unsent;
 		struct ol_tx_desc_t *tx_desc;
 		int segments = 1;
 
 		msdu_info.htt.info.ext_tid = cdf_nbuf_get_tid(msdu);
 		msdu_info.peer = NULL;
 
+		/*
+		 * Jumbo packets are posted segment by segment, so post
+		 * the batch collected so far ahead of them.
+		 */
+		if (num_batch && cdf_nbuf_is_tso(msdu)) {
+			unsent = ol_tx_ll_fast_flush(pdev, batch_msdus,
+						     batch_descs, num_batch,
+						     ep_id, msdu);
+			num_batch = 0;
+			if (unsent != msdu)
+				return unsent;
+		}
+
 		ol_tx_prepare_tso(vdev, msdu, msdu_info);
 		segments = msdu_info.tso_info.num_segs;
 
@@ -566,6 +684,20 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, cdf_nbuf_t msdu_list)
 				 * HTT tx descriptor.
 				 */
 				htt_tx_desc_display(tx_desc->htt_tx_desc);
+				if (!msdu_info.tso_info.is_tso) {
+					/* post with the rest of the batch */
+					batch_msdus[num_batch] = msdu;
+					batch_descs[num_batch++] = tx_desc;
+					if (num_batch < OL_TX_FAST_BATCH_MAX)
+						continue;
+					unsent = ol_tx_ll_fast_flush(pdev,
+						batch_msdus, batch_descs,
+						num_batch, ep_id, next);
+					num_batch = 0;
+					if (unsent != next)
+						return unsent;
+					continue;
+				}
 				if ((0 == ce_send_fast(pdev->ce_tx_hdl, &msdu,
 						       1, ep_id))) {
 					/*
@@ -590,7 +722,10 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, cdf_nbuf_t msdu_list)
 				TXRX_STATS_MSDU_LIST_INCR(
 					pdev, tx.dropped.host_reject, msdu);
 				/* the list of unaccepted MSDUs */
-				return msdu;
+				return ol_tx_ll_fast_flush(pdev, batch_msdus,
+							   batch_descs,
+							   num_batch, ep_id,
+							   msdu);
 			}
 		} /* while segments */
 
@@ -600,7 +735,9 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, cdf_nbuf_t msdu_list)
 			TXRX_STATS_TSO_RESET_MSDU(vdev->pdev);
 		}
 	} /* while msdus */
-	return NULL; /* all MSDUs were accepted */
+	/* NULL if all MSDUs were accepted */
+	return ol_tx_ll_fast_flush(pdev, batch_msdus, batch_descs, num_batch,
+				   ep_id, NULL);
 }
 #else
 cdf_nbuf_t
@@ -612,6 +749,9 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, cdf_nbuf_t msdu_list)
 		((struct htt_pdev_t *)(pdev->htt_pdev))->download_len;
 	uint32_t ep_id = HTT_EPID_GET(pdev->htt_pdev);
 	struct ol_txrx_msdu_info_t msdu_info;
+	cdf_nbuf_t batch_msdus[OL_TX_FAST_BATCH_MAX];
+	struct ol_tx_desc_t *batch_descs[OL_TX_FAST_BATCH_MAX];
+	int num_batch = 0;
 
 	msdu_info.htt.info.l2_hdr_type = vdev->pdev->htt_pkt_type;
 	msdu_info.htt.action.tx_comp_req = 0;
@@ -624,6 +764,7 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, cdf_nbuf_t msdu_list)
 	 */
 	while (msdu) {
 		cdf_nbuf_t next;
+		cdf_nbuf_t unsent;
 		struct ol_tx_desc_t *tx_desc;
 
 		msdu_info.htt.info.ext_tid = cdf_nbuf_get_tid(msdu);
@@ -665,23 +806,35 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, cdf_nbuf_t msdu_list)
 			 * pointer before the ce_send call.
 			 */
 			next = cdf_nbuf_next(msdu);
-			if ((0 == ce_send_fast(pdev->ce_tx_hdl, &msdu, 1,
-					       ep_id))) {
-				/* The packet could not be sent */
-				/* Free the descriptor, return the packet to the
-				 * caller */
-				ol_tx_desc_free(pdev, tx_desc);
-				return msdu;
+			/*
+			 * Collect the MSDUs and post them to the CE together,
+			 * so that the write index is updated once per batch.
+			 */
+			batch_msdus[num_batch] = msdu;
+			batch_descs[num_batch++] = tx_desc;
+			if (num_batch == OL_TX_FAST_BATCH_MAX) {
+				unsent = ol_tx_ll_fast_flush(pdev, batch_msdus,
+							     batch_descs,
+							     num_batch, ep_id,
+							     next);
+				num_batch = 0;
+				if (unsent != next)
+					return unsent;
 			}
 			msdu = next;
 		} else {
 			TXRX_STATS_MSDU_LIST_INCR(
 				pdev, tx.dropped.host_reject, msdu);
-			return msdu; /* the list of unaccepted MSDUs */
+			/* the list of unaccepted MSDUs */
+			return ol_tx_ll_fast_flush(pdev, batch_msdus,
+						   batch_descs, num_batch,
+						   ep_id, msdu);
 		}
 	}
 
-	return NULL; /* all MSDUs were accepted */
+	/* NULL if all MSDUs were accepted */
+	return ol_tx_ll_fast_flush(pdev, batch_msdus, batch_descs, num_batch,
+				   ep_id, NULL);
 }
 #endif /* FEATURE_TSO */
 #endif /* WLAN_FEATURE_FASTPATH */
@@ -827,6 +980,8 @@ cdf_nbuf_t ol_tx_ll_queue(ol_txrx_vdev_handle vdev, cdf_nbuf_t msdu_list)
 {
 	uint16_t eth_type;
 	uint32_t paused_reason;
+	uint8_t pkt_class;
+	bool is_auth_frm;
 
 	if (msdu_list == NULL)
 		return NULL;
@@ -836,12 +991,22 @@ cdf_nbuf_t ol_tx_ll_queue(ol_txrx_vdev_handle vdev, cdf_nbuf_t msdu_list)
 		if (cdf_unlikely((paused_reason &
 				  OL_TXQ_PAUSE_REASON_PEER_UNAUTHORIZED) ==
 				 paused_reason)) {
-			eth_type = (((struct ethernet_hdr_t *)
-				     cdf_nbuf_data(msdu_list))->
-				    ethertype[0] << 8) |
-				   (((struct ethernet_hdr_t *)
-				     cdf_nbuf_data(msdu_list))->ethertype[1]);
-			if (ETHERTYPE_IS_EAPOL_WAPI(eth_type)) {
+			/* use the class cached by the OS shim when it has one */
+			pkt_class = cdf_nbuf_get_tx_pkt_class(msdu_list);
+			if (pkt_class & NBUF_TX_PKT_CLASS_VALID) {
+				is_auth_frm = pkt_class &
+					(NBUF_TX_PKT_CLASS_EAPOL |
+					 NBUF_TX_PKT_CLASS_WAI);
+			} else {
+				eth_type = (((struct ethernet_hdr_t *)
+					     cdf_nbuf_data(msdu_list))->
+					    ethertype[0] << 8) |
+					   (((struct ethernet_hdr_t *)
+					     cdf_nbuf_data(msdu_list))->
+					    ethertype[1]);
+				is_auth_frm = ETHERTYPE_IS_EAPOL_WAPI(eth_type);
+			}
+			if (is_auth_frm) {
 				msdu_list = ol_tx_ll_wrapper(vdev, msdu_list);
 				return msdu_list;
 			}
@@ -1340,6 +1505,7 @@ void ol_tso_seg_list_init(struct ol_txrx_pdev_t *pdev, uint32_t num_seg)
 		c_element->next = NULL;
 	}
 	pdev->tso_seg_pool.pool_size = num_seg;
+	pdev->tso_seg_pool.num_free = num_seg;
 	cdf_spinlock_init(&pdev->tso_seg_pool.tso_mutex);
 }
 
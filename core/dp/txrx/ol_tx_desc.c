@@ -29,7 +29,7 @@
 #include <cdf_nbuf.h>           /* cdf_nbuf_t, etc. */
 #include <cdf_util.h>           /* cdf_assert */
 #include <cdf_lock.h>           /* cdf_spinlock */
-#ifdef QCA_COMPUTE_TX_DELAY
+#if defined(QCA_COMPUTE_TX_DELAY) || defined(QCA_TX_PEER_LATENCY)
 #include <cdf_time.h>           /* cdf_system_ticks */
 #endif
 
@@ -106,6 +106,23 @@ static inline void ol_tx_desc_reset_timestamp(struct ol_tx_desc_t *tx_desc)
 }
 #endif
 
+#ifdef QCA_TX_PEER_LATENCY
+/**
+ * ol_tx_desc_lat_stamp() - record the enqueue time of a tx descriptor
+ * @tx_desc: tx descriptor
+ *
+ * Return: None
+ */
+static inline void ol_tx_desc_lat_stamp(struct ol_tx_desc_t *tx_desc)
+{
+	tx_desc->lat_enqueue_us = cdf_system_time_us();
+}
+#else
+static inline void ol_tx_desc_lat_stamp(struct ol_tx_desc_t *tx_desc)
+{
+}
+#endif
+
 #ifndef QCA_LL_TX_FLOW_CONTROL_V2
 /**
  * ol_tx_desc_alloc() - allocate descriptor from freelist
@@ -127,6 +144,8 @@ struct ol_tx_desc_t *ol_tx_desc_alloc(struct ol_txrx_pdev_t *pdev,
 		ol_tx_desc_compute_delay(tx_desc);
 	}
 	cdf_spin_unlock_bh(&pdev->tx_mutex);
+	if (tx_desc)
+		ol_tx_desc_lat_stamp(tx_desc);
 	return tx_desc;
 }
 
@@ -178,6 +197,7 @@ struct ol_tx_desc_t *ol_tx_desc_alloc(struct ol_txrx_pdev_t *pdev,
 			}
 			ol_tx_desc_sanity_checks(pdev, tx_desc);
 			ol_tx_desc_compute_delay(tx_desc);
+			ol_tx_desc_lat_stamp(tx_desc);
 		} else {
 			cdf_spin_unlock_bh(&pool->flow_pool_lock);
 			pdev->pool_stats.pkt_drop_no_desc++;
@@ -219,17 +239,16 @@ ol_tx_desc_alloc_wrapper(struct ol_txrx_pdev_t *pdev,
 #endif
 #endif
 
-#ifndef QCA_LL_TX_FLOW_CONTROL_V2
 /**
- * ol_tx_desc_free() - put descriptor to freelist
+ * ol_tx_desc_free_prep() - release per-frame state before freeing a desc
  * @pdev: pdev handle
  * @tx_desc: tx descriptor
  *
  * Return: None
  */
-void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
+static inline void ol_tx_desc_free_prep(struct ol_txrx_pdev_t *pdev,
+					struct ol_tx_desc_t *tx_desc)
 {
-	cdf_spin_lock_bh(&pdev->tx_mutex);
 #if defined(FEATURE_TSO)
 	if (tx_desc->pkt_type == ol_tx_frm_tso) {
 		if (cdf_unlikely(tx_desc->tso_desc == NULL))
@@ -241,37 +260,67 @@ void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
 #endif
 	ol_tx_desc_reset_pkt_type(tx_desc);
 	ol_tx_desc_reset_timestamp(tx_desc);
+}
 
+#ifndef QCA_LL_TX_FLOW_CONTROL_V2
+/**
+ * ol_tx_desc_free() - put descriptor to freelist
+ * @pdev: pdev handle
+ * @tx_desc: tx descriptor
+ *
+ * Return: None
+ */
+void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
+{
+	cdf_spin_lock_bh(&pdev->tx_mutex);
+	ol_tx_desc_free_prep(pdev, tx_desc);
 	ol_tx_put_desc_global_pool(pdev, tx_desc);
 	cdf_spin_unlock_bh(&pdev->tx_mutex);
 }
 
-#else
 /**
- * ol_tx_desc_free() - put descriptor to pool freelist
+ * ol_tx_desc_free_list() - put a list of descriptors to freelist
  * @pdev: pdev handle
- * @tx_desc: tx descriptor
+ * @tx_descs: list of tx descriptors
+ *
+ * All descriptors are returned to the global pool under a single
+ * acquisition of the tx mutex. The descriptors' netbuf pointers are
+ * overwritten by the freelist linkage, so callers must be done with
+ * them before calling this.
  *
  * Return: None
  */
-void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
+void ol_tx_desc_free_list(struct ol_txrx_pdev_t *pdev,
+			  ol_tx_desc_list *tx_descs)
 {
-	struct ol_tx_flow_pool_t *pool = tx_desc->pool;
+	struct ol_tx_desc_t *tx_desc, *tmp;
 
-#if defined(FEATURE_TSO)
-	if (tx_desc->pkt_type == ol_tx_frm_tso) {
-		if (cdf_unlikely(tx_desc->tso_desc == NULL))
-			cdf_print("%s %d TSO desc is NULL!\n",
-				 __func__, __LINE__);
-		else
-			ol_tso_free_segment(pdev, tx_desc->tso_desc);
+	if (TAILQ_EMPTY(tx_descs))
+		return;
+
+	cdf_spin_lock_bh(&pdev->tx_mutex);
+	TAILQ_FOREACH_SAFE(tx_desc, tx_descs, tx_desc_list_elem, tmp) {
+		ol_tx_desc_free_prep(pdev, tx_desc);
+		ol_tx_put_desc_global_pool(pdev, tx_desc);
 	}
-#endif
-	ol_tx_desc_reset_pkt_type(tx_desc);
-	ol_tx_desc_reset_timestamp(tx_desc);
+	cdf_spin_unlock_bh(&pdev->tx_mutex);
+}
 
-	cdf_spin_lock_bh(&pool->flow_pool_lock);
-	ol_tx_put_desc_flow_pool(pool, tx_desc);
+#else
+/**
+ * ol_tx_flow_pool_put_done() - update pool state after descs were returned
+ * @pdev: pdev handle
+ * @pool: flow pool, with flow_pool_lock held by the caller
+ *
+ * Wakes the netif queues once the pool climbs back over its start
+ * threshold and frees an invalid pool once all its descriptors are back.
+ * Releases flow_pool_lock in all cases.
+ *
+ * Return: None
+ */
+static void ol_tx_flow_pool_put_done(struct ol_txrx_pdev_t *pdev,
+				     struct ol_tx_flow_pool_t *pool)
+{
 	switch (pool->status) {
 	case FLOW_POOL_ACTIVE_PAUSED:
 		if (pool->avail_desc > pool->start_th) {
@@ -298,7 +347,59 @@ void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
 		break;
 	};
 	cdf_spin_unlock_bh(&pool->flow_pool_lock);
+}
+
+/**
+ * ol_tx_desc_free() - put descriptor to pool freelist
+ * @pdev: pdev handle
+ * @tx_desc: tx descriptor
+ *
+ * Return: None
+ */
+void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
+{
+	struct ol_tx_flow_pool_t *pool = tx_desc->pool;
 
+	ol_tx_desc_free_prep(pdev, tx_desc);
+
+	cdf_spin_lock_bh(&pool->flow_pool_lock);
+	ol_tx_put_desc_flow_pool(pool, tx_desc);
+	ol_tx_flow_pool_put_done(pdev, pool);
+}
+
+/**
+ * ol_tx_desc_free_list() - put a list of descriptors to their pool freelists
+ * @pdev: pdev handle
+ * @tx_descs: list of tx descriptors
+ *
+ * Completions usually arrive in runs belonging to the same flow pool, so
+ * the pool lock is taken once per run rather than once per descriptor.
+ * The pause/invalid state of a pool is re-evaluated when its run ends.
+ * The descriptors' netbuf pointers are overwritten by the freelist
+ * linkage, so callers must be done with them before calling this.
+ *
+ * Return: None
+ */
+void ol_tx_desc_free_list(struct ol_txrx_pdev_t *pdev,
+			  ol_tx_desc_list *tx_descs)
+{
+	struct ol_tx_desc_t *tx_desc, *tmp;
+	struct ol_tx_flow_pool_t *cur_pool = NULL;
+
+	TAILQ_FOREACH_SAFE(tx_desc, tx_descs, tx_desc_list_elem, tmp) {
+		struct ol_tx_flow_pool_t *pool = tx_desc->pool;
+
+		ol_tx_desc_free_prep(pdev, tx_desc);
+		if (pool != cur_pool) {
+			if (cur_pool)
+				ol_tx_flow_pool_put_done(pdev, cur_pool);
+			cur_pool = pool;
+			cdf_spin_lock_bh(&cur_pool->flow_pool_lock);
+		}
+		ol_tx_put_desc_flow_pool(pool, tx_desc);
+	}
+	if (cur_pool)
+		ol_tx_flow_pool_put_done(pdev, cur_pool);
 }
 #endif
 
@@ -445,12 +546,12 @@ void ol_tx_desc_frame_list_free(struct ol_txrx_pdev_t *pdev,
 		OL_TX_RESTORE_HDR(tx_desc, msdu);
 #endif
 		cdf_nbuf_unmap(pdev->osdev, msdu, CDF_DMA_TO_DEVICE);
-		/* free the tx desc */
-		ol_tx_desc_free(pdev, tx_desc);
 		/* link the netbuf into a list to free as a batch */
 		cdf_nbuf_set_next(msdu, msdus);
 		msdus = msdu;
 	}
+	/* return the tx descs with a single lock round-trip */
+	ol_tx_desc_free_list(pdev, tx_descs);
 	/* free the netbufs as a batch */
 	cdf_nbuf_tx_free(msdus, had_error);
 }
@@ -557,6 +658,70 @@ struct cdf_tso_seg_elem_t *ol_tso_alloc_segment(struct ol_txrx_pdev_t *pdev)
 	return tso_seg;
 }
 
+/**
+ * ol_tso_alloc_segments() - allocate the TSO segments of a jumbo packet
+ * @pdev:   txrx pdev
+ * @num_seg: number of segment elements needed
+ *
+ * Takes @num_seg elements off the free list under a single acquisition
+ * of the pool lock.  Either all of them are allocated or none is.
+ *
+ * Return: list of @num_seg segment elements linked through next,
+ *	   NULL if the pool does not hold enough free elements
+ */
+struct cdf_tso_seg_elem_t *ol_tso_alloc_segments(struct ol_txrx_pdev_t *pdev,
+						 int num_seg)
+{
+	struct cdf_tso_seg_elem_t *tso_seg_list = NULL;
+	struct cdf_tso_seg_elem_t *last;
+	int i;
+
+	if (cdf_unlikely(num_seg <= 0))
+		return NULL;
+
+	cdf_spin_lock_bh(&pdev->tso_seg_pool.tso_mutex);
+	if (pdev->tso_seg_pool.num_free >= num_seg) {
+		tso_seg_list = pdev->tso_seg_pool.freelist;
+		last = tso_seg_list;
+		for (i = 1; i < num_seg; i++)
+			last = last->next;
+		pdev->tso_seg_pool.freelist = last->next;
+		pdev->tso_seg_pool.num_free -= num_seg;
+		last->next = NULL;
+	}
+	cdf_spin_unlock_bh(&pdev->tso_seg_pool.tso_mutex);
+
+	return tso_seg_list;
+}
+
+/**
+ * ol_tso_free_segments() - return a list of TSO segments to the pool
+ * @pdev:   txrx pdev
+ * @tso_seg_list: NULL terminated list of segment elements
+ *
+ * Return: none
+ */
+void ol_tso_free_segments(struct ol_txrx_pdev_t *pdev,
+			  struct cdf_tso_seg_elem_t *tso_seg_list)
+{
+	struct cdf_tso_seg_elem_t *last = tso_seg_list;
+	int num_seg = 1;
+
+	if (!tso_seg_list)
+		return;
+
+	while (last->next) {
+		last = last->next;
+		num_seg++;
+	}
+
+	cdf_spin_lock_bh(&pdev->tso_seg_pool.tso_mutex);
+	last->next = pdev->tso_seg_pool.freelist;
+	pdev->tso_seg_pool.freelist = tso_seg_list;
+	pdev->tso_seg_pool.num_free += num_seg;
+	cdf_spin_unlock_bh(&pdev->tso_seg_pool.tso_mutex);
+}
+
 /**
  * ol_tso_free_segment() - function to free a TSO segment
  * element
@@ -158,9 +158,28 @@ void *ol_ath_get_bcn_header(ol_pdev_handle pdev, A_UINT32 vdev_id);
  */
 void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc);
 
+/*
+ * @brief Free a list of tx descriptors, without freeing the matching frames.
+ * @details
+ *  Return every descriptor in the list to its freelist, taking the
+ *  freelist lock once for the whole batch (once per flow pool run when
+ *  flow control v2 is enabled).
+ *
+ * @param pdev - the data physical device that sent the data
+ * @param tx_descs - list of the descriptors being freed
+ */
+void ol_tx_desc_free_list(struct ol_txrx_pdev_t *pdev,
+			  ol_tx_desc_list *tx_descs);
+
 #if defined(FEATURE_TSO)
 struct cdf_tso_seg_elem_t *ol_tso_alloc_segment(struct ol_txrx_pdev_t *pdev);
 
+struct cdf_tso_seg_elem_t *ol_tso_alloc_segments(struct ol_txrx_pdev_t *pdev,
+						 int num_seg);
+
+void ol_tso_free_segments(struct ol_txrx_pdev_t *pdev,
+			  struct cdf_tso_seg_elem_t *tso_seg_list);
+
 void ol_tso_free_segment(struct ol_txrx_pdev_t *pdev,
 	 struct cdf_tso_seg_elem_t *tso_seg);
 #endif
@@ -343,9 +343,27 @@ ol_tx_delay_compute(struct ol_txrx_pdev_t *pdev,
 #define OL_TX_DELAY_COMPUTE(pdev, status, desc_ids, num_msdus)  /* no-op */
 #endif /* QCA_COMPUTE_TX_DELAY */
 
+#ifdef QCA_TX_PEER_LATENCY
+static void
+ol_tx_lat_compute(struct ol_txrx_pdev_t *pdev,
+		  enum htt_tx_status status,
+		  uint16_t *desc_ids, int num_msdus);
+#define OL_TX_LAT_COMPUTE ol_tx_lat_compute
+#else
+#define OL_TX_LAT_COMPUTE(pdev, status, desc_ids, num_msdus)  /* no-op */
+#endif /* QCA_TX_PEER_LATENCY */
+
 #ifndef OL_TX_RESTORE_HDR
 #define OL_TX_RESTORE_HDR(__tx_desc, __msdu)
 #endif
+
+/*
+ * Number of tx descriptors the completion handler prefetches ahead of the
+ * one it is currently processing. Descriptor IDs in a completion batch are
+ * not contiguous in memory, so each lookup is otherwise a likely miss.
+ */
+#define OL_TX_COMPL_PREFETCH_DEPTH 4
+
 /*
  * The following macros could have been inline functions too.
  * The only rationale for choosing macros, is to force the compiler to inline
@@ -496,11 +514,24 @@ ol_tx_completion_handler(ol_txrx_pdev_handle pdev,
 	TAILQ_INIT(&tx_descs);
 
 	OL_TX_DELAY_COMPUTE(pdev, status, desc_ids, num_msdus);
+	OL_TX_LAT_COMPUTE(pdev, status, desc_ids, num_msdus);
 
 	trace_str = (status) ? "OT:C:F:" : "OT:C:S:";
+	/* warm up the first few descriptors of the batch */
+	for (i = 0; i < num_msdus && i < OL_TX_COMPL_PREFETCH_DEPTH; i++)
+		cdf_prefetch(ol_tx_desc_find(pdev, desc_ids[i]));
+
 	for (i = 0; i < num_msdus; i++) {
 		tx_desc_id = desc_ids[i];
 		tx_desc = ol_tx_desc_find(pdev, tx_desc_id);
+		/*
+		 * ol_tx_desc_find() only computes the descriptor address, so
+		 * this is a pure prefetch that keeps the window
+		 * OL_TX_COMPL_PREFETCH_DEPTH descriptors ahead.
+		 */
+		if (i + OL_TX_COMPL_PREFETCH_DEPTH < num_msdus)
+			cdf_prefetch(ol_tx_desc_find(pdev,
+				desc_ids[i + OL_TX_COMPL_PREFETCH_DEPTH]));
 		tx_desc->status = status;
 		netbuf = tx_desc->netbuf;
 
@@ -650,6 +681,53 @@ ol_tx_inspect_handler(ol_txrx_pdev_handle pdev,
 	OL_TX_TARGET_CREDIT_ADJUST(num_msdus, pdev, NULL);
 }
 
+#if defined(QCA_COMPUTE_TX_DELAY) || defined(QCA_TX_PEER_LATENCY)
+uint32_t ol_tx_delay_avg(uint64_t sum, uint32_t num)
+{
+	uint32_t sum32;
+	int shift = 0;
+	/*
+	 * To avoid doing a 64-bit divide, shift the sum down until it is
+	 * no more than 32 bits (and shift the denominator to match).
+	 */
+	while ((sum >> 32) != 0) {
+		sum >>= 1;
+		shift++;
+	}
+	sum32 = (uint32_t) sum;
+	num >>= shift;
+	return (sum32 + (num >> 1)) / num;      /* round to nearest */
+}
+
+#ifdef QCA_COMPUTE_TX_DELAY_PER_TID
+static inline uint8_t *ol_tx_dest_addr_find(struct ol_txrx_pdev_t *pdev,
+					    cdf_nbuf_t tx_nbuf)
+{
+	uint8_t *hdr_ptr;
+	void *datap = cdf_nbuf_data(tx_nbuf);
+
+	if (pdev->frame_format == wlan_frm_fmt_raw) {
+		/* adjust hdr_ptr to RA */
+		struct ieee80211_frame *wh = (struct ieee80211_frame *)datap;
+		hdr_ptr = wh->i_addr1;
+	} else if (pdev->frame_format == wlan_frm_fmt_native_wifi) {
+		/* adjust hdr_ptr to RA */
+		struct ieee80211_frame *wh = (struct ieee80211_frame *)datap;
+		hdr_ptr = wh->i_addr1;
+	} else if (pdev->frame_format == wlan_frm_fmt_802_3) {
+		hdr_ptr = datap;
+	} else {
+		CDF_TRACE(CDF_MODULE_ID_TXRX, CDF_TRACE_LEVEL_ERROR,
+			  "Invalid standard frame type: %d",
+			  pdev->frame_format);
+		cdf_assert(0);
+		hdr_ptr = NULL;
+	}
+	return hdr_ptr;
+}
+#endif
+#endif
+
 #ifdef QCA_COMPUTE_TX_DELAY
 
 void ol_tx_set_compute_interval(ol_txrx_pdev_handle pdev, uint32_t interval)
@@ -668,23 +746,6 @@ ol_tx_packet_count(ol_txrx_pdev_handle pdev,
 	pdev->packet_loss_count[category] = 0;
 }
 
-uint32_t ol_tx_delay_avg(uint64_t sum, uint32_t num)
-{
-	uint32_t sum32;
-	int shift = 0;
-	/*
-	 * To avoid doing a 64-bit divide, shift the sum down until it is
-	 * no more than 32 bits (and shift the denominator to match).
-	 */
-	while ((sum >> 32) != 0) {
-		sum >>= 1;
-		shift++;
-	}
-	sum32 = (uint32_t) sum;
-	num >>= shift;
-	return (sum32 + (num >> 1)) / num;      /* round to nearest */
-}
-
 void
 ol_tx_delay(ol_txrx_pdev_handle pdev,
 	    uint32_t *queue_delay_microsec,
@@ -758,32 +819,6 @@ ol_tx_delay_hist(ol_txrx_pdev_handle pdev,
 }
 
 #ifdef QCA_COMPUTE_TX_DELAY_PER_TID
-static inline uint8_t *ol_tx_dest_addr_find(struct ol_txrx_pdev_t *pdev,
-					    cdf_nbuf_t tx_nbuf)
-{
-	uint8_t *hdr_ptr;
-	void *datap = cdf_nbuf_data(tx_nbuf);
-
-	if (pdev->frame_format == wlan_frm_fmt_raw) {
-		/* adjust hdr_ptr to RA */
-		struct ieee80211_frame *wh = (struct ieee80211_frame *)datap;
-		hdr_ptr = wh->i_addr1;
-	} else if (pdev->frame_format == wlan_frm_fmt_native_wifi) {
-		/* adjust hdr_ptr to RA */
-		struct ieee80211_frame *wh = (struct ieee80211_frame *)datap;
-		hdr_ptr = wh->i_addr1;
-	} else if (pdev->frame_format == wlan_frm_fmt_802_3) {
-		hdr_ptr = datap;
-	} else {
-		CDF_TRACE(CDF_MODULE_ID_TXRX, CDF_TRACE_LEVEL_ERROR,
-			  "Invalid standard frame type: %d",
-			  pdev->frame_format);
-		cdf_assert(0);
-		hdr_ptr = NULL;
-	}
-	return hdr_ptr;
-}
-
 static uint8_t
 ol_tx_delay_tid_from_l3_hdr(struct ol_txrx_pdev_t *pdev,
 			    cdf_nbuf_t msdu, struct ol_tx_desc_t *tx_desc)
@@ -965,3 +1000,184 @@ ol_tx_delay_compute(struct ol_txrx_pdev_t *pdev,
 }
 
 #endif /* QCA_COMPUTE_TX_DELAY */
+
+#ifdef QCA_TX_PEER_LATENCY
+/**
+ * ol_tx_lat_bin() - histogram bin of a tx latency
+ * @delay_us: enqueue to completion latency
+ *
+ * Return: index into ol_tx_lat_tid.bins
+ */
+static inline int ol_tx_lat_bin(uint32_t delay_us)
+{
+	int bin = 0;
+
+	delay_us >>= OL_TXRX_TX_LAT_BIN0_SHIFT;
+	while (delay_us && bin < OL_TXRX_TX_LAT_NUM_BINS - 1) {
+		delay_us >>= 1;
+		bin++;
+	}
+	return bin;
+}
+
+/**
+ * ol_tx_lat_compute() - account tx completion latency per peer and TID
+ * @pdev: pdev handle
+ * @status: completion status of the batch
+ * @desc_ids: tx descriptor ids of the batch
+ * @num_msdus: number of entries in @desc_ids
+ *
+ * Runs in the tx completion softirq. Each frame carries the local id of its
+ * destination peer, tagged by ol_tx_send_data_frame(), and the counters of
+ * each local id belong to the pdev. Neither the vdev nor the peer is
+ * looked up or dereferenced, so no lock is taken, and the counters of the
+ * current CPU are updated without atomics. Frames sent without a tag
+ * (forwarded, IPA, non-standard) are not accounted.
+ *
+ * Return: None
+ */
+static void
+ol_tx_lat_compute(struct ol_txrx_pdev_t *pdev,
+		  enum htt_tx_status status,
+		  uint16_t *desc_ids, int num_msdus)
+{
+	uint32_t now_us = cdf_system_time_us();
+	int cpu = cdf_get_cpu();
+	int i;
+
+	for (i = 0; i < num_msdus; i++) {
+		struct ol_tx_desc_t *tx_desc = ol_tx_desc_find(pdev,
+							       desc_ids[i]);
+		struct ol_tx_lat_cpu *lat_cpu;
+		struct ol_tx_lat_tid *lat;
+		uint32_t delay_us;
+		uint8_t lat_peer;
+		uint8_t tid;
+
+		if (cdf_unlikely(tx_desc->pkt_type >= OL_TXRX_MGMT_TYPE_BASE))
+			continue;
+
+		lat_peer = cdf_nbuf_get_tx_lat_peer(tx_desc->netbuf);
+		if (!lat_peer || lat_peer > OL_TXRX_NUM_LOCAL_PEER_IDS)
+			continue;
+		lat_cpu = pdev->tx_lat[lat_peer - 1];
+		if (cdf_unlikely(!lat_cpu))
+			continue;
+
+		tid = cdf_nbuf_get_tid(tx_desc->netbuf);
+		if (tid > OL_TXRX_TX_LAT_NON_QOS_TID)
+			tid = OL_TXRX_TX_LAT_NON_QOS_TID;
+		lat = &lat_cpu[cpu].tid[tid];
+
+		if (status != htt_tx_status_ok) {
+			lat->dropped++;
+			continue;
+		}
+
+		delay_us = now_us - tx_desc->lat_enqueue_us;
+		lat->count++;
+		lat->sum_us += delay_us;
+		if (delay_us > lat->max_us)
+			lat->max_us = delay_us;
+		lat->bins[ol_tx_lat_bin(delay_us)]++;
+	}
+}
+
+void ol_tx_lat_attach(struct ol_txrx_pdev_t *pdev)
+{
+	size_t size = cdf_get_num_cpus() * sizeof(struct ol_tx_lat_cpu);
+	int i;
+
+	for (i = 0; i < OL_TXRX_NUM_LOCAL_PEER_IDS; i++) {
+		pdev->tx_lat[i] = cdf_mem_malloc(size);
+		if (pdev->tx_lat[i])
+			cdf_mem_zero(pdev->tx_lat[i], size);
+	}
+}
+
+void ol_tx_lat_detach(struct ol_txrx_pdev_t *pdev)
+{
+	int i;
+
+	for (i = 0; i < OL_TXRX_NUM_LOCAL_PEER_IDS; i++) {
+		if (pdev->tx_lat[i])
+			cdf_mem_free(pdev->tx_lat[i]);
+		pdev->tx_lat[i] = NULL;
+	}
+}
+
+/**
+ * ol_tx_lat_percentile() - upper bound of the bin holding a percentile
+ * @lat: folded latency report
+ * @pct: percentile, 1-100
+ *
+ * Return: latency in us
+ */
+static uint32_t ol_tx_lat_percentile(struct ol_txrx_tx_latency *lat,
+				     uint32_t pct)
+{
+	uint32_t target = (uint32_t)(((uint64_t)lat->count * pct + 99) / 100);
+	uint32_t cum = 0;
+	int bin;
+
+	for (bin = 0; bin < OL_TXRX_TX_LAT_NUM_BINS - 1; bin++) {
+		cum += lat->bins[bin];
+		if (cum >= target)
+			return 1 << (OL_TXRX_TX_LAT_BIN0_SHIFT + bin);
+	}
+	return lat->max_us;
+}
+
+CDF_STATUS
+ol_txrx_peer_tx_latency_get(ol_txrx_pdev_handle pdev, uint8_t local_peer_id,
+			    uint8_t tid, struct ol_txrx_tx_latency *lat)
+{
+	struct ol_tx_lat_cpu *lat_cpu;
+	uint64_t sum_us = 0;
+	int cpu, bin;
+
+	if (tid >= OL_TXRX_TX_LAT_NUM_TIDS)
+		return CDF_STATUS_E_INVAL;
+
+	cdf_mem_zero(lat, sizeof(*lat));
+
+	if (!ol_txrx_peer_find_by_local_id(pdev, local_peer_id))
+		return CDF_STATUS_E_INVAL;
+	lat_cpu = pdev->tx_lat[local_peer_id];
+	if (!lat_cpu)
+		return CDF_STATUS_E_INVAL;
+
+	for (cpu = 0; cpu < cdf_get_num_cpus(); cpu++) {
+		struct ol_tx_lat_tid *src = &lat_cpu[cpu].tid[tid];
+
+		lat->count += src->count;
+		lat->dropped += src->dropped;
+		sum_us += src->sum_us;
+		if (src->max_us > lat->max_us)
+			lat->max_us = src->max_us;
+		for (bin = 0; bin < OL_TXRX_TX_LAT_NUM_BINS; bin++)
+			lat->bins[bin] += src->bins[bin];
+	}
+
+	if (!lat->count)
+		return CDF_STATUS_SUCCESS;
+
+	lat->avg_us = ol_tx_delay_avg(sum_us, lat->count);
+	lat->p50_us = ol_tx_lat_percentile(lat, 50);
+	lat->p90_us = ol_tx_lat_percentile(lat, 90);
+	lat->p99_us = ol_tx_lat_percentile(lat, 99);
+	return CDF_STATUS_SUCCESS;
+}
+
+void
+ol_txrx_peer_tx_latency_reset(ol_txrx_pdev_handle pdev,
+			      uint8_t local_peer_id)
+{
+	if (local_peer_id >= OL_TXRX_NUM_LOCAL_PEER_IDS ||
+	    !pdev->tx_lat[local_peer_id])
+		return;
+
+	cdf_mem_zero(pdev->tx_lat[local_peer_id],
+		     cdf_get_num_cpus() * sizeof(struct ol_tx_lat_cpu));
+}
+#endif /* QCA_TX_PEER_LATENCY */
@@ -83,4 +83,31 @@ void
 ol_tx_send_nonstd(struct ol_txrx_pdev_t *pdev,
 		  struct ol_tx_desc_t *tx_desc,
 		  cdf_nbuf_t msdu, enum htt_pkt_type pkt_type);
+
+#ifdef QCA_TX_PEER_LATENCY
+/**
+ * @brief Allocate the per-peer tx latency counters of a pdev.
+ * @details
+ *  The counters are best effort: a local peer id whose allocation fails
+ *  is simply not accounted.
+ *
+ * @param pdev - the phy dev
+ */
+void ol_tx_lat_attach(struct ol_txrx_pdev_t *pdev);
+
+/**
+ * @brief Free the per-peer tx latency counters of a pdev.
+ *
+ * @param pdev - the phy dev
+ */
+void ol_tx_lat_detach(struct ol_txrx_pdev_t *pdev);
+#else
+static inline void ol_tx_lat_attach(struct ol_txrx_pdev_t *pdev)
+{
+}
+
+static inline void ol_tx_lat_detach(struct ol_txrx_pdev_t *pdev)
+{
+}
+#endif /* QCA_TX_PEER_LATENCY */
 #endif /* _OL_TX_SEND__H_ */
@@ -32,6 +32,7 @@
 #include <cdf_types.h>          /* cdf_device_t, cdf_print */
 #include <cdf_lock.h>           /* cdf_spinlock */
 #include <cdf_atomic.h>         /* cdf_atomic_read */
+#include <cdf_mc_timer.h>       /* cdf_mc_timer_display_stats */
 
 /* Required for WLAN_FEATURE_FASTPATH */
 #include <ce_api.h>
@@ -777,6 +778,7 @@ ol_txrx_pdev_attach(ol_txrx_pdev_handle pdev)
 #endif
 
 	ol_txrx_local_peer_id_pool_init(pdev);
+	ol_tx_lat_attach(pdev);
 
 	pdev->cfg.ll_pause_txq_limit =
 		ol_tx_cfg_max_tx_queue_depth_ll(pdev->ctrl_pdev);
@@ -969,6 +971,7 @@ void ol_txrx_pdev_detach(ol_txrx_pdev_handle pdev, int force)
 	 */
 	wdi_event_detach(pdev);
 	ol_txrx_local_peer_id_cleanup(pdev);
+	ol_tx_lat_detach(pdev);
 
 #ifdef QCA_COMPUTE_TX_DELAY
 	cdf_spinlock_destroy(&pdev->tx_delay.mutex);
@@ -1019,6 +1022,7 @@ ol_txrx_vdev_attach(ol_txrx_pdev_handle pdev,
 			       &vdev->ll_pause.timer,
 			       ol_tx_vdev_ll_pause_queue_send, vdev,
 			       CDF_TIMER_TYPE_SW);
+	ol_rx_fwd_vdev_init(vdev);
 	cdf_atomic_init(&vdev->os_q_paused);
 	cdf_atomic_set(&vdev->os_q_paused, 0);
 	vdev->tx_fl_lwm = 0;
@@ -1107,6 +1111,8 @@ ol_txrx_vdev_detach(ol_txrx_vdev_handle vdev,
 	cdf_spin_unlock_bh(&vdev->ll_pause.mutex);
 	cdf_spinlock_destroy(&vdev->ll_pause.mutex);
 
+	ol_rx_fwd_vdev_deinit(vdev);
+
 	cdf_spin_lock_bh(&vdev->flow_control_lock);
 	vdev->osif_flow_control_cb = NULL;
 	vdev->osif_fc_ctx = NULL;
@@ -1296,6 +1302,12 @@ ol_txrx_peer_attach(ol_txrx_pdev_handle pdev,
 
 	cdf_atomic_init(&peer->delete_in_progress);
 	cdf_atomic_init(&peer->flush_in_progress);
+	/* the counters are best effort; the peer works without them */
+	peer->pkt_cnt = cdf_mem_malloc(cdf_get_num_cpus() *
+				       sizeof(*peer->pkt_cnt));
+	if (peer->pkt_cnt)
+		cdf_mem_zero(peer->pkt_cnt,
+			     cdf_get_num_cpus() * sizeof(*peer->pkt_cnt));
 
 	cdf_atomic_init(&peer->ref_cnt);
 
@@ -1340,6 +1352,8 @@ ol_txrx_peer_attach(ol_txrx_pdev_handle pdev,
 #endif
 
 	ol_txrx_local_peer_id_alloc(pdev, peer);
+	/* drop whatever the previous owner of the local id left behind */
+	ol_txrx_peer_tx_latency_reset(pdev, peer->local_id);
 
 	return peer;
 }
@@ -1696,6 +1710,8 @@ void ol_txrx_peer_unref_delete(ol_txrx_peer_handle peer)
 			}
 		}
 
+		if (peer->pkt_cnt)
+			cdf_mem_free(peer->pkt_cnt);
 		cdf_mem_free(peer);
 	} else {
 		cdf_spin_unlock_bh(&pdev->peer_ref_mutex);
@@ -2344,6 +2360,66 @@ ol_txrx_stats(uint8_t vdev_id, char *buffer, unsigned buf_len)
 	return len;
 }
 
+#if defined(FEATURE_TSO)
+/**
+ * ol_txrx_stats_display_tso_perf() - display the cost of TSO preparation
+ * @pdev: txrx pdev
+ *
+ * Throughput is the rate at which jumbo packets were accepted between the
+ * first and the latest one since the stats were cleared; cycles per byte
+ * is shown in hundredths.
+ *
+ * Return: none
+ */
+static void ol_txrx_stats_display_tso_perf(ol_txrx_pdev_handle pdev)
+{
+	struct ol_txrx_stats_tso_perf *perf = &pdev->stats.pub.tx.tso.perf;
+	uint32_t elapsed_ms;
+	uint64_t mbps = 0;
+	uint32_t cycles_per_byte_x100 = 0;
+
+	elapsed_ms = cdf_system_ticks_to_msecs(perf->last_ticks -
+					       perf->first_ticks);
+	/* bits per ms is kbps */
+	if (elapsed_ms)
+		mbps = cdf_div_u64(cdf_div_u64(perf->bytes * 8, elapsed_ms),
+				   1000);
+	/* cdf_div_u64 takes a 32-bit divisor, so count bytes in KB here */
+	if (perf->bytes >> 10)
+		cycles_per_byte_x100 = (uint32_t)cdf_div_u64(
+			cdf_div_u64(perf->prep_cycles * 100, 1024),
+			(uint32_t)(perf->bytes >> 10));
+
+	CDF_TRACE(CDF_MODULE_ID_TXRX, CDF_TRACE_LEVEL_ERROR,
+		  "  tso: %lld B in %u ms (%lld Mbps), prep %lld cycles (%u.%02u cycles/B)",
+		  perf->bytes, elapsed_ms, mbps, perf->prep_cycles,
+		  cycles_per_byte_x100 / 100, cycles_per_byte_x100 % 100);
+}
+#endif
+
+/**
+ * ol_txrx_stats_display_fwd() - display the intra-BSS forwarding stats
+ * @pdev: txrx pdev
+ *
+ * Return: none
+ */
+static void ol_txrx_stats_display_fwd(ol_txrx_pdev_handle pdev)
+{
+	struct ol_txrx_vdev_t *vdev;
+
+	TAILQ_FOREACH(vdev, &pdev->vdev_list, vdev_list_elem) {
+		if (!vdev->fwd.stats.batches)
+			continue;
+		CDF_TRACE(CDF_MODULE_ID_TXRX, CDF_TRACE_LEVEL_ERROR,
+			  "  vdev %d fwd: %u msdus in %u batches (max %u), "
+			  "deferred %u, dropped %u, pending %d",
+			  vdev->vdev_id, vdev->fwd.stats.msdus,
+			  vdev->fwd.stats.batches, vdev->fwd.stats.max_batch,
+			  vdev->fwd.stats.deferred, vdev->fwd.stats.dropped,
+			  vdev->fwd.deferred.depth);
+	}
+}
+
 void ol_txrx_stats_display(ol_txrx_pdev_handle pdev)
 {
 	CDF_TRACE(CDF_MODULE_ID_TXRX, CDF_TRACE_LEVEL_ERROR, "txrx stats:");
@@ -2388,6 +2464,9 @@ void ol_txrx_stats_display(ol_txrx_pdev_handle pdev)
 		  pdev->stats.pub.tx.comp_histogram.pkts_41_50,
 		  pdev->stats.pub.tx.comp_histogram.pkts_51_60,
 		  pdev->stats.pub.tx.comp_histogram.pkts_61_plus);
+#if defined(FEATURE_TSO)
+	ol_txrx_stats_display_tso_perf(pdev);
+#endif
 	CDF_TRACE(CDF_MODULE_ID_TXRX, CDF_TRACE_LEVEL_ERROR,
 		  "  rx: %lld ppdus, %lld mpdus, %lld msdus, %lld bytes, %lld errs",
 		  pdev->stats.priv.rx.normal.ppdus,
@@ -2401,6 +2480,7 @@ void ol_txrx_stats_display(ol_txrx_pdev_handle pdev)
 		  pdev->stats.pub.rx.intra_bss_fwd.packets_stack,
 		  pdev->stats.pub.rx.intra_bss_fwd.packets_fwd,
 		  pdev->stats.pub.rx.intra_bss_fwd.packets_stack_n_fwd);
+	ol_txrx_stats_display_fwd(pdev);
 }
 
 void ol_txrx_stats_clear(ol_txrx_pdev_handle pdev)
@@ -2426,6 +2506,41 @@ int16_t ol_txrx_peer_rssi(ol_txrx_peer_handle peer)
 }
 #endif /* #ifdef QCA_SUPPORT_PEER_DATA_RX_RSSI */
 
+#ifdef QCA_SUPPORT_TXRX_LOCAL_PEER_ID
+/**
+ * ol_txrx_peer_pkt_cnt_get() - read the data frame counters of a peer
+ * @pdev: txrx pdev handle
+ * @local_peer_id: local peer id (station id) of the peer
+ * @tx_cnt: filled with the number of frames sent to the peer
+ * @rx_cnt: filled with the number of frames received from the peer
+ *
+ * Sums the per-CPU counters. They are never cleared, so callers count
+ * frames over an interval by subtracting an earlier reading.
+ *
+ * Return: CDF_STATUS_SUCCESS, or CDF_STATUS_E_INVAL if the peer does not exist
+ */
+CDF_STATUS ol_txrx_peer_pkt_cnt_get(ol_txrx_pdev_handle pdev,
+				    uint8_t local_peer_id,
+				    uint32_t *tx_cnt, uint32_t *rx_cnt)
+{
+	struct ol_txrx_peer_t *peer;
+	int cpu;
+
+	*tx_cnt = 0;
+	*rx_cnt = 0;
+
+	peer = ol_txrx_peer_find_by_local_id(pdev, local_peer_id);
+	if (!peer || !peer->pkt_cnt)
+		return CDF_STATUS_E_INVAL;
+
+	for (cpu = 0; cpu < cdf_get_num_cpus(); cpu++) {
+		*tx_cnt += peer->pkt_cnt[cpu].tx;
+		*rx_cnt += peer->pkt_cnt[cpu].rx;
+	}
+	return CDF_STATUS_SUCCESS;
+}
+#endif /* QCA_SUPPORT_TXRX_LOCAL_PEER_ID */
+
 #ifdef QCA_ENABLE_OL_TXRX_PEER_STATS
 A_STATUS
 ol_txrx_peer_stats_copy(ol_txrx_pdev_handle pdev,
@@ -2823,6 +2938,9 @@ void ol_txrx_display_stats(uint16_t value)
 	case WLAN_TXRX_DESC_STATS:
 		cdf_nbuf_tx_desc_count_display();
 		break;
+	case WLAN_MC_TIMER_STATS:
+		cdf_mc_timer_display_stats();
+		break;
 	default:
 		CDF_TRACE(CDF_MODULE_ID_TXRX, CDF_TRACE_LEVEL_ERROR,
 					"%s: Unknown value", __func__);
@@ -2851,6 +2969,9 @@ void ol_txrx_clear_stats(uint16_t value)
 	case WLAN_TXRX_DESC_STATS:
 		cdf_nbuf_tx_desc_count_clear();
 		break;
+	case WLAN_MC_TIMER_STATS:
+		cdf_mc_timer_clear_stats();
+		break;
 	default:
 		CDF_TRACE(CDF_MODULE_ID_TXRX, CDF_TRACE_LEVEL_ERROR,
 					"%s: Unknown value", __func__);
@@ -111,6 +111,8 @@ void ol_tx_register_flow_control(struct ol_txrx_pdev_t *pdev)
 {
 	cdf_spinlock_init(&pdev->tx_desc.flow_pool_list_lock);
 	TAILQ_INIT(&pdev->tx_desc.flow_pool_list);
+	cdf_mem_zero(pdev->tx_desc.flow_pool_tbl,
+		     sizeof(pdev->tx_desc.flow_pool_tbl));
 
 	if (!ol_tx_get_is_mgmt_over_wmi_enabled())
 		ol_tx_register_global_mgmt_pool(pdev);
@@ -216,7 +218,14 @@ void ol_tx_clear_flow_pool_stats(void)
  * ol_tx_move_desc_n() - Move n descriptors from src_pool to dst_pool.
  * @src_pool: source pool
  * @dst_pool: destination pool
- * @desc_move_count: descriptor move count
+ * @desc_move_count: descriptor move count, already reserved against
+ *	dst_pool->deficient_desc by the caller
+ *
+ * The descriptors are detached from the source freelist as one chain and
+ * spliced onto the destination freelist in one go, so each pool lock is
+ * taken once per move rather than once per descriptor. The chain is
+ * private while it is retargeted at the destination pool, so that walk
+ * needs no lock.
  *
  * Return: actual descriptors moved
  */
@@ -224,43 +233,36 @@ static int ol_tx_move_desc_n(struct ol_tx_flow_pool_t *src_pool,
 		      struct ol_tx_flow_pool_t *dst_pool,
 		      int desc_move_count)
 {
-	uint16_t count = 0, i;
-	struct ol_tx_desc_t *tx_desc;
-	union ol_tx_desc_list_elem_t *temp_list = NULL;
+	uint16_t count, i;
+	union ol_tx_desc_list_elem_t *head, *tail, *elem;
 
-	/* Take descriptors from source pool and put it in temp_list */
+	/* Detach the first desc_move_count descriptors of the source pool */
 	cdf_spin_lock_bh(&src_pool->flow_pool_lock);
-	for (i = 0; i < desc_move_count; i++) {
-		tx_desc = ol_tx_get_desc_flow_pool(src_pool);
-		((union ol_tx_desc_list_elem_t *)tx_desc)->next = temp_list;
-		temp_list = (union ol_tx_desc_list_elem_t *)tx_desc;
-
+	count = (desc_move_count > src_pool->avail_desc) ?
+			src_pool->avail_desc : desc_move_count;
+	if (!count) {
+		cdf_spin_unlock_bh(&src_pool->flow_pool_lock);
+		return 0;
 	}
+	head = src_pool->freelist;
+	tail = head;
+	for (i = 1; i < count; i++)
+		tail = tail->next;
+	src_pool->freelist = tail->next;
+	src_pool->avail_desc -= count;
 	cdf_spin_unlock_bh(&src_pool->flow_pool_lock);
 
-	/* Take descriptors from temp_list and put it in destination pool */
+	tail->next = NULL;
+	for (elem = head; elem; elem = elem->next)
+		elem->tx_desc.pool = dst_pool;
+
+	/* Splice the chain onto the destination pool */
 	cdf_spin_lock_bh(&dst_pool->flow_pool_lock);
-	for (i = 0; i < desc_move_count; i++) {
-		if (dst_pool->deficient_desc)
-			dst_pool->deficient_desc--;
-		else
-			break;
-		tx_desc = &temp_list->tx_desc;
-		temp_list = temp_list->next;
-		ol_tx_put_desc_flow_pool(dst_pool, tx_desc);
-		count++;
-	}
+	tail->next = dst_pool->freelist;
+	dst_pool->freelist = head;
+	dst_pool->avail_desc += count;
 	cdf_spin_unlock_bh(&dst_pool->flow_pool_lock);
 
-	/* If anything is there in temp_list put it back to source pool */
-	cdf_spin_lock_bh(&src_pool->flow_pool_lock);
-	while (temp_list) {
-		tx_desc = &temp_list->tx_desc;
-		temp_list = temp_list->next;
-		ol_tx_put_desc_flow_pool(src_pool, tx_desc);
-	}
-	cdf_spin_unlock_bh(&src_pool->flow_pool_lock);
-
 	return count;
 }
 
@@ -279,31 +281,50 @@ ol_tx_distribute_descs_to_deficient_pools(struct ol_tx_flow_pool_t *src_pool)
 {
 	struct ol_txrx_pdev_t *pdev = cds_get_context(CDF_MODULE_ID_TXRX);
 	struct ol_tx_flow_pool_t *dst_pool = NULL;
-	uint16_t desc_count = src_pool->avail_desc;
+	uint16_t desc_count;
 	uint16_t desc_move_count = 0;
+	uint16_t moved;
 
 	if (!pdev) {
 		TXRX_PRINT(TXRX_PRINT_LEVEL_ERR,
 		   "%s: pdev is NULL\n", __func__);
 		return -EINVAL;
 	}
+
+	cdf_spin_lock_bh(&src_pool->flow_pool_lock);
+	desc_count = src_pool->avail_desc;
+	cdf_spin_unlock_bh(&src_pool->flow_pool_lock);
+
+	/*
+	 * deficient_desc is only lowered here, under flow_pool_list_lock,
+	 * so reserving the move count up front can not over-fill a pool and
+	 * the descriptors never have to be handed back to the source.
+	 */
 	cdf_spin_lock_bh(&pdev->tx_desc.flow_pool_list_lock);
 	TAILQ_FOREACH(dst_pool, &pdev->tx_desc.flow_pool_list,
 					 flow_pool_list_elem) {
+		if (desc_count == 0)
+			break;
+		if (dst_pool == src_pool)
+			continue;
+
 		cdf_spin_lock_bh(&dst_pool->flow_pool_lock);
-		if (dst_pool->deficient_desc) {
-			desc_move_count =
-				(dst_pool->deficient_desc > desc_count) ?
+		desc_move_count = (dst_pool->deficient_desc > desc_count) ?
 					desc_count : dst_pool->deficient_desc;
-			cdf_spin_unlock_bh(&dst_pool->flow_pool_lock);
-			desc_move_count = ol_tx_move_desc_n(src_pool,
-						dst_pool, desc_move_count);
-			desc_count -= desc_move_count;
-			cdf_spin_lock_bh(&dst_pool->flow_pool_lock);
-		}
+		dst_pool->deficient_desc -= desc_move_count;
 		cdf_spin_unlock_bh(&dst_pool->flow_pool_lock);
-		if (desc_count == 0)
+		if (!desc_move_count)
+			continue;
+
+		moved = ol_tx_move_desc_n(src_pool, dst_pool, desc_move_count);
+		if (moved < desc_move_count) {
+			/* source ran dry; give back the unused reservation */
+			cdf_spin_lock_bh(&dst_pool->flow_pool_lock);
+			dst_pool->deficient_desc += desc_move_count - moved;
+			cdf_spin_unlock_bh(&dst_pool->flow_pool_lock);
 			break;
+		}
+		desc_count -= moved;
 	}
 	cdf_spin_unlock_bh(&pdev->tx_desc.flow_pool_list_lock);
 
@@ -372,10 +393,12 @@ struct ol_tx_flow_pool_t *ol_tx_create_flow_pool(uint8_t flow_pool_id,
 	pool->avail_desc = size;
 	pool->deficient_desc = pool->flow_pool_size - pool->avail_desc;
 
-	/* Add flow_pool to flow_pool_list */
+	/* Add flow_pool to flow_pool_list and the flow_pool_id table */
 	cdf_spin_lock_bh(&pdev->tx_desc.flow_pool_list_lock);
 	TAILQ_INSERT_TAIL(&pdev->tx_desc.flow_pool_list, pool,
 			 flow_pool_list_elem);
+	if (flow_pool_id != INVALID_FLOW_ID)
+		pdev->tx_desc.flow_pool_tbl[flow_pool_id] = pool;
 	cdf_spin_unlock_bh(&pdev->tx_desc.flow_pool_list_lock);
 
 	return pool;
@@ -405,6 +428,9 @@ int ol_tx_delete_flow_pool(struct ol_tx_flow_pool_t *pool)
 
 	cdf_spin_lock_bh(&pdev->tx_desc.flow_pool_list_lock);
 	TAILQ_REMOVE(&pdev->tx_desc.flow_pool_list, pool, flow_pool_list_elem);
+	if (pool->flow_pool_id != INVALID_FLOW_ID &&
+	    pdev->tx_desc.flow_pool_tbl[pool->flow_pool_id] == pool)
+		pdev->tx_desc.flow_pool_tbl[pool->flow_pool_id] = NULL;
 	cdf_spin_unlock_bh(&pdev->tx_desc.flow_pool_list_lock);
 
 	cdf_spin_lock_bh(&pool->flow_pool_lock);
@@ -485,32 +511,24 @@ int ol_tx_free_invalid_flow_pool(struct ol_tx_flow_pool_t *pool)
  * ol_tx_get_flow_pool() - get flow_pool from flow_pool_id
  * @flow_pool_id: flow pool id
  *
+ * Looks the pool up in the flow_pool_id table rather than walking
+ * flow_pool_list, so no per-pool lock is needed.
+ *
  * Return: flow_pool ptr / NULL if not found
  */
 struct ol_tx_flow_pool_t *ol_tx_get_flow_pool(uint8_t flow_pool_id)
 {
 	struct ol_txrx_pdev_t *pdev = cds_get_context(CDF_MODULE_ID_TXRX);
-	struct ol_tx_flow_pool_t *pool = NULL;
-	bool is_found = false;
+	struct ol_tx_flow_pool_t *pool;
+
+	if (flow_pool_id == INVALID_FLOW_ID)
+		return NULL;
 
 	cdf_spin_lock_bh(&pdev->tx_desc.flow_pool_list_lock);
-	TAILQ_FOREACH(pool, &pdev->tx_desc.flow_pool_list,
-					 flow_pool_list_elem) {
-		cdf_spin_lock_bh(&pool->flow_pool_lock);
-		if (pool->flow_pool_id == flow_pool_id) {
-			cdf_spin_unlock_bh(&pool->flow_pool_lock);
-			is_found = true;
-			break;
-		}
-		cdf_spin_unlock_bh(&pool->flow_pool_lock);
-	}
+	pool = pdev->tx_desc.flow_pool_tbl[flow_pool_id];
 	cdf_spin_unlock_bh(&pdev->tx_desc.flow_pool_list_lock);
 
-	if (is_found == false)
-		pool = NULL;
-
 	return pool;
-
 }
 
 
@@ -31,6 +31,7 @@
 #include <cdf_util.h>               /* cdf_assert */
 #include <cdf_nbuf.h>               /* cdf_nbuf_t */
 #include <cdf_memory.h>             /* cdf_mem_set */
+#include <cdf_time.h>               /* cdf_system_ticks */
 #include <cds_ieee80211_common.h>   /* ieee80211_frame */
 #include <ol_htt_rx_api.h>          /* htt_rx_msdu_desc_completes_mpdu, etc. */
 
@@ -295,6 +296,21 @@ ol_rx_mpdu_list_next(struct ol_txrx_pdev_t *pdev,
 	} while (0)
 
 
+#if defined(FEATURE_TSO)
+#define TXRX_STATS_TSO_PERF_UPDATE(_pdev, _netbuf, _cycles)		\
+	do {								\
+		struct ol_txrx_stats_tso_perf *_perf =			\
+			&(_pdev)->stats.pub.tx.tso.perf;		\
+		_perf->last_ticks = cdf_system_ticks();			\
+		if (!_perf->bytes)					\
+			_perf->first_ticks = _perf->last_ticks;		\
+		_perf->bytes += cdf_nbuf_len(_netbuf);			\
+		_perf->prep_cycles += (_cycles);			\
+	} while (0)
+#else
+#define TXRX_STATS_TSO_PERF_UPDATE(_pdev, _netbuf, _cycles) /* no-op */
+#endif
+
 /*--- txrx sequence number trace macros ---*/
 
 #define TXRX_SEQ_NUM_ERR(_status) (0xffff - _status)
@@ -658,6 +674,18 @@ NOT_IP_TCP:
 #define OL_TXRX_PEER_STATS_MUTEX_DESTROY(peer)  /* no-op */
 #endif
 
+/*
+ * Per-CPU data frame counters for control-path heuristics (e.g. TDLS).
+ * Both the rx softirq and the OS shim's xmit handler run with bottom halves
+ * disabled, so the current CPU's entry can be updated without locks or
+ * atomics.
+ */
+#define OL_TXRX_PEER_PKT_CNT_ADD(peer, dir, n) \
+	do { \
+		if (cdf_likely((peer)->pkt_cnt)) \
+			(peer)->pkt_cnt[cdf_get_cpu()].dir += (n); \
+	} while (0)
+
 #ifndef DEBUG_HTT_CREDIT
 #define DEBUG_HTT_CREDIT 0
 #endif
@@ -141,6 +141,10 @@ struct ol_tx_desc_t {
 
 #ifdef QCA_COMPUTE_TX_DELAY
 	uint32_t entry_timestamp_ticks;
+#endif
+#ifdef QCA_TX_PEER_LATENCY
+	/* enqueue time (cdf_system_time_us) for latency stats */
+	uint32_t lat_enqueue_us;
 #endif
 	/*
 	 * Allow tx descriptors to be stored in (doubly-linked) lists.
@@ -306,6 +310,34 @@ struct ol_tx_delay_data {
 
 #endif /* QCA_COMPUTE_TX_DELAY */
 
+/*
+ * Per-CPU data frame counters of a peer. They only ever grow; consumers
+ * keep their own baseline to count frames over an interval.
+ */
+struct ol_txrx_peer_pkt_cnt {
+	uint32_t tx;
+	uint32_t rx;
+};
+
+#ifdef QCA_TX_PEER_LATENCY
+struct ol_tx_lat_tid {
+	uint32_t count;
+	uint32_t dropped;
+	uint64_t sum_us;
+	uint32_t max_us;
+	uint32_t bins[OL_TXRX_TX_LAT_NUM_BINS];
+};
+
+/*
+ * Tx latency counters of one local peer id on one CPU. Only the owning CPU
+ * writes to its slot, from the tx completion softirq, so no locking or
+ * atomics are needed; readers fold all the slots together.
+ */
+struct ol_tx_lat_cpu {
+	struct ol_tx_lat_tid tid[OL_TXRX_TX_LAT_NUM_TIDS];
+};
+#endif /* QCA_TX_PEER_LATENCY */
+
 /* Thermal Mitigation */
 
 enum throttle_level {
@@ -360,6 +392,9 @@ struct ol_txrx_pool_stats {
 	uint16_t pkt_drop_no_desc;
 };
 
+/* one slot per possible flow_pool_id */
+#define OL_TX_FLOW_POOL_TBL_SIZE 256
+
 /**
  * struct ol_tx_flow_pool_t - flow_pool info
  * @flow_pool_list_elem: flow_pool_list element
@@ -563,6 +598,8 @@ struct ol_txrx_pdev_t {
 		uint8_t num_invalid_bin;
 		cdf_spinlock_t flow_pool_list_lock;
 		TAILQ_HEAD(flow_pool_list_t, ol_tx_flow_pool_t) flow_pool_list;
+		/* flow_pool_id -> pool, under flow_pool_list_lock */
+		struct ol_tx_flow_pool_t *flow_pool_tbl[OL_TX_FLOW_POOL_TBL_SIZE];
 #endif
 		uint32_t page_size;
 		uint16_t desc_reserved_size;
@@ -727,6 +764,15 @@ struct ol_txrx_pdev_t {
 
 #endif /* QCA_COMPUTE_TX_DELAY */
 
+#ifdef QCA_TX_PEER_LATENCY
+	/*
+	 * per-CPU tx latency counters of each local peer id, cdf_get_num_cpus()
+	 * entries each. They live as long as the pdev, so the tx completion
+	 * path can update them without resolving or referencing the peer.
+	 */
+	struct ol_tx_lat_cpu *tx_lat[OL_TXRX_NUM_LOCAL_PEER_IDS];
+#endif
+
 	struct {
 		cdf_spinlock_t mutex;
 		/* timer used to monitor the throttle "on" phase and
@@ -844,6 +890,27 @@ struct ol_txrx_vdev_t {
 		uint32_t q_overflow_cnt;
 	} ll_pause;
 	bool disable_intrabss_fwd;
+
+	/* intra-BSS forwarding */
+	struct {
+		/* forwarded frames the tx path had no room for */
+		struct {
+			cdf_nbuf_t head;
+			cdf_nbuf_t tail;
+			int depth;
+		} deferred;
+		/* retries the deferred frames when no new batch comes */
+		cdf_softirq_timer_t timer;
+		bool is_timer_on;
+		cdf_spinlock_t mutex;
+		struct {
+			uint32_t batches;   /* lists handed to the tx path */
+			uint32_t msdus;     /* frames in those lists */
+			uint32_t max_batch; /* largest list */
+			uint32_t deferred;  /* frames rejected and deferred */
+			uint32_t dropped;   /* frames dropped, deferral full */
+		} stats;
+	} fwd;
 	cdf_atomic_t os_q_paused;
 	uint16_t tx_fl_lwm;
 	uint16_t tx_fl_hwm;
@@ -890,6 +957,8 @@ struct ol_rx_reorder_t {
 	struct ol_rx_reorder_array_elem_t *array;
 	/* base - single rx reorder element used for non-aggr cases */
 	struct ol_rx_reorder_array_elem_t base;
+	/* occupancy - bit n is set while array[n].head is non-NULL */
+	uint64_t occupancy;
 #if defined(QCA_SUPPORT_OL_RX_REORDER_TIMEOUT)
 	struct ol_rx_reorder_timeout_list_elem_t timeout;
 #endif
@@ -974,6 +1043,11 @@ struct ol_txrx_peer_t {
 #ifdef QCA_ENABLE_OL_TXRX_PEER_STATS
 	ol_txrx_peer_stats_t stats;
 #endif
+	/*
+	 * per-CPU data frame counters for control-path heuristics (e.g. TDLS),
+	 * cdf_get_num_cpus() entries
+	 */
+	struct ol_txrx_peer_pkt_cnt *pkt_cnt;
 	int16_t rssi_dbm;
 
 	/* NAWDS Flag and Bss Peer bit */
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2015 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Userspace microbenchmark for the rx reorder array release path.
+ *
+ * Compares the linear slot walk that ol_rx_reorder_release/flush used to
+ * do against the occupancy bitmap scan of ol_rx_reorder_collect, over a
+ * number of peer-TIDs with 64-MPDU block ack windows, for three arrival
+ * patterns:
+ *   in-order  - every MPDU of the window arrives, in sequence
+ *   lossy     - a share of MPDUs never arrive; the window is flushed
+ *   reordered - every MPDU arrives, in a random order; each arrival
+ *               releases the in-order run following the first hole
+ * Both engines must hand over the same MPDU sequence; the run aborts if
+ * they do not.
+ *
+ * Build from the top of the driver tree:
+ *   cc -O2 -o ol_rx_reorder_bench -Icore/dp/txrx \
+ *      core/dp/txrx/tools/ol_rx_reorder_bench.c
+ *
+ * Usage: ol_rx_reorder_bench [num_peer_tids [windows_per_peer_tid]]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ol_rx_reorder_bitmap.h"
+
+#define BENCH_WIN_SZ            64
+#define BENCH_WIN_SZ_MASK       (BENCH_WIN_SZ - 1)
+#define BENCH_LOSS_PCT          10
+#define BENCH_DEF_PEER_TIDS     256
+#define BENCH_DEF_WINDOWS       200
+
+struct bench_msdu {
+	struct bench_msdu *next;
+	unsigned seq;
+};
+
+struct bench_elem {
+	struct bench_msdu *head;
+	struct bench_msdu *tail;
+};
+
+struct bench_reorder {
+	struct bench_elem array[BENCH_WIN_SZ];
+	uint64_t occupancy;
+};
+
+enum bench_engine {
+	BENCH_LINEAR,
+	BENCH_BITMAP,
+};
+
+static unsigned long long bench_released;
+static unsigned long long bench_checksum;
+
+static void bench_deliver(struct bench_msdu *head)
+{
+	for (; head; head = head->next) {
+		bench_released++;
+		bench_checksum = bench_checksum * 31 + head->seq;
+	}
+}
+
+static void bench_store(struct bench_reorder *r, struct bench_msdu *msdu)
+{
+	unsigned idx = msdu->seq & BENCH_WIN_SZ_MASK;
+
+	msdu->next = NULL;
+	r->array[idx].head = msdu;
+	r->array[idx].tail = msdu;
+	r->occupancy |= 1ULL << idx;
+}
+
+/* The walk ol_rx_reorder_flush did before the occupancy bitmap */
+static struct bench_msdu *
+bench_collect_linear(struct bench_reorder *r, unsigned idx_start,
+		     unsigned idx_end)
+{
+	struct bench_msdu *head = NULL, *tail = NULL;
+	struct bench_elem *elem;
+
+	do {
+		elem = &r->array[idx_start];
+		idx_start = (idx_start + 1) & BENCH_WIN_SZ_MASK;
+		if (elem->head) {
+			if (tail)
+				tail->next = elem->head;
+			else
+				head = elem->head;
+			tail = elem->tail;
+			elem->head = elem->tail = NULL;
+		}
+	} while (idx_start != idx_end);
+	if (tail)
+		tail->next = NULL;
+	return head;
+}
+
+/* Same scan as ol_rx_reorder_collect */
+static struct bench_msdu *
+bench_collect_bitmap(struct bench_reorder *r, unsigned idx_start,
+		     unsigned idx_end)
+{
+	struct bench_msdu *head = NULL, *tail = NULL;
+	struct bench_elem *elem;
+	uint64_t pending;
+	unsigned len;
+
+	len = (idx_end - idx_start) & BENCH_WIN_SZ_MASK;
+	if (len == 0)
+		len = BENCH_WIN_SZ;
+	pending = ol_rx_reorder_bitmap_rotate(r->occupancy, idx_start,
+					      BENCH_WIN_SZ_MASK) &
+		  ol_rx_reorder_bitmap_len_mask(len);
+	while (pending) {
+		unsigned off, run, idx;
+
+		off = __builtin_ctzll(pending);
+		run = ol_rx_reorder_bitmap_run_len(pending >> off);
+		idx = (idx_start + off) & BENCH_WIN_SZ_MASK;
+		r->occupancy &= ~ol_rx_reorder_bitmap_range(idx, run,
+							    BENCH_WIN_SZ_MASK);
+		pending &= ~(ol_rx_reorder_bitmap_len_mask(run) << off);
+		while (run--) {
+			elem = &r->array[idx];
+			if (tail)
+				tail->next = elem->head;
+			else
+				head = elem->head;
+			tail = elem->tail;
+			elem->head = elem->tail = NULL;
+			idx = (idx + 1) & BENCH_WIN_SZ_MASK;
+		}
+	}
+	if (tail)
+		tail->next = NULL;
+	return head;
+}
+
+/* The walk ol_rx_reorder_first_hole did before the occupancy bitmap */
+static unsigned bench_first_hole_linear(struct bench_reorder *r,
+					unsigned idx_start)
+{
+	unsigned idx = (idx_start + 1) & BENCH_WIN_SZ_MASK;
+
+	while (idx != idx_start && !r->array[idx].head)
+		idx = (idx + 1) & BENCH_WIN_SZ_MASK;
+	while (idx != idx_start && r->array[idx].head)
+		idx = (idx + 1) & BENCH_WIN_SZ_MASK;
+	return idx;
+}
+
+static unsigned bench_first_hole_bitmap(struct bench_reorder *r,
+					unsigned idx_start)
+{
+	uint64_t rot = ol_rx_reorder_bitmap_rotate(r->occupancy, idx_start,
+						   BENCH_WIN_SZ_MASK);
+
+	return (idx_start +
+		ol_rx_reorder_bitmap_first_hole_end(rot, BENCH_WIN_SZ_MASK)) &
+	       BENCH_WIN_SZ_MASK;
+}
+
+static struct bench_msdu *
+bench_collect(enum bench_engine engine, struct bench_reorder *r,
+	      unsigned idx_start, unsigned idx_end)
+{
+	if (engine == BENCH_LINEAR)
+		return bench_collect_linear(r, idx_start, idx_end);
+	return bench_collect_bitmap(r, idx_start, idx_end);
+}
+
+static unsigned
+bench_first_hole(enum bench_engine engine, struct bench_reorder *r,
+		 unsigned idx_start)
+{
+	if (engine == BENCH_LINEAR)
+		return bench_first_hole_linear(r, idx_start);
+	return bench_first_hole_bitmap(r, idx_start);
+}
+
+enum bench_pattern {
+	BENCH_IN_ORDER,
+	BENCH_LOSSY,
+	BENCH_REORDERED,
+	BENCH_NUM_PATTERNS,
+};
+
+static const char * const bench_pattern_name[BENCH_NUM_PATTERNS] = {
+	"in-order", "lossy", "reordered",
+};
+
+/* Arrival order of the MPDUs of each window, per pattern */
+static unsigned bench_order[BENCH_WIN_SZ];
+static unsigned bench_order_len;
+
+static void bench_make_order(enum bench_pattern pattern, unsigned *seed)
+{
+	unsigned i, j, tmp;
+
+	bench_order_len = 0;
+	for (i = 0; i < BENCH_WIN_SZ; i++) {
+		if (pattern == BENCH_LOSSY &&
+		    (unsigned)rand_r(seed) % 100 < BENCH_LOSS_PCT)
+			continue;
+		bench_order[bench_order_len++] = i;
+	}
+	if (pattern != BENCH_REORDERED)
+		return;
+	for (i = bench_order_len - 1; i > 0; i--) {
+		j = (unsigned)rand_r(seed) % (i + 1);
+		tmp = bench_order[i];
+		bench_order[i] = bench_order[j];
+		bench_order[j] = tmp;
+	}
+}
+
+static double bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double bench_run(enum bench_engine engine, enum bench_pattern pattern,
+			struct bench_reorder *reorder, struct bench_msdu *msdus,
+			unsigned num_peer_tids, unsigned windows)
+{
+	unsigned seed = 1, w, p, i, start, end;
+	struct bench_reorder *r;
+	struct bench_msdu *msdu;
+	double t0, elapsed = 0;
+
+	for (w = 0; w < windows; w++) {
+		bench_make_order(pattern, &seed);
+		t0 = bench_now_ns();
+		for (p = 0; p < num_peer_tids; p++) {
+			r = &reorder[p];
+			start = (w * BENCH_WIN_SZ) & BENCH_WIN_SZ_MASK;
+			for (i = 0; i < bench_order_len; i++) {
+				msdu = &msdus[p * BENCH_WIN_SZ + i];
+				msdu->seq = w * BENCH_WIN_SZ + bench_order[i];
+				bench_store(r, msdu);
+				if (pattern != BENCH_REORDERED ||
+				    !r->array[start].head)
+					continue;
+				/*
+				 * The window start has arrived: release it and
+				 * the present MPDUs that follow it.  The slot
+				 * before the start is empty, so it serves as
+				 * the initial hole of the first hole search.
+				 */
+				end = bench_first_hole(engine, r,
+						       (start - 1) &
+						       BENCH_WIN_SZ_MASK);
+				bench_deliver(bench_collect(engine, r, start,
+							    end));
+				start = end;
+			}
+			/* flush whatever is left of the window */
+			bench_deliver(bench_collect(engine, r, start, start));
+		}
+		elapsed += bench_now_ns() - t0;
+	}
+	return elapsed;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned num_peer_tids = BENCH_DEF_PEER_TIDS;
+	unsigned windows = BENCH_DEF_WINDOWS;
+	struct bench_reorder *reorder;
+	struct bench_msdu *msdus;
+	unsigned long long sum[2], cnt[2];
+	double ns[2];
+	int pattern, engine;
+
+	if (argc > 1)
+		num_peer_tids = strtoul(argv[1], NULL, 0);
+	if (argc > 2)
+		windows = strtoul(argv[2], NULL, 0);
+	if (!num_peer_tids || !windows) {
+		fprintf(stderr, "usage: %s [num_peer_tids [windows]]\n",
+			argv[0]);
+		return 1;
+	}
+
+	reorder = calloc(num_peer_tids, sizeof(*reorder));
+	msdus = calloc((size_t)num_peer_tids * BENCH_WIN_SZ, sizeof(*msdus));
+	if (!reorder || !msdus) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	printf("%u peer-TIDs, %u windows of %u MPDUs each\n",
+	       num_peer_tids, windows, BENCH_WIN_SZ);
+	printf("%-10s %12s %12s %9s\n",
+	       "pattern", "linear ns", "bitmap ns", "speedup");
+	for (pattern = 0; pattern < BENCH_NUM_PATTERNS; pattern++) {
+		for (engine = BENCH_LINEAR; engine <= BENCH_BITMAP; engine++) {
+			memset(reorder, 0, num_peer_tids * sizeof(*reorder));
+			bench_released = 0;
+			bench_checksum = 0;
+			ns[engine] = bench_run(engine, pattern, reorder, msdus,
+					       num_peer_tids, windows);
+			sum[engine] = bench_checksum;
+			cnt[engine] = bench_released;
+		}
+		if (sum[BENCH_LINEAR] != sum[BENCH_BITMAP] ||
+		    cnt[BENCH_LINEAR] != cnt[BENCH_BITMAP]) {
+			fprintf(stderr, "%s: release sequence mismatch\n",
+				bench_pattern_name[pattern]);
+			return 1;
+		}
+		printf("%-10s %12.1f %12.1f %8.2fx\n",
+		       bench_pattern_name[pattern],
+		       ns[BENCH_LINEAR] / cnt[BENCH_LINEAR],
+		       ns[BENCH_BITMAP] / cnt[BENCH_BITMAP],
+		       ns[BENCH_LINEAR] / ns[BENCH_BITMAP]);
+	}
+
+	free(msdus);
+	free(reorder);
+	return 0;
+}
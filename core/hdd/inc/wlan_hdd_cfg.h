@@ -1873,6 +1873,16 @@ typedef enum {
 #define CFG_IPA_LOW_BANDWIDTH_MBPS_MAX           (100)
 #define CFG_IPA_LOW_BANDWIDTH_MBPS_DEFAULT       (100)
 
+/*
+ * Maximum number of IPA exception packets delivered to the network stack
+ * per interface in one poll of the exception rx work. 0 delivers every
+ * exception packet directly from the IPA callback.
+ */
+#define CFG_IPA_EXCEP_BATCH_SIZE                 "gIPAExcepBatchSize"
+#define CFG_IPA_EXCEP_BATCH_SIZE_MIN             (0)
+#define CFG_IPA_EXCEP_BATCH_SIZE_MAX             (64)
+#define CFG_IPA_EXCEP_BATCH_SIZE_DEFAULT         (16)
+
 /*
  * Firmware uart print
  */
@@ -2192,6 +2202,26 @@ typedef enum {
 #define CFG_BUS_BANDWIDTH_COMPUTE_INTERVAL_MIN     (0)
 #define CFG_BUS_BANDWIDTH_COMPUTE_INTERVAL_MAX     (10000)
 
+/*
+ * gBusBandwidthHysteresisPct - percentage below the threshold of the current
+ * bus bandwidth level that the predicted load must fall before the vote may
+ * be lowered. Avoids oscillation when traffic sits around a threshold.
+ */
+#define CFG_BUS_BANDWIDTH_HYSTERESIS_PCT           "gBusBandwidthHysteresisPct"
+#define CFG_BUS_BANDWIDTH_HYSTERESIS_PCT_DEFAULT   (10)
+#define CFG_BUS_BANDWIDTH_HYSTERESIS_PCT_MIN       (0)
+#define CFG_BUS_BANDWIDTH_HYSTERESIS_PCT_MAX       (90)
+
+/*
+ * gBusBandwidthDownHoldCount - number of consecutive compute intervals the
+ * predicted load must stay below the hysteresis band before the bus
+ * bandwidth vote is lowered. Raising the vote is never delayed.
+ */
+#define CFG_BUS_BANDWIDTH_DOWN_HOLD_COUNT          "gBusBandwidthDownHoldCount"
+#define CFG_BUS_BANDWIDTH_DOWN_HOLD_COUNT_DEFAULT  (3)
+#define CFG_BUS_BANDWIDTH_DOWN_HOLD_COUNT_MIN      (0)
+#define CFG_BUS_BANDWIDTH_DOWN_HOLD_COUNT_MAX      (100)
+
 #define CFG_TCP_DELACK_THRESHOLD_HIGH              "gTcpDelAckThresholdHigh"
 #define CFG_TCP_DELACK_THRESHOLD_HIGH_DEFAULT      (500)
 #define CFG_TCP_DELACK_THRESHOLD_HIGH_MIN          (0)
@@ -2776,6 +2806,17 @@ enum dot11p_mode {
 #define CFG_FIRST_SCAN_BUCKET_THRESHOLD_MAX       (-30)
 #define CFG_FIRST_SCAN_BUCKET_THRESHOLD_DEFAULT   (-30)
 
+/*
+ * RSSI and station statistics younger than this many milliseconds are
+ * returned to get_station/ioctl readers without querying the firmware
+ * again; concurrent readers share a single firmware query. 0 disables
+ * the cache.
+ */
+#define CFG_STATS_CACHE_TIME_NAME                 "gStatsCacheTimeMs"
+#define CFG_STATS_CACHE_TIME_MIN                  (0)
+#define CFG_STATS_CACHE_TIME_MAX                  (10000)
+#define CFG_STATS_CACHE_TIME_DEFAULT              (100)
+
 /*---------------------------------------------------------------------------
    Type declarations
    -------------------------------------------------------------------------*/
@@ -3162,6 +3203,7 @@ struct hdd_config {
 	uint32_t IpaHighBandwidthMbps;
 	uint32_t IpaMediumBandwidthMbps;
 	uint32_t IpaLowBandwidthMbps;
+	uint32_t IpaExcepBatchSize;
 #ifdef FEATURE_WLAN_MCC_TO_SCC_SWITCH
 	uint32_t WlanMccToSccSwitchMode;
 #endif
@@ -3225,6 +3267,8 @@ struct hdd_config {
 	uint32_t busBandwidthMediumThreshold;
 	uint32_t busBandwidthLowThreshold;
 	uint32_t busBandwidthComputeInterval;
+	uint32_t bus_bw_hysteresis_pct;
+	uint32_t bus_bw_down_hold_count;
 	uint32_t tcpDelackThresholdHigh;
 	uint32_t tcpDelackThresholdLow;
 	uint32_t tcp_tx_high_tput_thres;
@@ -3355,6 +3399,7 @@ struct hdd_config {
 	int8_t early_stop_scan_min_threshold;
 	int8_t early_stop_scan_max_threshold;
 	int8_t first_scan_bucket_threshold;
+	uint32_t stats_cache_time;
 };
 
 #define VAR_OFFSET(_Struct, _Var) (offsetof(_Struct, _Var))
@@ -45,6 +45,7 @@ void wlan_hdd_two_connections_scenario(hdd_context_t *hdd_ctx,
 void wlan_hdd_three_connections_scenario(hdd_context_t *hdd_ctx,
 	uint8_t first_chnl, uint8_t second_chnl,
 	enum cds_chain_mode chain_mask, uint8_t use_same_mac);
+void wlan_hdd_conc_decision_benchmark(hdd_context_t *hdd_ctx);
 #else
 static inline void clean_report(hdd_context_t *hdd_ctx)
 {
@@ -75,5 +76,9 @@ static inline void wlan_hdd_three_connections_scenario(hdd_context_t *hdd_ctx,
 		enum hdd_chain_mode chain_mask, uint8_t use_same_mac)
 {
 }
+
+static inline void wlan_hdd_conc_decision_benchmark(hdd_context_t *hdd_ctx)
+{
+}
 #endif
 #endif
@@ -50,6 +50,7 @@
 #include <wlan_hdd_wmm.h>
 #include <wlan_hdd_cfg.h>
 #include <linux/spinlock.h>
+#include <linux/pm_qos.h>
 #if defined(WLAN_OPEN_SOURCE) && defined(CONFIG_HAS_WAKELOCK)
 #include <linux/wakelock.h>
 #endif
@@ -320,6 +321,9 @@ extern spinlock_t hdd_context_lock;
  * @interval_tx:	# of tx packets received in the last 100ms interval
  * @total_rx:		# of total rx packets received on interface
  * @total_tx:		# of total tx packets received on interface
+ * @predicted_load:	load used for the bus bandwidth vote, in packets;
+ *			the larger of the packet count and the byte count
+ *			in MTU sized units, smoothed by the governor
  * @next_vote_level:	cnss_bus_width_type voting level (high or low)
  *			determined on the basis of total tx and rx packets
  *			received in the last 100ms interval
@@ -338,6 +342,7 @@ struct hdd_tx_rx_histogram {
 	uint64_t interval_tx;
 	uint64_t total_rx;
 	uint64_t total_tx;
+	uint64_t predicted_load;
 	uint32_t next_vote_level;
 	uint32_t next_rx_level;
 	uint32_t next_tx_level;
@@ -924,6 +929,16 @@ struct hdd_adapter_s {
 
 	uint8_t snr;
 
+	/*
+	 * Serializes firmware stats queries so concurrent readers share one;
+	 * the *_updated fields hold the jiffies at which rssi, ClassA_stat
+	 * and summary_stat were last refreshed by the firmware (0: never).
+	 */
+	struct mutex stats_req_lock;
+	unsigned long rssi_updated;
+	unsigned long class_a_updated;
+	unsigned long summary_updated;
+
 	struct work_struct monTxWorkQueue;
 	struct sk_buff *skb_to_tx;
 
@@ -964,6 +979,8 @@ struct hdd_adapter_s {
 #ifdef MSM_PLATFORM
 	unsigned long prev_rx_packets;
 	unsigned long prev_tx_packets;
+	unsigned long prev_rx_bytes;
+	unsigned long prev_tx_bytes;
 	int connection;
 #endif
 	bool is_roc_inprogress;
@@ -978,6 +995,8 @@ struct hdd_adapter_s {
 
 	/* DSCP to UP QoS Mapping */
 	sme_QosWmmUpType hddWmmDscpToUpMap[WLAN_HDD_MAX_DSCP + 1];
+	/* DSCP to packed UP/queue index, derived from hddWmmDscpToUpMap */
+	uint8_t hdd_wmm_dscp_class[WLAN_HDD_MAX_DSCP + 1];
 
 #ifdef WLAN_FEATURE_LINK_LAYER_STATS
 	bool isLinkLayerStatsSet;
@@ -1221,6 +1240,10 @@ struct hdd_context_s {
 	uint64_t prev_rx;
 	int cur_tx_level;
 	uint64_t prev_tx;
+	/* bus bandwidth governor state, see hdd_bus_bw_predict() */
+	uint64_t bus_bw_load;
+	uint32_t bus_bw_down_cnt;
+	struct pm_qos_request bus_bw_pm_qos;
 #endif
 	/* VHT80 allowed */
 	bool isVHT80Allowed;
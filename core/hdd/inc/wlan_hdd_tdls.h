@@ -318,8 +318,8 @@ typedef struct {
  * @is_responder: is responder
  * @discovery_processed: discovery processed flag
  * @discovery_attempt: discovery attempt
- * @tx_pkt: tx packet
- * @rx_pkt: rx packet
+ * @tx_pkt_base: txrx tx frame count at the last reset
+ * @rx_pkt_base: txrx rx frame count at the last reset
  * @uapsdQueues: uapsd queues
  * @maxSp: max sp
  * @isBufSta: is buffer sta
@@ -347,8 +347,8 @@ typedef struct _hddTdlsPeer_t {
 	uint8_t is_responder;
 	uint8_t discovery_processed;
 	uint16_t discovery_attempt;
-	uint16_t tx_pkt;
-	uint16_t rx_pkt;
+	uint32_t tx_pkt_base;
+	uint32_t rx_pkt_base;
 	uint8_t uapsdQueues;
 	uint8_t maxSp;
 	uint8_t isBufSta;
@@ -419,8 +419,8 @@ void wlan_hdd_tdls_extract_da(struct sk_buff *skb, uint8_t *mac);
 
 void wlan_hdd_tdls_extract_sa(struct sk_buff *skb, uint8_t *mac);
 
-int wlan_hdd_tdls_increment_pkt_count(hdd_adapter_t *pAdapter,
-				      const uint8_t *mac, uint8_t tx);
+int wlan_hdd_tdls_get_pkt_count(hddTdlsPeer_t *curr_peer,
+				uint32_t *tx_pkt, uint32_t *rx_pkt);
 
 int wlan_hdd_tdls_set_sta_id(hdd_adapter_t *pAdapter, const uint8_t *mac,
 			     uint8_t staId);
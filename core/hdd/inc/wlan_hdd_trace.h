@@ -108,7 +108,8 @@
 	ENUM(TRACE_CODE_HDD_CFG80211_SUSPEND_WLAN) \
 	ENUM(TRACE_CODE_HDD_CFG80211_SET_MAC_ACL) \
 	ENUM(TRACE_CODE_HDD_CFG80211_TESTMODE) \
-	ENUM(TRACE_CODE_HDD_CFG80211_DUMP_SURVEY)
+	ENUM(TRACE_CODE_HDD_CFG80211_DUMP_SURVEY) \
+	ENUM(TRACE_CODE_HDD_BUS_BW_VOTE)
 
 enum {
 #undef ENUM
@@ -71,6 +71,7 @@
 #define HDD_ETH_HEADER_LEN     14
 
 int hdd_hard_start_xmit(struct sk_buff *skb, struct net_device *dev);
+uint8_t hdd_tx_classify_pkt(struct sk_buff *skb);
 void hdd_tx_timeout(struct net_device *dev);
 CDF_STATUS hdd_init_tx_rx(hdd_adapter_t *pAdapter);
 CDF_STATUS hdd_deinit_tx_rx(hdd_adapter_t *pAdapter);
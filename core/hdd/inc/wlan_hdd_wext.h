@@ -357,6 +357,8 @@ CDF_STATUS wlan_hdd_get_station_stats(hdd_adapter_t *pAdapter);
 
 CDF_STATUS wlan_hdd_get_rssi(hdd_adapter_t *pAdapter, int8_t *rssi_value);
 
+void hdd_stats_cache_invalidate(hdd_adapter_t *adapter);
+
 CDF_STATUS wlan_hdd_get_snr(hdd_adapter_t *pAdapter, int8_t *snr);
 
 #ifdef FEATURE_WLAN_TDLS
@@ -203,6 +203,12 @@ extern const uint8_t hdd_qdisc_ac_to_tl_ac[];
 extern const uint8_t hdd_wmm_up_to_ac_map[];
 extern const uint8_t hdd_linux_up_to_ac_map[];
 
+/* Packed entries of hdd_adapter_t::hdd_wmm_dscp_class */
+#define HDD_WMM_CLASS_UP_MASK     0x07
+#define HDD_WMM_CLASS_QUEUE_SHIFT 4
+#define HDD_WMM_CLASS_UP(_c)      ((_c) & HDD_WMM_CLASS_UP_MASK)
+#define HDD_WMM_CLASS_QUEUE(_c)   ((_c) >> HDD_WMM_CLASS_QUEUE_SHIFT)
+
 #define WLAN_HDD_MAX_DSCP 0x3f
 
 /**
@@ -227,6 +233,17 @@ int hdd_wmmps_helper(hdd_adapter_t *pAdapter, uint8_t *ptr);
  */
 CDF_STATUS hdd_wmm_init(hdd_adapter_t *pAdapter);
 
+/**
+ * hdd_wmm_update_dscp_class() - rebuild the DSCP classification table
+ * @adapter: adapter whose DSCP to UP map has changed
+ *
+ * Must be called whenever hddWmmDscpToUpMap is modified, e.g. after a
+ * QoS map has been applied.
+ *
+ * Return: None
+ */
+void hdd_wmm_update_dscp_class(hdd_adapter_t *adapter);
+
 /**
  * hdd_wmm_adapter_init() - initialize the WMM configuration of an adapter
  * @pAdapter: [in]  pointer to Adapter context
@@ -808,6 +808,8 @@ static void hdd_send_association_event(struct net_device *dev,
 		spin_lock_bh(&pHddCtx->bus_bw_lock);
 		pAdapter->prev_tx_packets = pAdapter->stats.tx_packets;
 		pAdapter->prev_rx_packets = pAdapter->stats.rx_packets;
+		pAdapter->prev_tx_bytes = pAdapter->stats.tx_bytes;
+		pAdapter->prev_rx_bytes = pAdapter->stats.rx_bytes;
 		spin_unlock_bh(&pHddCtx->bus_bw_lock);
 		hdd_start_bus_bw_compute_timer(pAdapter);
 #endif
@@ -867,6 +869,8 @@ static void hdd_send_association_event(struct net_device *dev,
 		spin_lock_bh(&pHddCtx->bus_bw_lock);
 		pAdapter->prev_tx_packets = 0;
 		pAdapter->prev_rx_packets = 0;
+		pAdapter->prev_tx_bytes = 0;
+		pAdapter->prev_rx_bytes = 0;
 		spin_unlock_bh(&pHddCtx->bus_bw_lock);
 		hdd_stop_bus_bw_compute_timer(pAdapter);
 #endif
@@ -1032,6 +1036,7 @@ static CDF_STATUS hdd_dis_connect_handler(hdd_adapter_t *pAdapter,
 
 	hdd_clear_roam_profile_ie(pAdapter);
 	hdd_wmm_init(pAdapter);
+	hdd_stats_cache_invalidate(pAdapter);
 
 	/* indicate 'disconnect' status to wpa_supplicant... */
 	hdd_send_association_event(dev, pRoamInfo);
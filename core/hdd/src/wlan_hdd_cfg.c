@@ -2626,6 +2626,13 @@ REG_TABLE_ENTRY g_registry_table[] = {
 		     CFG_IPA_LOW_BANDWIDTH_MBPS_DEFAULT,
 		     CFG_IPA_LOW_BANDWIDTH_MBPS_MIN,
 		     CFG_IPA_LOW_BANDWIDTH_MBPS_MAX),
+
+	REG_VARIABLE(CFG_IPA_EXCEP_BATCH_SIZE, WLAN_PARAM_Integer,
+		     struct hdd_config, IpaExcepBatchSize,
+		     VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
+		     CFG_IPA_EXCEP_BATCH_SIZE_DEFAULT,
+		     CFG_IPA_EXCEP_BATCH_SIZE_MIN,
+		     CFG_IPA_EXCEP_BATCH_SIZE_MAX),
 #endif
 
 #ifdef WLAN_FEATURE_11AC
@@ -3023,6 +3030,20 @@ REG_TABLE_ENTRY g_registry_table[] = {
 		     CFG_BUS_BANDWIDTH_COMPUTE_INTERVAL_DEFAULT,
 		     CFG_BUS_BANDWIDTH_COMPUTE_INTERVAL_MIN,
 		     CFG_BUS_BANDWIDTH_COMPUTE_INTERVAL_MAX),
+
+	REG_VARIABLE(CFG_BUS_BANDWIDTH_HYSTERESIS_PCT, WLAN_PARAM_Integer,
+		     struct hdd_config, bus_bw_hysteresis_pct,
+		     VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
+		     CFG_BUS_BANDWIDTH_HYSTERESIS_PCT_DEFAULT,
+		     CFG_BUS_BANDWIDTH_HYSTERESIS_PCT_MIN,
+		     CFG_BUS_BANDWIDTH_HYSTERESIS_PCT_MAX),
+
+	REG_VARIABLE(CFG_BUS_BANDWIDTH_DOWN_HOLD_COUNT, WLAN_PARAM_Integer,
+		     struct hdd_config, bus_bw_down_hold_count,
+		     VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
+		     CFG_BUS_BANDWIDTH_DOWN_HOLD_COUNT_DEFAULT,
+		     CFG_BUS_BANDWIDTH_DOWN_HOLD_COUNT_MIN,
+		     CFG_BUS_BANDWIDTH_DOWN_HOLD_COUNT_MAX),
 	REG_VARIABLE(CFG_TCP_DELACK_THRESHOLD_HIGH, WLAN_PARAM_Integer,
 		     struct hdd_config, tcpDelackThresholdHigh,
 		     VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
@@ -3618,6 +3639,13 @@ REG_TABLE_ENTRY g_registry_table[] = {
 		     CFG_FIRST_SCAN_BUCKET_THRESHOLD_MIN,
 		     CFG_FIRST_SCAN_BUCKET_THRESHOLD_MAX),
 
+	REG_VARIABLE(CFG_STATS_CACHE_TIME_NAME, WLAN_PARAM_Integer,
+		     struct hdd_config, stats_cache_time,
+		     VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
+		     CFG_STATS_CACHE_TIME_DEFAULT,
+		     CFG_STATS_CACHE_TIME_MIN,
+		     CFG_STATS_CACHE_TIME_MAX),
+
 };
 
 
@@ -4954,6 +4982,9 @@ void hdd_cfg_print(hdd_context_t *pHddCtx)
 	CDF_TRACE(CDF_MODULE_ID_HDD, CDF_TRACE_LEVEL_INFO_HIGH,
 		  "Name = [IpaLowBandwidthMbps] Value = [%u] ",
 		  pHddCtx->config->IpaLowBandwidthMbps);
+	CDF_TRACE(CDF_MODULE_ID_HDD, CDF_TRACE_LEVEL_INFO_HIGH,
+		  "Name = [IpaExcepBatchSize] Value = [%u] ",
+		  pHddCtx->config->IpaExcepBatchSize);
 #endif
 	CDF_TRACE(CDF_MODULE_ID_HDD, CDF_TRACE_LEVEL_INFO_HIGH,
 		  "Name = [gEnableOverLapCh] Value = [%u] ",
@@ -4984,6 +5015,14 @@ void hdd_cfg_print(hdd_context_t *pHddCtx)
 	CDF_TRACE(CDF_MODULE_ID_HDD, CDF_TRACE_LEVEL_INFO_HIGH,
 		  "Name = [gbusBandwidthComputeInterval] Value = [%u] ",
 		  pHddCtx->config->busBandwidthComputeInterval);
+	CDF_TRACE(CDF_MODULE_ID_HDD, CDF_TRACE_LEVEL_INFO_HIGH,
+		  "Name = [%s] Value = [%u] ",
+		  CFG_BUS_BANDWIDTH_HYSTERESIS_PCT,
+		  pHddCtx->config->bus_bw_hysteresis_pct);
+	CDF_TRACE(CDF_MODULE_ID_HDD, CDF_TRACE_LEVEL_INFO_HIGH,
+		  "Name = [%s] Value = [%u] ",
+		  CFG_BUS_BANDWIDTH_DOWN_HOLD_COUNT,
+		  pHddCtx->config->bus_bw_down_hold_count);
 	CDF_TRACE(CDF_MODULE_ID_HDD, CDF_TRACE_LEVEL_INFO_HIGH,
 		  "Name = [gTcpDelAckThresholdHigh] Value = [%u] ",
 		  pHddCtx->config->tcpDelackThresholdHigh);
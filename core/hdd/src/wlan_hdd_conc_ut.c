@@ -42,6 +42,8 @@
 #include "wma_types.h"
 #include "wma.h"
 #include "wma_api.h"
+#include "cdf_time.h"
+#include "cdf_util.h"
 
 #define NUMBER_OF_SCENARIO 300
 #define MAX_ALLOWED_CHAR_IN_REPORT 50
@@ -863,3 +865,162 @@ void wlan_hdd_three_connections_scenario(hdd_context_t *hdd_ctx,
 		next_sub_type = CDS_STA_MODE;
 	}
 }
+
+/**
+ * struct conc_bench_t: cycles spent by the decision benchmark
+ *
+ * @calls: number of cds_get_pcl and cds_allow_concurrency calls timed
+ * @pcl_cold: cycles in cds_get_pcl right after a cache invalidation
+ * @pcl_warm: cycles in cds_get_pcl answered from the cache
+ * @allow_cold: cycles in cds_allow_concurrency after a cache invalidation
+ * @allow_warm: cycles in cds_allow_concurrency answered from the cache
+ * @mismatch: number of cached answers differing from computed ones
+ */
+struct conc_bench_t {
+	uint32_t calls;
+	uint64_t pcl_cold;
+	uint64_t pcl_warm;
+	uint64_t allow_cold;
+	uint64_t allow_warm;
+	uint32_t mismatch;
+};
+
+static const uint8_t conc_bench_chnl[] = {1, 6, 11, 36, 52, 100, 149, 165};
+
+static bool wlan_hdd_conc_bench_setup(hdd_context_t *hdd_ctx,
+		uint32_t num, enum cds_con_mode *sub_type, uint8_t *chnl)
+{
+	enum cds_con_mode dummy_type;
+	uint32_t i;
+
+	/* flush the entire table first */
+	if (!CDF_IS_STATUS_SUCCESS(cds_init_policy_mgr(hdd_ctx))) {
+		hdd_err("Policy manager initialization failed");
+		return false;
+	}
+	for (i = 0; i < num; i++) {
+		/* sub_type mapping between HDD and WMA are different */
+		wlan_hdd_map_subtypes_hdd_wma(&dummy_type, &sub_type[i]);
+		cds_incr_connection_count_utfw(hdd_ctx, i, 2, 2, CDS_TWO_TWO,
+			wlan_hdd_valid_type_of_persona(sub_type[i]),
+			dummy_type, chnl[i], 1);
+	}
+	return cds_get_connection_count(hdd_ctx) == num;
+}
+
+static void wlan_hdd_conc_bench_run(hdd_context_t *hdd_ctx,
+		struct conc_bench_t *bench)
+{
+	uint8_t pcl_cold[MAX_NUM_CHAN], pcl_warm[MAX_NUM_CHAN];
+	uint32_t len_cold, len_warm, i;
+	enum cds_con_mode new_type;
+	bool allow_cold, allow_warm;
+	uint64_t start;
+
+	for (new_type = CDS_STA_MODE; new_type < CDS_MAX_NUM_OF_MODE;
+	     new_type++) {
+		len_cold = len_warm = 0;
+		cds_conc_invalidate_cache();
+		start = cdf_get_cycles();
+		cds_get_pcl(hdd_ctx, new_type, pcl_cold, &len_cold);
+		bench->pcl_cold += cdf_get_cycles() - start;
+
+		start = cdf_get_cycles();
+		cds_get_pcl(hdd_ctx, new_type, pcl_warm, &len_warm);
+		bench->pcl_warm += cdf_get_cycles() - start;
+		if (len_cold != len_warm ||
+		    !cdf_mem_compare(pcl_cold, pcl_warm, len_cold))
+			bench->mismatch++;
+
+		for (i = 0; i < ARRAY_SIZE(conc_bench_chnl); i++) {
+			cds_conc_invalidate_cache();
+			start = cdf_get_cycles();
+			allow_cold = cds_allow_concurrency(hdd_ctx, new_type,
+					conc_bench_chnl[i], HW_MODE_20_MHZ);
+			bench->allow_cold += cdf_get_cycles() - start;
+
+			start = cdf_get_cycles();
+			allow_warm = cds_allow_concurrency(hdd_ctx, new_type,
+					conc_bench_chnl[i], HW_MODE_20_MHZ);
+			bench->allow_warm += cdf_get_cycles() - start;
+			if (allow_cold != allow_warm)
+				bench->mismatch++;
+		}
+		bench->calls++;
+	}
+}
+
+/**
+ * wlan_hdd_conc_decision_benchmark() - time the concurrency decisions
+ * @hdd_ctx: HDD context
+ *
+ * Sets up every combination of up to two existing connections over the
+ * modes and the 2.4/5 GHz bands, then times cds_get_pcl and
+ * cds_allow_concurrency for every new connection mode with the decision
+ * cache cold and warm, and checks that both give the same answers.
+ *
+ * Return: None
+ */
+void wlan_hdd_conc_decision_benchmark(hdd_context_t *hdd_ctx)
+{
+	static const uint8_t chnl_one[] = {6, 36, 149};
+	static const uint8_t chnl_pair[][2] = {
+		{6, 11}, {6, 36}, {36, 6}, {36, 149}, {6, 6}, {36, 36} };
+	struct conc_bench_t bench;
+	enum cds_con_mode sub_type[2] = {CDS_STA_MODE, CDS_STA_MODE};
+	uint8_t chnl[2] = {0, 0};
+	uint32_t i, pair, setups = 0;
+
+	cdf_mem_zero(&bench, sizeof(bench));
+
+	if (wlan_hdd_conc_bench_setup(hdd_ctx, 0, sub_type, chnl)) {
+		wlan_hdd_conc_bench_run(hdd_ctx, &bench);
+		setups++;
+	}
+	for (i = 0; i < ARRAY_SIZE(chnl_one); i++) {
+		chnl[0] = chnl_one[i];
+		for (sub_type[0] = CDS_STA_MODE;
+		     sub_type[0] < CDS_MAX_NUM_OF_MODE; sub_type[0]++) {
+			if (!wlan_hdd_conc_bench_setup(hdd_ctx, 1, sub_type,
+						       chnl))
+				continue;
+			wlan_hdd_conc_bench_run(hdd_ctx, &bench);
+			setups++;
+		}
+	}
+	for (pair = 0; pair < ARRAY_SIZE(chnl_pair); pair++) {
+		chnl[0] = chnl_pair[pair][0];
+		chnl[1] = chnl_pair[pair][1];
+		for (sub_type[0] = CDS_STA_MODE;
+		     sub_type[0] < CDS_MAX_NUM_OF_MODE; sub_type[0]++) {
+			for (sub_type[1] = CDS_STA_MODE;
+			     sub_type[1] < CDS_MAX_NUM_OF_MODE;
+			     sub_type[1]++) {
+				if (!wlan_hdd_conc_bench_setup(hdd_ctx, 2,
+							sub_type, chnl))
+					continue;
+				wlan_hdd_conc_bench_run(hdd_ctx, &bench);
+				setups++;
+			}
+		}
+	}
+	/* leave no connections behind */
+	cds_init_policy_mgr(hdd_ctx);
+
+	if (!bench.calls)
+		return;
+	pr_info("+----------Decision benchmark-----------+\n");
+	pr_info("setups %d pcl calls %d allow calls %d mismatches %d\n",
+		setups, bench.calls,
+		bench.calls * (uint32_t)ARRAY_SIZE(conc_bench_chnl),
+		bench.mismatch);
+	pr_info("cds_get_pcl cycles/call cold %llu warm %llu\n",
+		cdf_div_u64(bench.pcl_cold, bench.calls),
+		cdf_div_u64(bench.pcl_warm, bench.calls));
+	pr_info("cds_allow_concurrency cycles/call cold %llu warm %llu\n",
+		cdf_div_u64(bench.allow_cold,
+			bench.calls * ARRAY_SIZE(conc_bench_chnl)),
+		cdf_div_u64(bench.allow_warm,
+			bench.calls * ARRAY_SIZE(conc_bench_chnl)));
+	pr_info("+----------Decision benchmark end-------+\n");
+}
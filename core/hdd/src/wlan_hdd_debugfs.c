@@ -32,6 +32,8 @@
  * wlan_wcnss/wow_enable to enable/disable WoWL.
  * wlan_wcnss/wow_pattern to configure WoWL patterns.
  * wlan_wcnss/pattern_gen to configure periodic TX patterns.
+ * wlan_wcnss/tx_latency to read (or, on write, clear) the per-peer,
+ * per-TID tx latency histograms.
  */
 
 #ifdef WLAN_OPEN_SOURCE
@@ -42,6 +44,7 @@
 #define MAX_USER_COMMAND_SIZE_WOWL_ENABLE 8
 #define MAX_USER_COMMAND_SIZE_WOWL_PATTERN 512
 #define MAX_USER_COMMAND_SIZE_FRAME 4096
+#define HDD_TX_LATENCY_BUF_SIZE 16384
 
 /**
  * __wcnss_wowenable_write() - wow_enable debugfs handler
@@ -580,6 +583,124 @@ static int wcnss_debugfs_open(struct inode *inode, struct file *file)
 	return ret;
 }
 
+#ifdef QCA_TX_PEER_LATENCY
+/**
+ * __wcnss_txlatency_read() - tx_latency debugfs read handler
+ * @file: debugfs file handle
+ * @buf: user buffer to fill
+ * @count: size of @buf
+ * @ppos: offset into the virtual file
+ *
+ * Prints one "lat" line per peer and TID with traffic, followed by the
+ * non-empty histogram bins of that peer and TID.
+ *
+ * Return: number of bytes read, or a negative errno
+ */
+static ssize_t __wcnss_txlatency_read(struct file *file, char __user *buf,
+				      size_t count, loff_t *ppos)
+{
+	ol_txrx_pdev_handle pdev = cds_get_context(CDF_MODULE_ID_TXRX);
+	struct ol_txrx_tx_latency lat;
+	char *out;
+	size_t len = 0;
+	ssize_t ret;
+	int sta_id, tid, bin;
+
+	if (!pdev)
+		return -EINVAL;
+
+	out = cdf_mem_malloc(HDD_TX_LATENCY_BUF_SIZE);
+	if (!out)
+		return -ENOMEM;
+
+	for (sta_id = 0; sta_id < WLAN_MAX_STA_COUNT; sta_id++) {
+		for (tid = 0; tid < OL_TXRX_TX_LAT_NUM_TIDS; tid++) {
+			if (ol_txrx_peer_tx_latency_get(pdev, sta_id, tid,
+							&lat) !=
+			    CDF_STATUS_SUCCESS)
+				break;
+			if (!lat.count && !lat.dropped)
+				continue;
+			len += scnprintf(out + len,
+					 HDD_TX_LATENCY_BUF_SIZE - len,
+					 "lat sta_id=%d tid=%d count=%u dropped=%u avg_us=%u p50_us=%u p90_us=%u p99_us=%u max_us=%u\n",
+					 sta_id, tid, lat.count, lat.dropped,
+					 lat.avg_us, lat.p50_us, lat.p90_us,
+					 lat.p99_us, lat.max_us);
+			for (bin = 0; bin < OL_TXRX_TX_LAT_NUM_BINS; bin++) {
+				if (!lat.bins[bin])
+					continue;
+				len += scnprintf(out + len,
+						 HDD_TX_LATENCY_BUF_SIZE - len,
+						 "hist sta_id=%d tid=%d bin=%d count=%u\n",
+						 sta_id, tid, bin,
+						 lat.bins[bin]);
+			}
+		}
+	}
+
+	ret = simple_read_from_buffer(buf, count, ppos, out, len);
+	cdf_mem_free(out);
+	return ret;
+}
+
+/**
+ * wcnss_txlatency_read() - SSR wrapper for __wcnss_txlatency_read
+ * @file: file pointer
+ * @buf: buffer
+ * @count: count
+ * @ppos: position pointer
+ *
+ * Return: number of bytes read, or a negative errno
+ */
+static ssize_t wcnss_txlatency_read(struct file *file, char __user *buf,
+				    size_t count, loff_t *ppos)
+{
+	ssize_t ret;
+
+	cds_ssr_protect(__func__);
+	ret = __wcnss_txlatency_read(file, buf, count, ppos);
+	cds_ssr_unprotect(__func__);
+
+	return ret;
+}
+
+/**
+ * wcnss_txlatency_write() - clear the tx latency histograms of all peers
+ * @file: file pointer
+ * @buf: buffer (ignored)
+ * @count: count
+ * @ppos: position pointer
+ *
+ * Return: @count
+ */
+static ssize_t wcnss_txlatency_write(struct file *file,
+				     const char __user *buf,
+				     size_t count, loff_t *ppos)
+{
+	ol_txrx_pdev_handle pdev;
+	int sta_id;
+
+	cds_ssr_protect(__func__);
+	pdev = cds_get_context(CDF_MODULE_ID_TXRX);
+	if (pdev) {
+		for (sta_id = 0; sta_id < WLAN_MAX_STA_COUNT; sta_id++)
+			ol_txrx_peer_tx_latency_reset(pdev, sta_id);
+	}
+	cds_ssr_unprotect(__func__);
+
+	return count;
+}
+
+static const struct file_operations fops_txlatency = {
+	.read = wcnss_txlatency_read,
+	.write = wcnss_txlatency_write,
+	.open = wcnss_debugfs_open,
+	.owner = THIS_MODULE,
+	.llseek = default_llseek,
+};
+#endif /* QCA_TX_PEER_LATENCY */
+
 static const struct file_operations fops_wowenable = {
 	.write = wcnss_wowenable_write,
 	.open = wcnss_debugfs_open,
@@ -636,6 +757,13 @@ CDF_STATUS hdd_debugfs_init(hdd_adapter_t *pAdapter)
 					&fops_patterngen))
 		return CDF_STATUS_E_FAILURE;
 
+#ifdef QCA_TX_PEER_LATENCY
+	if (NULL == debugfs_create_file("tx_latency", S_IRUSR | S_IWUSR,
+					pHddCtx->debugfs_phy, pAdapter,
+					&fops_txlatency))
+		return CDF_STATUS_E_FAILURE;
+#endif
+
 	return CDF_STATUS_SUCCESS;
 }
 
@@ -40,6 +40,7 @@
 #include "cds_sched.h"
 #include "osdep.h"
 #include "hif.h"
+#include "bmi.h"
 #include "epping_main.h"
 #include "wlan_hdd_main.h"
 #include "wlan_hdd_power.h"
@@ -190,6 +191,7 @@ static void wlan_hdd_remove(void)
 
 	hdd_napi_destroy(true);
 	hif_close(hif_ctx);
+	ol_fw_cache_invalidate();
 
 	cds_free_global_context(&p_cds_context);
 
@@ -268,12 +268,208 @@ static int hdd_extscan_nl_fill_bss(struct sk_buff *skb, tSirWifiScanResult *ap,
 #undef PARAM_IE_LENGTH
 #undef PARAM_IE_DATA
 
+#define EXTSCAN_CACHED_NEST_HDRLEN NLA_HDRLEN
+#define EXTSCAN_CACHED_NL_FIXED_TLV \
+		((sizeof(uint32_t) + NLA_HDRLEN) + /* request id */ \
+		(sizeof(uint32_t) + NLA_HDRLEN) + /* num scan ids */ \
+		(sizeof(uint8_t) + NLA_HDRLEN) + /* more data */ \
+		(sizeof(uint32_t) + NLA_HDRLEN)) /* first scan id */
+#define EXTSCAN_CACHED_NL_SCAN_ID_TLV \
+		((sizeof(uint32_t) + NLA_HDRLEN) + /* scan id */ \
+		(sizeof(uint32_t) + NLA_HDRLEN) + /* flags */ \
+		(sizeof(uint32_t) + NLA_HDRLEN)) /* num results */
+
+/*
+ * Upper bound of the payload of one cached results reply. Replies are
+ * split at scan id / BSS boundaries to stay within it so that each
+ * reply skb is a single page allocation, whatever the number of buckets.
+ * A single BSS larger than this still goes out in a reply of its own.
+ */
+#define EXTSCAN_CACHED_RESULTS_MAX_NL_LEN 3072
+
+/**
+ * hdd_extscan_cached_bss_len() - netlink space needed for one cached BSS
+ * @ap: bss information
+ *
+ * Return: length in bytes as filled by hdd_extscan_nl_fill_bss()
+ */
+static uint32_t hdd_extscan_cached_bss_len(tSirWifiScanResult *ap)
+{
+	uint32_t len;
+
+	len = EXTSCAN_CACHED_NEST_HDRLEN +
+		(sizeof(ap->ts) + NLA_HDRLEN) +
+		(sizeof(ap->ssid) + NLA_HDRLEN) +
+		(sizeof(ap->bssid) + NLA_HDRLEN) +
+		(sizeof(ap->channel) + NLA_HDRLEN) +
+		(sizeof(ap->rssi) + NLA_HDRLEN) +
+		(sizeof(ap->rtt) + NLA_HDRLEN) +
+		(sizeof(ap->rtt_sd) + NLA_HDRLEN) +
+		(sizeof(ap->beaconPeriod) + NLA_HDRLEN) +
+		(sizeof(ap->capability) + NLA_HDRLEN) +
+		(sizeof(ap->ieLength) + NLA_HDRLEN);
+	if (ap->ieLength)
+		len += nla_total_size(ap->ieLength);
+
+	return len;
+}
+
+/**
+ * hdd_extscan_cached_results_plan() - find the end of the next reply
+ * @data: cached results
+ * @scan_idx: in: first scan id of the reply, out: scan id to stop at
+ * @ap_idx: in: first BSS of that scan id, out: BSS to stop at
+ * @num_ids: filled with the number of scan ids the reply carries
+ *
+ * Packs scan ids and their BSSs from (@scan_idx, @ap_idx) until
+ * EXTSCAN_CACHED_RESULTS_MAX_NL_LEN would be exceeded. At least one
+ * scan id and, if it has any, one BSS always go into the reply so that
+ * every reply makes progress.
+ *
+ * Return: netlink buffer length needed for the reply
+ */
+static uint32_t
+hdd_extscan_cached_results_plan(struct extscan_cached_scan_results *data,
+				uint32_t *scan_idx, uint32_t *ap_idx,
+				uint32_t *num_ids)
+{
+	struct extscan_cached_scan_result *result;
+	uint32_t len, id_len, need, num_aps = 0;
+	uint32_t i = *scan_idx, j = *ap_idx;
+
+	len = NLMSG_HDRLEN + EXTSCAN_CACHED_NL_FIXED_TLV +
+		EXTSCAN_CACHED_NEST_HDRLEN;
+	*num_ids = 0;
+	id_len = EXTSCAN_CACHED_NEST_HDRLEN + EXTSCAN_CACHED_NL_SCAN_ID_TLV +
+		EXTSCAN_CACHED_NEST_HDRLEN;
+
+	while (i < data->num_scan_ids) {
+		result = &data->result[i];
+
+		need = id_len;
+		if (j < result->num_results)
+			need += hdd_extscan_cached_bss_len(&result->ap[j]);
+		if (*num_ids && len + need > EXTSCAN_CACHED_RESULTS_MAX_NL_LEN)
+			break;
+		len += id_len;
+		(*num_ids)++;
+
+		for (; j < result->num_results; j++) {
+			need = hdd_extscan_cached_bss_len(&result->ap[j]);
+			if (num_aps &&
+			    len + need > EXTSCAN_CACHED_RESULTS_MAX_NL_LEN)
+				break;
+			len += need;
+			num_aps++;
+		}
+		if (j < result->num_results)
+			break;
+		i++;
+		j = 0;
+	}
+
+	*scan_idx = i;
+	*ap_idx = j;
+	return len;
+}
+
+/**
+ * hdd_extscan_cached_results_fill() - fill one cached results reply
+ * @skb: reply buffer
+ * @data: cached results
+ * @scan_idx: first scan id of the reply
+ * @ap_idx: first BSS of that scan id
+ * @end_scan_idx: scan id to stop at, from hdd_extscan_cached_results_plan
+ * @end_ap_idx: BSS to stop at, from hdd_extscan_cached_results_plan
+ * @num_ids: number of scan ids in the reply
+ * @more_data: value of the MORE_DATA attribute of this reply
+ *
+ * Return: 0 on success; error number otherwise
+ */
+static int
+hdd_extscan_cached_results_fill(struct sk_buff *skb,
+				struct extscan_cached_scan_results *data,
+				uint32_t scan_idx, uint32_t ap_idx,
+				uint32_t end_scan_idx, uint32_t end_ap_idx,
+				uint32_t num_ids, uint8_t more_data)
+{
+	struct extscan_cached_scan_result *result;
+	struct nlattr *nla_results, *nla_result, *nla_aps;
+	uint32_t i, j, k, end, n = 0;
+
+	if (nla_put_u32(skb, QCA_WLAN_VENDOR_ATTR_EXTSCAN_RESULTS_REQUEST_ID,
+		data->request_id) ||
+	    nla_put_u32(skb,
+		QCA_WLAN_VENDOR_ATTR_EXTSCAN_NUM_RESULTS_AVAILABLE,
+		num_ids) ||
+	    nla_put_u8(skb,
+		QCA_WLAN_VENDOR_ATTR_EXTSCAN_RESULTS_SCAN_RESULT_MORE_DATA,
+		more_data)) {
+		hddLog(LOGE, FL("put fail"));
+		return -EINVAL;
+	}
+
+	if (!num_ids)
+		return 0;
+
+	if (nla_put_u32(skb,
+		QCA_WLAN_VENDOR_ATTR_EXTSCAN_CACHED_RESULTS_SCAN_ID,
+		data->result[scan_idx].scan_id)) {
+		hddLog(LOGE, FL("put fail"));
+		return -EINVAL;
+	}
+	nla_results = nla_nest_start(skb,
+		      QCA_WLAN_VENDOR_ATTR_EXTSCAN_CACHED_RESULTS_LIST);
+	if (!nla_results)
+		return -EINVAL;
+
+	for (i = scan_idx, j = ap_idx; n < num_ids; i++, j = 0, n++) {
+		result = &data->result[i];
+		end = (i == end_scan_idx) ? end_ap_idx : result->num_results;
+
+		nla_result = nla_nest_start(skb, n);
+		if (!nla_result)
+			return -EINVAL;
+
+		if (nla_put_u32(skb,
+			QCA_WLAN_VENDOR_ATTR_EXTSCAN_CACHED_RESULTS_SCAN_ID,
+			result->scan_id) ||
+		    nla_put_u32(skb,
+			QCA_WLAN_VENDOR_ATTR_EXTSCAN_CACHED_RESULTS_FLAGS,
+			result->flags) ||
+		    nla_put_u32(skb,
+			QCA_WLAN_VENDOR_ATTR_EXTSCAN_NUM_RESULTS_AVAILABLE,
+			end - j)) {
+			hddLog(LOGE, FL("put fail"));
+			return -EINVAL;
+		}
+
+		nla_aps = nla_nest_start(skb,
+			     QCA_WLAN_VENDOR_ATTR_EXTSCAN_RESULTS_LIST);
+		if (!nla_aps)
+			return -EINVAL;
+
+		for (k = 0; j < end; j++, k++) {
+			if (hdd_extscan_nl_fill_bss(skb, &result->ap[j], k))
+				return -EINVAL;
+		}
+		nla_nest_end(skb, nla_aps);
+		nla_nest_end(skb, nla_result);
+	}
+	nla_nest_end(skb, nla_results);
+
+	return 0;
+}
+
 /** wlan_hdd_cfg80211_extscan_cached_results_ind() - get cached results
  * @ctx: hdd global context
  * @data: cached results
  *
  * This function reads the cached results %data, populated the NL
- * attributes and sends the NL event to the upper layer.
+ * attributes and sends the NL event to the upper layer. Large results
+ * are sent as several replies of bounded size, all but the last one
+ * with MORE_DATA set, the same way the firmware already fragments them
+ * across events.
  *
  * Return: none
  */
@@ -287,6 +483,8 @@ wlan_hdd_cfg80211_extscan_cached_results_ind(void *ctx,
 	struct extscan_cached_scan_result *result;
 	tSirWifiScanResult *ap;
 	uint32_t i, j, nl_buf_len;
+	uint32_t scan_idx, ap_idx, end_scan_idx, end_ap_idx, num_ids;
+	uint8_t more_data;
 	bool ignore_cached_results = false;
 
 	ENTER();
@@ -309,61 +507,6 @@ wlan_hdd_cfg80211_extscan_cached_results_ind(void *ctx,
 		return;
 	}
 
-#define EXTSCAN_CACHED_NEST_HDRLEN NLA_HDRLEN
-#define EXTSCAN_CACHED_NL_FIXED_TLV \
-		((sizeof(data->request_id) + NLA_HDRLEN) + \
-		(sizeof(data->num_scan_ids) + NLA_HDRLEN) + \
-		(sizeof(data->more_data) + NLA_HDRLEN))
-#define EXTSCAN_CACHED_NL_SCAN_ID_TLV \
-		((sizeof(result->scan_id) + NLA_HDRLEN) + \
-		(sizeof(result->flags) + NLA_HDRLEN) + \
-		(sizeof(result->num_results) + NLA_HDRLEN))
-#define EXTSCAN_CACHED_NL_SCAN_RESULTS_TLV \
-		((sizeof(ap->ts) + NLA_HDRLEN) + \
-		(sizeof(ap->ssid) + NLA_HDRLEN) + \
-		(sizeof(ap->bssid) + NLA_HDRLEN) + \
-		(sizeof(ap->channel) + NLA_HDRLEN) + \
-		(sizeof(ap->rssi) + NLA_HDRLEN) + \
-		(sizeof(ap->rtt) + NLA_HDRLEN) + \
-		(sizeof(ap->rtt_sd) + NLA_HDRLEN) + \
-		(sizeof(ap->beaconPeriod) + NLA_HDRLEN) + \
-		(sizeof(ap->capability) + NLA_HDRLEN) + \
-		(sizeof(ap->ieLength) + NLA_HDRLEN))
-#define EXTSCAN_CACHED_NL_SCAN_RESULTS_IE_DATA_TLV \
-		(ap->ieLength + NLA_HDRLEN)
-
-	nl_buf_len = NLMSG_HDRLEN;
-	nl_buf_len += EXTSCAN_CACHED_NL_FIXED_TLV;
-	if (data->num_scan_ids) {
-		nl_buf_len += sizeof(result->scan_id) + NLA_HDRLEN;
-		nl_buf_len += EXTSCAN_CACHED_NEST_HDRLEN;
-		result = &data->result[0];
-		for (i = 0; i < data->num_scan_ids; i++) {
-			nl_buf_len += EXTSCAN_CACHED_NEST_HDRLEN;
-			nl_buf_len += EXTSCAN_CACHED_NL_SCAN_ID_TLV;
-			nl_buf_len += EXTSCAN_CACHED_NEST_HDRLEN;
-
-			ap = &result->ap[0];
-			for (j = 0; j < result->num_results; j++) {
-				nl_buf_len += EXTSCAN_CACHED_NEST_HDRLEN;
-				nl_buf_len +=
-					EXTSCAN_CACHED_NL_SCAN_RESULTS_TLV;
-				if (ap->ieLength)
-					nl_buf_len +=
-					EXTSCAN_CACHED_NL_SCAN_RESULTS_IE_DATA_TLV;
-				ap++;
-			}
-			result++;
-		}
-	}
-
-	hddLog(LOG1, FL("nl_buf_len = %u"), nl_buf_len);
-	skb = cfg80211_vendor_cmd_alloc_reply_skb(pHddCtx->wiphy, nl_buf_len);
-
-	if (!skb) {
-		hddLog(LOGE, FL("cfg80211_vendor_cmd_alloc_reply_skb failed"));
-		goto fail;
-	}
 	hddLog(LOG1, "Req Id %u Num_scan_ids %u More Data %u",
 		data->request_id, data->num_scan_ids, data->more_data);
 
@@ -407,74 +550,37 @@ wlan_hdd_cfg80211_extscan_cached_results_ind(void *ctx,
 		result++;
 	}
 
-	if (nla_put_u32(skb, QCA_WLAN_VENDOR_ATTR_EXTSCAN_RESULTS_REQUEST_ID,
-		data->request_id) ||
-	    nla_put_u32(skb,
-		QCA_WLAN_VENDOR_ATTR_EXTSCAN_NUM_RESULTS_AVAILABLE,
-		data->num_scan_ids) ||
-	    nla_put_u8(skb,
-		QCA_WLAN_VENDOR_ATTR_EXTSCAN_RESULTS_SCAN_RESULT_MORE_DATA,
-		data->more_data)) {
-		hddLog(LOGE, FL("put fail"));
-		goto fail;
-	}
-
-	if (data->num_scan_ids) {
-		struct nlattr *nla_results;
-		result = &data->result[0];
-
-		if (nla_put_u32(skb,
-			QCA_WLAN_VENDOR_ATTR_EXTSCAN_CACHED_RESULTS_SCAN_ID,
-			result->scan_id)) {
-			hddLog(LOGE, FL("put fail"));
+	scan_idx = 0;
+	ap_idx = 0;
+	do {
+		end_scan_idx = scan_idx;
+		end_ap_idx = ap_idx;
+		nl_buf_len = hdd_extscan_cached_results_plan(data,
+					&end_scan_idx, &end_ap_idx, &num_ids);
+		more_data = (end_scan_idx < data->num_scan_ids) ?
+				1 : data->more_data;
+
+		hddLog(LOG1, FL("nl_buf_len = %u num_scan_ids %u more %u"),
+			nl_buf_len, num_ids, more_data);
+		skb = cfg80211_vendor_cmd_alloc_reply_skb(pHddCtx->wiphy,
+							  nl_buf_len);
+		if (!skb) {
+			hddLog(LOGE,
+			       FL("cfg80211_vendor_cmd_alloc_reply_skb failed"));
 			goto fail;
 		}
-		nla_results = nla_nest_start(skb,
-			      QCA_WLAN_VENDOR_ATTR_EXTSCAN_CACHED_RESULTS_LIST);
-		if (!nla_results)
-			goto fail;
-
-		for (i = 0; i < data->num_scan_ids; i++) {
-			struct nlattr *nla_result;
-			struct nlattr *nla_aps;
 
-			nla_result = nla_nest_start(skb, i);
-			if (!nla_result)
-				goto fail;
-
-			if (nla_put_u32(skb,
-				QCA_WLAN_VENDOR_ATTR_EXTSCAN_CACHED_RESULTS_SCAN_ID,
-				result->scan_id) ||
-			    nla_put_u32(skb,
-				QCA_WLAN_VENDOR_ATTR_EXTSCAN_CACHED_RESULTS_FLAGS,
-				result->flags) ||
-			    nla_put_u32(skb,
-				QCA_WLAN_VENDOR_ATTR_EXTSCAN_NUM_RESULTS_AVAILABLE,
-				result->num_results)) {
-				hddLog(LOGE, FL("put fail"));
-				goto fail;
-			}
-
-			nla_aps = nla_nest_start(skb,
-				     QCA_WLAN_VENDOR_ATTR_EXTSCAN_RESULTS_LIST);
-			if (!nla_aps)
-				goto fail;
-
-			ap = &result->ap[0];
-			for (j = 0; j < result->num_results; j++) {
-				if (hdd_extscan_nl_fill_bss(skb, ap, j))
-					goto fail;
+		if (hdd_extscan_cached_results_fill(skb, data, scan_idx,
+					ap_idx, end_scan_idx, end_ap_idx,
+					num_ids, more_data))
+			goto fail;
 
-				ap++;
-			}
-			nla_nest_end(skb, nla_aps);
-			nla_nest_end(skb, nla_result);
-			result++;
-		}
-		nla_nest_end(skb, nla_results);
-	}
+		cfg80211_vendor_cmd_reply(skb);
+		skb = NULL;
 
-	cfg80211_vendor_cmd_reply(skb);
+		scan_idx = end_scan_idx;
+		ap_idx = end_ap_idx;
+	} while (scan_idx < data->num_scan_ids);
 
 	if (!data->more_data) {
 		spin_lock(&context->context_lock);
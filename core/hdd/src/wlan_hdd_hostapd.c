@@ -1275,6 +1275,10 @@ CDF_STATUS hdd_hostapd_sap_event_cb(tpSap_Event pSapEvent,
 				pHostapdAdapter->stats.tx_packets;
 			pHostapdAdapter->prev_rx_packets =
 				pHostapdAdapter->stats.rx_packets;
+			pHostapdAdapter->prev_tx_bytes =
+				pHostapdAdapter->stats.tx_bytes;
+			pHostapdAdapter->prev_rx_bytes =
+				pHostapdAdapter->stats.rx_bytes;
 			spin_unlock_bh(&pHddCtx->bus_bw_lock);
 			hdd_start_bus_bw_compute_timer(pHostapdAdapter);
 		}
@@ -1464,6 +1468,8 @@ CDF_STATUS hdd_hostapd_sap_event_cb(tpSap_Event pSapEvent,
 			spin_lock_bh(&pHddCtx->bus_bw_lock);
 			pHostapdAdapter->prev_tx_packets = 0;
 			pHostapdAdapter->prev_rx_packets = 0;
+			pHostapdAdapter->prev_tx_bytes = 0;
+			pHostapdAdapter->prev_rx_bytes = 0;
 			spin_unlock_bh(&pHddCtx->bus_bw_lock);
 			hdd_stop_bus_bw_compute_timer(pHostapdAdapter);
 		}
@@ -84,6 +84,8 @@
 #define HDD_IPA_REAL_TIME_DEBUGGING        BIT(8)
 
 #define HDD_IPA_MAX_PENDING_EVENT_COUNT    20
+/* exception packets held per interface for hdd_ipa_excep_rx_poll() */
+#define HDD_IPA_MAX_EXCEP_RX_Q_LEN         1024
 
 typedef enum {
 	HDD_IPA_UC_OPCODE_TX_SUSPEND = 0,
@@ -244,6 +246,7 @@ struct hdd_ipa_iface_context {
 	cdf_spinlock_t interface_lock;
 	uint32_t ifa_address;
 	struct hdd_ipa_iface_stats stats;
+	cdf_nbuf_queue_t excep_rx_q;
 };
 
 struct hdd_ipa_stats {
@@ -277,6 +280,13 @@ struct hdd_ipa_stats {
 	uint64_t num_rx_excep;
 	uint64_t num_tx_bcmc;
 	uint64_t num_tx_bcmc_err;
+
+	uint64_t num_rx_excep_batch;
+	uint64_t num_rx_excep_batch_pkts;
+	uint64_t max_rx_excep_batch;
+	uint64_t num_rx_excep_resched;
+	uint64_t num_rx_excep_q_drop;
+	uint64_t num_tx_pm_batch;
 };
 
 struct ipa_uc_stas_map {
@@ -395,6 +405,11 @@ struct hdd_ipa_priv {
 	cdf_spinlock_t pm_lock;
 	bool suspended;
 
+	/* Exception rx packets waiting for the poll work, per interface */
+	struct work_struct excep_work;
+	cdf_spinlock_t excep_lock;
+	uint32_t excep_batch_size;
+
 	uint32_t pending_hw_desc_cnt;
 	uint32_t hw_desc_cnt;
 	spinlock_t q_lock;
@@ -1439,6 +1454,22 @@ static void hdd_ipa_uc_op_cb(struct op_msg_type *op_msg, void *usr_ctxt)
 			  hdd_ipa->stats.num_rx_excep,
 			  hdd_ipa->stats.num_tx_bcmc,
 			  hdd_ipa->stats.num_tx_bcmc_err);
+		CDF_TRACE(CDF_MODULE_ID_HDD, CDF_TRACE_LEVEL_ERROR,
+			  "==== IPA_UC WLAN_HOST BATCH ====\n"
+			  "EXCP BATCH SIZE : %u\n"
+			  "NUM EXCP BATCH : %llu\n"
+			  "NUM EXCP BATCH PKT : %llu\n"
+			  "MAX EXCP BATCH : %llu\n"
+			  "NUM EXCP RESCHED : %llu\n"
+			  "NUM EXCP Q DROP : %llu\n"
+			  "NUM PM TX BATCH : %llu",
+			  hdd_ipa->excep_batch_size,
+			  hdd_ipa->stats.num_rx_excep_batch,
+			  hdd_ipa->stats.num_rx_excep_batch_pkts,
+			  hdd_ipa->stats.max_rx_excep_batch,
+			  hdd_ipa->stats.num_rx_excep_resched,
+			  hdd_ipa->stats.num_rx_excep_q_drop,
+			  hdd_ipa->stats.num_tx_pm_batch);
 		CDF_TRACE(CDF_MODULE_ID_HDD, CDF_TRACE_LEVEL_ERROR,
 			  "==== IPA_UC WLAN_HOST CONTROL ====\n"
 			  "SAP NUM STAs: %d\n"
@@ -2437,6 +2468,44 @@ static void hdd_ipa_destroy_rm_resource(struct hdd_ipa_priv *hdd_ipa)
 			    "RM CONS resource delete failed %d", ret);
 }
 
+/**
+ * hdd_ipa_rx_adapter_is_valid() - Check an adapter can receive packets
+ * @hdd_ipa: Global HDD IPA context
+ * @adapter: network adapter
+ *
+ * Return: true if packets can be delivered to @adapter
+ */
+static bool hdd_ipa_rx_adapter_is_valid(struct hdd_ipa_priv *hdd_ipa,
+					hdd_adapter_t *adapter)
+{
+	if (!adapter || adapter->magic != WLAN_HDD_ADAPTER_MAGIC) {
+		HDD_IPA_LOG(CDF_TRACE_LEVEL_INFO_LOW, "Invalid adapter: 0x%p",
+			    adapter);
+		return false;
+	}
+
+	if (hdd_ipa->hdd_ctx->isUnloadInProgress)
+		return false;
+
+	return true;
+}
+
+/**
+ * hdd_ipa_rx_prepare_skb() - Set up an skb for the network stack
+ * @skb: network buffer
+ * @adapter: network adapter receiving @skb
+ *
+ * Return: None
+ */
+static inline void hdd_ipa_rx_prepare_skb(cdf_nbuf_t skb,
+					  hdd_adapter_t *adapter)
+{
+	skb->destructor = hdd_ipa_uc_rt_debug_destructor;
+	skb->dev = adapter->dev;
+	skb->protocol = eth_type_trans(skb, skb->dev);
+	skb->ip_summed = CHECKSUM_NONE;
+}
+
 /**
  * hdd_ipa_send_skb_to_network() - Send skb to kernel
  * @skb: network buffer
@@ -2453,24 +2522,13 @@ static void hdd_ipa_send_skb_to_network(cdf_nbuf_t skb,
 	struct hdd_ipa_priv *hdd_ipa = ghdd_ipa;
 	unsigned int cpu_index;
 
-	if (!adapter || adapter->magic != WLAN_HDD_ADAPTER_MAGIC) {
-		HDD_IPA_LOG(CDF_TRACE_LEVEL_INFO_LOW, "Invalid adapter: 0x%p",
-			    adapter);
-		HDD_IPA_INCREASE_INTERNAL_DROP_COUNT(hdd_ipa);
-		cdf_nbuf_free(skb);
-		return;
-	}
-
-	if (hdd_ipa->hdd_ctx->isUnloadInProgress) {
+	if (!hdd_ipa_rx_adapter_is_valid(hdd_ipa, adapter)) {
 		HDD_IPA_INCREASE_INTERNAL_DROP_COUNT(hdd_ipa);
 		cdf_nbuf_free(skb);
 		return;
 	}
 
-	skb->destructor = hdd_ipa_uc_rt_debug_destructor;
-	skb->dev = adapter->dev;
-	skb->protocol = eth_type_trans(skb, skb->dev);
-	skb->ip_summed = CHECKSUM_NONE;
+	hdd_ipa_rx_prepare_skb(skb, adapter);
 
 	cpu_index = wlan_hdd_get_cpu();
 
@@ -2484,6 +2542,184 @@ static void hdd_ipa_send_skb_to_network(cdf_nbuf_t skb,
 	adapter->dev->last_rx = jiffies;
 }
 
+/**
+ * hdd_ipa_excep_rx_take() - Take all queued exception packets of an iface
+ * @iface_context: interface-specific IPA context
+ * @purge_q: queue that receives the packets
+ *
+ * Return: None
+ */
+static void hdd_ipa_excep_rx_take(struct hdd_ipa_iface_context *iface_context,
+				  cdf_nbuf_queue_t *purge_q)
+{
+	struct hdd_ipa_priv *hdd_ipa = iface_context->hdd_ipa;
+
+	cdf_spin_lock_bh(&hdd_ipa->excep_lock);
+	*purge_q = iface_context->excep_rx_q;
+	cdf_nbuf_queue_init(&iface_context->excep_rx_q);
+	cdf_spin_unlock_bh(&hdd_ipa->excep_lock);
+}
+
+/**
+ * hdd_ipa_excep_rx_drop() - Free exception packets taken from a queue
+ * @hdd_ipa: Global HDD IPA context
+ * @purge_q: packets to free
+ *
+ * Return: None
+ */
+static void hdd_ipa_excep_rx_drop(struct hdd_ipa_priv *hdd_ipa,
+				  cdf_nbuf_queue_t *purge_q)
+{
+	cdf_nbuf_t skb;
+
+	while ((skb = cdf_nbuf_queue_remove(purge_q)) != NULL) {
+		HDD_IPA_INCREASE_INTERNAL_DROP_COUNT(hdd_ipa);
+		cdf_nbuf_free(skb);
+	}
+}
+
+/**
+ * hdd_ipa_excep_rx_purge() - Drop all queued exception packets
+ * @hdd_ipa: Global HDD IPA context
+ *
+ * Return: None
+ */
+static void hdd_ipa_excep_rx_purge(struct hdd_ipa_priv *hdd_ipa)
+{
+	cdf_nbuf_queue_t purge_q;
+	int i;
+
+	for (i = 0; i < HDD_IPA_MAX_IFACE; i++) {
+		hdd_ipa_excep_rx_take(&hdd_ipa->iface_context[i], &purge_q);
+		hdd_ipa_excep_rx_drop(hdd_ipa, &purge_q);
+	}
+}
+
+/**
+ * hdd_ipa_excep_rx_poll() - Deliver queued exception packets to the stack
+ * @work: pointer to the scheduled work
+ *
+ * NAPI-style poll of the per-interface exception queues: at most
+ * excep_batch_size packets are taken from each interface per run, under a
+ * single hold of excep_lock. interface_lock only covers the dequeue and
+ * the adapter check; the adapter's net_device is pinned with dev_hold()
+ * before the lock is dropped, so the batch is handed to the stack without
+ * holding it and hdd_ipa_cleanup_iface() is never stuck behind the
+ * receive path. Bottom halves are disabled around the delivery loop, so
+ * the receive softirq runs once for the batch instead of once per packet.
+ * The work reschedules itself while packets remain, which keeps one busy
+ * interface from starving the others.
+ *
+ * Return: None
+ */
+static void hdd_ipa_excep_rx_poll(struct work_struct *work)
+{
+	struct hdd_ipa_priv *hdd_ipa = container_of(work,
+						    struct hdd_ipa_priv,
+						    excep_work);
+	struct hdd_ipa_iface_context *iface_context;
+	hdd_adapter_t *adapter;
+	cdf_nbuf_queue_t batch;
+	cdf_nbuf_t skb;
+	unsigned int cpu_index;
+	uint32_t budget = hdd_ipa->excep_batch_size;
+	uint32_t cnt, delivered;
+	bool more = false;
+	int i;
+
+	for (i = 0; i < HDD_IPA_MAX_IFACE; i++) {
+		iface_context = &hdd_ipa->iface_context[i];
+		cdf_nbuf_queue_init(&batch);
+
+		cdf_spin_lock_bh(&iface_context->interface_lock);
+		cdf_spin_lock_bh(&hdd_ipa->excep_lock);
+		while (cdf_nbuf_queue_len(&batch) < budget) {
+			skb = cdf_nbuf_queue_remove(&iface_context->excep_rx_q);
+			if (!skb)
+				break;
+			cdf_nbuf_queue_add(&batch, skb);
+		}
+		if (!cdf_nbuf_is_queue_empty(&iface_context->excep_rx_q))
+			more = true;
+		cdf_spin_unlock_bh(&hdd_ipa->excep_lock);
+
+		cnt = cdf_nbuf_queue_len(&batch);
+		adapter = iface_context->adapter;
+		if (cnt && hdd_ipa_rx_adapter_is_valid(hdd_ipa, adapter))
+			dev_hold(adapter->dev);
+		else
+			adapter = NULL;
+		cdf_spin_unlock_bh(&iface_context->interface_lock);
+
+		if (!cnt)
+			continue;
+
+		hdd_ipa->stats.num_rx_excep_batch++;
+		hdd_ipa->stats.num_rx_excep_batch_pkts += cnt;
+		if (cnt > hdd_ipa->stats.max_rx_excep_batch)
+			hdd_ipa->stats.max_rx_excep_batch = cnt;
+
+		if (!adapter) {
+			hdd_ipa_excep_rx_drop(hdd_ipa, &batch);
+			continue;
+		}
+
+		delivered = 0;
+		local_bh_disable();
+		cpu_index = wlan_hdd_get_cpu();
+		while ((skb = cdf_nbuf_queue_remove(&batch)) != NULL) {
+			hdd_ipa_rx_prepare_skb(skb, adapter);
+			if (netif_receive_skb(skb) == NET_RX_SUCCESS)
+				delivered++;
+			HDD_IPA_INCREASE_NET_SEND_COUNT(hdd_ipa);
+		}
+		adapter->hdd_stats.hddTxRxStats.rxPackets[cpu_index] += cnt;
+		adapter->hdd_stats.hddTxRxStats.rxDelivered[cpu_index] +=
+			delivered;
+		adapter->hdd_stats.hddTxRxStats.rxRefused[cpu_index] +=
+			cnt - delivered;
+		adapter->dev->last_rx = jiffies;
+		local_bh_enable();
+		dev_put(adapter->dev);
+	}
+
+	if (more) {
+		hdd_ipa->stats.num_rx_excep_resched++;
+		schedule_work(&hdd_ipa->excep_work);
+	}
+}
+
+/**
+ * hdd_ipa_excep_rx_enqueue() - Queue an exception packet for the poll work
+ * @iface_context: interface-specific IPA context the packet belongs to
+ * @skb: network buffer, with the WLAN header already removed
+ *
+ * The packet is dropped if HDD_IPA_MAX_EXCEP_RX_Q_LEN packets are already
+ * waiting on the interface.
+ *
+ * Return: None
+ */
+static void hdd_ipa_excep_rx_enqueue(
+		struct hdd_ipa_iface_context *iface_context,
+		cdf_nbuf_t skb)
+{
+	struct hdd_ipa_priv *hdd_ipa = iface_context->hdd_ipa;
+
+	cdf_spin_lock_bh(&hdd_ipa->excep_lock);
+	if (cdf_nbuf_queue_len(&iface_context->excep_rx_q) >=
+	    HDD_IPA_MAX_EXCEP_RX_Q_LEN) {
+		hdd_ipa->stats.num_rx_excep_q_drop++;
+		cdf_spin_unlock_bh(&hdd_ipa->excep_lock);
+		HDD_IPA_INCREASE_INTERNAL_DROP_COUNT(hdd_ipa);
+		cdf_nbuf_free(skb);
+		return;
+	}
+	cdf_nbuf_queue_add(&iface_context->excep_rx_q, skb);
+	cdf_spin_unlock_bh(&hdd_ipa->excep_lock);
+
+	schedule_work(&hdd_ipa->excep_work);
+}
+
 /**
  * hdd_ipa_w2i_cb() - WLAN to IPA callback handler
  * @priv: pointer to private data registered with IPA (we register a
@@ -2597,7 +2833,10 @@ static void hdd_ipa_w2i_cb(void *priv, enum ipa_dp_evt_type evt,
 				"Intra-BSS FWD is disabled-skip forward to Tx");
 		}
 
-		hdd_ipa_send_skb_to_network(skb, adapter);
+		if (hdd_ipa->excep_batch_size)
+			hdd_ipa_excep_rx_enqueue(iface_context, skb);
+		else
+			hdd_ipa_send_skb_to_network(skb, adapter);
 		break;
 
 	default:
@@ -2627,6 +2866,35 @@ static void hdd_ipa_nbuf_cb(cdf_nbuf_t skb)
 	hdd_ipa_rm_try_release(hdd_ipa);
 }
 
+/**
+ * hdd_ipa_prepare_tx_skb() - Set up the skb of an IPA packet for TL
+ * @hdd_ipa: Global HDD IPA context
+ * @ipa_tx_desc: packet data descriptor
+ *
+ * Return: the skb of @ipa_tx_desc, ready to be handed to TL
+ */
+static cdf_nbuf_t hdd_ipa_prepare_tx_skb(struct hdd_ipa_priv *hdd_ipa,
+					 struct ipa_rx_data *ipa_tx_desc)
+{
+	cdf_nbuf_t skb = ipa_tx_desc->skb;
+
+	cdf_mem_set(skb->cb, sizeof(skb->cb), 0);
+	NBUF_OWNER_ID(skb) = IPA_NBUF_OWNER_ID;
+	NBUF_CALLBACK_FN(skb) = hdd_ipa_nbuf_cb;
+	if (hdd_ipa_uc_sta_is_enabled(hdd_ipa->hdd_ctx)) {
+		NBUF_MAPPED_PADDR_LO(skb) = ipa_tx_desc->dma_addr
+			+ HDD_IPA_WLAN_FRAG_HEADER
+			+ HDD_IPA_WLAN_IPA_HEADER;
+		ipa_tx_desc->skb->len -=
+			HDD_IPA_WLAN_FRAG_HEADER + HDD_IPA_WLAN_IPA_HEADER;
+	} else
+		NBUF_MAPPED_PADDR_LO(skb) = ipa_tx_desc->dma_addr;
+
+	NBUF_OWNER_PRIV_DATA(skb) = (unsigned long)ipa_tx_desc;
+
+	return skb;
+}
+
 /**
  * hdd_ipa_send_pkt_to_tl() - Send an IPA packet to TL
  * @iface_context: interface-specific IPA context
@@ -2671,21 +2939,7 @@ static void hdd_ipa_send_pkt_to_tl(
 
 	cdf_spin_unlock_bh(&iface_context->interface_lock);
 
-	skb = ipa_tx_desc->skb;
-
-	cdf_mem_set(skb->cb, sizeof(skb->cb), 0);
-	NBUF_OWNER_ID(skb) = IPA_NBUF_OWNER_ID;
-	NBUF_CALLBACK_FN(skb) = hdd_ipa_nbuf_cb;
-	if (hdd_ipa_uc_sta_is_enabled(hdd_ipa->hdd_ctx)) {
-		NBUF_MAPPED_PADDR_LO(skb) = ipa_tx_desc->dma_addr
-			+ HDD_IPA_WLAN_FRAG_HEADER
-			+ HDD_IPA_WLAN_IPA_HEADER;
-		ipa_tx_desc->skb->len -=
-			HDD_IPA_WLAN_FRAG_HEADER + HDD_IPA_WLAN_IPA_HEADER;
-	} else
-		NBUF_MAPPED_PADDR_LO(skb) = ipa_tx_desc->dma_addr;
-
-	NBUF_OWNER_PRIV_DATA(skb) = (unsigned long)ipa_tx_desc;
+	skb = hdd_ipa_prepare_tx_skb(hdd_ipa, ipa_tx_desc);
 
 	adapter->stats.tx_bytes += ipa_tx_desc->skb->len;
 
@@ -2705,12 +2959,100 @@ static void hdd_ipa_send_pkt_to_tl(
 
 }
 
+/**
+ * hdd_ipa_send_pkt_list_to_tl() - Send a batch of queued IPA packets to TL
+ * @iface_context: interface-specific IPA context all packets belong to
+ * @pkt_q: packets queued by hdd_ipa_i2w_cb() while suspended
+ *
+ * Batched form of hdd_ipa_send_pkt_to_tl(): the interface state is checked
+ * once under interface_lock and the packets are submitted to TL as one
+ * list. Packets TL does not accept are freed and counted as tx errors.
+ *
+ * Return: None
+ */
+static void hdd_ipa_send_pkt_list_to_tl(
+		struct hdd_ipa_iface_context *iface_context,
+		cdf_nbuf_queue_t *pkt_q)
+{
+	struct hdd_ipa_priv *hdd_ipa = iface_context->hdd_ipa;
+	struct hdd_ipa_pm_tx_cb *pm_tx_cb;
+	hdd_adapter_t *adapter;
+	cdf_nbuf_t skb, head = NULL, tail = NULL;
+	uint32_t cnt = cdf_nbuf_queue_len(pkt_q);
+	uint32_t unsent = 0;
+	bool cac_block_tx = false;
+
+	cdf_spin_lock_bh(&iface_context->interface_lock);
+	adapter = iface_context->adapter;
+	if (adapter) {
+		cac_block_tx =
+			WLAN_HDD_GET_AP_CTX_PTR(adapter)->dfs_cac_block_tx;
+		if (!cac_block_tx)
+			adapter->stats.tx_packets += cnt;
+	}
+	cdf_spin_unlock_bh(&iface_context->interface_lock);
+
+	if (!adapter || cac_block_tx) {
+		if (!adapter) {
+			HDD_IPA_LOG(CDF_TRACE_LEVEL_WARN, "Interface Down");
+			iface_context->stats.num_tx_drop += cnt;
+		} else {
+			iface_context->stats.num_tx_cac_drop += cnt;
+		}
+		while ((skb = cdf_nbuf_queue_remove(pkt_q)) != NULL) {
+			pm_tx_cb = (struct hdd_ipa_pm_tx_cb *)skb->cb;
+			ipa_free_skb(pm_tx_cb->ipa_tx_desc);
+		}
+		hdd_ipa_rm_try_release(hdd_ipa);
+		return;
+	}
+
+	while ((skb = cdf_nbuf_queue_remove(pkt_q)) != NULL) {
+		pm_tx_cb = (struct hdd_ipa_pm_tx_cb *)skb->cb;
+		skb = hdd_ipa_prepare_tx_skb(hdd_ipa, pm_tx_cb->ipa_tx_desc);
+		adapter->stats.tx_bytes += skb->len;
+
+		cdf_nbuf_set_next(skb, NULL);
+		if (tail)
+			cdf_nbuf_set_next(tail, skb);
+		else
+			head = skb;
+		tail = skb;
+	}
+
+	/*
+	 * Take the references before handing the list over, so that tx
+	 * completions of the head of the list can not underflow the count
+	 */
+	atomic_add(cnt, &hdd_ipa->tx_ref_cnt);
+
+	skb = ol_tx_send_ipa_data_frame_list(iface_context->tl_context, head);
+	while (skb) {
+		head = cdf_nbuf_next(skb);
+		ipa_free_skb((struct ipa_rx_data *)NBUF_OWNER_PRIV_DATA(skb));
+		unsent++;
+		skb = head;
+	}
+
+	hdd_ipa->stats.num_tx_pm_batch++;
+	iface_context->stats.num_tx += cnt - unsent;
+	if (unsent) {
+		HDD_IPA_LOG(CDF_TRACE_LEVEL_DEBUG, "TLSHIM tx fail: %u/%u",
+			    unsent, cnt);
+		iface_context->stats.num_tx_err += unsent;
+		atomic_sub(unsent, &hdd_ipa->tx_ref_cnt);
+		hdd_ipa_rm_try_release(hdd_ipa);
+	}
+}
+
 /**
  * hdd_ipa_pm_send_pkt_to_tl() - Send queued packets to TL
  * @work: pointer to the scheduled work
  *
  * Called during PM resume to send packets to TL which were queued
- * while host was in the process of suspending.
+ * while host was in the process of suspending. The pending queue is taken
+ * over as a whole under one hold of pm_lock, sorted per interface and
+ * each interface's packets are sent to TL as one batch.
  *
  * Return: None
  */
@@ -2720,26 +3062,42 @@ static void hdd_ipa_pm_send_pkt_to_tl(struct work_struct *work)
 						    struct hdd_ipa_priv,
 						    pm_work);
 	struct hdd_ipa_pm_tx_cb *pm_tx_cb = NULL;
+	cdf_nbuf_queue_t pm_queue;
+	cdf_nbuf_queue_t iface_q[HDD_IPA_MAX_IFACE];
 	cdf_nbuf_t skb;
 	uint32_t dequeued = 0;
+	int i;
 
-	cdf_spin_lock_bh(&hdd_ipa->pm_lock);
+	for (i = 0; i < HDD_IPA_MAX_IFACE; i++)
+		cdf_nbuf_queue_init(&iface_q[i]);
 
-	while (((skb = cdf_nbuf_queue_remove(&hdd_ipa->pm_queue_head)) != NULL)) {
+	/* Packets may still be queued until resume clears the suspend flag */
+	while (1) {
+		cdf_spin_lock_bh(&hdd_ipa->pm_lock);
+		pm_queue = hdd_ipa->pm_queue_head;
+		cdf_nbuf_queue_init(&hdd_ipa->pm_queue_head);
 		cdf_spin_unlock_bh(&hdd_ipa->pm_lock);
 
-		pm_tx_cb = (struct hdd_ipa_pm_tx_cb *)skb->cb;
+		if (cdf_nbuf_is_queue_empty(&pm_queue))
+			break;
 
-		dequeued++;
+		dequeued += cdf_nbuf_queue_len(&pm_queue);
 
-		hdd_ipa_send_pkt_to_tl(pm_tx_cb->iface_context,
-				       pm_tx_cb->ipa_tx_desc);
+		while ((skb = cdf_nbuf_queue_remove(&pm_queue)) != NULL) {
+			pm_tx_cb = (struct hdd_ipa_pm_tx_cb *)skb->cb;
+			cdf_nbuf_queue_add(
+				&iface_q[pm_tx_cb->iface_context->iface_id],
+				skb);
+		}
 
-		cdf_spin_lock_bh(&hdd_ipa->pm_lock);
+		for (i = 0; i < HDD_IPA_MAX_IFACE; i++) {
+			if (cdf_nbuf_is_queue_empty(&iface_q[i]))
+				continue;
+			hdd_ipa_send_pkt_list_to_tl(&hdd_ipa->iface_context[i],
+						    &iface_q[i]);
+		}
 	}
 
-	cdf_spin_unlock_bh(&hdd_ipa->pm_lock);
-
 	hdd_ipa->stats.num_tx_dequeued += dequeued;
 	if (dequeued > hdd_ipa->stats.num_max_pm_queue)
 		hdd_ipa->stats.num_max_pm_queue = dequeued;
@@ -3329,6 +3687,8 @@ static void hdd_ipa_clean_hdr(hdd_adapter_t *adapter)
  */
 static void hdd_ipa_cleanup_iface(struct hdd_ipa_iface_context *iface_context)
 {
+	cdf_nbuf_queue_t purge_q;
+
 	if (iface_context == NULL)
 		return;
 
@@ -3338,7 +3698,10 @@ static void hdd_ipa_cleanup_iface(struct hdd_ipa_iface_context *iface_context)
 	iface_context->adapter->ipa_context = NULL;
 	iface_context->adapter = NULL;
 	iface_context->tl_context = NULL;
+	/* exception packets still queued belong to the detached adapter */
+	hdd_ipa_excep_rx_take(iface_context, &purge_q);
 	cdf_spin_unlock_bh(&iface_context->interface_lock);
+	hdd_ipa_excep_rx_drop(iface_context->hdd_ipa, &purge_q);
 	iface_context->ifa_address = 0;
 	if (!iface_context->hdd_ipa->num_iface) {
 		HDD_IPA_LOG(CDF_TRACE_LEVEL_ERROR,
@@ -3997,6 +4360,7 @@ CDF_STATUS hdd_ipa_init(hdd_context_t *hdd_ctx)
 		iface_context->iface_id = i;
 		iface_context->adapter = NULL;
 		cdf_spinlock_init(&iface_context->interface_lock);
+		cdf_nbuf_queue_init(&iface_context->excep_rx_q);
 	}
 
 #ifdef CONFIG_CNSS
@@ -4007,6 +4371,14 @@ CDF_STATUS hdd_ipa_init(hdd_context_t *hdd_ctx)
 	cdf_spinlock_init(&hdd_ipa->pm_lock);
 	cdf_nbuf_queue_init(&hdd_ipa->pm_queue_head);
 
+#ifdef CONFIG_CNSS
+	cnss_init_work(&hdd_ipa->excep_work, hdd_ipa_excep_rx_poll);
+#else
+	INIT_WORK(&hdd_ipa->excep_work, hdd_ipa_excep_rx_poll);
+#endif
+	cdf_spinlock_init(&hdd_ipa->excep_lock);
+	hdd_ipa->excep_batch_size = hdd_ctx->config->IpaExcepBatchSize;
+
 	ret = hdd_ipa_setup_rm(hdd_ipa);
 	if (ret)
 		goto fail_setup_rm;
@@ -4041,6 +4413,7 @@ CDF_STATUS hdd_ipa_init(hdd_context_t *hdd_ctx)
 fail_create_sys_pipe:
 	hdd_ipa_destroy_rm_resource(hdd_ipa);
 fail_setup_rm:
+	cdf_spinlock_destroy(&hdd_ipa->excep_lock);
 	cdf_spinlock_destroy(&hdd_ipa->pm_lock);
 fail_get_resource:
 	cdf_mem_free(hdd_ipa);
@@ -4114,6 +4487,12 @@ CDF_STATUS hdd_ipa_cleanup(hdd_context_t *hdd_ctx)
 
 	cdf_spinlock_destroy(&hdd_ipa->pm_lock);
 
+#ifdef WLAN_OPEN_SOURCE
+	cancel_work_sync(&hdd_ipa->excep_work);
+#endif
+	hdd_ipa_excep_rx_purge(hdd_ipa);
+	cdf_spinlock_destroy(&hdd_ipa->excep_lock);
+
 	/* destory the interface lock */
 	for (i = 0; i < HDD_IPA_MAX_IFACE; i++) {
 		iface_context = &hdd_ipa->iface_context[i];
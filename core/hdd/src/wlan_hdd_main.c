@@ -1800,6 +1800,7 @@ static hdd_adapter_t *hdd_alloc_station_adapter(hdd_context_t *hdd_ctx,
 		init_completion(&adapter->tdls_link_establish_req_comp);
 #endif
 		init_completion(&adapter->change_country_code);
+		mutex_init(&adapter->stats_req_lock);
 
 
 		init_completion(&adapter->scan_info.abortscan_event_var);
@@ -3462,6 +3463,7 @@ void hdd_wlan_exit(hdd_context_t *hdd_ctx)
 		hddLog(CDF_TRACE_LEVEL_ERROR,
 		       FL("Cannot deallocate Bus bandwidth timer"));
 	}
+	pm_qos_remove_request(&hdd_ctx->bus_bw_pm_qos);
 #endif
 
 #ifdef FEATURE_WLAN_AP_AP_ACS_OPTIMIZE
@@ -3966,36 +3968,150 @@ static CDF_STATUS wlan_hdd_regulatory_init(hdd_context_t *hdd_ctx)
 }
 
 #ifdef MSM_PLATFORM
+/* Falling load is smoothed with a weight of 1 / 2^HDD_BUS_BW_EWMA_SHIFT */
+#define HDD_BUS_BW_EWMA_SHIFT		2
+/* Bytes counted as one packet when converting byte deltas to load */
+#define HDD_BUS_BW_BYTES_PER_PKT	1500
+/* CPU DMA latency requested while the bus is voted high, in us */
+#define HDD_BUS_BW_PM_QOS_LATENCY	DISABLE_KRAIT_IDLE_PS_VAL
+
+/**
+ * hdd_bus_bw_predict() - predict the load of the next compute interval
+ * @hdd_ctx: HDD context
+ * @packets: tx + rx packets seen in the last interval
+ * @bytes: tx + rx bytes seen in the last interval
+ *
+ * The load is the larger of the packet count and the byte count expressed
+ * in MTU sized packets, so that TSO/GRO aggregates and small packet floods
+ * are both accounted for. A rising load is followed at once (peak-hold) so
+ * the bus ramps up on the first busy interval, while a falling load decays
+ * through an EWMA so short gaps in traffic do not drop the vote.
+ *
+ * Return: predicted load in packets per interval
+ */
+static uint64_t hdd_bus_bw_predict(hdd_context_t *hdd_ctx,
+				   uint64_t packets, uint64_t bytes)
+{
+	uint64_t load = bytes;
+	uint64_t pred = hdd_ctx->bus_bw_load;
+
+	do_div(load, HDD_BUS_BW_BYTES_PER_PKT);
+	if (load < packets)
+		load = packets;
+
+	if (load >= pred)
+		pred = load;
+	else
+		pred -= (pred - load) >> HDD_BUS_BW_EWMA_SHIFT;
+
+	hdd_ctx->bus_bw_load = pred;
+	return pred;
+}
+
+#ifdef CONFIG_CNSS
+/**
+ * hdd_bus_bw_level_threshold() - load threshold of a bus bandwidth level
+ * @hdd_ctx: HDD context
+ * @level: bus bandwidth level
+ *
+ * Return: load above which @level is selected
+ */
+static uint64_t hdd_bus_bw_level_threshold(hdd_context_t *hdd_ctx,
+					   enum cnss_bus_width_type level)
+{
+	switch (level) {
+	case CNSS_BUS_WIDTH_HIGH:
+		return hdd_ctx->config->busBandwidthHighThreshold;
+	case CNSS_BUS_WIDTH_MEDIUM:
+		return hdd_ctx->config->busBandwidthMediumThreshold;
+	case CNSS_BUS_WIDTH_LOW:
+		return hdd_ctx->config->busBandwidthLowThreshold;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * hdd_bus_bw_next_level() - select the next bus bandwidth level
+ * @hdd_ctx: HDD context
+ * @load: predicted load
+ *
+ * The vote is raised as soon as @load crosses a threshold. It is lowered
+ * only after @load has stayed gBusBandwidthHysteresisPct below the
+ * threshold of the current level for gBusBandwidthDownHoldCount intervals.
+ *
+ * Return: bus bandwidth level to vote for
+ */
+static enum cnss_bus_width_type
+hdd_bus_bw_next_level(hdd_context_t *hdd_ctx, uint64_t load)
+{
+	struct hdd_config *cfg = hdd_ctx->config;
+	enum cnss_bus_width_type cur = hdd_ctx->cur_vote_level;
+	enum cnss_bus_width_type next;
+	uint64_t thresh;
+
+	if (load > cfg->busBandwidthHighThreshold)
+		next = CNSS_BUS_WIDTH_HIGH;
+	else if (load > cfg->busBandwidthMediumThreshold)
+		next = CNSS_BUS_WIDTH_MEDIUM;
+	else if (load > cfg->busBandwidthLowThreshold)
+		next = CNSS_BUS_WIDTH_LOW;
+	else
+		next = CNSS_BUS_WIDTH_NONE;
+
+	if (next >= cur) {
+		hdd_ctx->bus_bw_down_cnt = 0;
+		return next;
+	}
+
+	thresh = hdd_bus_bw_level_threshold(hdd_ctx, cur);
+	if (load * 100 > thresh * (100 - cfg->bus_bw_hysteresis_pct)) {
+		hdd_ctx->bus_bw_down_cnt = 0;
+		return cur;
+	}
+
+	if (++hdd_ctx->bus_bw_down_cnt <= cfg->bus_bw_down_hold_count)
+		return cur;
+
+	hdd_ctx->bus_bw_down_cnt = 0;
+	return next;
+}
+#endif
+
 void hdd_cnss_request_bus_bandwidth(hdd_context_t *hdd_ctx,
+			const uint64_t load,
 			const uint64_t tx_packets, const uint64_t rx_packets)
 {
 #ifdef CONFIG_CNSS
-	uint64_t total = tx_packets + rx_packets;
 	uint64_t temp_rx = 0;
 	uint64_t temp_tx = 0;
 	enum cnss_bus_width_type next_vote_level = CNSS_BUS_WIDTH_NONE;
 	enum wlan_tp_level next_rx_level = WLAN_SVC_TP_NONE;
 	enum wlan_tp_level next_tx_level = WLAN_SVC_TP_NONE;
 
+	next_vote_level = hdd_bus_bw_next_level(hdd_ctx, load);
 
-	if (total > hdd_ctx->config->busBandwidthHighThreshold)
-		next_vote_level = CNSS_BUS_WIDTH_HIGH;
-	else if (total > hdd_ctx->config->busBandwidthMediumThreshold)
-		next_vote_level = CNSS_BUS_WIDTH_MEDIUM;
-	else if (total > hdd_ctx->config->busBandwidthLowThreshold)
-		next_vote_level = CNSS_BUS_WIDTH_LOW;
-	else
-		next_vote_level = CNSS_BUS_WIDTH_NONE;
+	MTRACE(cdf_trace(CDF_MODULE_ID_HDD, TRACE_CODE_HDD_BUS_BW_VOTE,
+			 NO_SESSION, (next_vote_level << 28) |
+			 (uint32_t)min_t(uint64_t, load, 0x0fffffff)));
 
+	hdd_ctx->hdd_txrx_hist[hdd_ctx->hdd_txrx_hist_idx].predicted_load =
+							load;
 	hdd_ctx->hdd_txrx_hist[hdd_ctx->hdd_txrx_hist_idx].next_vote_level =
 							next_vote_level;
 
 	if (hdd_ctx->cur_vote_level != next_vote_level) {
 		hddLog(CDF_TRACE_LEVEL_DEBUG,
 		       FL(
-			  "trigger level %d, tx_packets: %lld, rx_packets: %lld"
+			  "trigger level %d, load: %llu, tx_packets: %lld, rx_packets: %lld"
 			 ),
-		       next_vote_level, tx_packets, rx_packets);
+		       next_vote_level, load, tx_packets, rx_packets);
+		if (next_vote_level == CNSS_BUS_WIDTH_HIGH)
+			pm_qos_update_request(&hdd_ctx->bus_bw_pm_qos,
+					      HDD_BUS_BW_PM_QOS_LATENCY);
+		else if (hdd_ctx->cur_vote_level == CNSS_BUS_WIDTH_HIGH)
+			pm_qos_update_request(&hdd_ctx->bus_bw_pm_qos,
+					      PM_QOS_DEFAULT_VALUE);
 		hdd_ctx->cur_vote_level = next_vote_level;
 		cnss_request_bus_bandwidth(next_vote_level);
 	}
@@ -4052,7 +4168,9 @@ static void hdd_bus_bw_compute_cbk(void *priv)
 	hdd_context_t *hdd_ctx = (hdd_context_t *) priv;
 	hdd_adapter_t *adapter = NULL;
 	uint64_t tx_packets = 0, rx_packets = 0;
+	uint64_t tx_bytes = 0, rx_bytes = 0;
 	uint64_t total_tx = 0, total_rx = 0;
+	uint64_t load;
 	hdd_adapter_list_node_t *adapterNode = NULL;
 	CDF_STATUS status = 0;
 	bool connected = false;
@@ -4086,6 +4204,10 @@ static void hdd_bus_bw_compute_cbk(void *priv)
 					      adapter->prev_tx_packets);
 		rx_packets += HDD_BW_GET_DIFF(adapter->stats.rx_packets,
 					      adapter->prev_rx_packets);
+		tx_bytes += HDD_BW_GET_DIFF(adapter->stats.tx_bytes,
+					    adapter->prev_tx_bytes);
+		rx_bytes += HDD_BW_GET_DIFF(adapter->stats.rx_bytes,
+					    adapter->prev_rx_bytes);
 
 		total_rx += adapter->stats.rx_packets;
 		total_tx += adapter->stats.tx_packets;
@@ -4093,6 +4215,8 @@ static void hdd_bus_bw_compute_cbk(void *priv)
 		spin_lock_bh(&hdd_ctx->bus_bw_lock);
 		adapter->prev_tx_packets = adapter->stats.tx_packets;
 		adapter->prev_rx_packets = adapter->stats.rx_packets;
+		adapter->prev_tx_bytes = adapter->stats.tx_bytes;
+		adapter->prev_rx_bytes = adapter->stats.rx_bytes;
 		spin_unlock_bh(&hdd_ctx->bus_bw_lock);
 		connected = true;
 	}
@@ -4114,7 +4238,9 @@ static void hdd_bus_bw_compute_cbk(void *priv)
 		return;
 	}
 
-	hdd_cnss_request_bus_bandwidth(hdd_ctx, tx_packets, rx_packets);
+	load = hdd_bus_bw_predict(hdd_ctx, tx_packets + rx_packets,
+				  tx_bytes + rx_bytes);
+	hdd_cnss_request_bus_bandwidth(hdd_ctx, load, tx_packets, rx_packets);
 
 	hdd_ipa_set_perf_level(hdd_ctx, tx_packets, rx_packets);
 	hdd_ipa_uc_stat_request(adapter, 2);
@@ -4149,15 +4275,16 @@ void wlan_hdd_display_tx_rx_histogram(hdd_context_t *hdd_ctx)
 #endif
 
 	hddLog(CDF_TRACE_LEVEL_ERROR,
-		"index, total_rx, interval_rx, total_tx, interval_tx, next_vote_level, next_rx_level, next_tx_level");
+		"index, total_rx, interval_rx, total_tx, interval_tx, predicted_load, next_vote_level, next_rx_level, next_tx_level");
 
 	for (i = 0; i < NUM_TX_RX_HISTOGRAM; i++) {
 		hddLog(CDF_TRACE_LEVEL_ERROR,
-			"%d: %llu, %llu, %llu, %llu, %d, %d, %d",
+			"%d: %llu, %llu, %llu, %llu, %llu, %d, %d, %d",
 			i, hdd_ctx->hdd_txrx_hist[i].total_rx,
 			hdd_ctx->hdd_txrx_hist[i].interval_rx,
 			hdd_ctx->hdd_txrx_hist[i].total_tx,
 			hdd_ctx->hdd_txrx_hist[i].interval_tx,
+			hdd_ctx->hdd_txrx_hist[i].predicted_load,
 			hdd_ctx->hdd_txrx_hist[i].next_vote_level,
 			hdd_ctx->hdd_txrx_hist[i].next_rx_level,
 			hdd_ctx->hdd_txrx_hist[i].next_tx_level);
@@ -5396,6 +5523,8 @@ ftm_processing:
 	cdf_mc_timer_init(&hdd_ctx->bus_bw_timer,
 			  CDF_TIMER_TYPE_SW,
 			  hdd_bus_bw_compute_cbk, (void *)hdd_ctx);
+	pm_qos_add_request(&hdd_ctx->bus_bw_pm_qos, PM_QOS_CPU_DMA_LATENCY,
+			   PM_QOS_DEFAULT_VALUE);
 #endif
 
 #ifdef WLAN_FEATURE_STATS_EXT
@@ -5469,6 +5598,11 @@ err_nl_srv:
 #endif /* WLAN_KD_READY_NOTIFIER */
 	nl_srv_exit();
 
+#ifdef MSM_PLATFORM
+	if (pm_qos_request_active(&hdd_ctx->bus_bw_pm_qos))
+		pm_qos_remove_request(&hdd_ctx->bus_bw_pm_qos);
+#endif
+
 	if (!CDF_IS_STATUS_SUCCESS
 			(cdf_mutex_destroy(&hdd_ctx->hdd_conc_list_lock))) {
 		hdd_err("Failed to destroy hdd_conc_list_lock");
@@ -5768,6 +5902,7 @@ static void hdd_driver_exit(void)
 	memdump_deinit();
 
 	wlan_hdd_unregister_driver();
+	cdf_timer_module_deinit();
 	return;
 }
 
@@ -6450,6 +6585,31 @@ hdd_adapter_t *hdd_get_con_sap_adapter(hdd_adapter_t *this_sap_adapter,
 }
 
 #ifdef MSM_PLATFORM
+/**
+ * hdd_bus_bw_reset_vote() - drop the bus bandwidth vote of the governor
+ * @hdd_ctx: HDD context
+ *
+ * Called once the compute timer is stopped so that the next connection
+ * starts from an idle prediction instead of the load and vote left by the
+ * previous one, and the CPU DMA latency request does not outlive traffic.
+ *
+ * Return: none
+ */
+static void hdd_bus_bw_reset_vote(hdd_context_t *hdd_ctx)
+{
+	hdd_ctx->bus_bw_load = 0;
+	hdd_ctx->bus_bw_down_cnt = 0;
+#ifdef CONFIG_CNSS
+	if (hdd_ctx->cur_vote_level == CNSS_BUS_WIDTH_HIGH)
+		pm_qos_update_request(&hdd_ctx->bus_bw_pm_qos,
+				      PM_QOS_DEFAULT_VALUE);
+	if (hdd_ctx->cur_vote_level != CNSS_BUS_WIDTH_NONE) {
+		hdd_ctx->cur_vote_level = CNSS_BUS_WIDTH_NONE;
+		cnss_request_bus_bandwidth(CNSS_BUS_WIDTH_NONE);
+	}
+#endif
+}
+
 void hdd_start_bus_bw_compute_timer(hdd_adapter_t *adapter)
 {
 	hdd_context_t *hdd_ctx = WLAN_HDD_GET_CTX(adapter);
@@ -6506,8 +6666,10 @@ void hdd_stop_bus_bw_compute_timer(hdd_adapter_t *adapter)
 		}
 	}
 
-	if (can_stop == true)
+	if (can_stop == true) {
 		cdf_mc_timer_stop(&hdd_ctx->bus_bw_timer);
+		hdd_bus_bw_reset_vote(hdd_ctx);
+	}
 }
 #endif
 
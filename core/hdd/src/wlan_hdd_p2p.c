@@ -2602,6 +2602,7 @@ void hdd_indicate_mgmt_frame(hdd_adapter_t *pAdapter,
 			sme_update_dsc_pto_up_mapping(pHddCtx->hHal,
 						      pAdapter->hddWmmDscpToUpMap,
 						      pAdapter->sessionId);
+			hdd_wmm_update_dscp_class(pAdapter);
 		}
 	}
 	/* Indicate Frame Over Normal Interface */
@@ -67,6 +67,7 @@
 
 #include <wma_types.h>
 #include "hif.h"
+#include "bmi.h"
 #include "sme_power_save_api.h"
 #include "cds_concurrency.h"
 
@@ -1613,7 +1614,8 @@ CDF_STATUS hdd_wlan_re_init(void *hif_sc)
 
 	hif_enable_power_gating(hif_sc);
 	hddLog(LOGE,
-		"%s: WLAN host driver reinitiation completed!", __func__);
+		"%s: WLAN host driver reinitiation completed! fw image cache saved %u ms",
+		__func__, ol_fw_cache_saved_ms());
 	goto success;
 
 err_cds_disable:
@@ -278,8 +278,11 @@ int hdd_softap_hard_start_xmit(struct sk_buff *skb, struct net_device *dev)
 	}
 #endif
 
-	wlan_hdd_log_eapol(skb,
-			   WIFI_EVENT_DRIVER_EAPOL_FRAME_TRANSMIT_REQUESTED);
+	/* Zero out skb's context buffer for the driver to use */
+	cdf_mem_set(skb->cb, sizeof(skb->cb), 0);
+	if (hdd_tx_classify_pkt(skb) & NBUF_TX_PKT_CLASS_EAPOL)
+		wlan_hdd_log_eapol(skb,
+			WIFI_EVENT_DRIVER_EAPOL_FRAME_TRANSMIT_REQUESTED);
 
 #ifdef QCA_PKT_PROTO_TRACE
 	if ((hddCtxt->config->gEnableDebugLog & CDS_PKT_TRAC_TYPE_EAPOL) ||
@@ -298,8 +301,6 @@ int hdd_softap_hard_start_xmit(struct sk_buff *skb, struct net_device *dev)
 	pAdapter->stats.tx_bytes += skb->len;
 	++pAdapter->stats.tx_packets;
 
-	/* Zero out skb's context buffer for the driver to use */
-	cdf_mem_set(skb->cb, sizeof(skb->cb), 0);
 	NBUF_SET_PACKET_TRACK(skb, NBUF_TX_PKT_DATA_TRACK);
 	NBUF_UPDATE_TX_PKT_COUNT(skb, NBUF_TX_PKT_HDD);
 
@@ -1338,33 +1338,35 @@ void wlan_hdd_tdls_extract_sa(struct sk_buff *skb, uint8_t *mac)
 }
 
 /**
- * wlan_hdd_tdls_increment_pkt_count() - update statistics counter on tdls peer
- * @pAdapter: HDD adapter
- * @mac: MAC address of the TDLS peer
- * @tx: If 1, increment tx packet counter, if 0, increment rx packet counter
+ * wlan_hdd_tdls_get_pkt_count() - read the tx/rx counters of a tdls peer
+ * @curr_peer: TDLS peer
+ * @tx_pkt: filled with the tx frame count since the last reset
+ * @rx_pkt: filled with the rx frame count since the last reset
  *
- * Return: 0 for success or negative errno otherwise
+ * The frames are counted per CPU on the txrx peer as they are sent and
+ * delivered, so TDLS adds no per-frame cost; the counters are summed here
+ * on the slow path and offset by the baseline taken at the last reset.
+ *
+ * Return: 0 for success or negative errno if the peer has no data path
  */
-int wlan_hdd_tdls_increment_pkt_count(hdd_adapter_t *pAdapter,
-				      const uint8_t *mac, uint8_t tx)
+int wlan_hdd_tdls_get_pkt_count(hddTdlsPeer_t *curr_peer,
+				uint32_t *tx_pkt, uint32_t *rx_pkt)
 {
-	hddTdlsPeer_t *curr_peer;
-	hdd_context_t *pHddCtx = WLAN_HDD_GET_CTX(pAdapter);
+	CDF_STATUS status;
 
-	if (eTDLS_SUPPORT_ENABLED != pHddCtx->tdls_mode)
-		return -EINVAL;
+	*tx_pkt = 0;
+	*rx_pkt = 0;
 
-	curr_peer = wlan_hdd_tdls_get_peer(pAdapter, mac);
-	if (curr_peer == NULL) {
-		hddLog(LOG1, FL("curr_peer is NULL"));
+	if (!curr_peer->staId)
 		return -EINVAL;
-	}
 
-	if (tx)
-		curr_peer->tx_pkt++;
-	else
-		curr_peer->rx_pkt++;
+	status = ol_txrx_peer_pkt_cnt_get(cds_get_context(CDF_MODULE_ID_TXRX),
+					  curr_peer->staId, tx_pkt, rx_pkt);
+	if (!CDF_IS_STATUS_SUCCESS(status))
+		return cdf_status_to_os_return(status);
 
+	*tx_pkt -= curr_peer->tx_pkt_base;
+	*rx_pkt -= curr_peer->rx_pkt_base;
 	return 0;
 }
 
@@ -1454,13 +1456,17 @@ static void wlan_tdd_tdls_reset_tx_rx(tdlsCtx_t *pHddTdlsCtx)
 	struct list_head *head;
 	hddTdlsPeer_t *tmp;
 	struct list_head *pos, *q;
+	ol_txrx_pdev_handle pdev = cds_get_context(CDF_MODULE_ID_TXRX);
 
 	for (i = 0; i < TDLS_PEER_LIST_SIZE; i++) {
 		head = &pHddTdlsCtx->peer_list[i];
 		list_for_each_safe(pos, q, head) {
 			tmp = list_entry(pos, hddTdlsPeer_t, node);
-			tmp->tx_pkt = 0;
-			tmp->rx_pkt = 0;
+			/* the txrx counters only grow; move the baseline */
+			if (tmp->staId)
+				ol_txrx_peer_pkt_cnt_get(pdev, tmp->staId,
+							 &tmp->tx_pkt_base,
+							 &tmp->rx_pkt_base);
 		}
 	}
 
@@ -1828,6 +1834,9 @@ int wlan_hdd_tdls_set_sta_id(hdd_adapter_t *pAdapter, const uint8_t *mac,
 	}
 
 	curr_peer->staId = staId;
+	/* a new txrx peer starts counting from zero */
+	curr_peer->tx_pkt_base = 0;
+	curr_peer->rx_pkt_base = 0;
 
 	return 0;
 }
@@ -2098,6 +2107,7 @@ int wlan_hdd_tdls_get_all_peers(hdd_adapter_t *pAdapter, char *buf, int buflen)
 	hddTdlsPeer_t *curr_peer;
 	tdlsCtx_t *pHddTdlsCtx;
 	hdd_context_t *pHddCtx = WLAN_HDD_GET_CTX(pAdapter);
+	uint32_t tx_pkt, rx_pkt;
 
 	ENTER();
 
@@ -2105,12 +2115,13 @@ int wlan_hdd_tdls_get_all_peers(hdd_adapter_t *pAdapter, char *buf, int buflen)
 		return 0;
 
 	init_len = buflen;
-	len = scnprintf(buf, buflen, "\n%-18s%-3s%-4s%-3s%-5s\n",
-			"MAC", "Id", "cap", "up", "RSSI");
+	len = scnprintf(buf, buflen, "\n%-18s%-3s%-4s%-3s%-5s%-9s%-9s\n",
+			"MAC", "Id", "cap", "up", "RSSI", "tx", "rx");
 	buf += len;
 	buflen -= len;
 	/*                           1234567890123456789012345678901234567 */
-	len = scnprintf(buf, buflen, "---------------------------------\n");
+	len = scnprintf(buf, buflen,
+			"-----------------------------------------------------\n");
 	buf += len;
 	buflen -= len;
 
@@ -2128,16 +2139,18 @@ int wlan_hdd_tdls_get_all_peers(hdd_adapter_t *pAdapter, char *buf, int buflen)
 		list_for_each(pos, head) {
 			curr_peer = list_entry(pos, hddTdlsPeer_t, node);
 
-			if (buflen < 32 + 1)
+			if (buflen < 52 + 1)
 				break;
+			wlan_hdd_tdls_get_pkt_count(curr_peer, &tx_pkt,
+						    &rx_pkt);
 			len = scnprintf(buf, buflen,
-					MAC_ADDRESS_STR "%3d%4s%3s%5d\n",
+					MAC_ADDRESS_STR "%3d%4s%3s%5d%9u%9u\n",
 					MAC_ADDR_ARRAY(curr_peer->peerMac),
 					curr_peer->staId,
 					(curr_peer->tdls_support ==
 					 eTDLS_CAP_SUPPORTED) ? "Y" : "N",
 					TDLS_IS_CONNECTED(curr_peer) ? "Y" :
-					"N", curr_peer->rssi);
+					"N", curr_peer->rssi, tx_pkt, rx_pkt);
 			buf += len;
 			buflen -= len;
 		}
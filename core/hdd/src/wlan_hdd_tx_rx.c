@@ -249,34 +249,35 @@ static bool wlan_hdd_is_eapol(struct sk_buff *skb)
 }
 
 /**
- * wlan_hdd_is_eapol_or_wai() - Check if frame is EAPOL or WAPI
+ * hdd_tx_classify_pkt() - classify a tx frame and cache the result
  * @skb:    skb data
  *
- * This function checks if the frame is EAPOL or WAPI.
- * single routine call will check for both types, thus avoiding
- * data path performance penalty.
- *
- * Return: true (1) if packet is EAPOL or WAPI
+ * Checks once whether the frame is EAPOL or WAPI and stores the result
+ * in the nbuf control block, so that the rest of the tx path (the WMM
+ * admission check, EAPOL logging and the paused queue in
+ * ol_tx_ll_queue()) can test the cached flags rather than parsing the
+ * frame again. Must be called after skb->cb has been cleared for driver
+ * use; the classification done in ndo_select_queue cannot be carried over
+ * in skb->cb since the qdisc owns it until the frame is handed to
+ * hard_start_xmit.
  *
+ * Return: NBUF_TX_PKT_CLASS_* flags of the frame
  */
-static bool wlan_hdd_is_eapol_or_wai(struct sk_buff *skb)
+uint8_t hdd_tx_classify_pkt(struct sk_buff *skb)
 {
 	uint16_t ether_type;
-
-	if (!skb) {
-		hdd_err(FL("skb is NULL"));
-		return false;
-	}
+	uint8_t pkt_class = NBUF_TX_PKT_CLASS_VALID;
 
 	ether_type = (uint16_t)(*(uint16_t *)
 			(skb->data + HDD_ETHERTYPE_802_1_X_FRAME_OFFSET));
 
-	if (ether_type == CDF_SWAP_U16(HDD_ETHERTYPE_802_1_X) ||
-	    ether_type == CDF_SWAP_U16(HDD_ETHERTYPE_WAI))
-		return true;
+	if (ether_type == CDF_SWAP_U16(HDD_ETHERTYPE_802_1_X))
+		pkt_class |= NBUF_TX_PKT_CLASS_EAPOL;
+	else if (ether_type == CDF_SWAP_U16(HDD_ETHERTYPE_WAI))
+		pkt_class |= NBUF_TX_PKT_CLASS_WAI;
 
-	/* No error msg handled since this will happen often */
-	return false;
+	cdf_nbuf_set_tx_pkt_class(skb, pkt_class);
+	return pkt_class;
 }
 
 /**
@@ -300,6 +301,7 @@ int hdd_hard_start_xmit(struct sk_buff *skb, struct net_device *dev)
 	uint8_t STAId = WLAN_MAX_STA_COUNT;
 	hdd_station_ctx_t *pHddStaCtx = &pAdapter->sessionCtx.station;
 	uint8_t proto_type = 0;
+	uint8_t pkt_class;
 #ifdef QCA_PKT_PROTO_TRACE
 	hdd_context_t *hddCtxt = WLAN_HDD_GET_CTX(pAdapter);
 #endif /* QCA_PKT_PROTO_TRACE */
@@ -373,6 +375,10 @@ int hdd_hard_start_xmit(struct sk_buff *skb, struct net_device *dev)
 		}
 	}
 
+	/* Zero out skb's context buffer for the driver to use */
+	cdf_mem_set(skb->cb, sizeof(skb->cb), 0);
+	pkt_class = hdd_tx_classify_pkt(skb);
+
 	/* user priority from IP header, which is already extracted and set from
 	 * select_queue call back function
 	 */
@@ -401,7 +407,8 @@ int hdd_hard_start_xmit(struct sk_buff *skb, struct net_device *dev)
 		likely(pAdapter->hddWmmStatus.wmmAcStatus[ac].
 			wmmAcAccessAllowed)) ||
 		((pHddStaCtx->conn_info.uIsAuthenticated == false) &&
-		 wlan_hdd_is_eapol_or_wai(skb))) {
+		 (pkt_class & (NBUF_TX_PKT_CLASS_EAPOL |
+			       NBUF_TX_PKT_CLASS_WAI)))) {
 		granted = true;
 	} else {
 		status = hdd_wmm_acquire_access(pAdapter, ac, &granted);
@@ -443,8 +450,9 @@ int hdd_hard_start_xmit(struct sk_buff *skb, struct net_device *dev)
 		skb->queue_mapping = hdd_linux_up_to_ac_map[up];
 	}
 
-	wlan_hdd_log_eapol(skb,
-			   WIFI_EVENT_DRIVER_EAPOL_FRAME_TRANSMIT_REQUESTED);
+	if (pkt_class & NBUF_TX_PKT_CLASS_EAPOL)
+		wlan_hdd_log_eapol(skb,
+			WIFI_EVENT_DRIVER_EAPOL_FRAME_TRANSMIT_REQUESTED);
 
 #ifdef QCA_PKT_PROTO_TRACE
 	if ((hddCtxt->config->gEnableDebugLog & CDS_PKT_TRAC_TYPE_EAPOL) ||
@@ -463,8 +471,6 @@ int hdd_hard_start_xmit(struct sk_buff *skb, struct net_device *dev)
 	pAdapter->stats.tx_bytes += skb->len;
 	++pAdapter->stats.tx_packets;
 
-	/* Zero out skb's context buffer for the driver to use */
-	cdf_mem_set(skb->cb, sizeof(skb->cb), 0);
 	NBUF_SET_PACKET_TRACK(skb, NBUF_TX_PKT_DATA_TRACK);
 	NBUF_UPDATE_TX_PKT_COUNT(skb, NBUF_TX_PKT_HDD);
 
@@ -776,7 +782,12 @@ static int wlan_hdd_get_eapol_params(struct sk_buff *skb,
 	bool ret;
 	uint8_t packet_type;
 
-	ret = wlan_hdd_is_eapol(skb);
+	/* tx frames were classified by hdd_tx_classify_pkt() */
+	if (event_type == WIFI_EVENT_DRIVER_EAPOL_FRAME_TRANSMIT_REQUESTED &&
+	    (cdf_nbuf_get_tx_pkt_class(skb) & NBUF_TX_PKT_CLASS_VALID))
+		ret = cdf_nbuf_get_tx_pkt_class(skb) & NBUF_TX_PKT_CLASS_EAPOL;
+	else
+		ret = wlan_hdd_is_eapol(skb);
 
 	if (!ret)
 		return -EINVAL;
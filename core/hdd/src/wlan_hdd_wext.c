@@ -368,6 +368,7 @@ static const hdd_freq_chan_map_t freq_chan_map[] = {
 
 #define WE_SET_DUAL_MAC_SCAN_CONFIG    21
 #define WE_SET_DUAL_MAC_FW_MODE_CONFIG 22
+#define WE_SME_CMD_QUEUE_UT_CMD        23
 
 #ifdef FEATURE_WLAN_TDLS
 #undef  MAX_VAR_ARGS
@@ -955,6 +956,39 @@ static bool hdd_is_auth_type_rsn(eCsrAuthType authType)
 	return rsnType;
 }
 
+/**
+ * hdd_stats_fresh() - check whether cached stats may be returned
+ * @adapter: adapter the stats belong to
+ * @updated: jiffies at which the stats were last refreshed, 0 if never
+ *
+ * Return: true if @updated lies within the configured freshness window
+ */
+static bool hdd_stats_fresh(hdd_adapter_t *adapter, unsigned long updated)
+{
+	uint32_t window = WLAN_HDD_GET_CTX(adapter)->config->stats_cache_time;
+
+	if (!window || !updated)
+		return false;
+
+	return time_in_range(jiffies, updated,
+			     updated + msecs_to_jiffies(window));
+}
+
+/**
+ * hdd_stats_cache_invalidate() - force the next stats readers to query FW
+ * @adapter: adapter whose cached RSSI and station stats are dropped
+ *
+ * Return: None
+ */
+void hdd_stats_cache_invalidate(hdd_adapter_t *adapter)
+{
+	spin_lock(&hdd_context_lock);
+	adapter->rssi_updated = 0;
+	adapter->class_a_updated = 0;
+	adapter->summary_updated = 0;
+	spin_unlock(&hdd_context_lock);
+}
+
 /**
  * hdd_get_rssi_cb() - "Get RSSI" callback function
  * @rssi: Current RSSI of the station
@@ -1016,6 +1050,7 @@ static void hdd_get_rssi_cb(int8_t rssi, uint32_t staId, void *pContext)
 
 	if (pAdapter->rssi > 0)
 		pAdapter->rssi = 0;
+	pAdapter->rssi_updated = jiffies;
 
 	/* notify the caller */
 	complete(&pStatsContext->completion);
@@ -1132,6 +1167,19 @@ CDF_STATUS wlan_hdd_get_rssi(hdd_adapter_t *pAdapter, int8_t *rssi_value)
 		return CDF_STATUS_SUCCESS;
 	}
 
+	if (hdd_stats_fresh(pAdapter, pAdapter->rssi_updated)) {
+		*rssi_value = pAdapter->rssi;
+		return CDF_STATUS_SUCCESS;
+	}
+
+	/* a concurrent reader may refresh the RSSI while we wait here */
+	mutex_lock(&pAdapter->stats_req_lock);
+	if (hdd_stats_fresh(pAdapter, pAdapter->rssi_updated)) {
+		mutex_unlock(&pAdapter->stats_req_lock);
+		*rssi_value = pAdapter->rssi;
+		return CDF_STATUS_SUCCESS;
+	}
+
 	init_completion(&context.completion);
 	context.pAdapter = pAdapter;
 	context.magic = RSSI_CONTEXT_MAGIC;
@@ -1172,6 +1220,7 @@ CDF_STATUS wlan_hdd_get_rssi(hdd_adapter_t *pAdapter, int8_t *rssi_value)
 	spin_lock(&hdd_context_lock);
 	context.magic = 0;
 	spin_unlock(&hdd_context_lock);
+	mutex_unlock(&pAdapter->stats_req_lock);
 
 	*rssi_value = pAdapter->rssi;
 
@@ -3327,6 +3376,7 @@ static void hdd_get_class_a_statistics_cb(void *pStats, void *pContext)
 
 	/* copy over the stats. do so as a struct copy */
 	pAdapter->hdd_stats.ClassA_stat = *pClassAStats;
+	pAdapter->class_a_updated = jiffies;
 
 	/* notify the caller */
 	complete(&pStatsContext->completion);
@@ -3358,6 +3408,16 @@ CDF_STATUS wlan_hdd_get_class_astats(hdd_adapter_t *pAdapter)
 		return CDF_STATUS_SUCCESS;
 	}
 
+	if (hdd_stats_fresh(pAdapter, pAdapter->class_a_updated))
+		return CDF_STATUS_SUCCESS;
+
+	/* a concurrent reader may refresh the stats while we wait here */
+	mutex_lock(&pAdapter->stats_req_lock);
+	if (hdd_stats_fresh(pAdapter, pAdapter->class_a_updated)) {
+		mutex_unlock(&pAdapter->stats_req_lock);
+		return CDF_STATUS_SUCCESS;
+	}
+
 	/* we are connected so prepare our callback context */
 	init_completion(&context.completion);
 	context.pAdapter = pAdapter;
@@ -3401,6 +3461,7 @@ CDF_STATUS wlan_hdd_get_class_astats(hdd_adapter_t *pAdapter)
 	spin_lock(&hdd_context_lock);
 	context.magic = 0;
 	spin_unlock(&hdd_context_lock);
+	mutex_unlock(&pAdapter->stats_req_lock);
 
 	/* either callback updated pAdapter stats or it has cached data */
 	return CDF_STATUS_SUCCESS;
@@ -3467,6 +3528,8 @@ static void hdd_get_station_statistics_cb(void *pStats, void *pContext)
 	/* copy over the stats. do so as a struct copy */
 	pAdapter->hdd_stats.summary_stat = *pSummaryStats;
 	pAdapter->hdd_stats.ClassA_stat = *pClassAStats;
+	pAdapter->summary_updated = jiffies;
+	pAdapter->class_a_updated = pAdapter->summary_updated;
 
 	/* notify the caller */
 	complete(&pStatsContext->completion);
@@ -3493,6 +3556,16 @@ CDF_STATUS wlan_hdd_get_station_stats(hdd_adapter_t *pAdapter)
 		return CDF_STATUS_SUCCESS;
 	}
 
+	if (hdd_stats_fresh(pAdapter, pAdapter->summary_updated))
+		return CDF_STATUS_SUCCESS;
+
+	/* a concurrent reader may refresh the stats while we wait here */
+	mutex_lock(&pAdapter->stats_req_lock);
+	if (hdd_stats_fresh(pAdapter, pAdapter->summary_updated)) {
+		mutex_unlock(&pAdapter->stats_req_lock);
+		return CDF_STATUS_SUCCESS;
+	}
+
 	/* we are connected so prepare our callback context */
 	init_completion(&context.completion);
 	context.pAdapter = pAdapter;
@@ -3540,6 +3613,7 @@ CDF_STATUS wlan_hdd_get_station_stats(hdd_adapter_t *pAdapter)
 	spin_lock(&hdd_context_lock);
 	context.magic = 0;
 	spin_unlock(&hdd_context_lock);
+	mutex_unlock(&pAdapter->stats_req_lock);
 
 	/* either callback updated pAdapter stats or it has cached data */
 	return CDF_STATUS_SUCCESS;
@@ -7890,11 +7964,22 @@ static int __iw_set_var_ints_getnone(struct net_device *dev,
 			/* MCC on same band with 1x1 same mac */
 			wlan_hdd_three_connections_scenario(hdd_ctx,
 				36, 149, CDS_ONE_ONE, 1);
+		} else if (apps_args[0] == 4) {
+			/* time cached vs computed concurrency decisions */
+			wlan_hdd_conc_decision_benchmark(hdd_ctx);
 		}
 		print_report(hdd_ctx);
 	}
 	break;
 
+	case WE_SME_CMD_QUEUE_UT_CMD:
+	{
+		hddLog(LOGE,
+			FL("<iwpriv wlan0 sme_cmdq_ut> is called\n"));
+		sme_cmd_queue_stress_test(hHal, apps_args[0]);
+	}
+	break;
+
 #ifdef FEATURE_WLAN_TDLS
 	case WE_TDLS_CONFIG_PARAMS:
 	{
@@ -10603,6 +10688,11 @@ static const struct iw_priv_args we_private_args[] = {
 	 IW_PRIV_TYPE_INT | MAX_VAR_ARGS,
 	 0,
 	 "pm_set_hw_mode"},
+
+	{WE_SME_CMD_QUEUE_UT_CMD,
+	 IW_PRIV_TYPE_INT | MAX_VAR_ARGS,
+	 0,
+	 "sme_cmdq_ut"},
 #endif
 #ifdef FEATURE_WLAN_TDLS
 	/* handlers for sub ioctl */
@@ -1395,9 +1395,35 @@ CDF_STATUS hdd_wmm_init(hdd_adapter_t *pAdapter)
 	/* Special case for Expedited Forwarding (DSCP 46) */
 	hddWmmDscpToUpMap[46] = SME_QOS_WMM_UP_VO;
 
+	hdd_wmm_update_dscp_class(pAdapter);
+
 	return CDF_STATUS_SUCCESS;
 }
 
+/**
+ * hdd_wmm_update_dscp_class() - rebuild the DSCP classification table
+ * @adapter: adapter whose DSCP to UP map has changed
+ *
+ * Folds the DSCP to UP map and the UP to netdev queue map into a single
+ * table so the transmit path resolves both with one lookup.
+ *
+ * Return: None
+ */
+void hdd_wmm_update_dscp_class(hdd_adapter_t *adapter)
+{
+	uint8_t dscp;
+	sme_QosWmmUpType up;
+
+	for (dscp = 0; dscp <= WLAN_HDD_MAX_DSCP; dscp++) {
+		up = adapter->hddWmmDscpToUpMap[dscp];
+		if (up >= HDD_WMM_UP_TO_AC_MAP_SIZE)
+			up = SME_QOS_WMM_UP_BE;
+		adapter->hdd_wmm_dscp_class[dscp] =
+			(hdd_linux_up_to_ac_map[up] <<
+			 HDD_WMM_CLASS_QUEUE_SHIFT) | up;
+	}
+}
+
 /**
  * hdd_wmm_adapter_init() - initialize the WMM configuration of an adapter
  * @pAdapter: [in]  pointer to Adapter context
@@ -1507,169 +1533,92 @@ CDF_STATUS hdd_wmm_adapter_close(hdd_adapter_t *pAdapter)
  *
  * @adapter: adapter upon which the packet is being transmitted
  * @skb: pointer to network buffer
- * @user_pri: user priority of the OS packet
  * @is_eapol: eapol packet flag
  *
- * Return: None
+ * The L2 protocol is read once and the common Ethernet II IPv4/IPv6
+ * cases are tested first; the resulting DSCP indexes the adapter's
+ * precomputed classification table.
+ *
+ * Return: packed user priority and queue index (HDD_WMM_CLASS_*)
  */
 static
-void hdd_wmm_classify_pkt(hdd_adapter_t *adapter,
-			  struct sk_buff *skb,
-			  sme_QosWmmUpType *user_pri,
-			  bool *is_eapol)
+uint8_t hdd_wmm_classify_pkt(hdd_adapter_t *adapter,
+			     struct sk_buff *skb,
+			     bool *is_eapol)
 {
+	unsigned char *pkt = skb->data;
+	union generic_ethhdr *eth_hdr = (union generic_ethhdr *)pkt;
+	__be16 proto = eth_hdr->eth_II.h_proto;
+	unsigned char tos = 0;
 	unsigned char dscp;
-	unsigned char tos;
-	union generic_ethhdr *eth_hdr;
-	struct iphdr *ip_hdr;
-	struct ipv6hdr *ipv6hdr;
-	unsigned char *pkt;
-
-	/* this code is executed for every packet therefore
-	 * all debug code is kept conditional
-	 */
-
-#ifdef HDD_WMM_DEBUG
-	CDF_TRACE(CDF_MODULE_ID_HDD, WMM_TRACE_LEVEL_INFO_LOW,
-		  "%s: Entered", __func__);
-#endif /* HDD_WMM_DEBUG */
 
-	pkt = skb->data;
-	eth_hdr = (union generic_ethhdr *)pkt;
-
-#ifdef HDD_WMM_DEBUG
-	CDF_TRACE(CDF_MODULE_ID_HDD, WMM_TRACE_LEVEL_INFO_LOW,
-		  "%s: proto is 0x%04x", __func__, skb->protocol);
-#endif /* HDD_WMM_DEBUG */
-
-	if (eth_hdr->eth_II.h_proto == htons(ETH_P_IP)) {
+	if (cdf_likely(proto == htons(ETH_P_IP))) {
 		/* case 1: Ethernet II IP packet */
-		ip_hdr = (struct iphdr *)&pkt[sizeof(eth_hdr->eth_II)];
-		tos = ip_hdr->tos;
-#ifdef HDD_WMM_DEBUG
-		CDF_TRACE(CDF_MODULE_ID_HDD, WMM_TRACE_LEVEL_INFO_LOW,
-				"%s: Ethernet II IP Packet, tos is %d",
-				__func__, tos);
-#endif /* HDD_WMM_DEBUG */
-
-	} else if (eth_hdr->eth_II.h_proto == htons(ETH_P_IPV6)) {
-		ipv6hdr = ipv6_hdr(skb);
-		tos = ntohs(*(const __be16 *)ipv6hdr) >> 4;
-#ifdef HDD_WMM_DEBUG
-		CDF_TRACE(CDF_MODULE_ID_HDD, WMM_TRACE_LEVEL_INFO_LOW,
-				"%s: Ethernet II IPv6 Packet, tos is %d",
-				__func__, tos);
-#endif /* HDD_WMM_DEBUG */
-	} else if ((ntohs(eth_hdr->eth_II.h_proto) < WLAN_MIN_PROTO) &&
-		  (eth_hdr->eth_8023.h_snap.dsap == WLAN_SNAP_DSAP) &&
-		  (eth_hdr->eth_8023.h_snap.ssap == WLAN_SNAP_SSAP) &&
-		  (eth_hdr->eth_8023.h_snap.ctrl == WLAN_SNAP_CTRL) &&
-		  (eth_hdr->eth_8023.h_proto == htons(ETH_P_IP))) {
-		/* case 2: 802.3 LLC/SNAP IP packet */
-		ip_hdr = (struct iphdr *)&pkt[sizeof(eth_hdr->eth_8023)];
-		tos = ip_hdr->tos;
-#ifdef HDD_WMM_DEBUG
-		CDF_TRACE(CDF_MODULE_ID_HDD, WMM_TRACE_LEVEL_INFO_LOW,
-				"%s: 802.3 LLC/SNAP IP Packet, tos is %d",
-				__func__, tos);
-#endif /* HDD_WMM_DEBUG */
-	} else if (eth_hdr->eth_II.h_proto == htons(ETH_P_8021Q)) {
-		/* VLAN tagged */
+		tos = ((struct iphdr *)&pkt[sizeof(eth_hdr->eth_II)])->tos;
+	} else if (proto == htons(ETH_P_IPV6)) {
+		tos = ntohs(*(const __be16 *)ipv6_hdr(skb)) >> 4;
+	} else if (proto == htons(HDD_ETHERTYPE_802_1_X)) {
+		/* Give the highest priority to 802.1x packet */
+		tos = 0xC0;
+		*is_eapol = true;
+	} else if (proto == htons(ETH_P_8021Q)) {
+		__be16 vlan_proto = eth_hdr->eth_IIv.h_vlan_encapsulated_proto;
 
-		if (eth_hdr->eth_IIv.h_vlan_encapsulated_proto ==
-			htons(ETH_P_IP)) {
+		if (vlan_proto == htons(ETH_P_IP)) {
 			/* case 3: Ethernet II vlan-tagged IP packet */
-			ip_hdr =
-				(struct iphdr *)
-				&pkt[sizeof(eth_hdr->eth_IIv)];
-			tos = ip_hdr->tos;
-#ifdef HDD_WMM_DEBUG
-			CDF_TRACE(CDF_MODULE_ID_HDD,
-				WMM_TRACE_LEVEL_INFO_LOW,
-				"%s: Ethernet II VLAN tagged IP Packet, tos is %d",
-				__func__, tos);
-#endif /* HDD_WMM_DEBUG */
-		} else
-		if ((ntohs(eth_hdr->eth_IIv.h_vlan_encapsulated_proto)
-			< WLAN_MIN_PROTO)
-		    && (eth_hdr->eth_8023v.h_snap.dsap ==
-			WLAN_SNAP_DSAP)
-			&& (eth_hdr->eth_8023v.h_snap.ssap ==
-			WLAN_SNAP_SSAP)
-			&& (eth_hdr->eth_8023v.h_snap.ctrl ==
-			WLAN_SNAP_CTRL)
-			&& (eth_hdr->eth_8023v.h_proto ==
-			htons(ETH_P_IP))) {
+			tos = ((struct iphdr *)
+			       &pkt[sizeof(eth_hdr->eth_IIv)])->tos;
+		} else if ((ntohs(vlan_proto) < WLAN_MIN_PROTO) &&
+			   (eth_hdr->eth_8023v.h_snap.dsap == WLAN_SNAP_DSAP) &&
+			   (eth_hdr->eth_8023v.h_snap.ssap == WLAN_SNAP_SSAP) &&
+			   (eth_hdr->eth_8023v.h_snap.ctrl == WLAN_SNAP_CTRL) &&
+			   (eth_hdr->eth_8023v.h_proto == htons(ETH_P_IP))) {
 			/* case 4: 802.3 LLC/SNAP vlan-tagged IP packet */
-			ip_hdr =
-				(struct iphdr *)
-				&pkt[sizeof(eth_hdr->eth_8023v)];
-			tos = ip_hdr->tos;
-#ifdef HDD_WMM_DEBUG
-			CDF_TRACE(CDF_MODULE_ID_HDD,
-				WMM_TRACE_LEVEL_INFO_LOW,
-				"%s: 802.3 LLC/SNAP VLAN tagged IP Packet, tos is %d",
-				__func__, tos);
-#endif /* HDD_WMM_DEBUG */
-		} else {
-			/* default */
-#ifdef HDD_WMM_DEBUG
-			CDF_TRACE(CDF_MODULE_ID_HDD,
-				WMM_TRACE_LEVEL_WARN,
-				"%s: VLAN tagged Unhandled Protocol, using default tos",
-				__func__);
-#endif /* HDD_WMM_DEBUG */
-			tos = 0;
+			tos = ((struct iphdr *)
+			       &pkt[sizeof(eth_hdr->eth_8023v)])->tos;
 		}
-	} else {
-		/* default */
-#ifdef HDD_WMM_DEBUG
-		CDF_TRACE(CDF_MODULE_ID_HDD, WMM_TRACE_LEVEL_WARN,
-			"%s: Unhandled Protocol, using default tos",
-			__func__);
-#endif /* HDD_WMM_DEBUG */
-		/* Give the highest priority to 802.1x packet */
-		if (eth_hdr->eth_II.h_proto ==
-			htons(HDD_ETHERTYPE_802_1_X)) {
-			tos = 0xC0;
-			*is_eapol = true;
-		} else
-			tos = 0;
+	} else if ((ntohs(proto) < WLAN_MIN_PROTO) &&
+		   (eth_hdr->eth_8023.h_snap.dsap == WLAN_SNAP_DSAP) &&
+		   (eth_hdr->eth_8023.h_snap.ssap == WLAN_SNAP_SSAP) &&
+		   (eth_hdr->eth_8023.h_snap.ctrl == WLAN_SNAP_CTRL) &&
+		   (eth_hdr->eth_8023.h_proto == htons(ETH_P_IP))) {
+		/* case 2: 802.3 LLC/SNAP IP packet */
+		tos = ((struct iphdr *)&pkt[sizeof(eth_hdr->eth_8023)])->tos;
 	}
 
 	dscp = (tos >> 2) & 0x3f;
-	*user_pri = adapter->hddWmmDscpToUpMap[dscp];
 
 #ifdef HDD_WMM_DEBUG
 	CDF_TRACE(CDF_MODULE_ID_HDD, WMM_TRACE_LEVEL_INFO,
-		"%s: tos is %d, dscp is %d, up is %d",
-		__func__, tos, dscp, *user_pri);
+		"%s: proto is 0x%04x, tos is %d, dscp is %d, class is 0x%02x",
+		__func__, ntohs(proto), tos, dscp,
+		adapter->hdd_wmm_dscp_class[dscp]);
 #endif /* HDD_WMM_DEBUG */
 
-	return;
+	return adapter->hdd_wmm_dscp_class[dscp];
 }
 
 #ifdef QCA_LL_TX_FLOW_CONTROL_V2
 /**
  * hdd_get_queue_index() - get queue index
- * @up: user priority
+ * @wmm_class: packed classification from hdd_wmm_classify_pkt()
  * @is_eapol: is_eapol flag
  *
  * Return: queue_index
  */
 static
-uint16_t hdd_get_queue_index(uint16_t up, bool is_eapol)
+uint16_t hdd_get_queue_index(uint8_t wmm_class, bool is_eapol)
 {
 	if (cdf_unlikely(is_eapol == true))
 		return HDD_LINUX_AC_HI_PRIO;
 	else
-		return hdd_linux_up_to_ac_map[up];
+		return HDD_WMM_CLASS_QUEUE(wmm_class);
 }
 #else
 static
-uint16_t hdd_get_queue_index(uint16_t up, bool is_eapol)
+uint16_t hdd_get_queue_index(uint8_t wmm_class, bool is_eapol)
 {
-	return hdd_linux_up_to_ac_map[up];
+	return HDD_WMM_CLASS_QUEUE(wmm_class);
 }
 #endif
 
@@ -1693,7 +1642,7 @@ uint16_t hdd_hostapd_select_queue(struct net_device *dev, struct sk_buff *skb
 
 )
 {
-	sme_QosWmmUpType up = SME_QOS_WMM_UP_BE;
+	uint8_t wmm_class;
 	uint16_t queueIndex;
 	hdd_adapter_t *adapter = (hdd_adapter_t *) netdev_priv(dev);
 	hdd_context_t *hddctx = WLAN_HDD_GET_CTX(adapter);
@@ -1707,9 +1656,9 @@ uint16_t hdd_hostapd_select_queue(struct net_device *dev, struct sk_buff *skb
 	}
 
 	/* Get the user priority from IP header */
-	hdd_wmm_classify_pkt(adapter, skb, &up, &is_eapol);
-	skb->priority = up;
-	queueIndex = hdd_get_queue_index(skb->priority, is_eapol);
+	wmm_class = hdd_wmm_classify_pkt(adapter, skb, &is_eapol);
+	skb->priority = HDD_WMM_CLASS_UP(wmm_class);
+	queueIndex = hdd_get_queue_index(wmm_class, is_eapol);
 
 	return queueIndex;
 }
@@ -1725,7 +1674,7 @@ uint16_t hdd_hostapd_select_queue(struct net_device *dev, struct sk_buff *skb
  */
 uint16_t hdd_wmm_select_queue(struct net_device *dev, struct sk_buff *skb)
 {
-	sme_QosWmmUpType up = SME_QOS_WMM_UP_BE;
+	uint8_t wmm_class;
 	uint16_t queueIndex;
 	hdd_adapter_t *pAdapter = WLAN_HDD_GET_PRIV_PTR(dev);
 	bool is_eapol = false;
@@ -1739,9 +1688,9 @@ uint16_t hdd_wmm_select_queue(struct net_device *dev, struct sk_buff *skb)
 	}
 
 	/* Get the user priority from IP header */
-	hdd_wmm_classify_pkt(pAdapter, skb, &up, &is_eapol);
-	skb->priority = up;
-	queueIndex = hdd_get_queue_index(skb->priority, is_eapol);
+	wmm_class = hdd_wmm_classify_pkt(pAdapter, skb, &is_eapol);
+	skb->priority = HDD_WMM_CLASS_UP(wmm_class);
+	queueIndex = hdd_get_queue_index(wmm_class, is_eapol);
 
 	return queueIndex;
 }
@@ -2020,9 +1969,10 @@ CDF_STATUS hdd_wmm_assoc(hdd_adapter_t *pAdapter,
 					       pAdapter->hddWmmDscpToUpMap,
 					       pAdapter->sessionId);
 
-	if (!CDF_IS_STATUS_SUCCESS(status)) {
+	if (!CDF_IS_STATUS_SUCCESS(status))
 		hdd_wmm_init(pAdapter);
-	}
+	else
+		hdd_wmm_update_dscp_class(pAdapter);
 
 	CDF_TRACE(CDF_MODULE_ID_HDD, WMM_TRACE_LEVEL_INFO_LOW,
 		  "%s: Exiting", __func__);
@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2015 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Userspace microbenchmark for the tx packet classification path.
+ *
+ * Runs a mix of Ethernet II IPv4/IPv6, VLAN-tagged IPv4, 802.3 LLC/SNAP
+ * IPv4, EAPOL, WAPI and ARP frames with random DSCP values through two
+ * engines:
+ *   reparse - what the tx path used to do: classify with the DSCP to UP
+ *             and UP to queue maps, then read the ethertype again for
+ *             the WMM admission check, for EAPOL logging and, while the
+ *             peer is unauthorized, in ol_tx_ll_queue
+ *   cached  - what it does now: classify with the packed per-adapter
+ *             DSCP class table, read the ethertype once in
+ *             hdd_tx_classify_pkt and cache the result in a control
+ *             block byte that the later stages test
+ * Each engine runs once with an authorized peer and once with the peer
+ * still unauthorized. Both engines must produce the same queue, UP and
+ * auth frame decisions; the run aborts if they do not.
+ *
+ * Build from the top of the driver tree:
+ *   cc -O2 -o hdd_tx_classify_bench core/hdd/tools/hdd_tx_classify_bench.c
+ *
+ * Usage: hdd_tx_classify_bench [num_frames [rounds]]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_FRAME_SZ          128
+#define BENCH_CB_SZ             48
+#define BENCH_DEF_FRAMES        4096
+#define BENCH_DEF_ROUNDS        500
+
+#define BENCH_ETH_HLEN          14
+#define BENCH_VLAN_HLEN         18
+#define BENCH_SNAP_HLEN         22
+#define BENCH_ETHERTYPE_OFFSET  12
+
+#define BENCH_ETH_P_IP          0x0800
+#define BENCH_ETH_P_IPV6        0x86DD
+#define BENCH_ETH_P_ARP         0x0806
+#define BENCH_ETH_P_8021Q       0x8100
+#define BENCH_ETH_P_EAPOL       0x888E
+#define BENCH_ETH_P_WAI         0x88b4
+#define BENCH_MIN_PROTO         0x0600
+
+/* same layout as HDD_WMM_CLASS_* in wlan_hdd_wmm.h */
+#define BENCH_CLASS_UP_MASK     0x07
+#define BENCH_CLASS_QUEUE_SHIFT 4
+#define BENCH_MAX_DSCP          0x3f
+
+/* same flags as NBUF_TX_PKT_CLASS_* in i_cdf_nbuf.h */
+#define BENCH_PKT_CLASS_EAPOL   0x01
+#define BENCH_PKT_CLASS_WAI     0x02
+#define BENCH_PKT_CLASS_VALID   0x80
+
+/* offset of the cached class in the control block, as in cvg_nbuf_cb */
+#define BENCH_CB_PKT_CLASS      7
+
+struct bench_frame {
+	uint8_t cb[BENCH_CB_SZ];
+	uint8_t data[BENCH_FRAME_SZ];
+};
+
+enum bench_kind {
+	BENCH_IPV4,
+	BENCH_IPV6,
+	BENCH_VLAN_IPV4,
+	BENCH_SNAP_IPV4,
+	BENCH_EAPOL,
+	BENCH_WAI,
+	BENCH_ARP,
+	BENCH_NUM_KINDS,
+};
+
+/* share of each frame kind in the mix, in percent */
+static const unsigned bench_kind_pct[BENCH_NUM_KINDS] = {
+	60, 15, 5, 5, 5, 2, 8,
+};
+
+enum bench_engine {
+	BENCH_REPARSE,
+	BENCH_CACHED,
+};
+
+/* default DSCP to UP map of the driver (hddWmmDscpToUpMap) */
+static uint8_t bench_dscp_to_up[BENCH_MAX_DSCP + 1];
+
+/* hdd_linux_up_to_ac_map */
+static const uint8_t bench_up_to_queue[8] = { 2, 3, 3, 2, 1, 1, 0, 0 };
+
+/* packed queue/UP per DSCP, as built by hdd_wmm_update_dscp_class() */
+static uint8_t bench_dscp_class[BENCH_MAX_DSCP + 1];
+
+static uint16_t bench_get_be16(const uint8_t *p)
+{
+	return (p[0] << 8) | p[1];
+}
+
+static void bench_put_be16(uint8_t *p, uint16_t v)
+{
+	p[0] = v >> 8;
+	p[1] = v & 0xff;
+}
+
+static void bench_init_maps(void)
+{
+	unsigned dscp, up;
+
+	for (dscp = 0; dscp <= BENCH_MAX_DSCP; dscp++) {
+		up = dscp >> 3;
+		bench_dscp_to_up[dscp] = up;
+		bench_dscp_class[dscp] =
+			(bench_up_to_queue[up] << BENCH_CLASS_QUEUE_SHIFT) | up;
+	}
+}
+
+static void bench_make_frame(struct bench_frame *frame, enum bench_kind kind,
+			     unsigned *seed)
+{
+	uint8_t tos = ((unsigned)rand_r(seed) & BENCH_MAX_DSCP) << 2;
+	uint8_t *d = frame->data;
+
+	memset(frame, 0, sizeof(*frame));
+	memset(d, 0xa5, 12);
+	switch (kind) {
+	case BENCH_IPV4:
+		bench_put_be16(&d[12], BENCH_ETH_P_IP);
+		d[BENCH_ETH_HLEN] = 0x45;
+		d[BENCH_ETH_HLEN + 1] = tos;
+		break;
+	case BENCH_IPV6:
+		bench_put_be16(&d[12], BENCH_ETH_P_IPV6);
+		bench_put_be16(&d[BENCH_ETH_HLEN], 0x6000 | (tos << 4));
+		break;
+	case BENCH_VLAN_IPV4:
+		bench_put_be16(&d[12], BENCH_ETH_P_8021Q);
+		bench_put_be16(&d[16], BENCH_ETH_P_IP);
+		d[BENCH_VLAN_HLEN] = 0x45;
+		d[BENCH_VLAN_HLEN + 1] = tos;
+		break;
+	case BENCH_SNAP_IPV4:
+		bench_put_be16(&d[12], 100);
+		d[14] = 0xaa;
+		d[15] = 0xaa;
+		d[16] = 0x03;
+		bench_put_be16(&d[20], BENCH_ETH_P_IP);
+		d[BENCH_SNAP_HLEN] = 0x45;
+		d[BENCH_SNAP_HLEN + 1] = tos;
+		break;
+	case BENCH_EAPOL:
+		bench_put_be16(&d[12], BENCH_ETH_P_EAPOL);
+		break;
+	case BENCH_WAI:
+		bench_put_be16(&d[12], BENCH_ETH_P_WAI);
+		break;
+	default:
+		bench_put_be16(&d[12], BENCH_ETH_P_ARP);
+		break;
+	}
+}
+
+static void bench_make_frames(struct bench_frame *frames, unsigned num)
+{
+	unsigned seed = 1, i, pick, kind;
+
+	for (i = 0; i < num; i++) {
+		pick = (unsigned)rand_r(&seed) % 100;
+		for (kind = 0; kind < BENCH_NUM_KINDS - 1; kind++) {
+			if (pick < bench_kind_pct[kind])
+				break;
+			pick -= bench_kind_pct[kind];
+		}
+		bench_make_frame(&frames[i], kind, &seed);
+	}
+}
+
+/* Same header walk as hdd_wmm_classify_pkt() */
+static uint8_t bench_get_tos(const uint8_t *d)
+{
+	uint16_t proto = bench_get_be16(&d[12]);
+	uint16_t vlan_proto;
+
+	if (proto == BENCH_ETH_P_IP)
+		return d[BENCH_ETH_HLEN + 1];
+	if (proto == BENCH_ETH_P_IPV6)
+		return bench_get_be16(&d[BENCH_ETH_HLEN]) >> 4;
+	if (proto == BENCH_ETH_P_EAPOL)
+		return 0xC0;
+	if (proto == BENCH_ETH_P_8021Q) {
+		vlan_proto = bench_get_be16(&d[16]);
+		if (vlan_proto == BENCH_ETH_P_IP)
+			return d[BENCH_VLAN_HLEN + 1];
+		return 0;
+	}
+	if (proto < BENCH_MIN_PROTO && d[14] == 0xaa && d[15] == 0xaa &&
+	    d[16] == 0x03 && bench_get_be16(&d[20]) == BENCH_ETH_P_IP)
+		return d[BENCH_SNAP_HLEN + 1];
+	return 0;
+}
+
+static bool bench_is_auth_frm(const uint8_t *d)
+{
+	uint16_t eth_type = bench_get_be16(&d[BENCH_ETHERTYPE_OFFSET]);
+
+	return eth_type == BENCH_ETH_P_EAPOL || eth_type == BENCH_ETH_P_WAI;
+}
+
+static bool bench_is_eapol(const uint8_t *d)
+{
+	return bench_get_be16(&d[BENCH_ETHERTYPE_OFFSET]) == BENCH_ETH_P_EAPOL;
+}
+
+static unsigned long long bench_checksum;
+
+/*
+ * One frame through the tx path: select_queue, the WMM admission check
+ * (which lets auth frames through on an unauthenticated link), EAPOL
+ * logging and, while the peer is unauthorized, the paused tx queue.
+ */
+static void bench_tx_reparse(struct bench_frame *frame, bool unauthorized)
+{
+	uint8_t dscp, up, queue;
+	bool auth_frm, eapol, admit = false;
+
+	dscp = (bench_get_tos(frame->data) >> 2) & BENCH_MAX_DSCP;
+	up = bench_dscp_to_up[dscp];
+	queue = bench_up_to_queue[up];
+
+	memset(frame->cb, 0, sizeof(frame->cb));
+	if (unauthorized)
+		admit = bench_is_auth_frm(frame->data);
+	eapol = bench_is_eapol(frame->data);
+	auth_frm = false;
+	if (unauthorized)
+		auth_frm = bench_is_auth_frm(frame->data);
+
+	bench_checksum = bench_checksum * 31 +
+		(queue << 8 | up << 4 | admit << 2 | eapol << 1 | auth_frm);
+}
+
+static void bench_tx_cached(struct bench_frame *frame, bool unauthorized)
+{
+	uint8_t class, dscp, up, queue, pkt_class;
+	uint16_t eth_type;
+	bool auth_frm, eapol, admit = false;
+
+	dscp = (bench_get_tos(frame->data) >> 2) & BENCH_MAX_DSCP;
+	class = bench_dscp_class[dscp];
+	up = class & BENCH_CLASS_UP_MASK;
+	queue = class >> BENCH_CLASS_QUEUE_SHIFT;
+
+	memset(frame->cb, 0, sizeof(frame->cb));
+	pkt_class = BENCH_PKT_CLASS_VALID;
+	eth_type = bench_get_be16(&frame->data[BENCH_ETHERTYPE_OFFSET]);
+	if (eth_type == BENCH_ETH_P_EAPOL)
+		pkt_class |= BENCH_PKT_CLASS_EAPOL;
+	else if (eth_type == BENCH_ETH_P_WAI)
+		pkt_class |= BENCH_PKT_CLASS_WAI;
+	frame->cb[BENCH_CB_PKT_CLASS] = pkt_class;
+
+	if (unauthorized)
+		admit = pkt_class &
+			(BENCH_PKT_CLASS_EAPOL | BENCH_PKT_CLASS_WAI);
+	eapol = frame->cb[BENCH_CB_PKT_CLASS] & BENCH_PKT_CLASS_EAPOL;
+	auth_frm = false;
+	if (unauthorized)
+		auth_frm = frame->cb[BENCH_CB_PKT_CLASS] &
+			(BENCH_PKT_CLASS_EAPOL | BENCH_PKT_CLASS_WAI);
+
+	bench_checksum = bench_checksum * 31 +
+		(queue << 8 | up << 4 | admit << 2 | eapol << 1 | auth_frm);
+}
+
+static double bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double bench_run(enum bench_engine engine, bool unauthorized,
+			struct bench_frame *frames, unsigned num_frames,
+			unsigned rounds)
+{
+	unsigned r, i;
+	double t0;
+
+	t0 = bench_now_ns();
+	for (r = 0; r < rounds; r++) {
+		for (i = 0; i < num_frames; i++) {
+			if (engine == BENCH_REPARSE)
+				bench_tx_reparse(&frames[i], unauthorized);
+			else
+				bench_tx_cached(&frames[i], unauthorized);
+		}
+	}
+	return bench_now_ns() - t0;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned num_frames = BENCH_DEF_FRAMES;
+	unsigned rounds = BENCH_DEF_ROUNDS;
+	struct bench_frame *frames;
+	unsigned long long sum[2];
+	double ns[2], total;
+	int unauthorized, engine;
+
+	if (argc > 1)
+		num_frames = strtoul(argv[1], NULL, 0);
+	if (argc > 2)
+		rounds = strtoul(argv[2], NULL, 0);
+	if (!num_frames || !rounds) {
+		fprintf(stderr, "usage: %s [num_frames [rounds]]\n", argv[0]);
+		return 1;
+	}
+
+	frames = calloc(num_frames, sizeof(*frames));
+	if (!frames) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	bench_init_maps();
+	bench_make_frames(frames, num_frames);
+
+	total = (double)num_frames * rounds;
+	printf("%u frames, %u rounds\n", num_frames, rounds);
+	printf("%-14s %12s %12s %9s\n",
+	       "peer", "reparse ns", "cached ns", "speedup");
+	for (unauthorized = 0; unauthorized <= 1; unauthorized++) {
+		for (engine = BENCH_REPARSE; engine <= BENCH_CACHED;
+		     engine++) {
+			bench_checksum = 0;
+			ns[engine] = bench_run(engine, unauthorized, frames,
+					       num_frames, rounds);
+			sum[engine] = bench_checksum;
+		}
+		if (sum[BENCH_REPARSE] != sum[BENCH_CACHED]) {
+			fprintf(stderr, "%s: classification mismatch\n",
+				unauthorized ? "unauthorized" : "authorized");
+			return 1;
+		}
+		printf("%-14s %12.2f %12.2f %8.2fx\n",
+		       unauthorized ? "unauthorized" : "authorized",
+		       ns[BENCH_REPARSE] / total, ns[BENCH_CACHED] / total,
+		       ns[BENCH_REPARSE] / ns[BENCH_CACHED]);
+	}
+
+	free(frames);
+	return 0;
+}
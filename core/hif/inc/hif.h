@@ -200,6 +200,12 @@ struct ol_softc {
 	uint32_t last_rxlen;
 	OS_DMA_MEM_CONTEXT(bmirsp_dmacontext)
 
+	/* command/response slots for pipelined BMI memory writes */
+	uint8_t *bmi_win_cmd_buff;
+	dma_addr_t bmi_win_cmd_da;
+	uint8_t *bmi_win_rsp_buff;
+	dma_addr_t bmi_win_rsp_da;
+
 	void *msi_magic;
 	dma_addr_t msi_magic_da;
 	OS_DMA_MEM_CONTEXT(msi_dmacontext)
@@ -424,6 +430,23 @@ CDF_STATUS hif_exchange_bmi_msg(struct ol_softc *scn,
 			 uint8_t *pResponseMessage,
 			 uint32_t *pResponseLength, uint32_t TimeoutMS);
 
+/*
+ * Split-phase variant of hif_exchange_bmi_msg, used to keep several BMI
+ * requests in flight. The request and response buffers are supplied
+ * together with their DMA addresses and must stay untouched until the
+ * transaction is reaped with hif_bmi_msg_wait. Transactions complete in
+ * submission order. hif_bmi_msg_wait may block (sleep).
+ */
+CDF_STATUS hif_bmi_msg_send(struct ol_softc *scn,
+			    uint8_t *bmi_request,
+			    cdf_dma_addr_t request_da,
+			    uint32_t request_length,
+			    uint8_t *bmi_response,
+			    cdf_dma_addr_t response_da,
+			    void **handle);
+CDF_STATUS hif_bmi_msg_wait(struct ol_softc *scn, void *handle,
+			    uint32_t *bmi_response_lengthp);
+
 /*
  * APIs to handle HIF specific diagnostic read accesses. These APIs are
  * synchronous and only allowed to be called from a context that
@@ -613,6 +636,7 @@ CDF_STATUS hif_send_head(struct ol_softc *scn, uint8_t PipeID,
 				  cdf_nbuf_t wbuf, uint32_t data_attr);
 void hif_send_complete_check(struct ol_softc *scn, uint8_t PipeID,
 			     int force);
+void hif_set_sw_target(struct ol_softc *scn, uint32_t ep_mask);
 void hif_cancel_deferred_target_sleep(struct ol_softc *scn);
 void hif_get_default_pipe(struct ol_softc *scn, uint8_t *ULPipe,
 			  uint8_t *DLPipe);
@@ -137,17 +137,34 @@ void hif_bmi_recv_data(struct CE_handle *copyeng, void *ce_context,
 }
 #endif
 
-CDF_STATUS hif_exchange_bmi_msg(struct ol_softc *scn,
-		     uint8_t *bmi_request,
-		     uint32_t request_length,
-		     uint8_t *bmi_response,
-		     uint32_t *bmi_response_lengthp, uint32_t TimeoutMS)
+/**
+ * hif_bmi_msg_send() - queue a BMI request without waiting for it
+ * @scn: ol_softc
+ * @bmi_request: request in host address space
+ * @request_da: DMA address of @bmi_request
+ * @request_length: length of the request
+ * @bmi_response: response buffer in host address space, or NULL
+ * @response_da: DMA address of @bmi_response
+ * @handle: filled with the transaction to pass to hif_bmi_msg_wait()
+ *
+ * Both buffers must stay untouched until the transaction has been
+ * reaped with hif_bmi_msg_wait(). Transactions complete in submission
+ * order, so several requests may be kept in flight.
+ *
+ * Return: CDF_STATUS_SUCCESS if the request was queued
+ */
+CDF_STATUS hif_bmi_msg_send(struct ol_softc *scn,
+			    uint8_t *bmi_request,
+			    cdf_dma_addr_t request_da,
+			    uint32_t request_length,
+			    uint8_t *bmi_response,
+			    cdf_dma_addr_t response_da,
+			    void **handle)
 {
 	struct HIF_CE_state *hif_state = (struct HIF_CE_state *)scn->hif_hdl;
 	struct HIF_CE_pipe_info *send_pipe_info =
 		&(hif_state->pipe_info[BMI_CE_NUM_TO_TARG]);
 	struct CE_handle *ce_send_hdl = send_pipe_info->ce_hdl;
-	cdf_dma_addr_t CE_request, CE_response = 0;
 	struct BMI_transaction *transaction = NULL;
 	int status = CDF_STATUS_SUCCESS;
 	struct HIF_CE_pipe_info *recv_pipe_info =
@@ -156,11 +173,6 @@ CDF_STATUS hif_exchange_bmi_msg(struct ol_softc *scn,
 	unsigned int mux_id = 0;
 	unsigned int transaction_id = 0xffff;
 	unsigned int user_flags = 0;
-#ifdef BMI_RSP_POLLING
-	cdf_dma_addr_t buf;
-	unsigned int completed_nbytes, id, flags;
-	int i;
-#endif
 
 	transaction =
 		(struct BMI_transaction *)cdf_mem_malloc(sizeof(*transaction));
@@ -183,15 +195,14 @@ CDF_STATUS hif_exchange_bmi_msg(struct ol_softc *scn,
 	transaction->bmi_request_host = bmi_request;
 	transaction->bmi_request_length = request_length;
 	transaction->bmi_response_length = 0;
-	transaction->bmi_timeout_ms = TimeoutMS;
+	transaction->bmi_timeout_ms = 0;
 	transaction->bmi_transaction_flags = 0;
 
 	/*
 	 * CE_request = dma_map_single(dev,
 	 * (void *)bmi_request, request_length, DMA_TO_DEVICE);
 	 */
-	CE_request = scn->bmi_cmd_da;
-	transaction->bmi_request_CE = CE_request;
+	transaction->bmi_request_CE = request_da;
 
 	if (bmi_response) {
 
@@ -199,13 +210,12 @@ CDF_STATUS hif_exchange_bmi_msg(struct ol_softc *scn,
 		 * CE_response = dma_map_single(dev, bmi_response,
 		 * BMI_DATASZ_MAX, DMA_FROM_DEVICE);
 		 */
-		CE_response = scn->bmi_rsp_da;
 		transaction->bmi_response_host = bmi_response;
-		transaction->bmi_response_CE = CE_response;
+		transaction->bmi_response_CE = response_da;
 		/* dma_cache_sync(dev, bmi_response,
 		    BMI_DATASZ_MAX, DMA_FROM_DEVICE); */
 		cdf_os_mem_dma_sync_single_for_device(scn->cdf_dev,
-					       CE_response,
+					       response_da,
 					       BMI_DATASZ_MAX,
 					       DMA_FROM_DEVICE);
 		ce_recv_buf_enqueue(ce_recv, transaction,
@@ -217,16 +227,49 @@ CDF_STATUS hif_exchange_bmi_msg(struct ol_softc *scn,
 	}
 
 	/* dma_cache_sync(dev, bmi_request, request_length, DMA_TO_DEVICE); */
-	cdf_os_mem_dma_sync_single_for_device(scn->cdf_dev, CE_request,
+	cdf_os_mem_dma_sync_single_for_device(scn->cdf_dev, request_da,
 				       request_length, DMA_TO_DEVICE);
 
 	status =
 		ce_send(ce_send_hdl, transaction,
-			CE_request, request_length,
+			request_da, request_length,
 			transaction_id, 0, user_flags);
 	ASSERT(status == CDF_STATUS_SUCCESS);
 	/* NB: see hif_bmi_send_done */
 
+	*handle = transaction;
+	return CDF_STATUS_SUCCESS;
+}
+
+/**
+ * hif_bmi_msg_wait() - wait for a BMI transaction queued by hif_bmi_msg_send
+ * @scn: ol_softc
+ * @handle: transaction returned by hif_bmi_msg_send()
+ * @bmi_response_lengthp: filled with the response length, may be NULL
+ *
+ * Must be called from a context that can block; the transaction is
+ * released on return.
+ *
+ * Return: CDF_STATUS_SUCCESS if the request (and response) completed
+ */
+CDF_STATUS hif_bmi_msg_wait(struct ol_softc *scn, void *handle,
+			    uint32_t *bmi_response_lengthp)
+{
+	struct HIF_CE_state *hif_state = (struct HIF_CE_state *)scn->hif_hdl;
+	struct HIF_CE_pipe_info *send_pipe_info =
+		&(hif_state->pipe_info[BMI_CE_NUM_TO_TARG]);
+	struct CE_handle *ce_send_hdl = send_pipe_info->ce_hdl;
+	struct BMI_transaction *transaction = handle;
+	int status = CDF_STATUS_SUCCESS;
+#ifdef BMI_RSP_POLLING
+	struct HIF_CE_pipe_info *recv_pipe_info =
+		&(hif_state->pipe_info[BMI_CE_NUM_TO_HOST]);
+	struct CE_handle *ce_recv = recv_pipe_info->ce_hdl;
+	cdf_dma_addr_t buf;
+	unsigned int completed_nbytes, id, flags;
+	int i;
+#endif
+
 	/* TBDXXX: handle timeout */
 
 	/* Wait for BMI request/response transaction to complete */
@@ -237,7 +280,7 @@ CDF_STATUS hif_exchange_bmi_msg(struct ol_softc *scn,
 		/*need some break out condition(time out?) */
 	}
 
-	if (bmi_response) {
+	if (transaction->bmi_response_host) {
 #ifdef BMI_RSP_POLLING
 		/* Fix EV118783, do not wait a semaphore for the BMI response
 		 * since the relative interruption may be lost.
@@ -290,3 +333,21 @@ CDF_STATUS hif_exchange_bmi_msg(struct ol_softc *scn,
 	cdf_mem_free(transaction);
 	return status;
 }
+
+CDF_STATUS hif_exchange_bmi_msg(struct ol_softc *scn,
+		     uint8_t *bmi_request,
+		     uint32_t request_length,
+		     uint8_t *bmi_response,
+		     uint32_t *bmi_response_lengthp, uint32_t TimeoutMS)
+{
+	void *transaction;
+	CDF_STATUS status;
+
+	status = hif_bmi_msg_send(scn, bmi_request, scn->bmi_cmd_da,
+				  request_length, bmi_response,
+				  scn->bmi_rsp_da, &transaction);
+	if (status != CDF_STATUS_SUCCESS)
+		return status;
+
+	return hif_bmi_msg_wait(scn, transaction, bmi_response_lengthp);
+}
@@ -36,6 +36,7 @@
 #include <bmi_msg.h>
 #include "hif_io32.h"
 #include <hif.h>
+#include <htc.h>
 #include "regtable.h"
 #define ATH_MODULE_NAME hif
 #include <a_debug.h>
@@ -546,6 +547,62 @@ void hif_detach_htc(struct ol_softc *scn)
 		  sizeof(hif_state->msg_callbacks_current));
 }
 
+/**
+ * hif_sw_target_owns() - is a send to be handled by the software target
+ * @hif_state: HIF CE state
+ * @transfer_id: transfer id of the send (the HTC endpoint)
+ *
+ * Return: true if the send is to be echoed by the software target
+ */
+static inline bool hif_sw_target_owns(struct HIF_CE_state *hif_state,
+				      unsigned int transfer_id)
+{
+	uint32_t ep_mask = hif_state->sw_target.ep_mask;
+
+	return cdf_unlikely(ep_mask) && transfer_id < 32 &&
+	       (ep_mask & (1 << transfer_id));
+}
+
+/**
+ * hif_sw_target_send() - queue a send to the software target
+ * @pipe_info: pipe the buffer is sent on, send ring entries already taken
+ * @nbuf: buffer to send
+ * @nbytes: number of bytes to send
+ * @transfer_id: transfer id of the send (the HTC endpoint)
+ * @nfrags: send ring entries taken by the buffer
+ *
+ * Return: CDF_STATUS_SUCCESS, or CDF_STATUS_E_RESOURCES if the software
+ *	   target ring is full
+ */
+static CDF_STATUS hif_sw_target_send(struct HIF_CE_pipe_info *pipe_info,
+				     cdf_nbuf_t nbuf, unsigned int nbytes,
+				     unsigned int transfer_id, int nfrags)
+{
+	struct hif_sw_target *sw = &pipe_info->HIF_CE_state->sw_target;
+	struct hif_sw_target_xfer *xfer;
+
+	cdf_spin_lock_bh(&sw->lock);
+	if (sw->count == HIF_SW_TARGET_RING_SIZE) {
+		cdf_spin_unlock_bh(&sw->lock);
+		cdf_spin_lock_bh(&pipe_info->completion_freeq_lock);
+		pipe_info->num_sends_allowed += nfrags;
+		cdf_spin_unlock_bh(&pipe_info->completion_freeq_lock);
+		return CDF_STATUS_E_RESOURCES;
+	}
+	xfer = &sw->ring[(sw->head + sw->count) &
+			 (HIF_SW_TARGET_RING_SIZE - 1)];
+	xfer->nbuf = nbuf;
+	xfer->nbytes = nbytes;
+	xfer->transfer_id = transfer_id;
+	xfer->pipe = pipe_info->pipe_num;
+	xfer->nfrags = nfrags;
+	sw->count++;
+	cdf_spin_unlock_bh(&sw->lock);
+
+	tasklet_schedule(&sw->intr_tq);
+	return CDF_STATUS_SUCCESS;
+}
+
 /* Send the first nbytes bytes of the buffer */
 CDF_STATUS
 hif_send_head(struct ol_softc *scn,
@@ -619,6 +676,10 @@ hif_send_head(struct ol_softc *scn,
 		return A_ERROR;
 	}
 
+	if (hif_sw_target_owns(hif_state, transfer_id))
+		return hif_sw_target_send(pipe_info, nbuf, nbytes,
+					  transfer_id, nfrags);
+
 	NBUF_UPDATE_TX_PKT_COUNT(nbuf, NBUF_TX_PKT_HIF);
 	DPTRACE(cdf_dp_trace(nbuf, CDF_DP_TRACE_HIF_PACKET_PTR_RECORD,
 				(uint8_t *)(cdf_nbuf_data(nbuf)),
@@ -777,6 +838,133 @@ hif_pci_ce_recv_data(struct CE_handle *copyeng, void *ce_context,
 					&flags) == CDF_STATUS_SUCCESS);
 }
 
+/**
+ * hif_sw_target_tasklet() - software target: complete and echo sends
+ * @data: HIF CE state
+ *
+ * Plays the part of the target copy engines for the sends queued by
+ * hif_sw_target_send(): each frame is copied into a receive buffer of
+ * the default receive pipe, its send is completed and the copy is then
+ * handed to the upper layer, through the same callbacks and in the same
+ * order as hif_pci_ce_send_done() and hif_pci_ce_recv_data() would. The
+ * echo keeps the HTC header, so it comes back on the endpoint it was
+ * sent on; the send direction flags are cleared as the target would.
+ *
+ * Return: none
+ */
+static void hif_sw_target_tasklet(unsigned long data)
+{
+	struct HIF_CE_state *hif_state = (struct HIF_CE_state *)data;
+	struct hif_sw_target *sw = &hif_state->sw_target;
+	struct hif_msg_callbacks *msg_callbacks =
+		&hif_state->msg_callbacks_current;
+	struct HIF_CE_pipe_info *pipe_info, *dl_info;
+	struct hif_sw_target_xfer xfer;
+	HTC_FRAME_HDR *hdr;
+	cdf_nbuf_t echo;
+	uint8_t ul_pipe, dl_pipe;
+	int budget = HIF_SW_TARGET_BUDGET;
+
+	hif_get_default_pipe(hif_state->scn, &ul_pipe, &dl_pipe);
+	dl_info = &hif_state->pipe_info[dl_pipe];
+
+	while (budget--) {
+		cdf_spin_lock(&sw->lock);
+		if (!sw->count) {
+			cdf_spin_unlock(&sw->lock);
+			return;
+		}
+		xfer = sw->ring[sw->head];
+		sw->head = (sw->head + 1) & (HIF_SW_TARGET_RING_SIZE - 1);
+		sw->count--;
+		cdf_spin_unlock(&sw->lock);
+
+		echo = NULL;
+		if (xfer.nbytes >= HTC_HDR_LENGTH &&
+		    xfer.nbytes <= dl_info->buf_sz)
+			echo = cdf_nbuf_alloc(hif_state->scn->cdf_dev,
+					      dl_info->buf_sz, 0, 4, false);
+		if (echo) {
+			cdf_mem_copy(cdf_nbuf_data(echo),
+				     cdf_nbuf_data(xfer.nbuf), xfer.nbytes);
+			hdr = (HTC_FRAME_HDR *)cdf_nbuf_data(echo);
+			HTC_SET_FIELD(hdr, HTC_FRAME_HDR, FLAGS, 0);
+			HTC_SET_FIELD(hdr, HTC_FRAME_HDR, CONTROLBYTES0, 0);
+			HTC_SET_FIELD(hdr, HTC_FRAME_HDR, CONTROLBYTES1, 0);
+		}
+
+		if (hif_state->scn->target_status == OL_TRGET_STATUS_RESET) {
+			if (echo)
+				cdf_nbuf_free(echo);
+			return;
+		}
+
+		msg_callbacks->txCompletionHandler(msg_callbacks->Context,
+						   xfer.nbuf, xfer.transfer_id,
+						   0);
+		pipe_info = &hif_state->pipe_info[xfer.pipe];
+		cdf_spin_lock(&pipe_info->completion_freeq_lock);
+		pipe_info->num_sends_allowed += xfer.nfrags;
+		cdf_spin_unlock(&pipe_info->completion_freeq_lock);
+
+		if (!echo) {
+			sw->dropped++;
+			continue;
+		}
+		sw->echoed++;
+		hif_ce_do_recv(msg_callbacks, echo, xfer.nbytes, dl_info);
+	}
+
+	tasklet_schedule(&sw->intr_tq);
+}
+
+/**
+ * hif_sw_target_cleanup() - complete the sends held by the software target
+ * @hif_state: HIF CE state
+ *
+ * Return: none
+ */
+static void hif_sw_target_cleanup(struct HIF_CE_state *hif_state)
+{
+	struct hif_sw_target *sw = &hif_state->sw_target;
+	struct hif_sw_target_xfer *xfer;
+	struct HIF_CE_pipe_info *pipe_info;
+
+	sw->ep_mask = 0;
+	tasklet_kill(&sw->intr_tq);
+
+	for (; sw->count; sw->count--) {
+		xfer = &sw->ring[sw->head];
+		sw->head = (sw->head + 1) & (HIF_SW_TARGET_RING_SIZE - 1);
+		pipe_info = &hif_state->pipe_info[xfer->pipe];
+		pipe_info->num_sends_allowed += xfer->nfrags;
+		if (hif_state->started)
+			hif_state->msg_callbacks_current.txCompletionHandler(
+				hif_state->msg_callbacks_current.Context,
+				xfer->nbuf, xfer->transfer_id, 0);
+	}
+}
+
+/**
+ * hif_set_sw_target() - echo HTC endpoints through a software target
+ * @scn: HIF context
+ * @ep_mask: bitmap of HTC endpoints, 0 to use the real target again
+ *
+ * Sends on the endpoints in @ep_mask still go through htc_send_pkt() and
+ * hif_send_head(), and take send ring entries of their pipe, but instead
+ * of being posted to the copy engine they are completed and echoed back
+ * by hif_sw_target_tasklet(). The epping benchmark uses this to measure
+ * the host side of the HTC/CE path without firmware.
+ *
+ * Return: none
+ */
+void hif_set_sw_target(struct ol_softc *scn, uint32_t ep_mask)
+{
+	struct HIF_CE_state *hif_state = (struct HIF_CE_state *)scn->hif_hdl;
+
+	hif_state->sw_target.ep_mask = ep_mask;
+}
+
 /* TBDXXX: Set CE High Watermark; invoke txResourceAvailHandler in response */
 
 void
@@ -1195,6 +1383,7 @@ void hif_buffer_cleanup(struct HIF_CE_state *hif_state)
 		hif_recv_buffer_cleanup_on_pipe(pipe_info);
 		hif_send_buffer_cleanup_on_pipe(pipe_info);
 	}
+	hif_sw_target_cleanup(hif_state);
 }
 
 void hif_flush_surprise_remove(struct ol_softc *scn)
@@ -1886,6 +2075,9 @@ int hif_config_ce(hif_handle_t hif_hdl)
 	scn->soc_version = soc_info.version;
 
 	cdf_spinlock_init(&hif_state->keep_awake_lock);
+	cdf_spinlock_init(&hif_state->sw_target.lock);
+	tasklet_init(&hif_state->sw_target.intr_tq, hif_sw_target_tasklet,
+		     (unsigned long)hif_state);
 
 	hif_state->keep_awake_count = 0;
 
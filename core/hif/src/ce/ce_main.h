@@ -104,6 +104,47 @@ struct ce_tasklet_entry {
 	void *hif_ce_state;
 };
 
+#define HIF_SW_TARGET_RING_SIZE 256
+#define HIF_SW_TARGET_BUDGET    64
+
+/**
+ * struct hif_sw_target_xfer - a send held by the software target
+ * @nbuf: buffer passed to hif_send_head()
+ * @nbytes: bytes of @nbuf that were sent
+ * @transfer_id: transfer id of the send (the HTC endpoint)
+ * @pipe: pipe the buffer was sent on
+ * @nfrags: send ring entries taken by the buffer
+ */
+struct hif_sw_target_xfer {
+	cdf_nbuf_t nbuf;
+	unsigned int nbytes;
+	unsigned int transfer_id;
+	uint8_t pipe;
+	uint8_t nfrags;
+};
+
+/**
+ * struct hif_sw_target - software stand-in for the target copy engines
+ * @ep_mask: HTC endpoints whose sends are echoed by the software target
+ * @lock: protects the transfer ring
+ * @intr_tq: tasklet standing in for the copy engine interrupt
+ * @head: oldest pending transfer
+ * @count: number of pending transfers
+ * @ring: pending transfers
+ * @echoed: frames echoed back to the host
+ * @dropped: sends completed without an echo
+ */
+struct hif_sw_target {
+	uint32_t ep_mask;
+	cdf_spinlock_t lock;
+	struct tasklet_struct intr_tq;
+	uint32_t head;
+	uint32_t count;
+	struct hif_sw_target_xfer ring[HIF_SW_TARGET_RING_SIZE];
+	uint32_t echoed;
+	uint32_t dropped;
+};
+
 struct HIF_CE_state {
 	struct ol_softc *scn;
 	bool started;
@@ -130,5 +171,8 @@ struct HIF_CE_state {
 
 	/* Copy Engine used for Diagnostic Accesses */
 	struct CE_handle *ce_diag;
+
+	/* Firmware-free target used by the epping benchmark */
+	struct hif_sw_target sw_target;
 };
 #endif /* __CE_H__ */
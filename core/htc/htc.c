@@ -523,6 +523,8 @@ static void reset_endpoint_states(HTC_TARGET *target)
 		pEndpoint->Id = i;
 		INIT_HTC_PACKET_QUEUE(&pEndpoint->TxQueue);
 		INIT_HTC_PACKET_QUEUE(&pEndpoint->TxLookupQueue);
+		A_MEMZERO(pEndpoint->TxLookupTable,
+			  sizeof(pEndpoint->TxLookupTable));
 		INIT_HTC_PACKET_QUEUE(&pEndpoint->RxBufferHoldQueue);
 		pEndpoint->target = target;
 		/* pEndpoint->TxCreditFlowEnabled = (A_BOOL)htc_credit_flow; */
@@ -79,6 +79,7 @@ extern "C" {
 #define HTC_SERVICE_TX_PACKET_TAG  HTC_TX_PACKET_TAG_INTERNAL
 
 #define HTC_CREDIT_HISTORY_MAX              1024
+#define HTC_TX_LOOKUP_TABLE_SIZE            64  /* power of 2 */
 
 typedef enum {
 	HTC_REQUEST_CREDIT,
@@ -115,6 +116,11 @@ typedef struct _HTC_ENDPOINT {
 #endif
 
 	HTC_PACKET_QUEUE TxLookupQueue;         /* lookup queue to match netbufs to htc packets */
+	/* TxLookupQueue packets hashed by netbuf, see htc_tx_lookup_add() */
+	HTC_PACKET *TxLookupTable[HTC_TX_LOOKUP_TABLE_SIZE];
+	A_UINT32 TxCompInOrder;         /* completions of the oldest packet */
+	A_UINT32 TxCompOutOfOrder;      /* other completions found by hash */
+	A_UINT32 TxCompLookupMiss;      /* completions found by queue search */
 	HTC_PACKET_QUEUE RxBufferHoldQueue;             /* temporary hold queue for back compatibility */
 	A_UINT8 SeqNo;          /* TX seq no (helpful) for debugging */
 	cdf_atomic_t TxProcessCount;            /* serialization */
@@ -102,9 +102,69 @@ void htc_dump_counter_info(HTC_HANDLE HTCHandle)
 {
 	HTC_TARGET *target = GET_HTC_TARGET_FROM_HANDLE(HTCHandle);
 
+	HTC_ENDPOINT *pEndpoint;
+	int i;
+
 	AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
 			("\n%s: ce_send_cnt = %d, TX_comp_cnt = %d\n",
 			 __func__, target->ce_send_cnt, target->TX_comp_cnt));
+	for (i = ENDPOINT_0; i < ENDPOINT_MAX; i++) {
+		pEndpoint = &target->EndPoint[i];
+		if (!pEndpoint->ServiceID)
+			continue;
+		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+				("EP%d: tx comp in order %u, out of order %u, lookup miss %u\n",
+				 i, pEndpoint->TxCompInOrder,
+				 pEndpoint->TxCompOutOfOrder,
+				 pEndpoint->TxCompLookupMiss));
+	}
+}
+
+/*
+ * The TX lookup table hashes the packets of the TX lookup queue by their
+ * netbuf, which HIF hands back as the per-transfer context of the send
+ * completion.  A packet whose hash slot is already taken is only on the
+ * queue and is found by searching it.
+ * All the functions below are called with the HTC TX lock held.
+ */
+#define HTC_TX_LOOKUP_IDX(netbuf)					\
+	((((unsigned long)(netbuf) >> 8) ^ ((unsigned long)(netbuf) >> 16)) & \
+	 (HTC_TX_LOOKUP_TABLE_SIZE - 1))
+
+/**
+ * htc_tx_lookup_add() - track a packet handed to HIF until it completes
+ * @pEndpoint: endpoint the packet is sent on
+ * @pPacket: packet being sent
+ *
+ * Return: None
+ */
+static inline void htc_tx_lookup_add(HTC_ENDPOINT *pEndpoint,
+				     HTC_PACKET *pPacket)
+{
+	HTC_PACKET **slot = &pEndpoint->TxLookupTable[HTC_TX_LOOKUP_IDX(
+				GET_HTC_PACKET_NET_BUF_CONTEXT(pPacket))];
+
+	HTC_PACKET_ENQUEUE(&pEndpoint->TxLookupQueue, pPacket);
+	if (!*slot)
+		*slot = pPacket;
+}
+
+/**
+ * htc_tx_lookup_remove() - stop tracking a packet handed to HIF
+ * @pEndpoint: endpoint the packet was sent on
+ * @pPacket: packet to remove, which must be on the TX lookup queue
+ *
+ * Return: None
+ */
+static inline void htc_tx_lookup_remove(HTC_ENDPOINT *pEndpoint,
+					HTC_PACKET *pPacket)
+{
+	HTC_PACKET **slot = &pEndpoint->TxLookupTable[HTC_TX_LOOKUP_IDX(
+				GET_HTC_PACKET_NET_BUF_CONTEXT(pPacket))];
+
+	if (*slot == pPacket)
+		*slot = NULL;
+	HTC_PACKET_REMOVE(&pEndpoint->TxLookupQueue, pPacket);
 }
 
 void htc_get_control_endpoint_tx_host_credits(HTC_HANDLE HTCHandle, int *credits)
@@ -319,7 +379,7 @@ static A_STATUS htc_send_bundled_netbuf(HTC_TARGET *target,
 			       data_len,
 			       pEndpoint->Id, HTC_TX_PACKET_TAG_BUNDLED);
 	LOCK_HTC_TX(target);
-	HTC_PACKET_ENQUEUE(&pEndpoint->TxLookupQueue, pPacketTx);
+	htc_tx_lookup_add(pEndpoint, pPacketTx);
 	UNLOCK_HTC_TX(target);
 #if DEBUG_BUNDLE
 	cdf_print(" Send bundle EP%d buffer size:0x%x, total:0x%x, count:%d.\n",
@@ -527,7 +587,7 @@ static A_STATUS htc_issue_packets(HTC_TARGET *target,
 		}
 		LOCK_HTC_TX(target);
 		/* store in look up queue to match completions */
-		HTC_PACKET_ENQUEUE(&pEndpoint->TxLookupQueue, pPacket);
+		htc_tx_lookup_add(pEndpoint, pPacket);
 		INC_HTC_EP_STAT(pEndpoint, TxIssued, 1);
 		pEndpoint->ul_outstanding_cnt++;
 		UNLOCK_HTC_TX(target);
@@ -557,7 +617,7 @@ static A_STATUS htc_issue_packets(HTC_TARGET *target,
 			LOCK_HTC_TX(target);
 			target->ce_send_cnt--;
 			pEndpoint->ul_outstanding_cnt--;
-			HTC_PACKET_REMOVE(&pEndpoint->TxLookupQueue, pPacket);
+			htc_tx_lookup_remove(pEndpoint, pPacket);
 			/* reclaim credits */
 #if defined(HIF_USB)
 			if (pEndpoint->Id >= ENDPOINT_2
@@ -1452,7 +1512,7 @@ A_STATUS htc_send_data_pkt(HTC_HANDLE HTCHandle, HTC_PACKET *pPacket,
 
 		LOCK_HTC_TX(target);
 		/* store in look up queue to match completions */
-		HTC_PACKET_ENQUEUE(&pEndpoint->TxLookupQueue, pPacket);
+		htc_tx_lookup_add(pEndpoint, pPacket);
 		INC_HTC_EP_STAT(pEndpoint, TxIssued, 1);
 		pEndpoint->ul_outstanding_cnt++;
 		UNLOCK_HTC_TX(target);
@@ -1473,7 +1533,7 @@ A_STATUS htc_send_data_pkt(HTC_HANDLE HTCHandle, HTC_PACKET *pPacket,
 			LOCK_HTC_TX(target);
 			pEndpoint->ul_outstanding_cnt--;
 			/* remove this packet from the tx completion queue */
-			HTC_PACKET_REMOVE(&pEndpoint->TxLookupQueue, pPacket);
+			htc_tx_lookup_remove(pEndpoint, pPacket);
 
 			/*
 			 * Don't bother reclaiming credits - HTC flow control
@@ -1518,6 +1578,10 @@ A_STATUS htc_send_data_pkt(HTC_HANDLE HTCHandle, HTC_PACKET *pPacket,
  * from a lookup list.
  * This is extra overhead that can be fixed by re-aligning HIF interfaces with HTC.
  *
+ * Completions are normally in order and match the head of the lookup
+ * queue.  Out of order completions are found through the lookup table,
+ * and only a packet that lost its table slot to a hash collision needs
+ * the queue to be searched.  The TX lock is taken once in all cases.
  */
 static HTC_PACKET *htc_lookup_tx_packet(HTC_TARGET *target,
 					HTC_ENDPOINT *pEndpoint,
@@ -1525,57 +1589,49 @@ static HTC_PACKET *htc_lookup_tx_packet(HTC_TARGET *target,
 {
 	HTC_PACKET *pPacket = NULL;
 	HTC_PACKET *pFoundPacket = NULL;
-	HTC_PACKET_QUEUE lookupQueue;
 
-	INIT_HTC_PACKET_QUEUE(&lookupQueue);
 	LOCK_HTC_TX(target);
 
 	/* mark that HIF has indicated the send complete for another packet */
 	pEndpoint->ul_outstanding_cnt--;
 
-	/* Dequeue first packet directly because of in-order completion */
-	pPacket = htc_packet_dequeue(&pEndpoint->TxLookupQueue);
+	/* Check the first packet directly because of in-order completion */
+	pPacket = htc_get_pkt_at_head(&pEndpoint->TxLookupQueue);
 	if (cdf_unlikely(!pPacket)) {
 		UNLOCK_HTC_TX(target);
 		return NULL;
 	}
 	if (netbuf == (cdf_nbuf_t) GET_HTC_PACKET_NET_BUF_CONTEXT(pPacket)) {
+		pEndpoint->TxCompInOrder++;
+		htc_tx_lookup_remove(pEndpoint, pPacket);
 		UNLOCK_HTC_TX(target);
 		return pPacket;
-	} else {
-		HTC_PACKET_ENQUEUE(&lookupQueue, pPacket);
 	}
 
-	/*
-	 * Move TX lookup queue to temp queue because most of packets that are not index 0
-	 * are not top 10 packets.
-	 */
-	HTC_PACKET_QUEUE_TRANSFER_TO_TAIL(&lookupQueue,
-					  &pEndpoint->TxLookupQueue);
-	UNLOCK_HTC_TX(target);
-
-	ITERATE_OVER_LIST_ALLOW_REMOVE(&lookupQueue.QueueHead, pPacket,
-				       HTC_PACKET, ListLink) {
+	pPacket = pEndpoint->TxLookupTable[HTC_TX_LOOKUP_IDX(netbuf)];
+	if (pPacket &&
+	    netbuf == (cdf_nbuf_t) GET_HTC_PACKET_NET_BUF_CONTEXT(pPacket)) {
+		pEndpoint->TxCompOutOfOrder++;
+		htc_tx_lookup_remove(pEndpoint, pPacket);
+		UNLOCK_HTC_TX(target);
+		return pPacket;
+	}
 
-		if (NULL == pPacket) {
-			pFoundPacket = pPacket;
-			break;
-		}
+	ITERATE_OVER_LIST_ALLOW_REMOVE(&pEndpoint->TxLookupQueue.QueueHead,
+				       pPacket, HTC_PACKET, ListLink) {
 		/* check for removal */
 		if (netbuf ==
 		    (cdf_nbuf_t) GET_HTC_PACKET_NET_BUF_CONTEXT(pPacket)) {
 			/* found it */
-			HTC_PACKET_REMOVE(&lookupQueue, pPacket);
+			htc_tx_lookup_remove(pEndpoint, pPacket);
 			pFoundPacket = pPacket;
 			break;
 		}
-
 	}
 	ITERATE_END;
+	if (pFoundPacket)
+		pEndpoint->TxCompLookupMiss++;
 
-	LOCK_HTC_TX(target);
-	HTC_PACKET_QUEUE_TRANSFER_TO_HEAD(&pEndpoint->TxLookupQueue,
-					  &lookupQueue);
 	UNLOCK_HTC_TX(target);
 
 	return pFoundPacket;
@@ -442,6 +442,10 @@ typedef struct sPESession       /* Added to Support BT-AMP */
 	uint16_t schBeaconOffsetBegin;
 	/* Size of the trailing portion */
 	uint16_t schBeaconOffsetEnd;
+	/* Offset of the additional IEs within the trailing portion */
+	uint16_t schBeaconOffsetAddnIe;
+	/* Template changed but has not been written to firmware yet */
+	bool schBeaconUpdatePending;
 	bool isOSENConnection;
 	/*  DSCP to UP mapping for HS 2.0 */
 	tSirQosMapSet QosMapSet;
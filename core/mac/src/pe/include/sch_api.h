@@ -60,10 +60,29 @@ extern void sch_qos_update_local(tpAniSirGlobal pMac, tpPESession psessionEntry)
 extern void sch_edca_profile_update(tpAniSirGlobal pMac,
 				    tpPESession psessionEntry);
 
+/*
+ * Segments of the cached beacon template. The template is kept packed per
+ * session and only the segments named by the caller are regenerated:
+ * SCH_BCN_SEG_FIXED - MAC header and tDot11fBeacon1 (SSID, rates, DS params)
+ * SCH_BCN_SEG_IES   - tDot11fBeacon2 (HT/VHT, EDCA, CSA, WPS...) and the
+ *                     probe response template derived from it
+ * SCH_BCN_SEG_ADDN_IE - additional IEs supplied by hostapd (vendor, P2P NoA)
+ */
+#define SCH_BCN_SEG_FIXED       0x01
+#define SCH_BCN_SEG_IES         0x02
+#define SCH_BCN_SEG_ADDN_IE     0x04
+#define SCH_BCN_SEG_ALL         (SCH_BCN_SEG_FIXED | SCH_BCN_SEG_IES | \
+				 SCH_BCN_SEG_ADDN_IE)
+
 /* / Set the fixed fields in a beacon frame */
 extern tSirRetStatus sch_set_fixed_beacon_fields(tpAniSirGlobal pMac,
 						 tpPESession psessionEntry);
 
+/* Regenerate the given segments of the beacon template */
+tSirRetStatus sch_update_beacon_fields(tpAniSirGlobal pMac,
+				       tpPESession psessionEntry,
+				       uint8_t segs);
+
 /* / Initialize globals */
 extern void sch_init_globals(tpAniSirGlobal pMac);
 
@@ -1780,8 +1780,8 @@ void lim_process_messages(tpAniSirGlobal mac_ctx, tpSirMsgQ msg)
 					session_entry->beaconParams.beaconInterval;
 				beacon_params.paramChangeBitmap |=
 					PARAM_BCN_INTERVAL_CHANGED;
-				sch_set_fixed_beacon_fields(mac_ctx,
-					session_entry);
+				sch_update_beacon_fields(mac_ctx,
+					session_entry, SCH_BCN_SEG_IES);
 				lim_send_beacon_params(mac_ctx, &beacon_params,
 					session_entry);
 			}
@@ -4137,7 +4137,7 @@ __lim_process_sme_update_apwpsi_es(tpAniSirGlobal pMac, uint32_t *pMsgBuf)
 	cdf_mem_copy(&psessionEntry->APWPSIEs, &pUpdateAPWPSIEsReq->APWPSIEs,
 		     sizeof(tSirAPWPSIEs));
 
-	sch_set_fixed_beacon_fields(pMac, psessionEntry);
+	sch_update_beacon_fields(pMac, psessionEntry, SCH_BCN_SEG_IES);
 	lim_send_beacon_ind(pMac, psessionEntry);
 
 end:
@@ -4218,7 +4218,7 @@ static void __lim_process_sme_hide_ssid(tpAniSirGlobal pMac, uint32_t *pMsgBuf)
 	lim_send_vdev_restart(pMac, psessionEntry, pUpdateParams->sessionId);
 
 	/* Update beacon */
-	sch_set_fixed_beacon_fields(pMac, psessionEntry);
+	sch_update_beacon_fields(pMac, psessionEntry, SCH_BCN_SEG_FIXED);
 	lim_send_beacon_ind(pMac, psessionEntry);
 
 	return;
@@ -4325,7 +4325,8 @@ static void __lim_process_sme_change_bi(tpAniSirGlobal pMac, uint32_t *pMsgBuf)
 
 		if (false == pMac->sap.SapDfsInfo.is_dfs_cac_timer_running) {
 			/* Update beacon */
-			sch_set_fixed_beacon_fields(pMac, psessionEntry);
+			sch_update_beacon_fields(pMac, psessionEntry,
+						 SCH_BCN_SEG_FIXED);
 
 			beaconParams.bssIdx = psessionEntry->bssIdx;
 			/* Set change in beacon Interval */
@@ -5382,6 +5383,7 @@ static void lim_process_update_add_ies(tpAniSirGlobal mac_ctx,
 			cdf_mem_free(addn_ie->probeRespData_buff);
 			addn_ie->probeRespData_buff = NULL;
 			addn_ie->probeRespDataLen = 0;
+			session_entry->schBeaconUpdatePending = true;
 			break;
 		case eUPDATE_IE_ASSOC_RESP:
 			cdf_mem_free(addn_ie->assocRespData_buff);
@@ -5404,6 +5406,11 @@ static void lim_process_update_add_ies(tpAniSirGlobal mac_ctx,
 	}
 	switch (update_add_ies->updateType) {
 	case eUPDATE_IE_PROBE_RESP:
+		/*
+		 * Not part of the beacon, make sure the next beacon update
+		 * sends the probe response template again
+		 */
+		session_entry->schBeaconUpdatePending = true;
 		if (update_ie->append) {
 			/*
 			 * In case of append, allocate new memory
@@ -5633,8 +5640,8 @@ static void lim_process_sme_dfs_csa_ie_request(tpAniSirGlobal mac_ctx,
 	wider_bw_ch_switch->newCenterChanFreq1 = 0;
 skip_vht:
 	/* Send CSA IE request from here */
-	if (sch_set_fixed_beacon_fields(mac_ctx, session_entry) !=
-			eSIR_SUCCESS) {
+	if (sch_update_beacon_fields(mac_ctx, session_entry,
+				     SCH_BCN_SEG_IES) != eSIR_SUCCESS) {
 		lim_log(mac_ctx, LOGE, FL("Unable to set CSA IE in beacon"));
 		return;
 	}
@@ -5738,8 +5745,8 @@ static void lim_process_nss_update_request(tpAniSirGlobal mac_ctx,
 	session_entry->gLimOperatingMode.present = 1;
 	session_entry->gLimOperatingMode.rxNSS = nss_update_req_ptr->new_nss;
 	/* Send nss update request from here */
-	if (sch_set_fixed_beacon_fields(mac_ctx, session_entry) !=
-			eSIR_SUCCESS) {
+	if (sch_update_beacon_fields(mac_ctx, session_entry,
+				     SCH_BCN_SEG_IES) != eSIR_SUCCESS) {
 		lim_log(mac_ctx, LOGE,
 			FL("Unable to set op mode IE in beacon"));
 		return;
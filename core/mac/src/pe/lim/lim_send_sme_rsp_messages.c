@@ -2346,7 +2346,8 @@ lim_send_dfs_chan_sw_ie_update(tpAniSirGlobal pMac, tpPESession psessionEntry)
 {
 
 	/* Update the beacon template and send to FW */
-	if (sch_set_fixed_beacon_fields(pMac, psessionEntry) != eSIR_SUCCESS) {
+	if (sch_update_beacon_fields(pMac, psessionEntry, SCH_BCN_SEG_IES) !=
+	    eSIR_SUCCESS) {
 		PELOGE(lim_log(pMac, LOGE, FL("Unable to set CSA IE in beacon"));)
 		return;
 	}
@@ -6081,8 +6081,9 @@ void lim_update_beacon(tpAniSirGlobal mac_ctx)
 			&& (eLIM_SME_NORMAL_STATE ==
 				mac_ctx->lim.gpSession[i].limSmeState)) {
 
-			sch_set_fixed_beacon_fields(mac_ctx,
-						&mac_ctx->lim.gpSession[i]);
+			sch_update_beacon_fields(mac_ctx,
+						&mac_ctx->lim.gpSession[i],
+						SCH_BCN_SEG_ADDN_IE);
 
 			if (false == mac_ctx->sap.SapDfsInfo.
 					is_dfs_cac_timer_running)
@@ -6094,8 +6095,9 @@ void lim_update_beacon(tpAniSirGlobal mac_ctx)
 						eLIM_BT_AMP_STA_ROLE)) &&
 				(mac_ctx->lim.gpSession[i].statypeForBss ==
 							STA_ENTRY_SELF)){
-			sch_set_fixed_beacon_fields(mac_ctx,
-						&mac_ctx->lim.gpSession[i]);
+			sch_update_beacon_fields(mac_ctx,
+						&mac_ctx->lim.gpSession[i],
+						SCH_BCN_SEG_ADDN_IE);
 		}
 	}
 }
@@ -148,64 +148,116 @@ sch_append_addn_ie(tpAniSirGlobal mac_ctx, tpPESession session,
 }
 
 /**
- * sch_set_fixed_beacon_fields() - sets the fixed params in beacon frame
- * @mac_ctx:       mac global context
+ * struct sch_beacon_gen_buf - scratch space for beacon regeneration
+ * @bcn_1: unpacked fixed fields and leading IEs
+ * @bcn_2: unpacked trailing IEs
+ * @wsc_prb_res: WPS IE of the probe response template
+ * @frm: newly packed bytes of the segment being regenerated
+ */
+struct sch_beacon_gen_buf {
+	tDot11fBeacon1 bcn_1;
+	tDot11fBeacon2 bcn_2;
+	tDot11fIEWscProbeRes wsc_prb_res;
+	uint8_t frm[SCH_MAX_BEACON_SIZE];
+};
+
+static void clear_probe_rsp_ie_bitmap(uint32_t *ie_bitmap, uint32_t pos)
+{
+	if ((pos >> 5) >= 8)
+		return;
+	ie_bitmap[pos >> 5] &= ~(1 << (pos & 0x1F));
+}
+
+/**
+ * sch_reset_probe_rsp_template() - reset the probe response template
  * @session:       pe session entry
- * @band:          out param, band caclculated
- * @opr_ch:        operating channels
+ * @segs:          SCH_BCN_SEG_* segments being regenerated
  *
- * Return: status of operation
+ * The beacon interval, capabilities, SSID, rates and DS params of the
+ * probe response template come from tDot11fBeacon1 and everything else
+ * from tDot11fBeacon2. Only the part owned by the regenerated segments
+ * is cleared, so that the other one does not need to be rebuilt.
+ *
+ * Return: None
  */
-
-tSirRetStatus
-sch_set_fixed_beacon_fields(tpAniSirGlobal mac_ctx, tpPESession session)
+static void sch_reset_probe_rsp_template(tpPESession session, uint8_t segs)
 {
-	tpAniBeaconStruct bcn_struct = (tpAniBeaconStruct)
-						session->pSchBeaconFrameBegin;
-	tpSirMacMgmtHdr mac;
-	uint16_t offset;
-	uint8_t *ptr;
-	tDot11fBeacon1 *bcn_1;
-	tDot11fBeacon2 *bcn_2;
-	uint32_t i, n_status, n_bytes;
-	uint32_t wps_ap_enable = 0, tmp;
-	tDot11fIEWscProbeRes *wsc_prb_res;
-	uint8_t *extra_ie = NULL;
-	uint32_t extra_ie_len = 0;
-	uint16_t extra_ie_offset = 0;
-	uint16_t p2p_ie_offset = 0;
-	tSirRetStatus status = eSIR_SUCCESS;
-	bool is_vht_enabled = false;
-
-	bcn_1 = cdf_mem_malloc(sizeof(tDot11fBeacon1));
-	if (NULL == bcn_1) {
-		sch_log(mac_ctx, LOGE, FL("Failed to allocate memory"));
-		return eSIR_MEM_ALLOC_FAILED;
+	tDot11fProbeResponse *prb_rsp = &session->probeRespFrame;
+	uint32_t *ie_bitmap = &session->DefProbeRspIeBitmap[0];
+	tDot11fFfBeaconInterval bcn_int;
+	tDot11fFfCapabilities caps;
+	tDot11fIESSID ssid;
+	tDot11fIESuppRates rates;
+	tDot11fIEDSParams ds_params;
+
+	if ((segs & SCH_BCN_SEG_FIXED) && (segs & SCH_BCN_SEG_IES)) {
+		cdf_mem_set((uint8_t *) ie_bitmap, (sizeof(uint32_t) * 8), 0);
+		cdf_mem_set((uint8_t *) prb_rsp, sizeof(*prb_rsp), 0);
+		return;
 	}
 
-	bcn_2 = cdf_mem_malloc(sizeof(tDot11fBeacon2));
-	if (NULL == bcn_2) {
-		sch_log(mac_ctx, LOGE, FL("Failed to allocate memory"));
-		cdf_mem_free(bcn_1);
-		return eSIR_MEM_ALLOC_FAILED;
+	if (segs & SCH_BCN_SEG_FIXED) {
+		clear_probe_rsp_ie_bitmap(ie_bitmap, SIR_MAC_SSID_EID);
+		clear_probe_rsp_ie_bitmap(ie_bitmap, SIR_MAC_RATESET_EID);
+		clear_probe_rsp_ie_bitmap(ie_bitmap, SIR_MAC_DS_PARAM_SET_EID);
+		cdf_mem_set((uint8_t *) &prb_rsp->BeaconInterval,
+			    sizeof(prb_rsp->BeaconInterval), 0);
+		cdf_mem_set((uint8_t *) &prb_rsp->Capabilities,
+			    sizeof(prb_rsp->Capabilities), 0);
+		cdf_mem_set((uint8_t *) &prb_rsp->SSID,
+			    sizeof(prb_rsp->SSID), 0);
+		cdf_mem_set((uint8_t *) &prb_rsp->SuppRates,
+			    sizeof(prb_rsp->SuppRates), 0);
+		cdf_mem_set((uint8_t *) &prb_rsp->DSParams,
+			    sizeof(prb_rsp->DSParams), 0);
+		return;
 	}
 
-	wsc_prb_res = cdf_mem_malloc(sizeof(tDot11fIEWscProbeRes));
-	if (NULL == wsc_prb_res) {
-		sch_log(mac_ctx, LOGE, FL("Failed to allocate memory"));
-		cdf_mem_free(bcn_1);
-		cdf_mem_free(bcn_2);
-		return eSIR_MEM_ALLOC_FAILED;
-	}
+	if (!(segs & SCH_BCN_SEG_IES))
+		return;
+
+	/* Keep the tDot11fBeacon1 part, it is not regenerated */
+	bcn_int = prb_rsp->BeaconInterval;
+	caps = prb_rsp->Capabilities;
+	ssid = prb_rsp->SSID;
+	rates = prb_rsp->SuppRates;
+	ds_params = prb_rsp->DSParams;
+
+	cdf_mem_set((uint8_t *) ie_bitmap, (sizeof(uint32_t) * 8), 0);
+	cdf_mem_set((uint8_t *) prb_rsp, sizeof(*prb_rsp), 0);
+
+	prb_rsp->BeaconInterval = bcn_int;
+	prb_rsp->Capabilities = caps;
+	prb_rsp->SSID = ssid;
+	prb_rsp->SuppRates = rates;
+	prb_rsp->DSParams = ds_params;
+	if (ssid.present)
+		set_probe_rsp_ie_bitmap(ie_bitmap, SIR_MAC_SSID_EID);
+	if (rates.present)
+		set_probe_rsp_ie_bitmap(ie_bitmap, SIR_MAC_RATESET_EID);
+	if (ds_params.present)
+		set_probe_rsp_ie_bitmap(ie_bitmap, SIR_MAC_DS_PARAM_SET_EID);
+}
 
-	sch_log(mac_ctx, LOG1, FL("Setting fixed beacon fields"));
+/**
+ * sch_populate_beacon1() - fill the MAC header and tDot11fBeacon1
+ * @mac_ctx:       mac global context
+ * @session:       pe session entry
+ * @mac:           MAC header to fill
+ * @bcn_1:         beacon1 to fill
+ *
+ * Return: None
+ */
+static void sch_populate_beacon1(tpAniSirGlobal mac_ctx, tpPESession session,
+				 tpSirMacMgmtHdr mac, tDot11fBeacon1 *bcn_1)
+{
+	uint32_t i;
 
 	/*
 	 * First set the fixed fields:
 	 * set the TFP headers, set the mac header
 	 */
-	cdf_mem_set((uint8_t *) &bcn_struct->macHdr, sizeof(tSirMacMgmtHdr), 0);
-	mac = (tpSirMacMgmtHdr) &bcn_struct->macHdr;
+	cdf_mem_set((uint8_t *) mac, sizeof(tSirMacMgmtHdr), 0);
 	mac->fc.type = SIR_MAC_MGMT_FRAME;
 	mac->fc.subType = SIR_MAC_MGMT_BEACON;
 
@@ -241,49 +293,25 @@ sch_set_fixed_beacon_fields(tpAniSirGlobal mac_ctx, tpPESession session)
 	populate_dot11f_ds_params(mac_ctx, &bcn_1->DSParams,
 				  session->currentOperChannel);
 	populate_dot11f_ibss_params(mac_ctx, &bcn_1->IBSSParams, session);
+}
 
-	offset = sizeof(tAniBeaconStruct);
-	ptr = session->pSchBeaconFrameBegin + offset;
-
-	if (LIM_IS_AP_ROLE(session)) {
-		/* Initialize the default IE bitmap to zero */
-		cdf_mem_set((uint8_t *) &(session->DefProbeRspIeBitmap),
-			    (sizeof(uint32_t) * 8), 0);
-
-		/* Initialize the default IE bitmap to zero */
-		cdf_mem_set((uint8_t *) &(session->probeRespFrame),
-			    sizeof(session->probeRespFrame), 0);
-
-		/*
-		 * Can be efficiently updated whenever new IE added in Probe
-		 * response in future
-		 */
-		if (lim_update_probe_rsp_template_ie_bitmap_beacon1(mac_ctx,
-					bcn_1, session) != eSIR_SUCCESS)
-			sch_log(mac_ctx, LOGE,
-				FL("Failed to build ProbeRsp template"));
-	}
+/**
+ * sch_populate_beacon2() - fill tDot11fBeacon2
+ * @mac_ctx:       mac global context
+ * @session:       pe session entry
+ * @qos:           QoS bit of the beacon capabilities
+ * @bcn_2:         beacon2 to fill
+ *
+ * Return: None
+ */
+static void sch_populate_beacon2(tpAniSirGlobal mac_ctx, tpPESession session,
+				 bool qos, tDot11fBeacon2 *bcn_2)
+{
+	uint32_t wps_ap_enable = 0, tmp;
+	bool is_vht_enabled = false;
 
-	n_status = dot11f_pack_beacon1(mac_ctx, bcn_1, ptr,
-				      SCH_MAX_BEACON_SIZE - offset, &n_bytes);
-	if (DOT11F_FAILED(n_status)) {
-		sch_log(mac_ctx, LOGE,
-			FL("Failed to packed a tDot11fBeacon1 (0x%08x.)."),
-			n_status);
-		cdf_mem_free(bcn_1);
-		cdf_mem_free(bcn_2);
-		cdf_mem_free(wsc_prb_res);
-		return eSIR_FAILURE;
-	} else if (DOT11F_WARNED(n_status)) {
-		sch_log(mac_ctx, LOGE,
-			FL("Warnings while packing a tDot11fBeacon1(0x%08x.)."),
-			n_status);
-	}
 	/*changed  to correct beacon corruption */
 	cdf_mem_set((uint8_t *) bcn_2, sizeof(tDot11fBeacon2), 0);
-	session->schBeaconOffsetBegin = offset + (uint16_t) n_bytes;
-	sch_log(mac_ctx, LOG1, FL("Initialized beacon begin, offset %d"),
-		offset);
 
 	/* Initialize the 'new' fields at the end of the beacon */
 
@@ -296,10 +324,9 @@ sch_set_fixed_beacon_fields(tpAniSirGlobal mac_ctx, tpPESession session)
 	populate_dot11_supp_operating_classes(mac_ctx,
 		&bcn_2->SuppOperatingClasses, session);
 	populate_dot11f_country(mac_ctx, &bcn_2->Country, session);
-	if (bcn_1->Capabilities.qos)
+	if (qos)
 		populate_dot11f_edca_param_set(mac_ctx, &bcn_2->EDCAParamSet,
 					       session);
-
 	if (session->lim11hEnable) {
 		populate_dot11f_power_constraints(mac_ctx,
 						  &bcn_2->PowerConstraints);
@@ -422,23 +449,115 @@ sch_set_fixed_beacon_fields(tpAniSirGlobal mac_ctx, tpPESession session)
 							eLIM_WSC_ENROLL_NOOP;
 		}
 	}
+}
+
+/**
+ * sch_update_beacon_fields() - regenerate segments of the beacon template
+ * @mac_ctx:       mac global context
+ * @session:       pe session entry
+ * @segs:          SCH_BCN_SEG_* segments whose contents may have changed
+ *
+ * The beacon template is kept packed in the session. Only the segments in
+ * @segs are populated and packed again, the others are reused as they are.
+ * A regenerated segment which comes out identical to the cached one does not
+ * mark the beacon as changed, so the template is not written to firmware
+ * again when nothing in it moved.
+ *
+ * Return: status of operation
+ */
+tSirRetStatus
+sch_update_beacon_fields(tpAniSirGlobal mac_ctx, tpPESession session,
+			 uint8_t segs)
+{
+	tpAniBeaconStruct bcn_struct = (tpAniBeaconStruct)
+						session->pSchBeaconFrameBegin;
+	struct sch_beacon_gen_buf *buf;
+	tSirMacMgmtHdr mac;
+	tDot11fFfCapabilities caps;
+	tDot11fIESSID ssid;
+	tDot11fIEWscProbeRes *wsc_prb_res;
+	uint16_t offset, bcn_2_len, addn_ie_len;
+	uint32_t n_status, n_bytes;
+	uint8_t *extra_ie;
+	uint16_t p2p_ie_offset = 0;
+	bool qos = false, changed = false;
+
+	/* Nothing is cached before the first call, build everything */
+	if (!session->schBeaconOffsetBegin)
+		segs = SCH_BCN_SEG_ALL;
+	segs &= SCH_BCN_SEG_ALL;
+	if (!segs)
+		return eSIR_SUCCESS;
+
+	buf = cdf_mem_malloc(sizeof(*buf));
+	if (NULL == buf) {
+		sch_log(mac_ctx, LOGE, FL("Failed to allocate memory"));
+		return eSIR_MEM_ALLOC_FAILED;
+	}
+
+	sch_log(mac_ctx, LOG1, FL("Setting beacon fields, segments 0x%x"),
+		segs);
+
+	if (segs & SCH_BCN_SEG_FIXED) {
+		sch_populate_beacon1(mac_ctx, session, &mac, &buf->bcn_1);
+		qos = buf->bcn_1.Capabilities.qos;
+	} else if (segs & SCH_BCN_SEG_IES) {
+		/* EDCA params in beacon2 follow the beacon1 QoS bit */
+		cdf_mem_set((uint8_t *) &caps, sizeof(caps), 0);
+		populate_dot11f_capabilities(mac_ctx, &caps, session);
+		qos = caps.qos;
+	}
+
+	wsc_prb_res = &buf->wsc_prb_res;
+	if (segs & SCH_BCN_SEG_IES) {
+		sch_populate_beacon2(mac_ctx, session, qos, &buf->bcn_2);
+
+		/* update probe response WPS IE instead of beacon WPS IE */
+		cdf_mem_set((uint8_t *) wsc_prb_res, sizeof(*wsc_prb_res), 0);
+		if (LIM_IS_AP_ROLE(session) &&
+		    session->wps_state != SAP_WPS_DISABLED &&
+		    session->APWPSIEs.SirWPSProbeRspIE.FieldPresent)
+			populate_dot11f_probe_res_wpsi_es(mac_ctx, wsc_prb_res,
+							  session);
+	}
+
+	if (LIM_IS_AP_ROLE(session) &&
+	    (segs & (SCH_BCN_SEG_FIXED | SCH_BCN_SEG_IES))) {
+		/*
+		 * The real SSID and the WPS IE of the probe response are not
+		 * part of the beacon, compare them separately.
+		 */
+		ssid = session->probeRespFrame.SSID;
+		if ((segs & SCH_BCN_SEG_IES) &&
+		    (wsc_prb_res->present !=
+		     session->probeRespFrame.WscProbeRes.present ||
+		     (wsc_prb_res->present &&
+		      !cdf_mem_compare(wsc_prb_res,
+				       &session->probeRespFrame.WscProbeRes,
+				       sizeof(*wsc_prb_res)))))
+			changed = true;
+
+		sch_reset_probe_rsp_template(session, segs);
 
-	if ((LIM_IS_AP_ROLE(session))) {
 		/*
-		 * Can be efficiently updated whenever new IE added  in Probe
+		 * Can be efficiently updated whenever new IE added in Probe
 		 * response in future
 		 */
-		lim_update_probe_rsp_template_ie_bitmap_beacon2(mac_ctx, bcn_2,
+		if ((segs & SCH_BCN_SEG_FIXED) &&
+		    lim_update_probe_rsp_template_ie_bitmap_beacon1(mac_ctx,
+				&buf->bcn_1, session) != eSIR_SUCCESS)
+			sch_log(mac_ctx, LOGE,
+				FL("Failed to build ProbeRsp template"));
+		if ((segs & SCH_BCN_SEG_FIXED) &&
+		    !cdf_mem_compare(&ssid, &session->probeRespFrame.SSID,
+				     sizeof(ssid)))
+			changed = true;
+
+		if (segs & SCH_BCN_SEG_IES) {
+			lim_update_probe_rsp_template_ie_bitmap_beacon2(mac_ctx,
+					&buf->bcn_2,
 					&session->DefProbeRspIeBitmap[0],
 					&session->probeRespFrame);
-
-		/* update probe response WPS IE instead of beacon WPS IE */
-		if (session->wps_state != SAP_WPS_DISABLED) {
-			if (session->APWPSIEs.SirWPSProbeRspIE.FieldPresent)
-				populate_dot11f_probe_res_wpsi_es(mac_ctx,
-							wsc_prb_res, session);
-			else
-				wsc_prb_res->present = 0;
 			if (wsc_prb_res->present) {
 				set_probe_rsp_ie_bitmap(
 					&session->DefProbeRspIeBitmap[0],
@@ -449,53 +568,133 @@ sch_set_fixed_beacon_fields(tpAniSirGlobal mac_ctx, tpPESession session)
 					sizeof(tDot11fIEWscProbeRes));
 			}
 		}
+	}
+
+	offset = sizeof(tAniBeaconStruct);
+	if (segs & SCH_BCN_SEG_FIXED) {
+		n_status = dot11f_pack_beacon1(mac_ctx, &buf->bcn_1, buf->frm,
+					SCH_MAX_BEACON_SIZE - offset, &n_bytes);
+		if (DOT11F_FAILED(n_status)) {
+			sch_log(mac_ctx, LOGE,
+				FL("Failed to packed a tDot11fBeacon1 (0x%08x.)."),
+				n_status);
+			cdf_mem_free(buf);
+			return eSIR_FAILURE;
+		} else if (DOT11F_WARNED(n_status)) {
+			sch_log(mac_ctx, LOGE,
+				FL("Warnings while packing a tDot11fBeacon1(0x%08x.)."),
+				n_status);
+		}
+
+		if (offset + n_bytes != session->schBeaconOffsetBegin ||
+		    !cdf_mem_compare(&bcn_struct->macHdr, &mac, sizeof(mac)) ||
+		    !cdf_mem_compare(session->pSchBeaconFrameBegin + offset,
+				     buf->frm, n_bytes)) {
+			cdf_mem_copy(&bcn_struct->macHdr, &mac, sizeof(mac));
+			cdf_mem_copy(session->pSchBeaconFrameBegin + offset,
+				     buf->frm, n_bytes);
+			session->schBeaconOffsetBegin =
+				offset + (uint16_t) n_bytes;
+			changed = true;
+		}
+		sch_log(mac_ctx, LOG1, FL("Initialized beacon begin, offset %d"),
+			offset);
+	}
+
+	bcn_2_len = session->schBeaconOffsetAddnIe;
+	addn_ie_len = session->schBeaconOffsetEnd - bcn_2_len;
+	if (segs & SCH_BCN_SEG_IES) {
+		n_status = dot11f_pack_beacon2(mac_ctx, &buf->bcn_2, buf->frm,
+					       SCH_MAX_BEACON_SIZE, &n_bytes);
+		if (DOT11F_FAILED(n_status)) {
+			sch_log(mac_ctx, LOGE,
+				FL("Failed to packed a tDot11fBeacon2 (0x%08x.)."),
+				n_status);
+			cdf_mem_free(buf);
+			return eSIR_FAILURE;
+		} else if (DOT11F_WARNED(n_status)) {
+			sch_log(mac_ctx, LOGE,
+				FL("Warnings while packing a tDot11fBeacon2(0x%08x.)."),
+				n_status);
+		}
+
+		if (n_bytes != bcn_2_len ||
+		    !cdf_mem_compare(session->pSchBeaconFrameEnd, buf->frm,
+				     n_bytes)) {
+			/* Keep the cached additional IEs behind beacon2 */
+			if (!(segs & SCH_BCN_SEG_ADDN_IE) && addn_ie_len) {
+				if (n_bytes + addn_ie_len <= SCH_MAX_BEACON_SIZE)
+					cdf_mem_move(session->pSchBeaconFrameEnd +
+						     n_bytes,
+						     session->pSchBeaconFrameEnd +
+						     bcn_2_len, addn_ie_len);
+				else
+					segs |= SCH_BCN_SEG_ADDN_IE;
+			}
+			cdf_mem_copy(session->pSchBeaconFrameEnd, buf->frm,
+				     n_bytes);
+			bcn_2_len = (uint16_t) n_bytes;
+			changed = true;
+		}
+	}
 
+	if (segs & SCH_BCN_SEG_ADDN_IE) {
+		n_bytes = bcn_2_len;
+		sch_append_addn_ie(mac_ctx, session, buf->frm,
+				   SCH_MAX_BEACON_SIZE, &n_bytes);
+		n_bytes -= bcn_2_len;
+		if (n_bytes != addn_ie_len ||
+		    !cdf_mem_compare(session->pSchBeaconFrameEnd + bcn_2_len,
+				     buf->frm, n_bytes)) {
+			cdf_mem_copy(session->pSchBeaconFrameEnd + bcn_2_len,
+				     buf->frm, n_bytes);
+			addn_ie_len = (uint16_t) n_bytes;
+			changed = true;
+		}
 	}
+	session->schBeaconOffsetAddnIe = bcn_2_len;
+	session->schBeaconOffsetEnd = bcn_2_len + addn_ie_len;
 
-	n_status = dot11f_pack_beacon2(mac_ctx, bcn_2,
-				      session->pSchBeaconFrameEnd,
-				      SCH_MAX_BEACON_SIZE, &n_bytes);
-	if (DOT11F_FAILED(n_status)) {
-		sch_log(mac_ctx, LOGE,
-			FL("Failed to packed a tDot11fBeacon2 (0x%08x.)."),
-			n_status);
-		cdf_mem_free(bcn_1);
-		cdf_mem_free(bcn_2);
-		cdf_mem_free(wsc_prb_res);
-		return eSIR_FAILURE;
-	} else if (DOT11F_WARNED(n_status)) {
-		sch_log(mac_ctx, LOGE,
-			FL("Warnings while packing a tDot11fBeacon2(0x%08x.)."),
-			n_status);
-	}
-
-	extra_ie = session->pSchBeaconFrameEnd + n_bytes;
-	extra_ie_offset = n_bytes;
-	/* TODO: Append additional IE here. */
-	sch_append_addn_ie(mac_ctx, session,
-			   session->pSchBeaconFrameEnd + n_bytes,
-			   SCH_MAX_BEACON_SIZE, &n_bytes);
-	session->schBeaconOffsetEnd = (uint16_t) n_bytes;
-	extra_ie_len = n_bytes - extra_ie_offset;
 	/* Get the p2p Ie Offset */
-	status = sch_get_p2p_ie_offset(extra_ie, extra_ie_len, &p2p_ie_offset);
-	if (eSIR_SUCCESS == status)
+	extra_ie = session->pSchBeaconFrameEnd + bcn_2_len;
+	if (eSIR_SUCCESS == sch_get_p2p_ie_offset(extra_ie, addn_ie_len,
+						  &p2p_ie_offset))
 		/* Update the P2P Ie Offset */
 		mac_ctx->sch.schObject.p2pIeOffset =
 			session->schBeaconOffsetBegin + TIM_IE_SIZE +
-			extra_ie_offset + p2p_ie_offset;
+			bcn_2_len + p2p_ie_offset;
 	else
 		mac_ctx->sch.schObject.p2pIeOffset = 0;
 
 	sch_log(mac_ctx, LOG1, FL("Initialized beacon end, offset %d"),
 		session->schBeaconOffsetEnd);
-	mac_ctx->sch.schObject.fBeaconChanged = 1;
-	cdf_mem_free(bcn_1);
-	cdf_mem_free(bcn_2);
-	cdf_mem_free(wsc_prb_res);
+
+	if (changed)
+		session->schBeaconUpdatePending = true;
+	if (session->schBeaconUpdatePending)
+		mac_ctx->sch.schObject.fBeaconChanged = 1;
+	else
+		sch_log(mac_ctx, LOG1, FL("Beacon template unchanged"));
+
+	cdf_mem_free(buf);
 	return eSIR_SUCCESS;
 }
 
+/**
+ * sch_set_fixed_beacon_fields() - sets the fixed params in beacon frame
+ * @mac_ctx:       mac global context
+ * @session:       pe session entry
+ *
+ * Regenerates the whole beacon template, see sch_update_beacon_fields().
+ *
+ * Return: status of operation
+ */
+tSirRetStatus
+sch_set_fixed_beacon_fields(tpAniSirGlobal mac_ctx, tpPESession session)
+{
+	return sch_update_beacon_fields(mac_ctx, session, SCH_BCN_SEG_ALL);
+}
+
 tSirRetStatus lim_update_probe_rsp_template_ie_bitmap_beacon1(tpAniSirGlobal pMac,
 						     tDot11fBeacon1 *beacon1,
 							      tpPESession
@@ -799,6 +998,7 @@ void write_beacon_to_memory(tpAniSirGlobal pMac, uint16_t size, uint16_t length,
 			}
 	}
 	pMac->sch.schObject.fBeaconChanged = 0;
+	psessionEntry->schBeaconUpdatePending = false;
 }
 
 /**
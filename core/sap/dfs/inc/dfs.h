@@ -61,6 +61,8 @@
 
 /* From wlan_modules/include/ */
 #include "ath_dfs_structs.h"
+/* Radar filter and delay line definitions */
+#include "dfs_filter.h"
 /*DFS - Newly added File to interface cld UMAC and dfs data structures*/
 #include <wma_dfs_interface.h>
 /*
@@ -86,9 +88,6 @@
 		}						     \
 } while (0)
 
-#define DFS_MIN(a, b) ((a) < (b) ? (a) : (b))
-#define DFS_MAX(a, b) ((a) > (b) ? (a) : (b))
-#define DFS_DIFF(a, b) (DFS_MAX(a, b) - DFS_MIN(a, b))
 /*
  * Maximum number of radar events to be processed in a single iteration.
  * Allows soft watchdog to run.
@@ -124,8 +123,6 @@
  */
 #define DFS_CHAN_LOADING_THRESH         50
 #define DFS_EXT_CHAN_LOADING_THRESH     30
-#define DFS_DEFAULT_PRI_MARGIN          6
-#define DFS_DEFAULT_FIXEDPATTERN_PRI_MARGIN       4
 #define ATH_DFSQ_LOCK(_dfs)        cdf_spin_lock_bh((&(_dfs)->dfs_radarqlock))
 #define ATH_DFSQ_UNLOCK(_dfs)      cdf_spin_unlock_bh((&(_dfs)->dfs_radarqlock))
 #define ATH_DFSQ_LOCK_INIT(_dfs)   cdf_spinlock_init(&(_dfs)->dfs_radarqlock)
@@ -157,9 +154,6 @@
 #define  DFS_AR_ACK_DETECT_PAR_THRESH  20
 #define  DFS_AR_PKT_COUNT_THRESH    20
 
-#define  DFS_MAX_DL_SIZE         64
-#define  DFS_MAX_DL_MASK         0x3F
-
 #define DFS_NOL_TIME       DFS_NOL_TIMEOUT_US
 /* 30 minutes in usecs */
 
@@ -170,7 +164,6 @@
 #define  DFS_MAX_B5_SIZE         128
 #define  DFS_MAX_B5_MASK         0x0000007F     /* 128 */
 
-#define  DFS_MAX_RADAR_OVERLAP      16  /* Max number of overlapping filters */
 /* Max number of dfs events which can be q'd */
 #define  DFS_MAX_EVENTS       1024
 
@@ -194,9 +187,6 @@
 /*Following threshold is not specified but should be okay statistically*/
 #define DFS_BIN5_BRI_LOWER_LIMIT 300000 /* us */
 #define DFS_BIN5_BRI_UPPER_LIMIT 12000000       /* us */
-/* Max number of pulses kept in buffer */
-#define DFS_MAX_PULSE_BUFFER_SIZE 1024
-#define DFS_MAX_PULSE_BUFFER_MASK 0x3ff
 
 #define DFS_FAST_CLOCK_MULTIPLIER       (800/11)
 #define DFS_NO_FAST_CLOCK_MULTIPLIER    (80)
@@ -219,32 +209,6 @@
 
 typedef cdf_spinlock_t dfsq_lock_t;
 
-#ifdef WIN32
-#pragma pack(push, dfs_pulseparams, 1)
-#endif
-struct dfs_pulseparams {
-	uint64_t p_time;        /* time for start of pulse in usecs */
-	uint8_t p_dur;          /* Duration of pulse in usecs */
-	uint8_t p_rssi;         /* Duration of pulse in usecs */
-} cdf_packed;
-#ifdef WIN32
-#pragma pack(pop, dfs_pulseparams)
-#endif
-
-#ifdef WIN32
-#pragma pack(push, dfs_pulseline, 1)
-#endif
-struct dfs_pulseline {
-	/* pl_elems - array of pulses in delay line */
-	struct dfs_pulseparams pl_elems[DFS_MAX_PULSE_BUFFER_SIZE];
-	uint32_t pl_firstelem;  /* Index of the first element */
-	uint32_t pl_lastelem;   /* Index of the last element */
-	uint32_t pl_numelems;   /* Number of elements in the delay line */
-} cdf_packed;
-#ifdef WIN32
-#pragma pack(pop, dfs_pulseline)
-#endif
-
 #ifdef WIN32
 #pragma pack(push, dfs_event, 1)
 #endif
@@ -295,10 +259,6 @@ struct dfs_event {
 #define DFS_RADARQ_SEQSIZE 513  /* Sequence counter wrap for radar */
 /* Number of radar channels we keep state for */
 #define DFS_NUM_RADAR_STATES  64
-/* Max number radar filters for each type */
-#define DFS_MAX_NUM_RADAR_FILTERS 10
-/* Number of different radar types */
-#define DFS_MAX_RADAR_TYPES   32
 
 struct dfs_ar_state {
 	uint32_t ar_prevwidth;
@@ -311,103 +271,6 @@ struct dfs_ar_state {
 	uint16_t ar_peaklist[DFS_AR_MAX_NUM_PEAKS];
 };
 
-#ifdef WIN32
-#pragma pack(push, dfs_delayelem, 1)
-#endif
-struct dfs_delayelem {
-	/* Current "filter" time for start of pulse in usecs */
-	uint32_t de_time;
-	/* Duration of pulse in usecs */
-	uint8_t de_dur;
-	/* rssi of pulse in dB */
-	uint8_t de_rssi;
-	/* time stamp for this delay element */
-	uint64_t de_ts;
-} cdf_packed;
-#ifdef WIN32
-#pragma pack(pop, dfs_delayelem)
-#endif
-
-/* NB: The first element in the circular buffer is the oldest element */
-
-#ifdef WIN32
-#pragma pack(push, dfs_delayline, 1)
-#endif
-struct dfs_delayline {
-	/* Array of pulses in delay line */
-	struct dfs_delayelem dl_elems[DFS_MAX_DL_SIZE];
-	/* Last timestamp the delay line was used (in usecs) */
-	uint64_t dl_last_ts;
-	/* Index of the first element */
-	uint32_t dl_firstelem;
-	/* Index of the last element */
-	uint32_t dl_lastelem;
-	/* Number of elements in the delay line */
-	uint32_t dl_numelems;
-} cdf_packed;
-#ifdef WIN32
-#pragma pack(pop, dfs_delayline)
-#endif
-
-#ifdef WIN32
-#pragma pack(push, dfs_filter, 1)
-#endif
-struct dfs_filter {
-	/* Delay line of pulses for this filter */
-	struct dfs_delayline rf_dl;
-	/* Number of pulses in the filter */
-	uint32_t rf_numpulses;
-	/* min pri to be considered for this filter */
-	uint32_t rf_minpri;
-	/* max pri to be considered for this filter */
-	uint32_t rf_maxpri;
-	/* match filter output threshold for radar detect */
-	uint32_t rf_threshold;
-	/* Length (in usecs) of the filter */
-	uint32_t rf_filterlen;
-	/* fixed or variable pattern type */
-	uint32_t rf_patterntype;
-	/* indicates if it is a fixed pri pulse */
-	uint32_t rf_fixed_pri_radar_pulse;
-	/* Min duration for this radar filter */
-	uint32_t rf_mindur;
-	/* Max duration for this radar filter */
-	uint32_t rf_maxdur;
-	uint32_t rf_ignore_pri_window;
-	/* Unique ID corresponding to the original filter ID */
-	uint32_t rf_pulseid;
-} cdf_packed;
-#ifdef WIN32
-#pragma pack(pop, dfs_filter)
-#endif
-
-struct dfs_filtertype {
-	struct dfs_filter ft_filters[DFS_MAX_NUM_RADAR_FILTERS];
-	/* Duration of pulse which specifies filter type */
-	uint32_t ft_filterdur;
-	/* Num filters of this type */
-	uint32_t ft_numfilters;
-	/* Last timestamp this filtertype was used(in usecs) */
-	uint64_t ft_last_ts;
-	/* min pulse duration to be considered for this filter type */
-	uint32_t ft_mindur;
-	/* max pulse duration to be considered for this filter type */
-	uint32_t ft_maxdur;
-	/* min rssi to be considered for this filter type */
-	uint32_t ft_rssithresh;
-	/* Num pulses in each filter of this type */
-	uint32_t ft_numpulses;
-	/* fixed or variable pattern type */
-	uint32_t ft_patterntype;
-	/* min pri to be considered for this type */
-	uint32_t ft_minpri;
-	/* rssi threshold margin. In Turbo Mode HW
-	 * reports rssi 3dB lower than in non TURBO
-	 * mode. This will offset that diff.
-	 */
-	uint32_t ft_rssimargin;
-};
-
 struct dfs_state {
 	struct dfs_ieee80211_channel rs_chan;       /* Channel info */
 	uint8_t rs_chanindex;   /* Channel index in radar structure */
@@ -793,6 +656,9 @@ int dfs_bin_pri_check(struct ath_dfs *dfs, struct dfs_filter *rf,
 		      int fundamentalpri);
 int dfs_staggered_check(struct ath_dfs *dfs, struct dfs_filter *rf,
 			uint32_t deltaT, uint32_t width);
+uint32_t dfs_delayline_get_pri(struct dfs_delayline *dl, uint32_t *pri);
+int dfs_pri_score(const uint32_t *pri, uint32_t num, uint32_t refpri,
+		  uint32_t primargin, int harmonics);
 /* False detection reduction */
 int dfs_get_pri_margin(struct ath_dfs *dfs, int is_extchan_detect,
 		       int is_fixed_pattern);
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2005-2015 The Linux Foundation. All rights reserved.
+ *
+ * Previously licensed under the ISC license by Qualcomm Atheros, Inc.
+ *
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * This file was originally distributed by Qualcomm Atheros, Inc.
+ * under proprietary terms before Copyright ownership was assigned
+ * to the Linux Foundation.
+ */
+
+/*
+ * Radar pulse line, delay line and filter definitions used by the bin
+ * detectors in dfs_bindetects.c and dfs_staggered.c.
+ *
+ * This file only needs the fixed width integer types and cdf_packed, so
+ * that the detectors can also be built into the userspace replay tool
+ * under tools/.
+ */
+
+#ifndef _DFS_FILTER_H_
+#define _DFS_FILTER_H_
+
+#define DFS_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define DFS_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define DFS_DIFF(a, b) (DFS_MAX(a, b) - DFS_MIN(a, b))
+
+/* PRI match margins in usecs, before the channel busy adjustment */
+#define DFS_DEFAULT_PRI_MARGIN          6
+#define DFS_DEFAULT_FIXEDPATTERN_PRI_MARGIN       4
+
+#define  DFS_MAX_DL_SIZE         64
+#define  DFS_MAX_DL_MASK         0x3F
+
+/* Max number of pulses kept in buffer */
+#define DFS_MAX_PULSE_BUFFER_SIZE 1024
+#define DFS_MAX_PULSE_BUFFER_MASK 0x3ff
+
+#ifdef WIN32
+#pragma pack(push, dfs_pulseparams, 1)
+#endif
+struct dfs_pulseparams {
+	uint64_t p_time;        /* time for start of pulse in usecs */
+	uint8_t p_dur;          /* Duration of pulse in usecs */
+	uint8_t p_rssi;         /* Duration of pulse in usecs */
+} cdf_packed;
+#ifdef WIN32
+#pragma pack(pop, dfs_pulseparams)
+#endif
+
+#ifdef WIN32
+#pragma pack(push, dfs_pulseline, 1)
+#endif
+struct dfs_pulseline {
+	/* pl_elems - array of pulses in delay line */
+	struct dfs_pulseparams pl_elems[DFS_MAX_PULSE_BUFFER_SIZE];
+	uint32_t pl_firstelem;  /* Index of the first element */
+	uint32_t pl_lastelem;   /* Index of the last element */
+	uint32_t pl_numelems;   /* Number of elements in the delay line */
+} cdf_packed;
+#ifdef WIN32
+#pragma pack(pop, dfs_pulseline)
+#endif
+
+#define  DFS_MAX_RADAR_OVERLAP      16  /* Max number of overlapping filters */
+/* Max number radar filters for each type */
+#define DFS_MAX_NUM_RADAR_FILTERS 10
+/* Number of different radar types */
+#define DFS_MAX_RADAR_TYPES   32
+
+#ifdef WIN32
+#pragma pack(push, dfs_delayelem, 1)
+#endif
+struct dfs_delayelem {
+	/* Current "filter" time for start of pulse in usecs */
+	uint32_t de_time;
+	/* Duration of pulse in usecs */
+	uint8_t de_dur;
+	/* rssi of pulse in dB */
+	uint8_t de_rssi;
+	/* time stamp for this delay element */
+	uint64_t de_ts;
+} cdf_packed;
+#ifdef WIN32
+#pragma pack(pop, dfs_delayelem)
+#endif
+
+/* NB: The first element in the circular buffer is the oldest element */
+
+#ifdef WIN32
+#pragma pack(push, dfs_delayline, 1)
+#endif
+struct dfs_delayline {
+	/* Array of pulses in delay line */
+	struct dfs_delayelem dl_elems[DFS_MAX_DL_SIZE];
+	/* Last timestamp the delay line was used (in usecs) */
+	uint64_t dl_last_ts;
+	/* Index of the first element */
+	uint32_t dl_firstelem;
+	/* Index of the last element */
+	uint32_t dl_lastelem;
+	/* Number of elements in the delay line */
+	uint32_t dl_numelems;
+} cdf_packed;
+#ifdef WIN32
+#pragma pack(pop, dfs_delayline)
+#endif
+
+#ifdef WIN32
+#pragma pack(push, dfs_filter, 1)
+#endif
+struct dfs_filter {
+	/* Delay line of pulses for this filter */
+	struct dfs_delayline rf_dl;
+	/* Number of pulses in the filter */
+	uint32_t rf_numpulses;
+	/* min pri to be considered for this filter */
+	uint32_t rf_minpri;
+	/* max pri to be considered for this filter */
+	uint32_t rf_maxpri;
+	/* match filter output threshold for radar detect */
+	uint32_t rf_threshold;
+	/* Length (in usecs) of the filter */
+	uint32_t rf_filterlen;
+	/* fixed or variable pattern type */
+	uint32_t rf_patterntype;
+	/* indicates if it is a fixed pri pulse */
+	uint32_t rf_fixed_pri_radar_pulse;
+	/* Min duration for this radar filter */
+	uint32_t rf_mindur;
+	/* Max duration for this radar filter */
+	uint32_t rf_maxdur;
+	uint32_t rf_ignore_pri_window;
+	/* Unique ID corresponding to the original filter ID */
+	uint32_t rf_pulseid;
+} cdf_packed;
+#ifdef WIN32
+#pragma pack(pop, dfs_filter)
+#endif
+
+struct dfs_filtertype {
+	struct dfs_filter ft_filters[DFS_MAX_NUM_RADAR_FILTERS];
+	/* Duration of pulse which specifies filter type */
+	uint32_t ft_filterdur;
+	/* Num filters of this type */
+	uint32_t ft_numfilters;
+	/* Last timestamp this filtertype was used(in usecs) */
+	uint64_t ft_last_ts;
+	/* min pulse duration to be considered for this filter type */
+	uint32_t ft_mindur;
+	/* max pulse duration to be considered for this filter type */
+	uint32_t ft_maxdur;
+	/* min rssi to be considered for this filter type */
+	uint32_t ft_rssithresh;
+	/* Num pulses in each filter of this type */
+	uint32_t ft_numpulses;
+	/* fixed or variable pattern type */
+	uint32_t ft_patterntype;
+	/* min pri to be considered for this type */
+	uint32_t ft_minpri;
+	/* rssi threshold margin. In Turbo Mode HW
+	 * reports rssi 3dB lower than in non TURBO
+	 * mode. This will offset that diff.
+	 */
+	uint32_t ft_rssimargin;
+};
+
+#endif /* _DFS_FILTER_H_ */
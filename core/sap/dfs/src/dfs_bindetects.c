@@ -57,6 +57,58 @@
  */
 #ifdef ATH_SUPPORT_DFS
 
+/**
+ * dfs_delayline_get_pri() - copy the PRIs of a delay line to a flat array
+ * @dl: delay line
+ * @pri: array of at least DFS_MAX_DL_SIZE entries
+ *
+ * The PRI scoring loops compare every delay line element against every
+ * other one but only need the PRI. Unrolling the ring of delay elements
+ * into a flat array once lets those loops walk contiguous memory without
+ * masking the index on every access, which the compiler can vectorize.
+ *
+ * Return: number of PRIs copied, in delay line order
+ */
+uint32_t dfs_delayline_get_pri(struct dfs_delayline *dl, uint32_t *pri)
+{
+	uint32_t n;
+
+	for (n = 0; n < dl->dl_numelems; n++)
+		pri[n] = dl->dl_elems[(dl->dl_firstelem + n) &
+				      DFS_MAX_DL_MASK].de_time;
+
+	return dl->dl_numelems;
+}
+
+/**
+ * dfs_pri_score() - count the PRIs within a margin of a reference PRI
+ * @pri: PRIs from dfs_delayline_get_pri()
+ * @num: number of entries in @pri
+ * @refpri: reference PRI
+ * @primargin: PRI margin
+ * @harmonics: also match twice and three times the reference PRI
+ *
+ * Return: number of matching PRIs
+ */
+int dfs_pri_score(const uint32_t *pri, uint32_t num, uint32_t refpri,
+		  uint32_t primargin, int harmonics)
+{
+	uint32_t i, refpri_2 = 2 * refpri, refpri_3 = 3 * refpri;
+	int score = 0;
+
+	if (harmonics) {
+		for (i = 0; i < num; i++)
+			score += (DFS_DIFF(pri[i], refpri) < primargin) |
+				 (DFS_DIFF(pri[i], refpri_2) < primargin) |
+				 (DFS_DIFF(pri[i], refpri_3) < primargin);
+	} else {
+		for (i = 0; i < num; i++)
+			score += (DFS_DIFF(pri[i], refpri) < primargin);
+	}
+
+	return score;
+}
+
 int
 dfs_bin_fixedpattern_check(struct ath_dfs *dfs, struct dfs_filter *rf,
 			   uint32_t dur, int ext_chan_flag)
@@ -199,14 +251,14 @@ int
 dfs_bin_check(struct ath_dfs *dfs, struct dfs_filter *rf, uint32_t deltaT,
 	      uint32_t width, int ext_chan_flag)
 {
-	uint32_t refpri, refdur, searchpri, deltapri, deltapri_2, deltapri_3,
-		 averagerefpri;
-	uint32_t n, i, primargin, durmargin, highscore, highscoreindex;
-	int score[DFS_MAX_DL_SIZE], delayindex, dindex, found = 0;
+	uint32_t refpri, refdur, averagerefpri;
+	uint32_t pri[DFS_MAX_DL_SIZE], numpri;
+	uint32_t n, primargin, durmargin, highscore, highscoreindex;
+	int score[DFS_MAX_DL_SIZE], delayindex, found = 0;
 	struct dfs_delayline *dl;
 	uint32_t scoreindex, lowpriindex = 0, lowpri = 0xffff;
 	int numpulses = 0;
-	int lowprichk = 3, pri_match = 0;
+	int lowprichk = 3;
 
 	dl = &rf->rf_dl;
 	if (dl->dl_numelems < (rf->rf_threshold - 1)) {
@@ -234,43 +286,25 @@ dfs_bin_check(struct ath_dfs *dfs, struct dfs_filter *rf, uint32_t deltaT,
 	}
 
 	OS_MEMZERO(score, sizeof(int) * DFS_MAX_DL_SIZE);
+	numpri = dfs_delayline_get_pri(dl, pri);
 	/* find out the lowest pri */
-	for (n = 0; n < dl->dl_numelems; n++) {
-		delayindex = (dl->dl_firstelem + n) & DFS_MAX_DL_MASK;
-		refpri = dl->dl_elems[delayindex].de_time;
+	for (n = 0; n < numpri; n++) {
+		refpri = pri[n];
 		if (refpri == 0)
 			continue;
 		else if (refpri < lowpri) {
-			lowpri = dl->dl_elems[delayindex].de_time;
+			lowpri = refpri;
 			lowpriindex = n;
 		}
 	}
 	/* find out the each delay element's pri score */
-	for (n = 0; n < dl->dl_numelems; n++) {
-		delayindex = (dl->dl_firstelem + n) & DFS_MAX_DL_MASK;
-		refpri = dl->dl_elems[delayindex].de_time;
+	for (n = 0; n < numpri; n++) {
+		refpri = pri[n];
 		if (refpri == 0)
 			continue;
 		if (refpri < rf->rf_maxpri) {   /* use only valid PRI range for high score */
-			for (i = 0; i < dl->dl_numelems; i++) {
-				dindex =
-					(dl->dl_firstelem + i) & DFS_MAX_DL_MASK;
-				searchpri = dl->dl_elems[dindex].de_time;
-				deltapri = DFS_DIFF(searchpri, refpri);
-				deltapri_2 = DFS_DIFF(searchpri, 2 * refpri);
-				deltapri_3 = DFS_DIFF(searchpri, 3 * refpri);
-				if (rf->rf_ignore_pri_window == 2) {
-					pri_match = ((deltapri < primargin)
-						     || (deltapri_2 < primargin)
-						     || (deltapri_3 <
-							 primargin));
-				} else {
-					pri_match = (deltapri < primargin);
-				}
-
-				if (pri_match)
-					score[n]++;
-			}
+			score[n] = dfs_pri_score(pri, numpri, refpri, primargin,
+						 rf->rf_ignore_pri_window == 2);
 		} else {
 			score[n] = 0;
 		}
@@ -283,20 +317,14 @@ dfs_bin_check(struct ath_dfs *dfs, struct dfs_filter *rf, uint32_t deltaT,
 	/* find out the high scorer */
 	highscore = 0;
 	highscoreindex = 0;
-	for (n = 0; n < dl->dl_numelems; n++) {
+	for (n = 0; n < numpri; n++) {
 		if (score[n] > highscore) {
 			highscore = score[n];
 			highscoreindex = n;
 		} else if (score[n] == highscore) {
 			/*more than one pri has highscore take the least pri */
-			delayindex =
-				(dl->dl_firstelem +
-				 highscoreindex) & DFS_MAX_DL_MASK;
-			dindex = (dl->dl_firstelem + n) & DFS_MAX_DL_MASK;
-			if (dl->dl_elems[dindex].de_time <=
-			    dl->dl_elems[delayindex].de_time) {
+			if (pri[n] <= pri[highscoreindex])
 				highscoreindex = n;
-			}
 		}
 	}
 	/* find the average pri of pulses around the pri of highscore or
@@ -375,10 +403,11 @@ dfs_bin_pri_check(struct ath_dfs *dfs, struct dfs_filter *rf,
 
 		MatchCount = 0;
 		if (score > priscorechk) {
-			for (i = 0; i < dl->dl_numelems; i++) {
-				dindex =
-					(dl->dl_firstelem + i) & DFS_MAX_DL_MASK;
-				searchpri = dl->dl_elems[dindex].de_time;
+			uint32_t pri[DFS_MAX_DL_SIZE], numpri;
+
+			numpri = dfs_delayline_get_pri(dl, pri);
+			for (i = 0; i < numpri; i++) {
+				searchpri = pri[i];
 				deltapri = DFS_DIFF(searchpri, refpri);
 				if (deltapri < primargin) {
 					averagerefpri += searchpri;
@@ -98,9 +98,10 @@ static int is_unique_pri(uint32_t highestpri, uint32_t midpri,
 int dfs_staggered_check(struct ath_dfs *dfs, struct dfs_filter *rf,
 			uint32_t deltaT, uint32_t width)
 {
-	uint32_t refpri, refdur, searchpri = 0, deltapri;       /* , averagerefpri; */
-	uint32_t n, i, primargin, durmargin;
-	int score[DFS_MAX_DL_SIZE], delayindex, dindex, found = 0;
+	uint32_t refpri, refdur;       /* , averagerefpri; */
+	uint32_t pri[DFS_MAX_DL_SIZE], numpri;
+	uint32_t n, primargin, durmargin;
+	int score[DFS_MAX_DL_SIZE], delayindex, found = 0;
 	struct dfs_delayline *dl;
 	uint32_t scoreindex, lowpriindex = 0, lowpri = 0xffff;
 #if 0
@@ -133,21 +134,20 @@ int dfs_staggered_check(struct ath_dfs *dfs, struct dfs_filter *rf,
 	}
 
 	OS_MEMZERO(score, sizeof(int) * DFS_MAX_DL_SIZE);
+	numpri = dfs_delayline_get_pri(dl, pri);
 	/* find out the lowest pri */
-	for (n = 0; n < dl->dl_numelems; n++) {
-		delayindex = (dl->dl_firstelem + n) & DFS_MAX_DL_MASK;
-		refpri = dl->dl_elems[delayindex].de_time;
+	for (n = 0; n < numpri; n++) {
+		refpri = pri[n];
 		if (refpri == 0)
 			continue;
 		else if (refpri < lowpri) {
-			lowpri = dl->dl_elems[delayindex].de_time;
+			lowpri = refpri;
 			lowpriindex = n;
 		}
 	}
 	/* find out the each delay element's pri score */
-	for (n = 0; n < dl->dl_numelems; n++) {
-		delayindex = (dl->dl_firstelem + n) & DFS_MAX_DL_MASK;
-		refpri = dl->dl_elems[delayindex].de_time;
+	for (n = 0; n < numpri; n++) {
+		refpri = pri[n];
 		if (refpri == 0) {
 			continue;
 		}
@@ -157,13 +157,7 @@ int dfs_staggered_check(struct ath_dfs *dfs, struct dfs_filter *rf,
 			continue;
 		}
 
-		for (i = 0; i < dl->dl_numelems; i++) {
-			dindex = (dl->dl_firstelem + i) & DFS_MAX_DL_MASK;
-			searchpri = dl->dl_elems[dindex].de_time;
-			deltapri = DFS_DIFF(searchpri, refpri);
-			if (deltapri < primargin)
-				score[n]++;
-		}
+		score[n] = dfs_pri_score(pri, numpri, refpri, primargin, 0);
 	}
 	for (n = 0; n < dl->dl_numelems; n++) {
 		delayindex = (dl->dl_firstelem + n) & DFS_MAX_DL_MASK;
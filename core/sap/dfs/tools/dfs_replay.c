@@ -0,0 +1,621 @@
+/*
+ * Copyright (c) 2015 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Userspace replay harness for the DFS radar pulse detectors.
+ *
+ * dfs_bindetects.c and dfs_staggered.c are built in unchanged, with the
+ * FCC, ETSI and MKK filters of radar_filters.h set up the way
+ * dfs_init_radar_filters() does.  Radar pulse events are fed to them the
+ * way the filter type loop of dfs_process_radarevent() does, for a 20 MHz
+ * primary channel: no extension channel busy adjustment, no bin5 (chirp)
+ * radars.  After a detection the delay lines are reset, as they are once
+ * the channel has been switched.
+ *
+ * The harness reports, per radar type of the domain, the share of radar
+ * bursts detected, the number of false alarms on noise-only streams and
+ * the CPU time spent in the detectors per pulse.
+ *
+ * Pulse streams are synthetic, or are replayed from a file with one pulse
+ * per line:
+ *   <tsf usecs> <duration usecs> <rssi> <radar>
+ * where <radar> is 0 for pulses that are not from a radar.  A run of
+ * lines with the same <radar> value is one trial; a radar trial counts as
+ * detected if the detectors fire on any of its pulses, and every detection
+ * in a noise trial counts as a false alarm.  Lines starting with '#' are
+ * skipped.
+ *
+ * Build from the top of the driver tree:
+ *   cc -O2 -o dfs_replay -Icore/sap/dfs/inc -Icore/cdf/inc \
+ *      core/sap/dfs/tools/dfs_replay.c
+ *
+ * Usage: dfs_replay fcc|etsi|mkk [trials [noise_pulses_per_sec]]
+ *        dfs_replay fcc|etsi|mkk -f <pulse file>
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* ath_dfs_structs.h only needs cdf_mem_copy from cdf_memory.h */
+#define __CDF_MEMORY_H
+#define cdf_mem_copy(dst, src, len) memcpy(dst, src, len)
+#define cdf_packed __attribute__((__packed__))
+
+#include "ath_dfs_structs.h"
+#include "dfs_filter.h"
+#include "radar_filters.h"
+
+/*
+ * The parts of dfs.h used by the detectors.  Only the pulse line of
+ * struct ath_dfs is read by them.
+ */
+#define _DFS_H_
+#define ATH_SUPPORT_DFS 1
+
+struct ath_dfs {
+	struct dfs_pulseline *pulses;
+	uint32_t dfs_debug_mask;
+};
+
+struct dfs_event {
+	uint8_t re_rssi;
+	uint8_t re_dur;
+};
+
+enum {
+	ATH_DEBUG_DFS = 0x00000100,
+	ATH_DEBUG_DFS1 = 0x00000200,
+	ATH_DEBUG_DFS2 = 0x00000400,
+	ATH_DEBUG_DFS3 = 0x00000800,
+};
+
+#define DFS_DPRINTK(dfs, _m, _fmt, ...) do { } while (0)
+#define OS_MEMZERO(ptr, len) memset(ptr, 0, len)
+
+void dfs_add_pulse(struct ath_dfs *dfs, struct dfs_filter *rf,
+		   struct dfs_event *re, uint32_t deltaT, uint64_t this_ts);
+int dfs_bin_fixedpattern_check(struct ath_dfs *dfs, struct dfs_filter *rf,
+			       uint32_t dur, int ext_chan_flag);
+int dfs_bin_check(struct ath_dfs *dfs, struct dfs_filter *rf,
+		  uint32_t deltaT, uint32_t dur, int ext_chan_flag);
+int dfs_bin_pri_check(struct ath_dfs *dfs, struct dfs_filter *rf,
+		      struct dfs_delayline *dl, uint32_t score,
+		      uint32_t refpri, uint32_t refdur, int ext_chan_flag,
+		      int fundamentalpri);
+int dfs_staggered_check(struct ath_dfs *dfs, struct dfs_filter *rf,
+			uint32_t deltaT, uint32_t width);
+uint32_t dfs_delayline_get_pri(struct dfs_delayline *dl, uint32_t *pri);
+int dfs_pri_score(const uint32_t *pri, uint32_t num, uint32_t refpri,
+		  uint32_t primargin, int harmonics);
+
+/* dfs_get_pri_margin() and dfs_get_filter_threshold() off HT40 */
+static int dfs_get_pri_margin(struct ath_dfs *dfs, int is_extchan_detect,
+			      int is_fixed_pattern)
+{
+	return is_fixed_pattern ? DFS_DEFAULT_FIXEDPATTERN_PRI_MARGIN :
+				  DFS_DEFAULT_PRI_MARGIN;
+}
+
+static int dfs_get_filter_threshold(struct ath_dfs *dfs,
+				    struct dfs_filter *rf,
+				    int is_extchan_detect)
+{
+	return rf->rf_threshold;
+}
+
+static void dfs_print_delayline(struct ath_dfs *dfs, struct dfs_delayline *dl)
+{
+}
+
+static void dfs_print_filter(struct ath_dfs *dfs, struct dfs_filter *rf)
+{
+}
+
+#include "../src/dfs_bindetects.c"
+#include "../src/dfs_staggered.c"
+
+/* dfs->dfs_pri_multiplier as set up by dfs_attach() */
+#define REPLAY_PRI_MULTIPLIER   2
+#define REPLAY_DEF_TRIALS       200
+#define REPLAY_DEF_NOISE_PPS    500
+/* noise lead-in before each synthetic radar burst */
+#define REPLAY_LEAD_IN_US       100000
+/* share of radar pulses the receiver misses */
+#define REPLAY_PULSE_LOSS_PCT   10
+#define REPLAY_MAX_RADARS       32
+
+struct replay_det {
+	struct ath_dfs dfs;
+	struct dfs_pulseline pulses;
+	struct dfs_filtertype ftypes[DFS_MAX_RADAR_TYPES];
+	int numtypes;
+	int8_t radartable[256][DFS_MAX_RADAR_OVERLAP];
+};
+
+struct replay_stats {
+	unsigned long long pulses;
+	double ns;
+	unsigned trials[REPLAY_MAX_RADARS + 1];
+	unsigned detected[REPLAY_MAX_RADARS + 1];
+	unsigned false_alarms;
+	double noise_secs;
+};
+
+static unsigned replay_seed = 1;
+
+static unsigned replay_rand(void)
+{
+	/* xorshift32, so runs are reproducible across libcs */
+	replay_seed ^= replay_seed << 13;
+	replay_seed ^= replay_seed >> 17;
+	replay_seed ^= replay_seed << 5;
+	return replay_seed;
+}
+
+static unsigned replay_rand_range(unsigned lo, unsigned hi)
+{
+	return hi <= lo ? lo : lo + replay_rand() % (hi - lo + 1);
+}
+
+static double replay_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* copy of dfs_round() in dfs_misc.c */
+static uint32_t replay_round(int32_t val)
+{
+	uint32_t ival, rem;
+
+	if (val < 0)
+		return 0;
+	ival = val / 100;
+	rem = val - (ival * 100);
+	return rem < 50 ? ival : ival + 1;
+}
+
+static void replay_reset(struct replay_det *det)
+{
+	struct dfs_filtertype *ft;
+	int n, i;
+
+	memset(&det->pulses, 0, sizeof(det->pulses));
+	det->pulses.pl_lastelem = DFS_MAX_PULSE_BUFFER_MASK;
+	for (n = 0; n < det->numtypes; n++) {
+		ft = &det->ftypes[n];
+		ft->ft_last_ts = 0;
+		for (i = 0; i < ft->ft_numfilters; i++) {
+			memset(&ft->ft_filters[i].rf_dl, 0,
+			       sizeof(ft->ft_filters[i].rf_dl));
+			ft->ft_filters[i].rf_dl.dl_lastelem = DFS_MAX_DL_MASK;
+		}
+	}
+}
+
+/* The radar filter part of dfs_init_radar_filters() */
+static int replay_init(struct replay_det *det, struct dfs_pulse *radars,
+		       int numradars)
+{
+	struct dfs_filtertype *ft;
+	struct dfs_filter *rf;
+	uint32_t T, Tmax;
+	int p, n, i, depth;
+
+	memset(det, 0, sizeof(*det));
+	det->dfs.pulses = &det->pulses;
+	memset(det->radartable, -1, sizeof(det->radartable));
+
+	for (p = 0; p < numradars; p++) {
+		ft = NULL;
+		for (n = 0; n < det->numtypes; n++) {
+			if (radars[p].rp_pulsedur ==
+			    det->ftypes[n].ft_filterdur &&
+			    radars[p].rp_numpulses ==
+			    det->ftypes[n].ft_numpulses &&
+			    radars[p].rp_mindur == det->ftypes[n].ft_mindur &&
+			    radars[p].rp_maxdur == det->ftypes[n].ft_maxdur) {
+				ft = &det->ftypes[n];
+				break;
+			}
+		}
+		if (!ft) {
+			if (det->numtypes == DFS_MAX_RADAR_TYPES)
+				return -1;
+			ft = &det->ftypes[det->numtypes];
+			ft->ft_numpulses = radars[p].rp_numpulses;
+			ft->ft_patterntype = radars[p].rp_patterntype;
+			ft->ft_mindur = radars[p].rp_mindur;
+			ft->ft_maxdur = radars[p].rp_maxdur;
+			ft->ft_filterdur = radars[p].rp_pulsedur;
+			ft->ft_rssithresh = radars[p].rp_rssithresh;
+			ft->ft_rssimargin = radars[p].rp_rssimargin;
+			ft->ft_minpri = 1000000;
+			for (i = ft->ft_mindur; i <= ft->ft_maxdur; i++) {
+				for (depth = 0;
+				     depth < DFS_MAX_RADAR_OVERLAP &&
+				     det->radartable[i][depth] != -1;
+				     depth++)
+					;
+				if (depth == DFS_MAX_RADAR_OVERLAP)
+					return -1;
+				det->radartable[i][depth] = det->numtypes;
+			}
+			det->numtypes++;
+		}
+		if (ft->ft_numfilters == DFS_MAX_NUM_RADAR_FILTERS)
+			return -1;
+		rf = &ft->ft_filters[ft->ft_numfilters++];
+		rf->rf_numpulses = radars[p].rp_numpulses;
+		rf->rf_patterntype = radars[p].rp_patterntype;
+		rf->rf_pulseid = radars[p].rp_pulseid;
+		rf->rf_mindur = radars[p].rp_mindur;
+		rf->rf_maxdur = radars[p].rp_maxdur;
+		rf->rf_ignore_pri_window = radars[p].rp_ignore_pri_window;
+		T = (100000000 / radars[p].rp_max_pulsefreq) -
+		    100 * radars[p].rp_meanoffset;
+		rf->rf_minpri = replay_round((int32_t)T -
+					     100 * radars[p].rp_pulsevar);
+		Tmax = (100000000 / radars[p].rp_pulsefreq) -
+		       100 * radars[p].rp_meanoffset;
+		rf->rf_maxpri = replay_round((int32_t)Tmax +
+					     100 * radars[p].rp_pulsevar);
+		if (rf->rf_minpri < ft->ft_minpri)
+			ft->ft_minpri = rf->rf_minpri;
+		rf->rf_fixed_pri_radar_pulse =
+			radars[p].rp_max_pulsefreq == radars[p].rp_pulsefreq;
+		rf->rf_threshold = radars[p].rp_threshold;
+		rf->rf_filterlen = rf->rf_maxpri * rf->rf_numpulses;
+	}
+
+	replay_reset(det);
+	return 0;
+}
+
+/*
+ * One pulse through the pulse line and the filter type loop of
+ * dfs_process_radarevent()
+ *
+ * Return: 1 if a radar was detected
+ */
+static int replay_pulse(struct replay_det *det, uint64_t this_ts,
+			uint8_t dur, uint8_t rssi)
+{
+	struct dfs_pulseline *pl = &det->pulses;
+	struct dfs_event re = { .re_rssi = rssi, .re_dur = dur };
+	struct dfs_filtertype *ft;
+	struct dfs_filter *rf;
+	uint64_t deltaT;
+	uint32_t index, p;
+	int depth, found, retval = 0;
+
+	index = (pl->pl_lastelem + 1) & DFS_MAX_PULSE_BUFFER_MASK;
+	if (pl->pl_numelems == DFS_MAX_PULSE_BUFFER_SIZE)
+		pl->pl_firstelem =
+			(pl->pl_firstelem + 1) & DFS_MAX_PULSE_BUFFER_MASK;
+	else
+		pl->pl_numelems++;
+	pl->pl_lastelem = index;
+	pl->pl_elems[index].p_time = this_ts;
+	pl->pl_elems[index].p_dur = dur;
+	pl->pl_elems[index].p_rssi = rssi;
+
+	for (depth = 0; depth < DFS_MAX_RADAR_OVERLAP &&
+	     det->radartable[dur][depth] != -1 && !retval; depth++) {
+		ft = &det->ftypes[det->radartable[dur][depth]];
+		if (rssi < ft->ft_rssithresh && dur > 4)
+			continue;
+		deltaT = this_ts - ft->ft_last_ts;
+		if (deltaT < ft->ft_minpri && deltaT != 0)
+			continue;
+
+		for (p = 0, found = 0; p < ft->ft_numfilters && !found; p++) {
+			rf = &ft->ft_filters[p];
+			if (dur < rf->rf_mindur || dur > rf->rf_maxdur)
+				continue;
+			deltaT = this_ts - rf->rf_dl.dl_last_ts;
+			if (deltaT < rf->rf_minpri && deltaT != 0)
+				continue;
+			if (rf->rf_ignore_pri_window > 0) {
+				if (deltaT < rf->rf_minpri) {
+					rf->rf_dl.dl_last_ts = this_ts;
+					continue;
+				}
+			} else if (deltaT > REPLAY_PRI_MULTIPLIER *
+				   rf->rf_maxpri || deltaT < rf->rf_minpri) {
+				rf->rf_dl.dl_last_ts = this_ts;
+				continue;
+			}
+			dfs_add_pulse(&det->dfs, rf, &re, (uint32_t)deltaT,
+				      this_ts);
+			if (rf->rf_patterntype == 2)
+				found = dfs_staggered_check(&det->dfs, rf,
+							    (uint32_t)deltaT,
+							    dur);
+			else
+				found = dfs_bin_check(&det->dfs, rf,
+						      (uint32_t)deltaT, dur, 0);
+			rf->rf_dl.dl_last_ts = this_ts;
+		}
+		ft->ft_last_ts = this_ts;
+		retval |= found;
+	}
+
+	return retval;
+}
+
+/* Feed one pulse to the detectors and account its cost */
+static int replay_feed(struct replay_det *det, struct replay_stats *st,
+		       uint64_t ts, unsigned dur, unsigned rssi)
+{
+	double t0;
+	int found;
+
+	if (dur > 255)
+		dur = 255;
+	if (rssi > 255)
+		rssi = 255;
+
+	t0 = replay_now_ns();
+	found = replay_pulse(det, ts, dur, rssi);
+	st->ns += replay_now_ns() - t0;
+	st->pulses++;
+
+	if (found)
+		replay_reset(det);
+	return found;
+}
+
+/* Noise pulses at noise_pps from *ts for span usecs */
+static int replay_noise(struct replay_det *det, struct replay_stats *st,
+			uint64_t *ts, uint64_t span, unsigned noise_pps)
+{
+	uint64_t end = *ts + span;
+	int found = 0;
+
+	if (!noise_pps) {
+		*ts = end;
+		return 0;
+	}
+	for (;;) {
+		*ts += 1 + replay_rand() % (2000000 / noise_pps);
+		if (*ts >= end)
+			break;
+		found += replay_feed(det, st, *ts, replay_rand_range(1, 30),
+				     replay_rand_range(5, 40));
+	}
+	*ts = end;
+	return found;
+}
+
+/* One burst of a radar type interleaved with noise */
+static int replay_burst(struct replay_det *det, struct replay_stats *st,
+			uint64_t *ts, struct dfs_pulse *rp, unsigned noise_pps)
+{
+	uint32_t pri[3], minpri, maxpri;
+	unsigned i, npri, dur;
+	int found = 0;
+
+	minpri = 1000000 / rp->rp_max_pulsefreq;
+	maxpri = 1000000 / rp->rp_pulsefreq;
+	npri = rp->rp_patterntype == 2 ? 3 : 1;
+	for (i = 0; i < npri; i++)
+		pri[i] = replay_rand_range(minpri, maxpri);
+	dur = rp->rp_pulsedur;
+	if (dur < rp->rp_mindur)
+		dur = rp->rp_mindur;
+	if (dur > rp->rp_maxdur)
+		dur = rp->rp_maxdur;
+
+	for (i = 0; i < rp->rp_numpulses; i++) {
+		/* noise seen by the receiver between two radar pulses */
+		uint64_t next = *ts + pri[i % npri];
+
+		found += replay_noise(det, st, ts, pri[i % npri] - 1,
+				      noise_pps);
+		*ts = next;
+		if (replay_rand() % 100 < REPLAY_PULSE_LOSS_PCT)
+			continue;
+		found += replay_feed(det, st, *ts,
+				     replay_rand_range(dur > rp->rp_mindur ?
+						       dur - 1 : dur,
+						       dur < rp->rp_maxdur ?
+						       dur + 1 : dur),
+				     rp->rp_rssithresh +
+				     replay_rand_range(5, 20));
+	}
+	return found;
+}
+
+static void replay_synthetic(struct replay_det *det, struct replay_stats *st,
+			     struct dfs_pulse *radars, int numradars,
+			     unsigned trials, unsigned noise_pps)
+{
+	uint64_t ts = 1;
+	unsigned t;
+	int p;
+
+	for (p = 0; p < numradars; p++) {
+		for (t = 0; t < trials; t++) {
+			replay_reset(det);
+			/* detections in the lead-in are false alarms */
+			st->false_alarms += replay_noise(det, st, &ts,
+							 REPLAY_LEAD_IN_US,
+							 noise_pps);
+			st->noise_secs += REPLAY_LEAD_IN_US / 1e6;
+			st->trials[p]++;
+			if (replay_burst(det, st, &ts, &radars[p], noise_pps))
+				st->detected[p]++;
+		}
+	}
+
+	/* noise only, one second per trial */
+	replay_reset(det);
+	for (t = 0; t < trials; t++) {
+		st->false_alarms += replay_noise(det, st, &ts, 1000000,
+						 noise_pps);
+		st->noise_secs += 1;
+	}
+}
+
+static int replay_file(struct replay_det *det, struct replay_stats *st,
+		       const char *path)
+{
+	unsigned long long ts, first_ts = 0, last_ts = 0;
+	unsigned dur, rssi, radar, cur = 0;
+	char line[128];
+	int found = 0, in_trial = 0;
+	FILE *f;
+
+	f = fopen(path, "r");
+	if (!f) {
+		perror(path);
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), f)) {
+		if (line[0] == '#' || line[0] == '\n')
+			continue;
+		if (sscanf(line, "%llu %u %u %u", &ts, &dur, &rssi,
+			   &radar) != 4) {
+			fprintf(stderr, "%s: bad line: %s", path, line);
+			fclose(f);
+			return -1;
+		}
+		if (radar > REPLAY_MAX_RADARS)
+			radar = REPLAY_MAX_RADARS;
+		if (!in_trial || radar != cur) {
+			if (in_trial && cur)
+				st->detected[cur - 1] += !!found;
+			else if (in_trial)
+				st->noise_secs += (last_ts - first_ts) / 1e6;
+			if (radar)
+				st->trials[radar - 1]++;
+			cur = radar;
+			first_ts = ts;
+			found = 0;
+			in_trial = 1;
+		}
+		last_ts = ts;
+		if (replay_feed(det, st, ts, dur, rssi)) {
+			if (cur)
+				found = 1;
+			else
+				st->false_alarms++;
+		}
+	}
+	if (in_trial && cur)
+		st->detected[cur - 1] += !!found;
+	else if (in_trial)
+		st->noise_secs += (last_ts - first_ts) / 1e6;
+
+	fclose(f);
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	static struct replay_det det;
+	struct replay_stats st;
+	struct dfs_pulse *radars;
+	unsigned trials = REPLAY_DEF_TRIALS;
+	unsigned noise_pps = REPLAY_DEF_NOISE_PPS;
+	const char *path = NULL;
+	unsigned total = 0, detected = 0;
+	int numradars, p;
+
+	if (argc < 2)
+		goto usage;
+	if (!strcmp(argv[1], "fcc")) {
+		radars = dfs_fcc_radars;
+		numradars = sizeof(dfs_fcc_radars) / sizeof(dfs_fcc_radars[0]);
+	} else if (!strcmp(argv[1], "etsi")) {
+		radars = dfs_etsi_radars;
+		numradars = sizeof(dfs_etsi_radars) /
+			    sizeof(dfs_etsi_radars[0]);
+	} else if (!strcmp(argv[1], "mkk")) {
+		radars = dfs_mkk4_radars;
+		numradars = sizeof(dfs_mkk4_radars) /
+			    sizeof(dfs_mkk4_radars[0]);
+	} else {
+		goto usage;
+	}
+
+	if (argc > 3 && !strcmp(argv[2], "-f")) {
+		path = argv[3];
+	} else {
+		if (argc > 2)
+			trials = strtoul(argv[2], NULL, 0);
+		if (argc > 3)
+			noise_pps = strtoul(argv[3], NULL, 0);
+		if (!trials)
+			goto usage;
+	}
+
+	if (replay_init(&det, radars, numradars)) {
+		fprintf(stderr, "%s: too many radar filters\n", argv[1]);
+		return 1;
+	}
+
+	memset(&st, 0, sizeof(st));
+	if (path) {
+		if (replay_file(&det, &st, path))
+			return 1;
+		numradars = REPLAY_MAX_RADARS;
+	} else {
+		printf("%s: %u trials per radar type, %u noise pulses/s, "
+		       "%u%% radar pulse loss\n", argv[1], trials, noise_pps,
+		       REPLAY_PULSE_LOSS_PCT);
+		replay_synthetic(&det, &st, radars, numradars, trials,
+				 noise_pps);
+	}
+
+	printf("%-8s %8s %8s %8s\n", "radar", "trials", "detected", "rate");
+	for (p = 0; p < numradars; p++) {
+		if (!st.trials[p])
+			continue;
+		printf("%-8d %8u %8u %7.1f%%\n",
+		       path ? p + 1 : (int)radars[p].rp_pulseid,
+		       st.trials[p], st.detected[p],
+		       100.0 * st.detected[p] / st.trials[p]);
+		total += st.trials[p];
+		detected += st.detected[p];
+	}
+	if (total)
+		printf("%-8s %8u %8u %7.1f%%\n", "all", total, detected,
+		       100.0 * detected / total);
+	printf("false alarms: %u in %.1f s of noise (%.2f/min)\n",
+	       st.false_alarms, st.noise_secs,
+	       st.noise_secs ? 60.0 * st.false_alarms / st.noise_secs : 0);
+	if (st.pulses)
+		printf("cpu: %llu pulses, %.1f ns/pulse\n", st.pulses,
+		       st.ns / st.pulses);
+	return 0;
+
+usage:
+	fprintf(stderr,
+		"usage: %s fcc|etsi|mkk [trials [noise_pulses_per_sec]]\n"
+		"       %s fcc|etsi|mkk -f <pulse file>\n", argv[0], argv[0]);
+	return 1;
+}
@@ -42,11 +42,25 @@
 #define LL_ACCESS_LOCK          true
 #define LL_ACCESS_NOLOCK        false
 
+struct tagDblLinkList;
+
 typedef struct tagListElem {
 	struct tagListElem *last;
 	struct tagListElem *next;
+	/* list the element is linked on, NULL when it is not on a list */
+	struct tagDblLinkList *pList;
 } tListElem;
 
+/*
+ * Optional index kept in step with a list. The hooks are called with the
+ * list lock held, after an element is linked and after it is unlinked.
+ */
+typedef struct tagListIndex {
+	void (*insert)(struct tagListIndex *pIndex,
+		       struct tagDblLinkList *pList, tListElem *pEntry);
+	void (*remove)(struct tagListIndex *pIndex, tListElem *pEntry);
+} tListIndex;
+
 typedef enum {
 	LIST_FLAG_CLOSE = 0,
 	LIST_FLAG_OPEN = 0xa1b2c4d7,
@@ -62,6 +76,7 @@ typedef struct tagDblLinkList {
 	/*command debugging */
 	uint32_t cmdTimeoutDuration;       /* command timeout duration */
 	cdf_mc_timer_t *cmdTimeoutTimer;   /*command timeout Timer */
+	tListIndex *pIndex;                /* optional index of the entries */
 } tDblLinkList;
 
 /*
@@ -84,6 +99,7 @@ typedef struct tagDblLinkList {
 uint32_t csr_ll_count(tDblLinkList *pList);
 CDF_STATUS csr_ll_open(tHddHandle hHdd, tDblLinkList *pList);
 void csr_ll_close(tDblLinkList *pList);
+void csr_ll_set_index(tDblLinkList *pList, tListIndex *pIndex);
 void csr_ll_lock(tDblLinkList *pList);
 void csr_ll_unlock(tDblLinkList *pList);
 bool csr_ll_is_list_empty(tDblLinkList *pList, bool fInterlocked);
@@ -106,5 +122,6 @@ tListElem *csr_ll_next(tDblLinkList *pList, tListElem *pEntry,
 		bool fInterlocked);
 tListElem *csr_ll_previous(tDblLinkList *pList, tListElem *pEntry,
 		bool fInterlocked);
+/* O(1), the element records the list it is linked on */
 bool csr_ll_find_entry(tDblLinkList *pList, tListElem *pEntryToFind);
 #endif
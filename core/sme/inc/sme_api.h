@@ -1067,4 +1067,13 @@ sme_get_opclass(tHalHandle hal, uint8_t channel, uint8_t bw_offset,
 }
 #endif
 
+#ifdef MPC_UT_FRAMEWORK
+void sme_cmd_queue_stress_test(tHalHandle hal, uint32_t num_cmds);
+#else
+static inline void sme_cmd_queue_stress_test(tHalHandle hal,
+					     uint32_t num_cmds)
+{
+}
+#endif
+
 #endif /* #if !defined( __SME_API_H ) */
@@ -172,6 +172,11 @@ typedef struct tagSmeCmd {
 	tListElem Link;
 	eSmeCommandType command;
 	uint32_t sessionId;
+	/* link on the per-session chain of struct sme_cmd_index */
+	tListElem sessionLink;
+	/* session slot and class the command was indexed under */
+	uint8_t indexSession;
+	uint8_t indexClass;
 	union {
 		tScanCmd scanCmd;
 		tRoamCmd roamCmd;
@@ -204,6 +209,11 @@ void sme_process_pending_queue(tpAniSirGlobal pMac);
 void sme_release_command(tpAniSirGlobal pMac, tSmeCmd *pCmd);
 void purge_sme_session_cmd_list(tpAniSirGlobal pMac, uint32_t sessionId,
 		tDblLinkList *pList);
+void sme_cmd_index_init(struct sme_cmd_index *index, tDblLinkList *list);
+uint32_t sme_cmd_index_count(tDblLinkList *list, uint32_t session_id,
+		enum sme_cmd_class cmd_class);
+tSmeCmd *sme_cmd_index_first(tDblLinkList *list, uint32_t session_id);
+tSmeCmd *sme_cmd_index_next(tDblLinkList *list, tSmeCmd *cmd);
 bool sme_command_pending(tpAniSirGlobal pMac);
 bool pmc_process_command(tpAniSirGlobal pMac, tSmeCmd *pCommand);
 bool qos_process_command(tpAniSirGlobal pMac, tSmeCmd *pCommand);
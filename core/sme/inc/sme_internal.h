@@ -100,6 +100,42 @@ typedef enum eSmeState {
 	SME_STATE_READY,
 } eSmeState;
 
+/*
+ * Session slots of struct sme_cmd_index. Each session id below
+ * SME_CMD_INDEX_NO_SESSION has a slot of its own; all other session ids,
+ * including invalid ones, share the SME_CMD_INDEX_NO_SESSION slot.
+ */
+#define SME_CMD_INDEX_SESSIONS  8
+#define SME_CMD_INDEX_NO_SESSION (SME_CMD_INDEX_SESSIONS - 1)
+
+/**
+ * enum sme_cmd_class - command classes counted by struct sme_cmd_index
+ * @SME_CMD_CLASS_SCAN: eSmeCommandScan
+ * @SME_CMD_CLASS_ROAM: eSmeCommandRoam other than a disconnect
+ * @SME_CMD_CLASS_DISCONNECT: eSmeCommandRoam for a disconnect
+ * @SME_CMD_CLASS_OTHER: any other command
+ * @SME_CMD_CLASS_MAX: number of classes
+ */
+enum sme_cmd_class {
+	SME_CMD_CLASS_SCAN,
+	SME_CMD_CLASS_ROAM,
+	SME_CMD_CLASS_DISCONNECT,
+	SME_CMD_CLASS_OTHER,
+	SME_CMD_CLASS_MAX
+};
+
+/**
+ * struct sme_cmd_index - per-session and per-class index of a command list
+ * @ops: hooks called by the csr_ll functions on insert and remove
+ * @session: per-session chains of the commands, in list order
+ * @count: number of commands per session and class
+ */
+struct sme_cmd_index {
+	tListIndex ops;
+	tListElem session[SME_CMD_INDEX_SESSIONS];
+	uint16_t count[SME_CMD_INDEX_SESSIONS][SME_CMD_CLASS_MAX];
+};
+
 #define SME_IS_START(pMac)  (SME_STATE_STOP != (pMac)->sme.state)
 #define SME_IS_READY(pMac)  (SME_STATE_READY == (pMac)->sme.state)
 
@@ -147,6 +183,7 @@ typedef struct tagSmeStruct {
 	void **pSmeCmdBufAddr;
 	tDblLinkList smeCmdActiveList;
 	tDblLinkList smeCmdPendingList;
+	struct sme_cmd_index smeCmdPendingIndex;
 	tDblLinkList smeCmdFreeList;    /* preallocated roam cmd list */
 	tCDF_CON_MODE currDeviceMode;
 #ifdef FEATURE_WLAN_LPHB
@@ -154,6 +191,7 @@ typedef struct tagSmeStruct {
 #endif /* FEATURE_WLAN_LPHB */
 	/* pending scan command list */
 	tDblLinkList smeScanCmdPendingList;
+	struct sme_cmd_index smeScanCmdPendingIndex;
 	/* active scan command list */
 	tDblLinkList smeScanCmdActiveList;
 #ifdef FEATURE_WLAN_DIAG_SUPPORT_CSR
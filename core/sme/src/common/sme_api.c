@@ -59,6 +59,8 @@
 #include "sme_power_save_api.h"
 #include "wma.h"
 #include "sch_api.h"
+#include "cdf_time.h"
+#include "cdf_util.h"
 
 extern tSirRetStatus u_mac_post_ctrl_msg(void *pSirGlobal, tSirMbMsg *pMb);
 
@@ -307,6 +309,225 @@ static void free_sme_cmds(tpAniSirGlobal mac_ctx)
 	mac_ctx->sme.pSmeCmdBufAddr = NULL;
 }
 
+/**
+ * sme_cmd_index_slot() - session slot of struct sme_cmd_index
+ * @session_id: session id of a command
+ *
+ * Return: slot index, SME_CMD_INDEX_NO_SESSION for session ids without a
+ *	   slot of their own
+ */
+static uint8_t sme_cmd_index_slot(uint32_t session_id)
+{
+	if (session_id >= SME_CMD_INDEX_NO_SESSION)
+		return SME_CMD_INDEX_NO_SESSION;
+	return (uint8_t)session_id;
+}
+
+static uint8_t sme_cmd_index_class(tSmeCmd *cmd)
+{
+	if (eSmeCommandScan == cmd->command)
+		return SME_CMD_CLASS_SCAN;
+	if (CSR_IS_DISCONNECT_COMMAND(cmd))
+		return SME_CMD_CLASS_DISCONNECT;
+	if (eSmeCommandRoam == cmd->command)
+		return SME_CMD_CLASS_ROAM;
+	return SME_CMD_CLASS_OTHER;
+}
+
+/**
+ * sme_cmd_index_insert() - index a command linked on a command list
+ * @ops: index hooks of the list
+ * @list: command list, locked
+ * @entry: Link of the command, already on @list
+ *
+ * The per-session chain is kept in list order. Head and tail insertions
+ * are O(1); an insertion in the middle of the list walks back to the
+ * previous command of the same session slot.
+ *
+ * Return: None
+ */
+static void sme_cmd_index_insert(tListIndex *ops, tDblLinkList *list,
+				 tListElem *entry)
+{
+	struct sme_cmd_index *index =
+		GET_BASE_ADDR(ops, struct sme_cmd_index, ops);
+	tSmeCmd *cmd = GET_BASE_ADDR(entry, tSmeCmd, Link);
+	tSmeCmd *prev_cmd;
+	tListElem *pos, *prev;
+
+	cmd->indexSession = sme_cmd_index_slot(cmd->sessionId);
+	cmd->indexClass = sme_cmd_index_class(cmd);
+	index->count[cmd->indexSession][cmd->indexClass]++;
+
+	pos = &index->session[cmd->indexSession];
+	if (entry->next == &list->ListHead) {
+		pos = pos->last;
+	} else if (entry->last != &list->ListHead) {
+		for (prev = entry->last; prev != &list->ListHead;
+		     prev = prev->last) {
+			prev_cmd = GET_BASE_ADDR(prev, tSmeCmd, Link);
+			if (prev_cmd->indexSession == cmd->indexSession) {
+				pos = &prev_cmd->sessionLink;
+				break;
+			}
+		}
+	}
+
+	/* link after pos */
+	cmd->sessionLink.last = pos;
+	cmd->sessionLink.next = pos->next;
+	pos->next->last = &cmd->sessionLink;
+	pos->next = &cmd->sessionLink;
+}
+
+static void sme_cmd_index_remove(tListIndex *ops, tListElem *entry)
+{
+	struct sme_cmd_index *index =
+		GET_BASE_ADDR(ops, struct sme_cmd_index, ops);
+	tSmeCmd *cmd = GET_BASE_ADDR(entry, tSmeCmd, Link);
+
+	cmd->sessionLink.last->next = cmd->sessionLink.next;
+	cmd->sessionLink.next->last = cmd->sessionLink.last;
+	cmd->sessionLink.next = cmd->sessionLink.last = NULL;
+	index->count[cmd->indexSession][cmd->indexClass]--;
+}
+
+/**
+ * sme_cmd_index_init() - attach a per-session index to a command list
+ * @index: index to initialize
+ * @list: empty command list holding tSmeCmd entries
+ *
+ * Return: None
+ */
+void sme_cmd_index_init(struct sme_cmd_index *index, tDblLinkList *list)
+{
+	uint8_t i;
+
+	cdf_mem_zero(index, sizeof(*index));
+	for (i = 0; i < SME_CMD_INDEX_SESSIONS; i++)
+		index->session[i].next = index->session[i].last =
+			&index->session[i];
+	index->ops.insert = sme_cmd_index_insert;
+	index->ops.remove = sme_cmd_index_remove;
+	csr_ll_set_index(list, &index->ops);
+}
+
+/* First command of session_id at or after link on the chain */
+static tSmeCmd *sme_cmd_index_scan(tListElem *chain, tListElem *link,
+				   uint32_t session_id)
+{
+	tSmeCmd *cmd;
+
+	for (; link != chain; link = link->next) {
+		cmd = GET_BASE_ADDR(link, tSmeCmd, sessionLink);
+		if (cmd->sessionId == session_id)
+			return cmd;
+	}
+	return NULL;
+}
+
+/* First command of session_id at or after entry on the list itself */
+static tSmeCmd *sme_cmd_list_scan(tDblLinkList *list, tListElem *entry,
+				  uint32_t session_id)
+{
+	tSmeCmd *cmd;
+
+	for (; entry; entry = csr_ll_next(list, entry, LL_ACCESS_NOLOCK)) {
+		cmd = GET_BASE_ADDR(entry, tSmeCmd, Link);
+		if (cmd->sessionId == session_id)
+			return cmd;
+	}
+	return NULL;
+}
+
+/**
+ * sme_cmd_index_first() - first command of a session on a command list
+ * @list: command list, locked by the caller
+ * @session_id: session id
+ *
+ * Uses the per-session chain when the list is indexed and walks the list
+ * otherwise. Commands are returned in list order.
+ *
+ * Return: command or NULL
+ */
+tSmeCmd *sme_cmd_index_first(tDblLinkList *list, uint32_t session_id)
+{
+	struct sme_cmd_index *index;
+	tListElem *chain;
+
+	if (!list->pIndex)
+		return sme_cmd_list_scan(list,
+				csr_ll_peek_head(list, LL_ACCESS_NOLOCK),
+				session_id);
+
+	index = GET_BASE_ADDR(list->pIndex, struct sme_cmd_index, ops);
+	chain = &index->session[sme_cmd_index_slot(session_id)];
+	return sme_cmd_index_scan(chain, chain->next, session_id);
+}
+
+/**
+ * sme_cmd_index_next() - next command of the same session
+ * @list: command list, locked by the caller
+ * @cmd: command on @list
+ *
+ * Fetch the next command before @cmd is taken off the list.
+ *
+ * Return: command or NULL
+ */
+tSmeCmd *sme_cmd_index_next(tDblLinkList *list, tSmeCmd *cmd)
+{
+	struct sme_cmd_index *index;
+	tListElem *chain;
+
+	if (!list->pIndex)
+		return sme_cmd_list_scan(list,
+				csr_ll_next(list, &cmd->Link, LL_ACCESS_NOLOCK),
+				cmd->sessionId);
+
+	index = GET_BASE_ADDR(list->pIndex, struct sme_cmd_index, ops);
+	chain = &index->session[cmd->indexSession];
+	return sme_cmd_index_scan(chain, cmd->sessionLink.next,
+				  cmd->sessionId);
+}
+
+/**
+ * sme_cmd_index_count() - number of commands of a session on a command list
+ * @list: command list, locked by the caller
+ * @session_id: session id
+ * @cmd_class: class of commands to count, SME_CMD_CLASS_MAX for all
+ *
+ * O(1) for an indexed list, except for session ids sharing the
+ * SME_CMD_INDEX_NO_SESSION slot.
+ *
+ * Return: number of commands
+ */
+uint32_t sme_cmd_index_count(tDblLinkList *list, uint32_t session_id,
+			     enum sme_cmd_class cmd_class)
+{
+	struct sme_cmd_index *index;
+	uint8_t slot = sme_cmd_index_slot(session_id);
+	uint32_t count = 0;
+	uint8_t i;
+	tSmeCmd *cmd;
+
+	if (list->pIndex && slot != SME_CMD_INDEX_NO_SESSION) {
+		index = GET_BASE_ADDR(list->pIndex, struct sme_cmd_index, ops);
+		if (cmd_class < SME_CMD_CLASS_MAX)
+			return index->count[slot][cmd_class];
+		for (i = 0; i < SME_CMD_CLASS_MAX; i++)
+			count += index->count[slot][i];
+		return count;
+	}
+
+	for (cmd = sme_cmd_index_first(list, session_id); cmd;
+	     cmd = sme_cmd_index_next(list, cmd)) {
+		if (cmd_class == SME_CMD_CLASS_MAX ||
+		    cmd_class == sme_cmd_index_class(cmd))
+			count++;
+	}
+	return count;
+}
+
 static CDF_STATUS init_sme_cmd_list(tpAniSirGlobal pMac)
 {
 	CDF_STATUS status;
@@ -325,6 +546,8 @@ static CDF_STATUS init_sme_cmd_list(tpAniSirGlobal pMac)
 	status = csr_ll_open(pMac->hHdd, &pMac->sme.smeCmdPendingList);
 	if (!CDF_IS_STATUS_SUCCESS(status))
 		goto end;
+	sme_cmd_index_init(&pMac->sme.smeCmdPendingIndex,
+			   &pMac->sme.smeCmdPendingList);
 
 	status = csr_ll_open(pMac->hHdd, &pMac->sme.smeScanCmdActiveList);
 	if (!CDF_IS_STATUS_SUCCESS(status))
@@ -333,6 +556,8 @@ static CDF_STATUS init_sme_cmd_list(tpAniSirGlobal pMac)
 	status = csr_ll_open(pMac->hHdd, &pMac->sme.smeScanCmdPendingList);
 	if (!CDF_IS_STATUS_SUCCESS(status))
 		goto end;
+	sme_cmd_index_init(&pMac->sme.smeScanCmdPendingIndex,
+			   &pMac->sme.smeScanCmdPendingList);
 
 	status = csr_ll_open(pMac->hHdd, &pMac->sme.smeCmdFreeList);
 	if (!CDF_IS_STATUS_SUCCESS(status))
@@ -433,8 +658,8 @@ void purge_sme_session_cmd_list(tpAniSirGlobal pMac, uint32_t sessionId,
 				tDblLinkList *pList)
 {
 	/* release any out standing commands back to free command list */
-	tListElem *pEntry, *pNext;
-	tSmeCmd *pCommand;
+	tListElem *pEntry;
+	tSmeCmd *pCommand, *pNext;
 	tDblLinkList localList;
 
 	cdf_mem_zero(&localList, sizeof(tDblLinkList));
@@ -444,17 +669,15 @@ void purge_sme_session_cmd_list(tpAniSirGlobal pMac, uint32_t sessionId,
 	}
 
 	csr_ll_lock(pList);
-	pEntry = csr_ll_peek_head(pList, LL_ACCESS_NOLOCK);
-	while (pEntry != NULL) {
-		pNext = csr_ll_next(pList, pEntry, LL_ACCESS_NOLOCK);
-		pCommand = GET_BASE_ADDR(pEntry, tSmeCmd, Link);
-		if (pCommand->sessionId == sessionId) {
-			if (csr_ll_remove_entry(pList, pEntry, LL_ACCESS_NOLOCK)) {
-				csr_ll_insert_tail(&localList, pEntry,
-						   LL_ACCESS_NOLOCK);
-			}
+	pCommand = sme_cmd_index_first(pList, sessionId);
+	while (pCommand != NULL) {
+		pNext = sme_cmd_index_next(pList, pCommand);
+		if (csr_ll_remove_entry(pList, &pCommand->Link,
+					LL_ACCESS_NOLOCK)) {
+			csr_ll_insert_tail(&localList, &pCommand->Link,
+					   LL_ACCESS_NOLOCK);
 		}
-		pEntry = pNext;
+		pCommand = pNext;
 	}
 	csr_ll_unlock(pList);
 
@@ -691,6 +914,20 @@ tListElem *csr_get_cmd_to_process(tpAniSirGlobal pMac, tDblLinkList *pList,
 	tListElem *pCurEntry = NULL;
 	tSmeCmd *pCommand;
 
+	/* Nothing to pick if every pending command is for this session */
+	if (fInterlocked)
+		csr_ll_lock(pList);
+	if (sme_cmd_index_count(pList, sessionId, SME_CMD_CLASS_MAX) ==
+	    csr_ll_count(pList)) {
+		if (fInterlocked)
+			csr_ll_unlock(pList);
+		sms_log(pMac, LOG1,
+			"No command pending with different sessionId");
+		return NULL;
+	}
+	if (fInterlocked)
+		csr_ll_unlock(pList);
+
 	/* Go through the list and return the command whose session id is not
 	 * matching with the current ongoing scan cmd sessionId */
 	pCurEntry = csr_ll_peek_head(pList, LL_ACCESS_LOCK);
@@ -14920,3 +15157,154 @@ void sme_get_opclass(tHalHandle hal, uint8_t channel, uint8_t bw_offset,
 	}
 }
 #endif
+
+#ifdef MPC_UT_FRAMEWORK
+#define SME_CMDQ_UT_DEFAULT_CMDS 512
+#define SME_CMDQ_UT_MAX_CMDS     4096
+
+/* Linear walk of the whole list, the lookup the session index replaces */
+static uint32_t sme_cmdq_ut_linear_count(tDblLinkList *list,
+					 uint32_t session_id)
+{
+	tListElem *entry;
+	tSmeCmd *cmd;
+	uint32_t count = 0;
+
+	entry = csr_ll_peek_head(list, LL_ACCESS_NOLOCK);
+	while (entry) {
+		cmd = GET_BASE_ADDR(entry, tSmeCmd, Link);
+		if (cmd->sessionId == session_id)
+			count++;
+		entry = csr_ll_next(list, entry, LL_ACCESS_NOLOCK);
+	}
+	return count;
+}
+
+/**
+ * sme_cmd_queue_stress_test() - stress the indexed SME command queue
+ * @hal: HAL handle
+ * @num_cmds: number of commands to queue, 0 for the default
+ *
+ * Queues scan, roam and disconnect commands spread over all sessions on
+ * a private list with a session index, checks the index against a linear
+ * walk and reports the cycles spent queueing, looking up commands of a
+ * session through the index and linearly, and purging per session.
+ * The commands are never sent, so this is safe to run on a live driver.
+ *
+ * Return: None
+ */
+void sme_cmd_queue_stress_test(tHalHandle hal, uint32_t num_cmds)
+{
+	tpAniSirGlobal mac = PMAC_STRUCT(hal);
+	struct sme_cmd_index *index;
+	tDblLinkList list;
+	tSmeCmd *cmds, *cmd, *next;
+	tSmeCmd *expect[CSR_ROAM_SESSION_MAX];
+	tListElem *entry;
+	uint64_t start, insert_cycles, index_cycles, linear_cycles;
+	uint64_t purge_cycles;
+	uint32_t i, session, indexed = 0, linear = 0, errors = 0;
+
+	if (!num_cmds)
+		num_cmds = SME_CMDQ_UT_DEFAULT_CMDS;
+	if (num_cmds > SME_CMDQ_UT_MAX_CMDS)
+		num_cmds = SME_CMDQ_UT_MAX_CMDS;
+
+	cmds = cdf_mem_malloc(num_cmds * sizeof(*cmds));
+	index = cdf_mem_malloc(sizeof(*index));
+	if (!cmds || !index) {
+		sms_log(mac, LOGE, FL("no memory for %d commands"), num_cmds);
+		goto free;
+	}
+	cdf_mem_zero(cmds, num_cmds * sizeof(*cmds));
+	cdf_mem_zero(&list, sizeof(list));
+	if (!CDF_IS_STATUS_SUCCESS(csr_ll_open(mac->hHdd, &list))) {
+		sms_log(mac, LOGE, FL("failed to open list"));
+		goto free;
+	}
+	sme_cmd_index_init(index, &list);
+
+	for (i = 0; i < num_cmds; i++) {
+		cmd = &cmds[i];
+		cmd->sessionId = i % CSR_ROAM_SESSION_MAX;
+		if (i & 1) {
+			cmd->command = eSmeCommandScan;
+		} else {
+			cmd->command = eSmeCommandRoam;
+			cmd->u.roamCmd.roamReason = (i % 5) ?
+				eCsrHddIssued : eCsrForcedDisassoc;
+		}
+	}
+
+	csr_ll_lock(&list);
+	start = cdf_get_cycles();
+	for (i = 0; i < num_cmds; i++) {
+		/* disconnects go to the head like in csr_queue_sme_command */
+		if (CSR_IS_DISCONNECT_COMMAND(&cmds[i]))
+			csr_ll_insert_head(&list, &cmds[i].Link,
+					   LL_ACCESS_NOLOCK);
+		else
+			csr_ll_insert_tail(&list, &cmds[i].Link,
+					   LL_ACCESS_NOLOCK);
+	}
+	insert_cycles = cdf_get_cycles() - start;
+
+	start = cdf_get_cycles();
+	for (session = 0; session < CSR_ROAM_SESSION_MAX; session++)
+		indexed += sme_cmd_index_count(&list, session,
+					       SME_CMD_CLASS_MAX);
+	index_cycles = cdf_get_cycles() - start;
+
+	start = cdf_get_cycles();
+	for (session = 0; session < CSR_ROAM_SESSION_MAX; session++)
+		linear += sme_cmdq_ut_linear_count(&list, session);
+	linear_cycles = cdf_get_cycles() - start;
+
+	/* the session chains must be in list order */
+	for (session = 0; session < CSR_ROAM_SESSION_MAX; session++)
+		expect[session] = sme_cmd_index_first(&list, session);
+	entry = csr_ll_peek_head(&list, LL_ACCESS_NOLOCK);
+	while (entry) {
+		cmd = GET_BASE_ADDR(entry, tSmeCmd, Link);
+		if (cmd != expect[cmd->sessionId])
+			errors++;
+		else
+			expect[cmd->sessionId] = sme_cmd_index_next(&list, cmd);
+		entry = csr_ll_next(&list, entry, LL_ACCESS_NOLOCK);
+	}
+
+	start = cdf_get_cycles();
+	for (session = 0; session < CSR_ROAM_SESSION_MAX; session++) {
+		cmd = sme_cmd_index_first(&list, session);
+		while (cmd) {
+			next = sme_cmd_index_next(&list, cmd);
+			if (!csr_ll_remove_entry(&list, &cmd->Link,
+						 LL_ACCESS_NOLOCK))
+				errors++;
+			cmd = next;
+		}
+	}
+	purge_cycles = cdf_get_cycles() - start;
+	if (csr_ll_count(&list))
+		errors++;
+	csr_ll_unlock(&list);
+
+	if (indexed != num_cmds || linear != num_cmds)
+		errors++;
+
+	sms_log(mac, LOGE,
+		FL("%d cmds: insert %llu cycles, session lookup indexed %llu linear %llu, purge %llu, errors %d"),
+		num_cmds, insert_cycles, index_cycles, linear_cycles,
+		purge_cycles, errors);
+	sms_log(mac, LOGE, FL("per cmd: insert %llu purge %llu cycles"),
+		cdf_div_u64(insert_cycles, num_cmds),
+		cdf_div_u64(purge_cycles, num_cmds));
+
+	csr_ll_close(&list);
+free:
+	if (index)
+		cdf_mem_free(index);
+	if (cmds)
+		cdf_mem_free(cmds);
+}
+#endif
@@ -2582,8 +2582,8 @@ void csr_roam_remove_duplicate_command(tpAniSirGlobal pMac, uint32_t sessionId,
 				       tSmeCmd *pCommand,
 				       eCsrRoamReason eRoamReason)
 {
-	tListElem *pEntry, *pNextEntry;
-	tSmeCmd *pDupCommand;
+	tListElem *pEntry;
+	tSmeCmd *pDupCommand, *pNextCommand;
 	tDblLinkList localList;
 
 	cdf_mem_zero(&localList, sizeof(tDblLinkList));
@@ -2592,12 +2592,14 @@ void csr_roam_remove_duplicate_command(tpAniSirGlobal pMac, uint32_t sessionId,
 		return;
 	}
 	csr_ll_lock(&pMac->sme.smeCmdPendingList);
-	pEntry = csr_ll_peek_head(&pMac->sme.smeCmdPendingList, LL_ACCESS_NOLOCK);
-	while (pEntry) {
-		pNextEntry =
-			csr_ll_next(&pMac->sme.smeCmdPendingList, pEntry,
-				    LL_ACCESS_NOLOCK);
-		pDupCommand = GET_BASE_ADDR(pEntry, tSmeCmd, Link);
+	/* Only commands of the same session can be duplicates */
+	pDupCommand = sme_cmd_index_first(&pMac->sme.smeCmdPendingList,
+					  pCommand ? pCommand->sessionId :
+					  sessionId);
+	while (pDupCommand) {
+		pNextCommand = sme_cmd_index_next(&pMac->sme.smeCmdPendingList,
+						  pDupCommand);
+		pEntry = &pDupCommand->Link;
 		/* Remove the previous command if.. */
 		/* - the new roam command is for the same RoamReason... */
 		/* - the new roam command is a NewProfileList. */
@@ -2639,7 +2641,7 @@ void csr_roam_remove_duplicate_command(tpAniSirGlobal pMac, uint32_t sessionId,
 						   LL_ACCESS_NOLOCK);
 			}
 		}
-		pEntry = pNextEntry;
+		pDupCommand = pNextCommand;
 	}
 	csr_ll_unlock(&pMac->sme.smeCmdPendingList);
 
@@ -7976,25 +7978,12 @@ CDF_STATUS csr_roam_save_connected_infomation(tpAniSirGlobal pMac,
 static bool is_disconnect_pending(tpAniSirGlobal pmac,
 				uint8_t sessionid)
 {
-	tListElem *entry = NULL;
-	tListElem *next_entry = NULL;
-	tSmeCmd *command = NULL;
 	bool disconnect_cmd_exist = false;
 
 	csr_ll_lock(&pmac->sme.smeCmdPendingList);
-	entry = csr_ll_peek_head(&pmac->sme.smeCmdPendingList, LL_ACCESS_NOLOCK);
-	while (entry) {
-		next_entry = csr_ll_next(&pmac->sme.smeCmdPendingList,
-					entry, LL_ACCESS_NOLOCK);
-
-		command = GET_BASE_ADDR(entry, tSmeCmd, Link);
-		if (command && CSR_IS_DISCONNECT_COMMAND(command) &&
-				command->sessionId == sessionid){
-			disconnect_cmd_exist = true;
-			break;
-		}
-		entry = next_entry;
-	}
+	if (sme_cmd_index_count(&pmac->sme.smeCmdPendingList, sessionid,
+				SME_CMD_CLASS_DISCONNECT))
+		disconnect_cmd_exist = true;
 	csr_ll_unlock(&pmac->sme.smeCmdPendingList);
 	return disconnect_cmd_exist;
 }
@@ -8239,20 +8228,12 @@ bool csr_is_roam_command_waiting_for_session(tpAniSirGlobal pMac, uint32_t sessi
 	}
 	if (false == fRet) {
 		csr_ll_lock(&pMac->sme.smeCmdPendingList);
-		pEntry =
-			csr_ll_peek_head(&pMac->sme.smeCmdPendingList,
-					 LL_ACCESS_NOLOCK);
-		while (pEntry) {
-			pCommand = GET_BASE_ADDR(pEntry, tSmeCmd, Link);
-			if ((eSmeCommandRoam == pCommand->command)
-			    && (sessionId == pCommand->sessionId)) {
-				fRet = true;
-				break;
-			}
-			pEntry =
-				csr_ll_next(&pMac->sme.smeCmdPendingList, pEntry,
-					    LL_ACCESS_NOLOCK);
-		}
+		/* disconnects are roam commands counted in their own class */
+		if (sme_cmd_index_count(&pMac->sme.smeCmdPendingList,
+					sessionId, SME_CMD_CLASS_ROAM) ||
+		    sme_cmd_index_count(&pMac->sme.smeCmdPendingList,
+					sessionId, SME_CMD_CLASS_DISCONNECT))
+			fRet = true;
 		csr_ll_unlock(&pMac->sme.smeCmdPendingList);
 	}
 	if (false == fRet) {
@@ -80,6 +80,9 @@
 #define PCL_ADVANTAGE 30
 #define PCL_RSSI_THRESHOLD -75
 
+/* slack allowed on the scan result aging timer, in ms */
+#define CSR_SCAN_AGING_TIMER_SLACK_MS 1000
+
 #define CSR_SCAN_IS_OVER_BSS_LIMIT(pMac)  \
 	((pMac)->scan.nBssLimit <= (csr_ll_count(&(pMac)->scan.scanResultList)))
 
@@ -188,6 +191,10 @@ CDF_STATUS csr_scan_open(tpAniSirGlobal mac_ctx)
 	if (!CDF_IS_STATUS_SUCCESS(status))
 		sms_log(mac_ctx, LOGE,
 			FL("Mem Alloc failed for CFG ResultAging timer"));
+	else
+		/* aging is not time critical, let it share wakeups */
+		cdf_mc_timer_set_slack(&mac_ctx->scan.hTimerResultCfgAging,
+				       CSR_SCAN_AGING_TIMER_SLACK_MS);
 
 	return status;
 }
@@ -1497,46 +1504,21 @@ static uint32_t csr_get_bss_cap_value(tpAniSirGlobal pMac,
 
 /**
  * csr_is_better_rssi() - Is bss1 better than bss2
- * @mac_ctx:             Global MAC Context pointer.
  * @bss1:                Pointer to the first BSS.
  * @bss2:                Pointer to the second BSS.
  *
  * This routine helps in determining the preference value
  * of a particular BSS in the scan result which is further
  * used in the sorting logic of the final candidate AP's.
+ * The boost and penalty logic has already been applied to
+ * alteredRssi when the entry was copied by csr_save_scan_entry.
  *
  * Return:          true, if bss1 is better than bss2
  *                  false, if bss2 is better than bss1.
  */
-static bool csr_is_better_rssi(tpAniSirGlobal mac_ctx,
-		tCsrScanResult *bss1, tCsrScanResult *bss2)
+static bool csr_is_better_rssi(tCsrScanResult *bss1, tCsrScanResult *bss2)
 {
-	bool ret;
-	int rssi1, rssi2;
-	struct cdf_mac_addr local_mac;
-
-	rssi1 = bss1->Result.BssDescriptor.rssi;
-	rssi2 = bss2->Result.BssDescriptor.rssi;
-	/*
-	 * Apply the boost and penlty logic and check
-	 * which is the best RSSI
-	 */
-	cdf_mem_zero(&local_mac.bytes, CDF_MAC_ADDR_SIZE);
-	cdf_mem_copy(&local_mac.bytes,
-			&bss1->Result.BssDescriptor.bssId, CDF_MAC_ADDR_SIZE);
-	rssi1 = csr_get_altered_rssi(mac_ctx, rssi1,
-			bss1->Result.BssDescriptor.channelId,
-			&local_mac);
-	cdf_mem_copy(&local_mac.bytes,
-			&bss2->Result.BssDescriptor.bssId, CDF_MAC_ADDR_SIZE);
-	rssi2 = csr_get_altered_rssi(mac_ctx, rssi2,
-			bss2->Result.BssDescriptor.channelId,
-			&local_mac);
-	if (CSR_IS_BETTER_RSSI(rssi1, rssi2))
-		ret = true;
-	else
-		ret = false;
-	return ret;
+	return CSR_IS_BETTER_RSSI(bss1->alteredRssi, bss2->alteredRssi);
 }
 
 /**
@@ -1565,7 +1547,7 @@ static bool csr_is_better_bss(tpAniSirGlobal mac_ctx,
 			ret = true;
 		else if (CSR_IS_EQUAL_CAP_VALUE
 				(bss1->capValue, bss2->capValue)) {
-			if (csr_is_better_rssi(mac_ctx, bss1, bss2))
+			if (csr_is_better_rssi(bss1, bss2))
 				ret = true;
 			else
 				ret = false;
@@ -1861,9 +1843,7 @@ csr_save_scan_entry(tpAniSirGlobal pMac,
 	CDF_STATUS status = CDF_STATUS_SUCCESS;
 	tCsrScanResult *pResult;
 	uint32_t bssLen, allocLen;
-	/* To sort the list */
-	tListElem *pTmpEntry;
-	tCsrScanResult *pTmpResult;
+	struct cdf_mac_addr bssid;
 
 	if (!(NULL == pFilter || fMatch))
 		return status;
@@ -1895,37 +1875,102 @@ csr_save_scan_entry(tpAniSirGlobal pMac,
 	cdf_mem_copy(&pResult->Result.BssDescriptor,
 		     &pBssDesc->Result.BssDescriptor,
 		     bssLen);
+	/*
+	 * Apply the boost and penalty logic once here so that sorting
+	 * the list does not have to redo it for every comparison
+	 */
+	cdf_mem_zero(&bssid.bytes, CDF_MAC_ADDR_SIZE);
+	cdf_mem_copy(bssid.bytes, &pResult->Result.BssDescriptor.bssId,
+		     CDF_MAC_ADDR_SIZE);
+	pResult->alteredRssi = csr_get_altered_rssi(pMac,
+				pResult->Result.BssDescriptor.rssi,
+				pResult->Result.BssDescriptor.channelId,
+				&bssid);
 	/*
 	 * No need to lock pRetList because it is locally allocated and no
-	 * outside can access it at this time
+	 * outside can access it at this time. The list is put in order by
+	 * csr_scan_sort_result_list once all entries are collected.
 	 */
-	if (csr_ll_is_list_empty(&pRetList->List, LL_ACCESS_NOLOCK)) {
-		csr_ll_insert_tail(&pRetList->List, &pResult->Link,
-				   LL_ACCESS_NOLOCK);
-		(*count)++;
-		return status;
-	}
+	csr_ll_insert_tail(&pRetList->List, &pResult->Link, LL_ACCESS_NOLOCK);
+	(*count)++;
+	return status;
+}
 
-	pTmpEntry = csr_ll_peek_head(&pRetList->List, LL_ACCESS_NOLOCK);
-	while (pTmpEntry) {
-		pTmpResult = GET_BASE_ADDR(pTmpEntry, tCsrScanResult, Link);
-		if (csr_is_better_bss(pMac, pResult, pTmpResult)) {
-			csr_ll_insert_entry(&pRetList->List, pTmpEntry,
-					    &pResult->Link, LL_ACCESS_NOLOCK);
-			/* To indicate we are done */
-			pResult = NULL;
-			break;
+/**
+ * csr_scan_sort_result_list() - order a result list, best BSS first
+ * @mac_ctx: Global MAC Context pointer.
+ * @list: result list built by csr_parse_scan_results
+ *
+ * Bottom-up merge sort on csr_is_better_bss(). It is stable, so BSSs
+ * that compare equal keep their scan cache order exactly as the former
+ * per-entry insertion did, but needs O(n log n) instead of O(n^2)
+ * comparisons. The list must not be visible to any other context.
+ *
+ * Return: None
+ */
+static void csr_scan_sort_result_list(tpAniSirGlobal mac_ctx,
+				      tDblLinkList *list)
+{
+	tListElem *head = &list->ListHead;
+	tListElem *first, *tail, *p, *q, *e;
+	uint32_t insize = 1, nmerges, psize, qsize, i;
+
+	if (list->Count < 2)
+		return;
+
+	/* work on a NULL terminated chain, back links are rebuilt below */
+	first = head->next;
+	head->last->next = NULL;
+
+	do {
+		p = first;
+		first = NULL;
+		tail = NULL;
+		nmerges = 0;
+		while (p) {
+			nmerges++;
+			q = p;
+			psize = 0;
+			for (i = 0; i < insize && q; i++) {
+				psize++;
+				q = q->next;
+			}
+			qsize = insize;
+			while (psize || (qsize && q)) {
+				/* take from q only if strictly better */
+				if (psize && (!qsize || !q ||
+				    !csr_is_better_bss(mac_ctx,
+					GET_BASE_ADDR(q, tCsrScanResult, Link),
+					GET_BASE_ADDR(p, tCsrScanResult,
+						      Link)))) {
+					e = p;
+					p = p->next;
+					psize--;
+				} else {
+					e = q;
+					q = q->next;
+					qsize--;
+				}
+				if (tail)
+					tail->next = e;
+				else
+					first = e;
+				tail = e;
+			}
+			p = q;
 		}
-		pTmpEntry = csr_ll_next(&pRetList->List,
-					pTmpEntry, LL_ACCESS_NOLOCK);
-	}
-	if (pResult != NULL) {
-		/* This one is not better than any one */
-		csr_ll_insert_tail(&pRetList->List, &pResult->Link,
-				   LL_ACCESS_NOLOCK);
+		tail->next = NULL;
+		insize *= 2;
+	} while (nmerges > 1);
+
+	p = head;
+	for (e = first; e; e = e->next) {
+		e->last = p;
+		p->next = e;
+		p = e;
 	}
-	(*count)++;
-	return status;
+	p->next = head;
+	head->last = p;
 }
 
 /**
@@ -2070,6 +2115,7 @@ CDF_STATUS csr_scan_get_result(tpAniSirGlobal pMac,
 	csr_ll_open(pMac->hHdd, &pRetList->List);
 	pRetList->pCurEntry = NULL;
 	status = csr_parse_scan_results(pMac, pFilter, pRetList, &count);
+	csr_scan_sort_result_list(pMac, &pRetList->List);
 	sms_log(pMac, LOG1, FL("return %d BSS %d"),
 		csr_ll_count(&pRetList->List), status);
 	if (!CDF_IS_STATUS_SUCCESS(status) || (phResult == NULL)) {
@@ -5725,8 +5771,8 @@ static void csr_scan_result_cfg_aging_timer_handler(void *pv)
 bool csr_scan_remove_fresh_scan_command(tpAniSirGlobal pMac, uint8_t sessionId)
 {
 	bool fRet = false;
-	tListElem *pEntry, *pEntryTmp;
-	tSmeCmd *pCommand;
+	tListElem *pEntry;
+	tSmeCmd *pCommand, *pNextCommand;
 	tDblLinkList localList;
 	tDblLinkList *pCmdList;
 
@@ -5739,26 +5785,25 @@ bool csr_scan_remove_fresh_scan_command(tpAniSirGlobal pMac, uint8_t sessionId)
 	pCmdList = &pMac->sme.smeScanCmdPendingList;
 
 	csr_ll_lock(pCmdList);
-	pEntry = csr_ll_peek_head(pCmdList, LL_ACCESS_NOLOCK);
-	while (pEntry) {
-		pEntryTmp = csr_ll_next(pCmdList, pEntry, LL_ACCESS_NOLOCK);
-		pCommand = GET_BASE_ADDR(pEntry, tSmeCmd, Link);
-		if (!((eSmeCommandScan == pCommand->command)
-		    && (sessionId == pCommand->sessionId))) {
-			pEntry = pEntryTmp;
+	pCommand = sme_cmd_index_first(pCmdList, sessionId);
+	while (pCommand) {
+		pNextCommand = sme_cmd_index_next(pCmdList, pCommand);
+		if (eSmeCommandScan != pCommand->command) {
+			pCommand = pNextCommand;
 			continue;
 		}
 		sms_log(pMac, LOGW,
 			FL("-------- abort scan command reason = %d"),
 			pCommand->u.scanCmd.reason);
 		/* The rest are fresh scan requests */
+		pEntry = &pCommand->Link;
 		if (csr_ll_remove_entry(pCmdList, pEntry,
 					LL_ACCESS_NOLOCK)) {
 			csr_ll_insert_tail(&localList, pEntry,
 					   LL_ACCESS_NOLOCK);
 		}
 		fRet = true;
-		pEntry = pEntryTmp;
+		pCommand = pNextCommand;
 	}
 
 	csr_ll_unlock(pCmdList);
@@ -6430,8 +6475,7 @@ void csr_remove_cmd_with_session_id_from_pending_list(tpAniSirGlobal pMac,
 {
 	tDblLinkList localList;
 	tListElem *pEntry;
-	tSmeCmd *pCommand;
-	tListElem *pEntryToRemove;
+	tSmeCmd *pCommand, *pNextCommand;
 
 	cdf_mem_zero(&localList, sizeof(tDblLinkList));
 	if (!CDF_IS_STATUS_SUCCESS(csr_ll_open(pMac->hHdd, &localList))) {
@@ -6440,27 +6484,17 @@ void csr_remove_cmd_with_session_id_from_pending_list(tpAniSirGlobal pMac,
 	}
 
 	csr_ll_lock(pList);
-	pEntry = csr_ll_peek_head(pList, LL_ACCESS_NOLOCK);
-	if (pEntry) {
-		/*
-		 * Have to make sure we don't loop back to the head of the list,
-		 * which will happen if the entry is NOT on the list
-		 */
-		while (pEntry) {
-			pEntryToRemove = pEntry;
-			pEntry = csr_ll_next(pList, pEntry, LL_ACCESS_NOLOCK);
-			pCommand = GET_BASE_ADDR(pEntryToRemove, tSmeCmd, Link);
-
-			if (!((pCommand->command == commandType) &&
-			    (pCommand->sessionId == sessionId)))
-				continue;
+	pCommand = sme_cmd_index_first(pList, sessionId);
+	while (pCommand) {
+		pNextCommand = sme_cmd_index_next(pList, pCommand);
+		if (pCommand->command == commandType &&
+		    csr_ll_remove_entry(pList, &pCommand->Link,
+					LL_ACCESS_NOLOCK)) {
 			/* Remove that entry only */
-			if (csr_ll_remove_entry(pList, pEntryToRemove,
-						LL_ACCESS_NOLOCK)) {
-				csr_ll_insert_tail(&localList, pEntryToRemove,
-						   LL_ACCESS_NOLOCK);
-			}
+			csr_ll_insert_tail(&localList, &pCommand->Link,
+					   LL_ACCESS_NOLOCK);
 		}
+		pCommand = pNextCommand;
 	}
 	csr_ll_unlock(pList);
 
@@ -6538,8 +6572,7 @@ void csr_remove_scan_for_ssid_from_pending_list(tpAniSirGlobal pMac,
 {
 	tDblLinkList localList;
 	tListElem *pEntry;
-	tSmeCmd *pCommand;
-	tListElem *pEntryToRemove;
+	tSmeCmd *pCommand, *pNextCommand;
 
 	cdf_mem_zero(&localList, sizeof(tDblLinkList));
 	if (!CDF_IS_STATUS_SUCCESS(csr_ll_open(pMac->hHdd, &localList))) {
@@ -6547,29 +6580,18 @@ void csr_remove_scan_for_ssid_from_pending_list(tpAniSirGlobal pMac,
 		return;
 	}
 	csr_ll_lock(pList);
-	if (!csr_ll_is_list_empty(pList, LL_ACCESS_NOLOCK)) {
-		pEntry = csr_ll_peek_head(pList, LL_ACCESS_NOLOCK);
-		/*
-		 * Have to make sure we don't loop back to the head of the list,
-		 * which will happen if the entry is NOT on the list...
-		 */
-		while (pEntry) {
-			pEntryToRemove = pEntry;
-			pEntry = csr_ll_next(pList, pEntry, LL_ACCESS_NOLOCK);
-			pCommand = GET_BASE_ADDR(pEntryToRemove, tSmeCmd, Link);
-
-			if (!((eSmeCommandScan == pCommand->command) &&
-			    (sessionId == pCommand->sessionId)))
-				continue;
-			if (eCsrScanForSsid != pCommand->u.scanCmd.reason)
-				continue;
+	pCommand = sme_cmd_index_first(pList, sessionId);
+	while (pCommand) {
+		pNextCommand = sme_cmd_index_next(pList, pCommand);
+		if ((eSmeCommandScan == pCommand->command) &&
+		    (eCsrScanForSsid == pCommand->u.scanCmd.reason) &&
+		    csr_ll_remove_entry(pList, &pCommand->Link,
+					LL_ACCESS_NOLOCK)) {
 			/* Remove that entry only */
-			if (csr_ll_remove_entry(pList, pEntryToRemove,
-						LL_ACCESS_NOLOCK)) {
-				csr_ll_insert_tail(&localList, pEntryToRemove,
-						   LL_ACCESS_NOLOCK);
-			}
+			csr_ll_insert_tail(&localList, &pCommand->Link,
+					   LL_ACCESS_NOLOCK);
 		}
+		pCommand = pNextCommand;
 	}
 	csr_ll_unlock(pList);
 	while ((pEntry = csr_ll_remove_head(&localList, LL_ACCESS_NOLOCK))) {
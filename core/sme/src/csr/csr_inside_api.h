@@ -155,6 +155,7 @@ typedef struct tagCsrScanResult {
 	int32_t AgingCount;     /* This BSS is removed when it reaches 0 or less */
 	uint32_t preferValue;   /* The bigger the number, the better the BSS. This value override capValue */
 	uint32_t capValue;      /* The biggger the better. This value is in use only if we have equal preferValue */
+	int32_t alteredRssi;    /* RSSI after 5G boost/penalty and favored BSSID score, set for csr_scan_get_result entries */
 	/* This member must be the last in the structure because the end of tSirBssDescription (inside) is an */
 	/*    array with nonknown size at this time */
 
@@ -41,6 +41,23 @@
 CDF_INLINE_FN void csr_list_init(tListElem *pList)
 {
 	pList->last = pList->next = pList;
+	pList->pList = NULL;
+}
+
+/* Record that pEntry was linked on pList and update the list index */
+CDF_INLINE_FN void csr_ll_linked(tDblLinkList *pList, tListElem *pEntry)
+{
+	pEntry->pList = pList;
+	if (pList->pIndex)
+		pList->pIndex->insert(pList->pIndex, pList, pEntry);
+}
+
+/* Record that pEntry was unlinked from pList and update the list index */
+CDF_INLINE_FN void csr_ll_unlinked(tDblLinkList *pList, tListElem *pEntry)
+{
+	if (pList->pIndex)
+		pList->pIndex->remove(pList->pIndex, pEntry);
+	pEntry->pList = NULL;
 }
 
 CDF_INLINE_FN void csr_list_remove_entry(tListElem *pEntry)
@@ -199,20 +216,16 @@ bool csr_ll_find_entry(tDblLinkList *pList, tListElem *pEntryToFind)
 		return fFound;
 	}
 
-	if (LIST_FLAG_OPEN == pList->Flag) {
-		pEntry = csr_ll_peek_head(pList, LL_ACCESS_NOLOCK);
-
-		/* Have to make sure we don't loop back to the head of the list, which will */
-		/* happen if the entry is NOT on the list... */
-
-		while (pEntry && (pEntry != &pList->ListHead)) {
-			if (pEntry == pEntryToFind) {
-				fFound = true;
-				break;
-			}
-			pEntry = pEntry->next;
-		}
-
+	if ((LIST_FLAG_OPEN == pList->Flag) && pEntryToFind) {
+		/*
+		 * The owner is set while the element is linked. The neighbour
+		 * check catches stale copies of an element that is on the list.
+		 */
+		pEntry = pEntryToFind;
+		fFound = (pEntry->pList == pList) &&
+			 (pEntry != &pList->ListHead) &&
+			 (pEntry->next->last == pEntry) &&
+			 (pEntry->last->next == pEntry);
 	}
 	return fFound;
 }
@@ -231,6 +244,7 @@ CDF_STATUS csr_ll_open(tHddHandle hHdd, tDblLinkList *pList)
 	if (LIST_FLAG_OPEN != pList->Flag) {
 		pList->Count = 0;
 		pList->cmdTimeoutTimer = NULL;
+		pList->pIndex = NULL;
 		cdf_status = cdf_mutex_init(&pList->Lock);
 
 		if (CDF_IS_STATUS_SUCCESS(cdf_status)) {
@@ -257,9 +271,31 @@ void csr_ll_close(tDblLinkList *pList)
 		csr_ll_purge(pList, LL_ACCESS_LOCK);
 		cdf_mutex_destroy(&pList->Lock);
 		pList->Flag = LIST_FLAG_CLOSE;
+		pList->pIndex = NULL;
 	}
 }
 
+/**
+ * csr_ll_set_index() - attach an index to a list
+ * @pList: list, must be empty
+ * @pIndex: index to keep in step with the list, NULL to detach
+ *
+ * Return: None
+ */
+void csr_ll_set_index(tDblLinkList *pList, tListIndex *pIndex)
+{
+	if (!pList) {
+		CDF_TRACE(CDF_MODULE_ID_SME, CDF_TRACE_LEVEL_FATAL,
+			  "%s: Error!! pList is Null", __func__);
+		return;
+	}
+
+	csr_ll_lock(pList);
+	CDF_ASSERT(csrIsListEmpty(&pList->ListHead));
+	pList->pIndex = pIndex;
+	csr_ll_unlock(pList);
+}
+
 void csr_ll_insert_tail(tDblLinkList *pList, tListElem *pEntry,
 			bool fInterlocked)
 {
@@ -275,6 +311,7 @@ void csr_ll_insert_tail(tDblLinkList *pList, tListElem *pEntry,
 		}
 		csr_list_insert_tail(&pList->ListHead, pEntry);
 		pList->Count++;
+		csr_ll_linked(pList, pEntry);
 		if (fInterlocked) {
 			csr_ll_unlock(pList);
 		}
@@ -297,6 +334,7 @@ void csr_ll_insert_head(tDblLinkList *pList, tListElem *pEntry,
 		}
 		csr_list_insert_head(&pList->ListHead, pEntry);
 		pList->Count++;
+		csr_ll_linked(pList, pEntry);
 		if (fInterlocked) {
 			csr_ll_unlock(pList);
 		}
@@ -323,6 +361,7 @@ void csr_ll_insert_entry(tDblLinkList *pList, tListElem *pEntry,
 		}
 		csr_list_insert_entry(pEntry, pNewEntry);
 		pList->Count++;
+		csr_ll_linked(pList, pNewEntry);
 		if (fInterlocked) {
 			csr_ll_unlock(pList);
 		}
@@ -348,6 +387,7 @@ tListElem *csr_ll_remove_tail(tDblLinkList *pList, bool fInterlocked)
 
 			pEntry = csr_list_remove_tail(&pList->ListHead);
 			pList->Count--;
+			csr_ll_unlinked(pList, pEntry);
 		}
 		if (fInterlocked) {
 			csr_ll_unlock(pList);
@@ -401,6 +441,7 @@ tListElem *csr_ll_remove_head(tDblLinkList *pList, bool fInterlocked)
 		if (!csrIsListEmpty(&pList->ListHead)) {
 			pEntry = csr_list_remove_head(&pList->ListHead);
 			pList->Count--;
+			csr_ll_unlinked(pList, pEntry);
 		}
 
 		if (fInterlocked) {
@@ -478,20 +519,13 @@ bool csr_ll_remove_entry(tDblLinkList *pList, tListElem *pEntryToRemove,
 			csr_ll_lock(pList);
 		}
 
-		pEntry = csr_ll_peek_head(pList, LL_ACCESS_NOLOCK);
-
-		/* Have to make sure we don't loop back to the head of the list, which will */
-		/* happen if the entry is NOT on the list... */
-		while (pEntry && (pEntry != &pList->ListHead)) {
-			if (pEntry == pEntryToRemove) {
-				csr_list_remove_entry(pEntry);
-				pList->Count--;
-
-				fFound = true;
-				break;
-			}
+		if (csr_ll_find_entry(pList, pEntryToRemove)) {
+			pEntry = pEntryToRemove;
+			csr_list_remove_entry(pEntry);
+			pList->Count--;
+			csr_ll_unlinked(pList, pEntry);
 
-			pEntry = pEntry->next;
+			fFound = true;
 		}
 		if (fInterlocked) {
 			csr_ll_unlock(pList);
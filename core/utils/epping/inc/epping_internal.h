@@ -104,6 +104,66 @@ typedef struct {
 } epping_poll_t;
 #endif
 
+/*
+ * Benchmark mode: packets generated by the host with a known header
+ * cookie, timestamped on TX and matched on echo. Round trip times are
+ * kept in log-linear (HDR style) histograms: every power of two of
+ * microseconds is split into EPPING_BENCH_HIST_SUB linear sub-buckets,
+ * which bounds the relative error to 1/EPPING_BENCH_HIST_SUB.
+ */
+#define EPPING_BENCH_COOKIE             0xBE4C4D4B
+#define EPPING_BENCH_MAX_SIZES          8
+#define EPPING_BENCH_HIST_SUB_BITS      4
+#define EPPING_BENCH_HIST_SUB           (1 << EPPING_BENCH_HIST_SUB_BITS)
+#define EPPING_BENCH_HIST_MAG           24
+#define EPPING_BENCH_HIST_BUCKETS       \
+	((EPPING_BENCH_HIST_MAG + 1) << EPPING_BENCH_HIST_SUB_BITS)
+#define EPPING_BENCH_DEF_PKT_SIZE       1024
+#define EPPING_BENCH_DEF_BURST          8
+#define EPPING_BENCH_DEF_NUM_BURSTS     1000
+#define EPPING_BENCH_DEF_INTERVAL_MS    1
+#define EPPING_BENCH_MAX_BURST          64
+/* only ac 0 and 1 are mapped to the mboxping service, see epping_tx.c */
+#define EPPING_BENCH_STREAM_MASK        0x3
+
+struct epping_bench_hist {
+	uint32_t bucket[EPPING_BENCH_HIST_BUCKETS];
+	uint64_t count;
+	uint64_t sum_us;
+	uint32_t min_us;
+	uint32_t max_us;
+};
+
+struct epping_bench_cfg {
+	uint16_t pkt_size[EPPING_BENCH_MAX_SIZES];
+	uint8_t num_sizes;
+	uint16_t burst;
+	uint32_t num_bursts;
+	uint32_t interval_ms;
+	uint8_t stream_mask;
+	bool loopback;
+};
+
+struct epping_bench {
+	struct epping_bench_cfg cfg;
+	bool inited;
+	bool running;
+	uint32_t seq;
+	uint32_t bursts_sent;
+	uint64_t tx_pkts;
+	uint64_t tx_bytes;
+	uint64_t tx_fail;
+	uint64_t rx_pkts;
+	uint64_t rx_bytes;
+	uint64_t rx_stale;
+	uint64_t start_ns;
+	uint64_t stop_ns;
+	struct epping_bench_hist hist[EPPING_MAX_NUM_EPIDS];
+	cdf_spinlock_t lock;
+	cdf_softirq_timer_t timer;
+	struct dentry *debugfs_dir;
+};
+
 typedef struct epping_context_s {
 	int32_t con_mode;
 	char *pwlan_module_name;
@@ -126,6 +186,7 @@ typedef struct epping_context_s {
 	int cookie_count;
 	struct epping_cookie *s_cookie_mem[MAX_COOKIE_SLOTS_NUM];
 	cdf_spinlock_t cookie_lock;
+	struct epping_bench bench;
 } epping_context_t;
 
 typedef enum {
@@ -194,4 +255,10 @@ void epping_unregister_tx_copier(HTC_ENDPOINT_ID eid,
 void epping_tx_copier_schedule(epping_context_t *pEpping_ctx,
 			       HTC_ENDPOINT_ID eid, cdf_nbuf_t skb);
 #endif /* HIF_PCI */
+
+/* epping_bench signatures */
+void epping_bench_init(epping_context_t *pEpping_ctx);
+void epping_bench_deinit(epping_context_t *pEpping_ctx);
+bool epping_bench_rx(epping_context_t *pEpping_ctx, HTC_ENDPOINT_ID eid,
+		     cdf_nbuf_t skb);
 #endif /* end #ifndef EPPING_INTERNAL_H */
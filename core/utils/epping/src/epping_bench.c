@@ -0,0 +1,709 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Previously licensed under the ISC license by Qualcomm Atheros, Inc.
+ *
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * This file was originally distributed by Qualcomm Atheros, Inc.
+ * under proprietary terms before Copyright ownership was assigned
+ * to the Linux Foundation.
+ */
+
+/**
+ * DOC: epping_bench.c
+ *
+ * End point ping benchmark mode. The host generates bursts of echo
+ * packets with a configurable size mix, burst depth and stream (access
+ * class) mix, stamps each one on TX and records the round trip time
+ * when the echo comes back through epping_rx().
+ *
+ * This driver supports the following debugfs files:
+ * epping_bench/config  - read/write benchmark parameters
+ * epping_bench/control - write "start", "stop" or "reset"
+ * epping_bench/results - machine readable counters and histograms
+ *
+ * With loopback=1 the packets still go through htc_send_pkt() and
+ * hif_send_head(), but the bench endpoints are handed to the HIF software
+ * target (hif_set_sw_target()), which completes each send and echoes it
+ * back through the HTC receive path in place of the firmware. This
+ * measures the host side of the whole echo path without firmware.
+ */
+
+#include <cds_api.h>
+#include <linux/debugfs.h>
+#include <linux/vmalloc.h>
+#include <linux/uaccess.h>
+#include <linux/ktime.h>
+#include "hif.h"
+#include "epping_main.h"
+#include "epping_internal.h"
+#include "epping_test.h"
+
+#define EPPING_BENCH_DEBUGFS_DIR        "epping_bench"
+#define EPPING_BENCH_CMD_SIZE           256
+#define EPPING_BENCH_RESULTS_SIZE       (64 * 1024)
+#define EPPING_BENCH_HEADROOM           64
+
+/**
+ * epping_bench_hist_index() - map a latency to a histogram bucket
+ * @us: latency in microseconds
+ *
+ * Values below EPPING_BENCH_HIST_SUB are stored exactly; above that,
+ * each power of two is split into EPPING_BENCH_HIST_SUB linear
+ * sub-buckets. Values beyond the top magnitude saturate.
+ *
+ * Return: bucket index
+ */
+static uint32_t epping_bench_hist_index(uint32_t us)
+{
+	uint32_t msb, shift, idx;
+
+	if (us < EPPING_BENCH_HIST_SUB)
+		return us;
+
+	msb = fls(us) - 1;
+	shift = msb - EPPING_BENCH_HIST_SUB_BITS;
+	idx = ((shift + 1) << EPPING_BENCH_HIST_SUB_BITS) +
+	      ((us >> shift) & (EPPING_BENCH_HIST_SUB - 1));
+
+	if (idx >= EPPING_BENCH_HIST_BUCKETS)
+		idx = EPPING_BENCH_HIST_BUCKETS - 1;
+	return idx;
+}
+
+/**
+ * epping_bench_hist_lower() - lowest latency that maps to a bucket
+ * @idx: bucket index
+ *
+ * Return: lower bound of the bucket in microseconds
+ */
+static uint32_t epping_bench_hist_lower(uint32_t idx)
+{
+	uint32_t mag = idx >> EPPING_BENCH_HIST_SUB_BITS;
+	uint32_t sub = idx & (EPPING_BENCH_HIST_SUB - 1);
+
+	if (mag == 0)
+		return sub;
+	return (EPPING_BENCH_HIST_SUB + sub) << (mag - 1);
+}
+
+static void epping_bench_hist_add(struct epping_bench_hist *hist,
+				  uint32_t us)
+{
+	hist->bucket[epping_bench_hist_index(us)]++;
+	if (!hist->count || us < hist->min_us)
+		hist->min_us = us;
+	if (us > hist->max_us)
+		hist->max_us = us;
+	hist->count++;
+	hist->sum_us += us;
+}
+
+/**
+ * epping_bench_hist_percentile() - compute a percentile from a histogram
+ * @hist: histogram
+ * @pct: percentile scaled by 10 (e.g. 999 for p99.9)
+ *
+ * Return: lower bound of the bucket containing the percentile
+ */
+static uint32_t epping_bench_hist_percentile(struct epping_bench_hist *hist,
+					     uint32_t pct)
+{
+	uint64_t target, seen = 0;
+	uint32_t i;
+
+	if (!hist->count)
+		return 0;
+
+	target = hist->count * pct;
+	target = (target + 999) / 1000;
+	if (!target)
+		target = 1;
+
+	for (i = 0; i < EPPING_BENCH_HIST_BUCKETS; i++) {
+		seen += hist->bucket[i];
+		if (seen >= target)
+			return epping_bench_hist_lower(i);
+	}
+	return hist->max_us;
+}
+
+static void epping_bench_reset_stats(struct epping_bench *bench)
+{
+	bench->seq = 0;
+	bench->bursts_sent = 0;
+	bench->tx_pkts = 0;
+	bench->tx_bytes = 0;
+	bench->tx_fail = 0;
+	bench->rx_pkts = 0;
+	bench->rx_bytes = 0;
+	bench->rx_stale = 0;
+	bench->start_ns = 0;
+	bench->stop_ns = 0;
+	cdf_mem_zero(bench->hist, sizeof(bench->hist));
+}
+
+/**
+ * epping_bench_set_sw_target() - echo the bench streams in HIF
+ * @pEpping_ctx: epping context
+ * @enable: true to hand the bench endpoints to the HIF software target,
+ *	    false to send them to the firmware again
+ *
+ * Return: none
+ */
+static void epping_bench_set_sw_target(epping_context_t *pEpping_ctx,
+				       bool enable)
+{
+	struct ol_softc *scn = cds_get_context(CDF_MODULE_ID_HIF);
+	struct epping_bench_cfg *cfg = &pEpping_ctx->bench.cfg;
+	uint32_t ep_mask = 0;
+	int i;
+
+	if (!scn)
+		return;
+
+	for (i = 0; enable && i < EPPING_MAX_NUM_EPIDS; i++)
+		if (cfg->stream_mask & EPPING_BENCH_STREAM_MASK & (1 << i))
+			ep_mask |= 1 << pEpping_ctx->EppingEndpoint[i];
+	hif_set_sw_target(scn, ep_mask);
+}
+
+/**
+ * epping_bench_build_pkt() - allocate and fill one benchmark packet
+ * @bench: benchmark state
+ * @stream: access class stream to send on
+ * @len: total packet length including the epping header
+ *
+ * Return: packet, or NULL on allocation failure
+ */
+static cdf_nbuf_t epping_bench_build_pkt(struct epping_bench *bench,
+					 uint8_t stream, uint16_t len)
+{
+	cdf_nbuf_t skb;
+	EPPING_HEADER *hdr;
+	uint64_t now;
+
+	if (len < sizeof(EPPING_HEADER))
+		len = sizeof(EPPING_HEADER);
+
+	skb = cdf_nbuf_alloc(NULL, len + EPPING_BENCH_HEADROOM,
+			     EPPING_BENCH_HEADROOM, 4, false);
+	if (!skb)
+		return NULL;
+
+	cdf_nbuf_put_tail(skb, len);
+	hdr = (EPPING_HEADER *) cdf_nbuf_data(skb);
+	cdf_mem_set(hdr, len, EPPING_RSVD_FILL);
+	SET_EPPING_PACKET_MAGIC(hdr);
+	hdr->StreamNo_h = stream;
+	hdr->StreamEcho_h = stream;
+	hdr->Cmd_h = EPPING_CMD_ECHO_PACKET;
+	hdr->CmdFlags_h = 0;
+	hdr->HostContext_h = EPPING_BENCH_COOKIE;
+	hdr->SeqNo = bench->seq++;
+	hdr->DataLength = len - sizeof(EPPING_HEADER);
+	now = ktime_to_ns(ktime_get());
+	cdf_mem_copy(hdr->TimeStamp, &now, sizeof(hdr->TimeStamp));
+
+	return skb;
+}
+
+/**
+ * epping_bench_send_burst() - send one burst across the stream mix
+ * @pEpping_ctx: epping context
+ *
+ * Packet sizes and streams are picked round-robin from the configured
+ * size list and stream mask so every burst covers the whole mix.
+ *
+ * Return: none
+ */
+static void epping_bench_send_burst(epping_context_t *pEpping_ctx)
+{
+	struct epping_bench *bench = &pEpping_ctx->bench;
+	struct epping_bench_cfg *cfg = &bench->cfg;
+	epping_adapter_t *pAdapter = pEpping_ctx->epping_adapter;
+	uint8_t streams[EPPING_MAX_NUM_EPIDS];
+	uint8_t num_streams = 0, stream;
+	uint16_t len;
+	cdf_nbuf_t skb;
+	int i;
+
+	for (i = 0; i < EPPING_MAX_NUM_EPIDS; i++)
+		if (cfg->stream_mask & EPPING_BENCH_STREAM_MASK & (1 << i))
+			streams[num_streams++] = i;
+	if (!num_streams || !pAdapter)
+		return;
+
+	/*
+	 * The counters are read by the results file and reset from the
+	 * control file, so update them under bench->lock. The lock is not
+	 * held across the send itself.
+	 */
+	for (i = 0; i < cfg->burst; i++) {
+		cdf_spin_lock_bh(&bench->lock);
+		stream = streams[bench->seq % num_streams];
+		len = cfg->pkt_size[(bench->seq / num_streams) %
+				    cfg->num_sizes];
+		skb = epping_bench_build_pkt(bench, stream, len);
+		if (!skb) {
+			bench->tx_fail++;
+			cdf_spin_unlock_bh(&bench->lock);
+			continue;
+		}
+		bench->tx_pkts++;
+		bench->tx_bytes += len;
+		cdf_spin_unlock_bh(&bench->lock);
+
+		if (epping_tx_send(skb, pAdapter)) {
+			cdf_spin_lock_bh(&bench->lock);
+			bench->tx_pkts--;
+			bench->tx_bytes -= len;
+			bench->tx_fail++;
+			cdf_spin_unlock_bh(&bench->lock);
+		}
+	}
+	cdf_spin_lock_bh(&bench->lock);
+	bench->bursts_sent++;
+	cdf_spin_unlock_bh(&bench->lock);
+}
+
+static void epping_bench_timer_expire(void *data)
+{
+	epping_context_t *pEpping_ctx = (epping_context_t *) data;
+	struct epping_bench *bench = &pEpping_ctx->bench;
+
+	if (!bench->running)
+		return;
+
+	epping_bench_send_burst(pEpping_ctx);
+
+	if (bench->cfg.num_bursts &&
+	    bench->bursts_sent >= bench->cfg.num_bursts) {
+		bench->running = false;
+		bench->stop_ns = ktime_to_ns(ktime_get());
+		if (bench->cfg.loopback)
+			epping_bench_set_sw_target(pEpping_ctx, false);
+		EPPING_LOG(CDF_TRACE_LEVEL_INFO_HIGH,
+			   "%s: done, tx %llu rx %llu", __func__,
+			   bench->tx_pkts, bench->rx_pkts);
+		return;
+	}
+	cdf_softirq_timer_mod(&bench->timer, bench->cfg.interval_ms);
+}
+
+/**
+ * epping_bench_rx() - consume an echoed benchmark packet
+ * @pEpping_ctx: epping context
+ * @eid: endpoint the packet was received on
+ * @skb: received packet, epping header at data pointer
+ *
+ * Return: true if the packet was a benchmark packet and was freed,
+ *	   false if it should continue up the normal RX path
+ */
+bool epping_bench_rx(epping_context_t *pEpping_ctx, HTC_ENDPOINT_ID eid,
+		     cdf_nbuf_t skb)
+{
+	struct epping_bench *bench = &pEpping_ctx->bench;
+	EPPING_HEADER *hdr;
+	uint64_t sent_ns, now;
+	uint32_t rtt_us;
+	uint8_t stream;
+
+	if (!bench->inited || cdf_nbuf_len(skb) < sizeof(EPPING_HEADER))
+		return false;
+
+	hdr = (EPPING_HEADER *) cdf_nbuf_data(skb);
+	if (!IS_EPPING_PACKET(hdr) ||
+	    hdr->HostContext_h != EPPING_BENCH_COOKIE)
+		return false;
+
+	now = ktime_to_ns(ktime_get());
+	cdf_mem_copy(&sent_ns, hdr->TimeStamp, sizeof(sent_ns));
+	stream = hdr->StreamNo_h;
+
+	cdf_spin_lock_bh(&bench->lock);
+	if (stream >= EPPING_MAX_NUM_EPIDS || !bench->start_ns ||
+	    sent_ns < bench->start_ns || sent_ns > now) {
+		bench->rx_stale++;
+	} else {
+		rtt_us = (uint32_t) div_u64(now - sent_ns, NSEC_PER_USEC);
+		epping_bench_hist_add(&bench->hist[stream], rtt_us);
+		bench->rx_pkts++;
+		bench->rx_bytes += cdf_nbuf_len(skb);
+	}
+	cdf_spin_unlock_bh(&bench->lock);
+
+	cdf_nbuf_free(skb);
+	return true;
+}
+
+static void epping_bench_start(epping_context_t *pEpping_ctx)
+{
+	struct epping_bench *bench = &pEpping_ctx->bench;
+
+	if (bench->running)
+		return;
+
+	cdf_spin_lock_bh(&bench->lock);
+	epping_bench_reset_stats(bench);
+	bench->start_ns = ktime_to_ns(ktime_get());
+	cdf_spin_unlock_bh(&bench->lock);
+
+	if (bench->cfg.loopback)
+		epping_bench_set_sw_target(pEpping_ctx, true);
+	bench->running = true;
+	cdf_softirq_timer_mod(&bench->timer, bench->cfg.interval_ms);
+}
+
+static void epping_bench_stop(epping_context_t *pEpping_ctx)
+{
+	struct epping_bench *bench = &pEpping_ctx->bench;
+
+	if (!bench->running)
+		return;
+	bench->running = false;
+	cdf_softirq_timer_cancel(&bench->timer);
+	bench->stop_ns = ktime_to_ns(ktime_get());
+	if (bench->cfg.loopback)
+		epping_bench_set_sw_target(pEpping_ctx, false);
+}
+
+static void epping_bench_default_cfg(struct epping_bench_cfg *cfg)
+{
+	cdf_mem_zero(cfg, sizeof(*cfg));
+	cfg->pkt_size[0] = EPPING_BENCH_DEF_PKT_SIZE;
+	cfg->num_sizes = 1;
+	cfg->burst = EPPING_BENCH_DEF_BURST;
+	cfg->num_bursts = EPPING_BENCH_DEF_NUM_BURSTS;
+	cfg->interval_ms = EPPING_BENCH_DEF_INTERVAL_MS;
+	cfg->stream_mask = EPPING_BENCH_STREAM_MASK;
+	cfg->loopback = false;
+}
+
+#ifdef WLAN_OPEN_SOURCE
+/**
+ * epping_bench_parse_sizes() - parse a comma separated size list
+ * @cfg: config to update
+ * @val: value string, e.g. "64,512,1500"
+ *
+ * Return: 0 on success, -EINVAL on a malformed list
+ */
+static int epping_bench_parse_sizes(struct epping_bench_cfg *cfg, char *val)
+{
+	char *tok;
+	uint16_t size;
+	uint8_t n = 0;
+
+	while ((tok = strsep(&val, ",")) != NULL) {
+		if (n >= EPPING_BENCH_MAX_SIZES || kstrtou16(tok, 0, &size))
+			return -EINVAL;
+		if (size < sizeof(EPPING_HEADER) || size > ETH_FRAME_LEN)
+			return -EINVAL;
+		cfg->pkt_size[n++] = size;
+	}
+	if (!n)
+		return -EINVAL;
+	cfg->num_sizes = n;
+	return 0;
+}
+
+static ssize_t epping_bench_config_write(struct file *file,
+					 const char __user *buf,
+					 size_t count, loff_t *ppos)
+{
+	epping_context_t *pEpping_ctx = file->private_data;
+	struct epping_bench *bench = &pEpping_ctx->bench;
+	struct epping_bench_cfg cfg = bench->cfg;
+	char cmd[EPPING_BENCH_CMD_SIZE + 1];
+	char *sptr, *token, *val;
+	uint32_t num;
+
+	if (bench->running)
+		return -EBUSY;
+	if (count > EPPING_BENCH_CMD_SIZE)
+		return -EINVAL;
+	if (copy_from_user(cmd, buf, count))
+		return -EFAULT;
+	cmd[count] = '\0';
+	sptr = strim(cmd);
+
+	while ((token = strsep(&sptr, " \t")) != NULL) {
+		if (!*token)
+			continue;
+		val = strchr(token, '=');
+		if (!val)
+			return -EINVAL;
+		*val++ = '\0';
+
+		if (!strcmp(token, "size")) {
+			if (epping_bench_parse_sizes(&cfg, val))
+				return -EINVAL;
+			continue;
+		}
+		if (kstrtou32(val, 0, &num))
+			return -EINVAL;
+
+		if (!strcmp(token, "burst")) {
+			if (!num || num > EPPING_BENCH_MAX_BURST)
+				return -EINVAL;
+			cfg.burst = num;
+		} else if (!strcmp(token, "bursts")) {
+			cfg.num_bursts = num;
+		} else if (!strcmp(token, "interval_ms")) {
+			cfg.interval_ms = num;
+		} else if (!strcmp(token, "stream_mask")) {
+			if (!num || (num & ~EPPING_BENCH_STREAM_MASK))
+				return -EINVAL;
+			cfg.stream_mask = num;
+		} else if (!strcmp(token, "loopback")) {
+			cfg.loopback = !!num;
+		} else {
+			return -EINVAL;
+		}
+	}
+
+	bench->cfg = cfg;
+	return count;
+}
+
+static ssize_t epping_bench_config_read(struct file *file,
+					char __user *buf,
+					size_t count, loff_t *ppos)
+{
+	epping_context_t *pEpping_ctx = file->private_data;
+	struct epping_bench_cfg *cfg = &pEpping_ctx->bench.cfg;
+	char out[EPPING_BENCH_CMD_SIZE];
+	int len, i;
+
+	len = scnprintf(out, sizeof(out), "size=");
+	for (i = 0; i < cfg->num_sizes; i++)
+		len += scnprintf(out + len, sizeof(out) - len, "%s%u",
+				 i ? "," : "", cfg->pkt_size[i]);
+	len += scnprintf(out + len, sizeof(out) - len,
+			 " burst=%u bursts=%u interval_ms=%u stream_mask=0x%x loopback=%u\n",
+			 cfg->burst, cfg->num_bursts, cfg->interval_ms,
+			 cfg->stream_mask, cfg->loopback);
+
+	return simple_read_from_buffer(buf, count, ppos, out, len);
+}
+
+static ssize_t epping_bench_control_write(struct file *file,
+					  const char __user *buf,
+					  size_t count, loff_t *ppos)
+{
+	epping_context_t *pEpping_ctx = file->private_data;
+	struct epping_bench *bench = &pEpping_ctx->bench;
+	char cmd[16];
+	char *sptr;
+
+	if (count >= sizeof(cmd))
+		return -EINVAL;
+	if (copy_from_user(cmd, buf, count))
+		return -EFAULT;
+	cmd[count] = '\0';
+	sptr = strim(cmd);
+
+	if (!strcmp(sptr, "start")) {
+		if (!pEpping_ctx->epping_adapter)
+			return -ENODEV;
+		epping_bench_start(pEpping_ctx);
+	} else if (!strcmp(sptr, "stop")) {
+		epping_bench_stop(pEpping_ctx);
+	} else if (!strcmp(sptr, "reset")) {
+		if (bench->running)
+			return -EBUSY;
+		cdf_spin_lock_bh(&bench->lock);
+		epping_bench_reset_stats(bench);
+		cdf_spin_unlock_bh(&bench->lock);
+	} else {
+		return -EINVAL;
+	}
+	return count;
+}
+
+/**
+ * epping_bench_results_read() - dump results in key=value form
+ * @file: debugfs file
+ * @buf: user buffer
+ * @count: size of @buf
+ * @ppos: offset
+ *
+ * One "summary" line, one "stream" line per stream that saw traffic and
+ * one "hist" line per non-empty histogram bucket, so the output can be
+ * parsed line by line by CI scripts.
+ *
+ * Return: number of bytes read, or negative errno
+ */
+static ssize_t epping_bench_results_read(struct file *file,
+					 char __user *buf,
+					 size_t count, loff_t *ppos)
+{
+	epping_context_t *pEpping_ctx = file->private_data;
+	struct epping_bench *bench = &pEpping_ctx->bench;
+	struct epping_bench_hist *hist;
+	uint64_t end_ns, elapsed_us;
+	char *out;
+	int len = 0, size = EPPING_BENCH_RESULTS_SIZE;
+	ssize_t ret;
+	int i, j;
+
+	out = vmalloc(size);
+	if (!out)
+		return -ENOMEM;
+
+	cdf_spin_lock_bh(&bench->lock);
+	end_ns = bench->running ? ktime_to_ns(ktime_get()) : bench->stop_ns;
+	elapsed_us = (bench->start_ns && end_ns > bench->start_ns) ?
+		     div_u64(end_ns - bench->start_ns, NSEC_PER_USEC) : 0;
+
+	len += scnprintf(out + len, size - len,
+			 "summary version=1 running=%u loopback=%u elapsed_us=%llu bursts=%u tx_pkts=%llu tx_bytes=%llu tx_fail=%llu rx_pkts=%llu rx_bytes=%llu rx_stale=%llu\n",
+			 bench->running, bench->cfg.loopback, elapsed_us,
+			 bench->bursts_sent, bench->tx_pkts, bench->tx_bytes,
+			 bench->tx_fail, bench->rx_pkts, bench->rx_bytes,
+			 bench->rx_stale);
+
+	for (i = 0; i < EPPING_MAX_NUM_EPIDS; i++) {
+		hist = &bench->hist[i];
+		if (!hist->count)
+			continue;
+		len += scnprintf(out + len, size - len,
+				 "stream id=%d count=%llu min_us=%u avg_us=%llu p50_us=%u p90_us=%u p99_us=%u p999_us=%u max_us=%u\n",
+				 i, hist->count, hist->min_us,
+				 div64_u64(hist->sum_us, hist->count),
+				 epping_bench_hist_percentile(hist, 500),
+				 epping_bench_hist_percentile(hist, 900),
+				 epping_bench_hist_percentile(hist, 990),
+				 epping_bench_hist_percentile(hist, 999),
+				 hist->max_us);
+	}
+
+	for (i = 0; i < EPPING_MAX_NUM_EPIDS; i++) {
+		hist = &bench->hist[i];
+		for (j = 0; j < EPPING_BENCH_HIST_BUCKETS; j++) {
+			if (!hist->bucket[j])
+				continue;
+			len += scnprintf(out + len, size - len,
+					 "hist id=%d lo_us=%u count=%u\n",
+					 i, epping_bench_hist_lower(j),
+					 hist->bucket[j]);
+		}
+	}
+	cdf_spin_unlock_bh(&bench->lock);
+
+	ret = simple_read_from_buffer(buf, count, ppos, out, len);
+	vfree(out);
+	return ret;
+}
+
+static const struct file_operations fops_epping_bench_config = {
+	.read = epping_bench_config_read,
+	.write = epping_bench_config_write,
+	.open = simple_open,
+	.owner = THIS_MODULE,
+	.llseek = default_llseek,
+};
+
+static const struct file_operations fops_epping_bench_control = {
+	.write = epping_bench_control_write,
+	.open = simple_open,
+	.owner = THIS_MODULE,
+	.llseek = default_llseek,
+};
+
+static const struct file_operations fops_epping_bench_results = {
+	.read = epping_bench_results_read,
+	.open = simple_open,
+	.owner = THIS_MODULE,
+	.llseek = default_llseek,
+};
+
+static void epping_bench_debugfs_init(epping_context_t *pEpping_ctx)
+{
+	struct epping_bench *bench = &pEpping_ctx->bench;
+
+	bench->debugfs_dir = debugfs_create_dir(EPPING_BENCH_DEBUGFS_DIR,
+						NULL);
+	if (!bench->debugfs_dir) {
+		EPPING_LOG(CDF_TRACE_LEVEL_ERROR,
+			   "%s: failed to create debugfs dir", __func__);
+		return;
+	}
+	debugfs_create_file("config", S_IRUSR | S_IWUSR, bench->debugfs_dir,
+			    pEpping_ctx, &fops_epping_bench_config);
+	debugfs_create_file("control", S_IWUSR, bench->debugfs_dir,
+			    pEpping_ctx, &fops_epping_bench_control);
+	debugfs_create_file("results", S_IRUSR, bench->debugfs_dir,
+			    pEpping_ctx, &fops_epping_bench_results);
+}
+
+static void epping_bench_debugfs_deinit(epping_context_t *pEpping_ctx)
+{
+	debugfs_remove_recursive(pEpping_ctx->bench.debugfs_dir);
+	pEpping_ctx->bench.debugfs_dir = NULL;
+}
+#else
+static inline void epping_bench_debugfs_init(epping_context_t *pEpping_ctx)
+{
+}
+
+static inline void epping_bench_debugfs_deinit(epping_context_t *pEpping_ctx)
+{
+}
+#endif /* WLAN_OPEN_SOURCE */
+
+/**
+ * epping_bench_init() - set up benchmark state and debugfs entries
+ * @pEpping_ctx: epping context
+ *
+ * Return: none
+ */
+void epping_bench_init(epping_context_t *pEpping_ctx)
+{
+	struct epping_bench *bench = &pEpping_ctx->bench;
+
+	cdf_mem_zero(bench, sizeof(*bench));
+	epping_bench_default_cfg(&bench->cfg);
+	cdf_spinlock_init(&bench->lock);
+	cdf_softirq_timer_init(epping_get_cdf_ctx(), &bench->timer,
+			       epping_bench_timer_expire, pEpping_ctx,
+			       CDF_TIMER_TYPE_SW);
+	epping_bench_debugfs_init(pEpping_ctx);
+	bench->inited = true;
+}
+
+/**
+ * epping_bench_deinit() - stop any running benchmark and tear down
+ * @pEpping_ctx: epping context
+ *
+ * Return: none
+ */
+void epping_bench_deinit(epping_context_t *pEpping_ctx)
+{
+	struct epping_bench *bench = &pEpping_ctx->bench;
+
+	if (!bench->inited)
+		return;
+
+	epping_bench_stop(pEpping_ctx);
+	epping_bench_debugfs_deinit(pEpping_ctx);
+	cdf_softirq_timer_free(&bench->timer);
+	cdf_spinlock_destroy(&bench->lock);
+	bench->inited = false;
+}
@@ -120,6 +120,7 @@ void epping_disable(void)
 			   "%s: error: pEpping_ctx  = NULL", __func__);
 		return;
 	}
+	epping_bench_deinit(pEpping_ctx);
 	if (pEpping_ctx->epping_adapter) {
 		epping_destroy_adapter(pEpping_ctx->epping_adapter);
 		pEpping_ctx->epping_adapter = NULL;
@@ -292,6 +293,7 @@ int epping_enable(struct device *parent_dev)
 		epping_cookie_cleanup(pEpping_ctx);
 		goto error_end;
 	}
+	epping_bench_init(pEpping_ctx);
 
 	EPPING_LOG(CDF_TRACE_LEVEL_INFO_HIGH, "%s: Exit", __func__);
 	return ret;
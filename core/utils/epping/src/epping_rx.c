@@ -134,6 +134,9 @@ void epping_rx(void *ctx, HTC_PACKET *pPacket)
 		if (EPPING_ALIGNMENT_PAD > 0) {
 			A_NETBUF_PULL(pktSkb, EPPING_ALIGNMENT_PAD);
 		}
+		/* benchmark echoes are consumed here, not passed up */
+		if (epping_bench_rx(pEpping_ctx, eid, pktSkb))
+			return;
 		if (enb_rx_dump)
 			epping_hex_dump((void *)cdf_nbuf_data(pktSkb),
 					pktSkb->len, __func__);
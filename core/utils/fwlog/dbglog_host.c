@@ -48,6 +48,10 @@
 
 #define CLD_DEBUGFS_DIR          "cld"
 #define DEBUGFS_BLOCK_NAME       "dbglog_block"
+#define DEBUGFS_RING_NAME        "dbglog_ring"
+
+/* Bytes of DBGLOG_PROCESS_RING_RAW records kept, must be a power of 2 */
+#define DBGLOG_RING_SIZE         (256 * 1024)
 
 #define ATH_MODULE_NAME fwlog
 #include <a_debug.h>
@@ -85,1185 +89,7 @@ wmi_config_debug_module_cmd(wmi_unified_t wmi_handle, A_UINT32 param,
 			    A_UINT32 val, A_UINT32 *module_id_bitmap,
 			    A_UINT32 bitmap_len);
 
-const char *dbglog_get_module_str(A_UINT32 module_id)
-{
-	switch (module_id) {
-	case WLAN_MODULE_INF:
-		return "INF";
-	case WLAN_MODULE_WMI:
-		return "WMI";
-	case WLAN_MODULE_STA_PWRSAVE:
-		return "STA PS";
-	case WLAN_MODULE_WHAL:
-		return "WHAL";
-	case WLAN_MODULE_COEX:
-		return "COEX";
-	case WLAN_MODULE_ROAM:
-		return "ROAM";
-	case WLAN_MODULE_RESMGR_CHAN_MANAGER:
-		return "CHANMGR";
-	case WLAN_MODULE_RESMGR:
-		return "RESMGR";
-	case WLAN_MODULE_VDEV_MGR:
-		return "VDEV";
-	case WLAN_MODULE_SCAN:
-		return "SCAN";
-	case WLAN_MODULE_RATECTRL:
-		return "RC";
-	case WLAN_MODULE_AP_PWRSAVE:
-		return "AP PS";
-	case WLAN_MODULE_BLOCKACK:
-		return "BA";
-	case WLAN_MODULE_MGMT_TXRX:
-		return "MGMT";
-	case WLAN_MODULE_DATA_TXRX:
-		return "DATA";
-	case WLAN_MODULE_HTT:
-		return "HTT";
-	case WLAN_MODULE_HOST:
-		return "HOST";
-	case WLAN_MODULE_BEACON:
-		return "BEACON";
-	case WLAN_MODULE_OFFLOAD:
-		return "OFFLOAD";
-	case WLAN_MODULE_WAL:
-		return "WAL";
-	case WAL_MODULE_DE:
-		return "DE";
-	case WLAN_MODULE_PCIELP:
-		return "PCIELP";
-	case WLAN_MODULE_RTT:
-		return "RTT";
-	case WLAN_MODULE_DCS:
-		return "DCS";
-	case WLAN_MODULE_CACHEMGR:
-		return "CACHEMGR";
-	case WLAN_MODULE_ANI:
-		return "ANI";
-	case WLAN_MODULE_TEST:
-		return "TESTPOINT";
-	case WLAN_MODULE_STA_SMPS:
-		return "STA_SMPS";
-	case WLAN_MODULE_TDLS:
-		return "TDLS";
-	case WLAN_MODULE_P2P:
-		return "P2P";
-	case WLAN_MODULE_WOW:
-		return "WoW";
-	case WLAN_MODULE_IBSS_PWRSAVE:
-		return "IBSS PS";
-	case WLAN_MODULE_EXTSCAN:
-		return "ExtScan";
-	case WLAN_MODULE_UNIT_TEST:
-		return "UNIT_TEST";
-	case WLAN_MODULE_MLME:
-		return "MLME";
-	case WLAN_MODULE_SUPPL:
-		return "SUPPLICANT";
-	default:
-		return "UNKNOWN";
-	}
-}
-
-char *DBG_MSG_ARR[WLAN_MODULE_ID_MAX][MAX_DBG_MSGS] = {
-	{
-		"INF_MSG_START",
-		"INF_ASSERTION_FAILED",
-		"INF_TARGET_ID",
-		"INF_MSG_END"
-	},
-	{
-		"WMI_DBGID_DEFINITION_START",
-		"WMI_CMD_RX_XTND_PKT_TOO_SHORT",
-		"WMI_EXTENDED_CMD_NOT_HANDLED",
-		"WMI_CMD_RX_PKT_TOO_SHORT",
-		"WMI_CALLING_WMI_EXTENSION_FN",
-		"WMI_CMD_NOT_HANDLED",
-		"WMI_IN_SYNC",
-		"WMI_TARGET_WMI_SYNC_CMD",
-		"WMI_SET_SNR_THRESHOLD_PARAMS",
-		"WMI_SET_RSSI_THRESHOLD_PARAMS",
-		"WMI_SET_LQ_TRESHOLD_PARAMS",
-		"WMI_TARGET_CREATE_PSTREAM_CMD",
-		"WMI_WI_DTM_INUSE",
-		"WMI_TARGET_DELETE_PSTREAM_CMD",
-		"WMI_TARGET_IMPLICIT_DELETE_PSTREAM_CMD",
-		"WMI_TARGET_GET_BIT_RATE_CMD",
-		"WMI_GET_RATE_MASK_CMD_FIX_RATE_MASK_IS",
-		"WMI_TARGET_GET_AVAILABLE_CHANNELS_CMD",
-		"WMI_TARGET_GET_TX_PWR_CMD",
-		"WMI_FREE_EVBUF_WMIBUF",
-		"WMI_FREE_EVBUF_DATABUF",
-		"WMI_FREE_EVBUF_BADFLAG",
-		"WMI_HTC_RX_ERROR_DATA_PACKET",
-		"WMI_HTC_RX_SYNC_PAUSING_FOR_MBOX",
-		"WMI_INCORRECT_WMI_DATA_HDR_DROPPING_PKT",
-		"WMI_SENDING_READY_EVENT",
-		"WMI_SETPOWER_MDOE_TO_MAXPERF",
-		"WMI_SETPOWER_MDOE_TO_REC",
-		"WMI_BSSINFO_EVENT_FROM",
-		"WMI_TARGET_GET_STATS_CMD",
-		"WMI_SENDING_SCAN_COMPLETE_EVENT",
-		"WMI_SENDING_RSSI_INDB_THRESHOLD_EVENT ",
-		"WMI_SENDING_RSSI_INDBM_THRESHOLD_EVENT",
-		"WMI_SENDING_LINK_QUALITY_THRESHOLD_EVENT",
-		"WMI_SENDING_ERROR_REPORT_EVENT",
-		"WMI_SENDING_CAC_EVENT",
-		"WMI_TARGET_GET_ROAM_TABLE_CMD",
-		"WMI_TARGET_GET_ROAM_DATA_CMD",
-		"WMI_SENDING_GPIO_INTR_EVENT",
-		"WMI_SENDING_GPIO_ACK_EVENT",
-		"WMI_SENDING_GPIO_DATA_EVENT",
-		"WMI_CMD_RX",
-		"WMI_CMD_RX_XTND",
-		"WMI_EVENT_SEND",
-		"WMI_EVENT_SEND_XTND",
-		"WMI_CMD_PARAMS_DUMP_START",
-		"WMI_CMD_PARAMS_DUMP_END",
-		"WMI_CMD_PARAMS",
-		"WMI_EVENT_ALLOC_FAILURE",
-		"WMI_DBGID_DCS_PARAM_CMD",
-		"WMI_SEND_EVENT_WRONG_TLV",
-		"WMI_SEND_EVENT_NO_TLV_DEF",
-		"WMI_DBGID_DEFNITION_END",
-	},
-	{
-		"PS_STA_DEFINITION_START",
-		"PS_STA_PM_ARB_REQUEST",
-		"PS_STA_DELIVER_EVENT",
-		"PS_STA_PSPOLL_SEQ_DONE",
-		"PS_STA_COEX_MODE",
-		"PS_STA_PSPOLL_ALLOW",
-		"PS_STA_SET_PARAM",
-		"PS_STA_SPECPOLL_TIMER_STARTED",
-		"PS_STA_SPECPOLL_TIMER_STOPPED",
-	},
-	{
-		"WHAL_DBGID_DEFINITION_START",
-		"WHAL_ERROR_ANI_CONTROL",
-		"WHAL_ERROR_CHIP_TEST1",
-		"WHAL_ERROR_CHIP_TEST2",
-		"WHAL_ERROR_EEPROM_CHECKSUM",
-		"WHAL_ERROR_EEPROM_MACADDR",
-		"WHAL_ERROR_INTERRUPT_HIU",
-		"WHAL_ERROR_KEYCACHE_RESET",
-		"WHAL_ERROR_KEYCACHE_SET",
-		"WHAL_ERROR_KEYCACHE_TYPE",
-		"WHAL_ERROR_KEYCACHE_TKIPENTRY",
-		"WHAL_ERROR_KEYCACHE_WEPLENGTH",
-		"WHAL_ERROR_PHY_INVALID_CHANNEL",
-		"WHAL_ERROR_POWER_AWAKE",
-		"WHAL_ERROR_POWER_SET",
-		"WHAL_ERROR_RECV_STOPDMA",
-		"WHAL_ERROR_RECV_STOPPCU",
-		"WHAL_ERROR_RESET_CHANNF1",
-		"WHAL_ERROR_RESET_CHANNF2",
-		"WHAL_ERROR_RESET_PM",
-		"WHAL_ERROR_RESET_OFFSETCAL",
-		"WHAL_ERROR_RESET_RFGRANT",
-		"WHAL_ERROR_RESET_RXFRAME",
-		"WHAL_ERROR_RESET_STOPDMA",
-		"WHAL_ERROR_RESET_ERRID",
-		"WHAL_ERROR_RESET_ADCDCCAL1",
-		"WHAL_ERROR_RESET_ADCDCCAL2",
-		"WHAL_ERROR_RESET_TXIQCAL",
-		"WHAL_ERROR_RESET_RXIQCAL",
-		"WHAL_ERROR_RESET_CARRIERLEAK",
-		"WHAL_ERROR_XMIT_COMPUTE",
-		"WHAL_ERROR_XMIT_NOQUEUE",
-		"WHAL_ERROR_XMIT_ACTIVEQUEUE",
-		"WHAL_ERROR_XMIT_BADTYPE",
-		"WHAL_ERROR_XMIT_STOPDMA",
-		"WHAL_ERROR_INTERRUPT_BB_PANIC",
-		"WHAL_ERROR_PAPRD_MAXGAIN_ABOVE_WINDOW",
-		"WHAL_ERROR_QCU_HW_PAUSE_MISMATCH",
-		"WHAL_DBGID_DEFINITION_END",
-	},
-	{
-		"COEX_DEBUGID_START",
-		"BTCOEX_DBG_MCI_1",
-		"BTCOEX_DBG_MCI_2",
-		"BTCOEX_DBG_MCI_3",
-		"BTCOEX_DBG_MCI_4",
-		"BTCOEX_DBG_MCI_5",
-		"BTCOEX_DBG_MCI_6",
-		"BTCOEX_DBG_MCI_7",
-		"BTCOEX_DBG_MCI_8",
-		"BTCOEX_DBG_MCI_9",
-		"BTCOEX_DBG_MCI_10",
-		"COEX_WAL_BTCOEX_INIT",
-		"COEX_WAL_PAUSE",
-		"COEX_WAL_RESUME",
-		"COEX_UPDATE_AFH",
-		"COEX_HWQ_EMPTY_CB",
-		"COEX_MCI_TIMER_HANDLER",
-		"COEX_MCI_RECOVER",
-		"ERROR_COEX_MCI_ISR",
-		"ERROR_COEX_MCI_GPM",
-		"COEX_ProfileType",
-		"COEX_LinkID",
-		"COEX_LinkState",
-		"COEX_LinkRole",
-		"COEX_LinkRate",
-		"COEX_VoiceType",
-		"COEX_TInterval",
-		"COEX_WRetrx",
-		"COEX_Attempts",
-		"COEX_PerformanceState",
-		"COEX_LinkType",
-		"COEX_RX_MCI_GPM_VERSION_QUERY",
-		"COEX_RX_MCI_GPM_VERSION_RESPONSE",
-		"COEX_RX_MCI_GPM_STATUS_QUERY",
-		"COEX_STATE_WLAN_VDEV_DOWN",
-		"COEX_STATE_WLAN_VDEV_START",
-		"COEX_STATE_WLAN_VDEV_CONNECTED",
-		"COEX_STATE_WLAN_VDEV_SCAN_STARTED",
-		"COEX_STATE_WLAN_VDEV_SCAN_END",
-		"COEX_STATE_WLAN_DEFAULT",
-		"COEX_CHANNEL_CHANGE",
-		"COEX_POWER_CHANGE",
-		"COEX_CONFIG_MGR",
-		"COEX_TX_MCI_GPM_BT_CAL_REQ",
-		"COEX_TX_MCI_GPM_BT_CAL_GRANT",
-		"COEX_TX_MCI_GPM_BT_CAL_DONE",
-		"COEX_TX_MCI_GPM_WLAN_CAL_REQ",
-		"COEX_TX_MCI_GPM_WLAN_CAL_GRANT",
-		"COEX_TX_MCI_GPM_WLAN_CAL_DONE",
-		"COEX_TX_MCI_GPM_BT_DEBUG",
-		"COEX_TX_MCI_GPM_VERSION_QUERY",
-		"COEX_TX_MCI_GPM_VERSION_RESPONSE",
-		"COEX_TX_MCI_GPM_STATUS_QUERY",
-		"COEX_TX_MCI_GPM_HALT_BT_GPM",
-		"COEX_TX_MCI_GPM_WLAN_CHANNELS",
-		"COEX_TX_MCI_GPM_BT_PROFILE_INFO",
-		"COEX_TX_MCI_GPM_BT_STATUS_UPDATE",
-		"COEX_TX_MCI_GPM_BT_UPDATE_FLAGS",
-		"COEX_TX_MCI_GPM_UNKNOWN",
-		"COEX_TX_MCI_SYS_WAKING",
-		"COEX_TX_MCI_LNA_TAKE",
-		"COEX_TX_MCI_LNA_TRANS",
-		"COEX_TX_MCI_SYS_SLEEPING",
-		"COEX_TX_MCI_REQ_WAKE",
-		"COEX_TX_MCI_REMOTE_RESET",
-		"COEX_TX_MCI_TYPE_UNKNOWN",
-		"COEX_WHAL_MCI_RESET",
-		"COEX_POLL_BT_CAL_DONE_TIMEOUT",
-		"COEX_WHAL_PAUSE",
-		"COEX_RX_MCI_GPM_BT_CAL_REQ",
-		"COEX_RX_MCI_GPM_BT_CAL_DONE",
-		"COEX_RX_MCI_GPM_BT_CAL_GRANT",
-		"COEX_WLAN_CAL_START",
-		"COEX_WLAN_CAL_RESULT",
-		"COEX_BtMciState",
-		"COEX_BtCalState",
-		"COEX_WlanCalState",
-		"COEX_RxReqWakeCount",
-		"COEX_RxRemoteResetCount",
-		"COEX_RESTART_CAL",
-		"COEX_SENDMSG_QUEUE",
-		"COEX_RESETSEQ_LNAINFO_TIMEOUT",
-		"COEX_MCI_ISR_IntRaw",
-		"COEX_MCI_ISR_Int1Raw",
-		"COEX_MCI_ISR_RxMsgRaw",
-		"COEX_WHAL_COEX_RESET",
-		"COEX_WAL_COEX_INIT",
-		"COEX_TXRX_CNT_LIMIT_ISR",
-		"COEX_CH_BUSY",
-		"COEX_REASSESS_WLAN_STATE",
-		"COEX_BTCOEX_WLAN_STATE_UPDATE",
-		"COEX_BT_NUM_OF_PROFILES",
-		"COEX_BT_NUM_OF_HID_PROFILES",
-		"COEX_BT_NUM_OF_ACL_PROFILES",
-		"COEX_BT_NUM_OF_HI_ACL_PROFILES",
-		"COEX_BT_NUM_OF_VOICE_PROFILES",
-		"COEX_WLAN_AGGR_LIMIT",
-		"COEX_BT_LOW_PRIO_BUDGET",
-		"COEX_BT_HI_PRIO_BUDGET",
-		"COEX_BT_IDLE_TIME",
-		"COEX_SET_COEX_WEIGHT",
-		"COEX_WLAN_WEIGHT_GROUP",
-		"COEX_BT_WEIGHT_GROUP",
-		"COEX_BT_INTERVAL_ALLOC",
-		"COEX_BT_SCHEME",
-		"COEX_BT_MGR",
-		"COEX_BT_SM_ERROR",
-		"COEX_SYSTEM_UPDATE",
-		"COEX_LOW_PRIO_LIMIT",
-		"COEX_HI_PRIO_LIMIT",
-		"COEX_BT_INTERVAL_START",
-		"COEX_WLAN_INTERVAL_START",
-		"COEX_NON_LINK_BUDGET",
-		"COEX_CONTENTION_MSG",
-		"COEX_SET_NSS",
-		"COEX_SELF_GEN_MASK",
-		"COEX_PROFILE_ERROR",
-		"COEX_WLAN_INIT",
-		"COEX_BEACON_MISS",
-		"COEX_BEACON_OK",
-		"COEX_BTCOEX_SCAN_ACTIVITY",
-		"COEX_SCAN_ACTIVITY",
-		"COEX_FORCE_QUIETTIME",
-		"COEX_BT_MGR_QUIETTIME",
-		"COEX_BT_INACTIVITY_TRIGGER",
-		"COEX_BT_INACTIVITY_REPORTED",
-		"COEX_TX_MCI_GPM_WLAN_PRIO",
-		"COEX_TX_MCI_GPM_BT_PAUSE_PROFILE",
-		"COEX_TX_MCI_GPM_WLAN_SET_ACL_INACTIVITY",
-		"COEX_RX_MCI_GPM_BT_ACL_INACTIVITY_REPORT",
-		"COEX_GENERIC_ERROR",
-		"COEX_RX_RATE_THRESHOLD",
-		"COEX_RSSI",
-		"COEX_WLAN_VDEV_NOTIF_START", /*                 133 */
-		"COEX_WLAN_VDEV_NOTIF_UP", /*                    134 */
-		"COEX_WLAN_VDEV_NOTIF_DOWN", /*                135 */
-		"COEX_WLAN_VDEV_NOTIF_STOP", /*               136 */
-		"COEX_WLAN_VDEV_NOTIF_ADD_PEER", /*           137 */
-		"COEX_WLAN_VDEV_NOTIF_DELETE_PEER", /*          138 */
-		"COEX_WLAN_VDEV_NOTIF_CONNECTED_PEER", /*       139 */
-		"COEX_WLAN_VDEV_NOTIF_PAUSE", /*               140 */
-		"COEX_WLAN_VDEV_NOTIF_UNPAUSED", /*           141 */
-		"COEX_STATE_WLAN_VDEV_PEER_ADD", /*           142 */
-		"COEX_STATE_WLAN_VDEV_CONNECTED_PEER", /*     143 */
-		"COEX_STATE_WLAN_VDEV_DELETE_PEER", /*          144 */
-		"COEX_STATE_WLAN_VDEV_PAUSE", /*                145 */
-		"COEX_STATE_WLAN_VDEV_UNPAUSED", /*           146 */
-		"COEX_SCAN_CALLBACK", /*               147 */
-		"COEX_RC_SET_CHAINMASK", /*            148 */
-		"COEX_TX_MCI_GPM_WLAN_SET_BT_RXSS_THRES", /*    149 */
-		"COEX_TX_MCI_GPM_BT_RXSS_THRES_QUERY", /*    150 */
-		"COEX_BT_RXSS_THRES", /*               151 */
-		"COEX_BT_PROFILE_ADD_RMV", /*          152 */
-		"COEX_BT_SCHED_INFO", /*               153 */
-		"COEX_TRF_MGMT", /*                    154 */
-		"COEX_SCHED_START", /*                 155 */
-		"COEX_SCHED_RESULT", /*                156 */
-		"COEX_SCHED_ERROR", /*                      157 */
-		"COEX_SCHED_PRE_OP", /*                     158 */
-		"COEX_SCHED_POST_OP", /*                    159 */
-		"COEX_RX_RATE", /*                          160 */
-		"COEX_ACK_PRIORITY", /*                     161 */
-		"COEX_STATE_WLAN_VDEV_UP", /*               162 */
-		"COEX_STATE_WLAN_VDEV_PEER_UPDATE", /*      163 */
-		"COEX_STATE_WLAN_VDEV_STOP", /*             164 */
-		"COEX_WLAN_PAUSE_PEER", /*                  165 */
-		"COEX_WLAN_UNPAUSE_PEER", /*                166 */
-		"COEX_WLAN_PAUSE_INTERVAL_START", /*        167 */
-		"COEX_WLAN_POSTPAUSE_INTERVAL_START", /*    168 */
-		"COEX_TRF_FREERUN", /*                      169 */
-		"COEX_TRF_SHAPE_PM", /*                     170 */
-		"COEX_TRF_SHAPE_PSP", /*                    171 */
-		"COEX_TRF_SHAPE_S_CTS", /*                  172 */
-		"COEX_CHAIN_CONFIG", /*                   173 */
-		"COEX_SYSTEM_MONITOR", /*                 174 */
-		"COEX_SINGLECHAIN_INIT", /*               175 */
-		"COEX_MULTICHAIN_INIT", /*                176 */
-		"COEX_SINGLECHAIN_DBG_1", /*              177 */
-		"COEX_SINGLECHAIN_DBG_2", /*              178 */
-		"COEX_SINGLECHAIN_DBG_3", /*              179 */
-		"COEX_MULTICHAIN_DBG_1", /*               180 */
-		"COEX_MULTICHAIN_DBG_2", /*               181 */
-		"COEX_MULTICHAIN_DBG_3", /*               182 */
-		"COEX_PSP_TX_CB", /*                       183 */
-		"COEX_PSP_RX_CB", /*                       184 */
-		"COEX_PSP_STAT_1", /*                       185 */
-		"COEX_PSP_SPEC_POLL", /*                       186 */
-		"COEX_PSP_READY_STATE", /*                       187 */
-		"COEX_PSP_TX_STATUS_STATE", /*               188 */
-		"COEX_PSP_RX_STATUS_STATE_1", /*               189 */
-		"COEX_PSP_NOT_READY_STATE", /*               190 */
-		"COEX_PSP_DISABLED_STATE", /*               191 */
-		"COEX_PSP_ENABLED_STATE", /*               192 */
-		"COEX_PSP_SEND_PSPOLL", /*                       193 */
-		"COEX_PSP_MGR_ENTER", /*                       194 */
-		"COEX_PSP_MGR_RESULT", /*                       195 */
-		"COEX_PSP_NONWLAN_INTERVAL", /*               196 */
-		"COEX_PSP_STAT_2", /*                       197 */
-		"COEX_PSP_RX_STATUS_STATE_2", /*               198 */
-		"COEX_PSP_ERROR", /*                       199 */
-		"COEX_T2BT",    /*                               200 */
-		"COEX_BT_DURATION", /*                           201 */
-		"COEX_TX_MCI_GPM_WLAN_SCHED_INFO_TRIG", /*       202 */
-		"COEX_TX_MCI_GPM_WLAN_SCHED_INFO_TRIG_RSP", /*   203 */
-		"COEX_TX_MCI_GPM_SCAN_OP", /*                   204 */
-		"COEX_TX_MCI_GPM_BT_PAUSE_GPM_TX", /*       205 */
-		"COEX_CTS2S_SEND", /*                       206 */
-		"COEX_CTS2S_RESULT", /*                       207 */
-		"COEX_ENTER_OCS", /*                       208 */
-		"COEX_EXIT_OCS", /*                       209 */
-		"COEX_UPDATE_OCS", /*                       210 */
-		"COEX_STATUS_OCS", /*                       211 */
-		"COEX_STATS_BT", /*                       212 */
-		"COEX_MWS_WLAN_INIT",
-		"COEX_MWS_WBTMR_SYNC",
-		"COEX_MWS_TYPE2_RX",
-		"COEX_MWS_TYPE2_TX",
-		"COEX_MWS_WLAN_CHAVD",
-		"COEX_MWS_WLAN_CHAVD_INSERT",
-		"COEX_MWS_WLAN_CHAVD_MERGE",
-		"COEX_MWS_WLAN_CHAVD_RPT",
-		"COEX_MWS_CP_MSG_SEND",
-		"COEX_MWS_CP_ESCAPE",
-		"COEX_MWS_CP_UNFRAME",
-		"COEX_MWS_CP_SYNC_UPDATE",
-		"COEX_MWS_CP_SYNC",
-		"COEX_MWS_CP_WLAN_STATE_IND",
-		"COEX_MWS_CP_SYNCRESP_TIMEOUT",
-		"COEX_MWS_SCHEME_UPDATE",
-		"COEX_MWS_WLAN_EVENT",
-		"COEX_MWS_UART_UNESCAPE",
-		"COEX_MWS_UART_ENCODE_SEND",
-		"COEX_MWS_UART_RECV_DECODE",
-		"COEX_MWS_UL_HDL",
-		"COEX_MWS_REMOTE_EVENT",
-		"COEX_MWS_OTHER",
-		"COEX_MWS_ERROR",
-		"COEX_MWS_ANT_DIVERSITY", /* 237 */
-		"COEX_P2P_GO",
-		"COEX_P2P_CLIENT",
-		"COEX_SCC_1",
-		"COEX_SCC_2",
-		"COEX_MCC_1",
-		"COEX_MCC_2",
-		"COEX_TRF_SHAPE_NOA",
-		"COEX_NOA_ONESHOT",
-		"COEX_NOA_PERIODIC",
-		"COEX_LE_1",
-		"COEX_LE_2",
-		"COEX_ANT_1",
-		"COEX_ANT_2",
-		"COEX_ENTER_NOA",
-		"COEX_EXIT_NOA",
-		"COEX_BT_SCAN_PROTECT", /* 253 */
-		"COEX_DEBUG_ID_END" /* 254 */
-	},
-	{
-		"ROAM_DBGID_DEFINITION_START",
-		"ROAM_MODULE_INIT",
-		"ROAM_DEV_START",
-		"ROAM_CONFIG_RSSI_THRESH",
-		"ROAM_CONFIG_SCAN_PERIOD",
-		"ROAM_CONFIG_AP_PROFILE",
-		"ROAM_CONFIG_CHAN_LIST",
-		"ROAM_CONFIG_SCAN_PARAMS",
-		"ROAM_CONFIG_RSSI_CHANGE",
-		"ROAM_SCAN_TIMER_START",
-		"ROAM_SCAN_TIMER_EXPIRE",
-		"ROAM_SCAN_TIMER_STOP",
-		"ROAM_SCAN_STARTED",
-		"ROAM_SCAN_COMPLETE",
-		"ROAM_SCAN_CANCELLED",
-		"ROAM_CANDIDATE_FOUND",
-		"ROAM_RSSI_ACTIVE_SCAN",
-		"ROAM_RSSI_ACTIVE_ROAM",
-		"ROAM_RSSI_GOOD",
-		"ROAM_BMISS_FIRST_RECV",
-		"ROAM_DEV_STOP",
-		"ROAM_FW_OFFLOAD_ENABLE",
-		"ROAM_CANDIDATE_SSID_MATCH",
-		"ROAM_CANDIDATE_SECURITY_MATCH",
-		"ROAM_LOW_RSSI_INTERRUPT",
-		"ROAM_HIGH_RSSI_INTERRUPT",
-		"ROAM_SCAN_REQUESTED",
-		"ROAM_BETTER_CANDIDATE_FOUND",
-		"ROAM_BETTER_AP_EVENT",
-		"ROAM_CANCEL_LOW_PRIO_SCAN",
-		"ROAM_FINAL_BMISS_RECVD",
-		"ROAM_CONFIG_SCAN_MODE",
-		"ROAM_BMISS_FINAL_SCAN_ENABLE",
-		"ROAM_SUITABLE_AP_EVENT",
-		"ROAM_RSN_IE_PARSE_ERROR",
-		"ROAM_WPA_IE_PARSE_ERROR",
-		"ROAM_SCAN_CMD_FROM_HOST",
-		"ROAM_HO_SORT_CANDIDATE",
-		"ROAM_HO_SAVE_CANDIDATE",
-		"ROAM_HO_GET_CANDIDATE",
-		"ROAM_HO_OFFLOAD_SET_PARAM",
-		"ROAM_HO_SM",
-		"ROAM_HO_HTT_SAVED",
-		"ROAM_HO_SYNC_START",
-		"ROAM_HO_START",
-		"ROAM_HO_COMPLETE",
-		"ROAM_HO_STOP",
-		"ROAM_HO_HTT_FORWARD",
-		"ROAM_DBGID_DEFINITION_END"
-	},
-	{
-		"RESMGR_CHMGR_DEFINITION_START",
-		"RESMGR_CHMGR_PAUSE_COMPLETE",
-		"RESMGR_CHMGR_CHANNEL_CHANGE",
-		"RESMGR_CHMGR_RESUME_COMPLETE",
-		"RESMGR_CHMGR_VDEV_PAUSE",
-		"RESMGR_CHMGR_VDEV_UNPAUSE",
-		"RESMGR_CHMGR_CTS2S_TX_COMP",
-		"RESMGR_CHMGR_CFEND_TX_COMP",
-		"RESMGR_CHMGR_DEFINITION_END"
-	},
-	{
-		"RESMGR_DEFINITION_START",
-		"RESMGR_OCS_ALLOCRAM_SIZE",
-		"RESMGR_OCS_RESOURCES",
-		"RESMGR_LINK_CREATE",
-		"RESMGR_LINK_DELETE",
-		"RESMGR_OCS_CHREQ_CREATE",
-		"RESMGR_OCS_CHREQ_DELETE",
-		"RESMGR_OCS_CHREQ_START",
-		"RESMGR_OCS_CHREQ_STOP",
-		"RESMGR_OCS_SCHEDULER_INVOKED",
-		"RESMGR_OCS_CHREQ_GRANT",
-		"RESMGR_OCS_CHREQ_COMPLETE",
-		"RESMGR_OCS_NEXT_TSFTIME",
-		"RESMGR_OCS_TSF_TIMEOUT_US",
-		"RESMGR_OCS_CURR_CAT_WINDOW",
-		"RESMGR_OCS_CURR_CAT_WINDOW_REQ",
-		"RESMGR_OCS_CURR_CAT_WINDOW_TIMESLOT",
-		"RESMGR_OCS_CHREQ_RESTART",
-		"RESMGR_OCS_CLEANUP_CH_ALLOCATORS",
-		"RESMGR_OCS_PURGE_CHREQ",
-		"RESMGR_OCS_CH_ALLOCATOR_FREE",
-		"RESMGR_OCS_RECOMPUTE_SCHEDULE",
-		"RESMGR_OCS_NEW_CAT_WINDOW_REQ",
-		"RESMGR_OCS_NEW_CAT_WINDOW_TIMESLOT",
-		"RESMGR_OCS_CUR_CH_ALLOC",
-		"RESMGR_OCS_WIN_CH_ALLOC",
-		"RESMGR_OCS_SCHED_CH_CHANGE",
-		"RESMGR_OCS_CONSTRUCT_CAT_WIN",
-		"RESMGR_OCS_CHREQ_PREEMPTED",
-		"RESMGR_OCS_CH_SWITCH_REQ",
-		"RESMGR_OCS_CHANNEL_SWITCHED",
-		"RESMGR_OCS_CLEANUP_STALE_REQS",
-		"RESMGR_OCS_CHREQ_UPDATE",
-		"RESMGR_OCS_REG_NOA_NOTIF",
-		"RESMGR_OCS_DEREG_NOA_NOTIF",
-		"RESMGR_OCS_GEN_PERIODIC_NOA",
-		"RESMGR_OCS_RECAL_QUOTAS",
-		"RESMGR_OCS_GRANTED_QUOTA_STATS",
-		"RESMGR_OCS_ALLOCATED_QUOTA_STATS",
-		"RESMGR_OCS_REQ_QUOTA_STATS",
-		"RESMGR_OCS_TRACKING_TIME_FIRED",
-		"RESMGR_VC_ARBITRATE_ATTRIBUTES",
-		"RESMGR_OCS_LATENCY_STRICT_TIME_SLOT",
-		"RESMGR_OCS_CURR_TSF",
-		"RESMGR_OCS_QUOTA_REM",
-		"RESMGR_OCS_LATENCY_CASE_NO",
-		"RESMGR_OCS_WIN_CAT_DUR",
-		"RESMGR_VC_UPDATE_CUR_VC",
-		"RESMGR_VC_REG_UNREG_LINK",
-		"RESMGR_VC_PRINT_LINK",
-		"RESMGR_OCS_MISS_TOLERANCE",
-		"RESMGR_DYN_SCH_ALLOCRAM_SIZE",
-		"RESMGR_DYN_SCH_ENABLE",
-		"RESMGR_DYN_SCH_ACTIVE",
-		"RESMGR_DYN_SCH_CH_STATS_START",
-		"RESMGR_DYN_SCH_CH_SX_STATS",
-		"RESMGR_DYN_SCH_TOT_UTIL_PER",
-		"RESMGR_DYN_SCH_HOME_CH_QUOTA",
-		"RESMGR_OCS_REG_RECAL_QUOTA_NOTIF",
-		"RESMGR_OCS_DEREG_RECAL_QUOTA_NOTIF",
-		"RESMGR_DEFINITION_END"
-	},
-	{
-		"VDEV_MGR_DEBID_DEFINITION_START", /* vdev Mgr */
-		"VDEV_MGR_FIRST_BEACON_MISS_DETECTED",
-		"VDEV_MGR_FINAL_BEACON_MISS_DETECTED",
-		"VDEV_MGR_BEACON_IN_SYNC",
-		"VDEV_MGR_AP_KEEPALIVE_IDLE",
-		"VDEV_MGR_AP_KEEPALIVE_INACTIVE",
-		"VDEV_MGR_AP_KEEPALIVE_UNRESPONSIVE",
-		"VDEV_MGR_AP_TBTT_CONFIG",
-		"VDEV_MGR_FIRST_BCN_RECEIVED",
-		"VDEV_MGR_VDEV_START",
-		"VDEV_MGR_VDEV_UP",
-		"VDEV_MGR_PEER_AUTHORIZED",
-		"VDEV_MGR_OCS_HP_LP_REQ_POSTED",
-		"VDEV_MGR_VDEV_START_OCS_HP_REQ_COMPLETE",
-		"VDEV_MGR_VDEV_START_OCS_HP_REQ_STOP",
-		"VDEV_MGR_HP_START_TIME",
-		"VDEV_MGR_VDEV_PAUSE_DELAY_UPDATE",
-		"VDEV_MGR_VDEV_PAUSE_FAIL",
-		"VDEV_MGR_GEN_PERIODIC_NOA",
-		"VDEV_MGR_OFF_CHAN_GO_CH_REQ_SETUP",
-		"VDEV_MGR_DEFINITION_END",
-	},
-	{
-		"SCAN_START_COMMAND_FAILED", /* scan */
-		"SCAN_STOP_COMMAND_FAILED",
-		"SCAN_EVENT_SEND_FAILED",
-		"SCAN_ENGINE_START",
-		"SCAN_ENGINE_CANCEL_COMMAND",
-		"SCAN_ENGINE_STOP_DUE_TO_TIMEOUT",
-		"SCAN_EVENT_SEND_TO_HOST",
-		"SCAN_FWLOG_EVENT_ADD",
-		"SCAN_FWLOG_EVENT_REM",
-		"SCAN_FWLOG_EVENT_PREEMPTED",
-		"SCAN_FWLOG_EVENT_RESTARTED",
-		"SCAN_FWLOG_EVENT_COMPLETED",
-	},
-	{
-		"RATECTRL_DBGID_DEFINITION_START", /* Rate ctrl */
-		"RATECTRL_DBGID_ASSOC",
-		"RATECTRL_DBGID_NSS_CHANGE",
-		"RATECTRL_DBGID_CHAINMASK_ERR",
-		"RATECTRL_DBGID_UNEXPECTED_FRAME",
-		"RATECTRL_DBGID_WAL_RCQUERY",
-		"RATECTRL_DBGID_WAL_RCUPDATE",
-		"RATECTRL_DBGID_GTX_UPDATE",
-		"RATECTRL_DBGID_DEFINITION_END"
-	},
-	{
-		"AP_PS_DBGID_DEFINITION_START",
-		"AP_PS_DBGID_UPDATE_TIM",
-		"AP_PS_DBGID_PEER_STATE_CHANGE",
-		"AP_PS_DBGID_PSPOLL",
-		"AP_PS_DBGID_PEER_CREATE",
-		"AP_PS_DBGID_PEER_DELETE",
-		"AP_PS_DBGID_VDEV_CREATE",
-		"AP_PS_DBGID_VDEV_DELETE",
-		"AP_PS_DBGID_SYNC_TIM",
-		"AP_PS_DBGID_NEXT_RESPONSE",
-		"AP_PS_DBGID_START_SP",
-		"AP_PS_DBGID_COMPLETED_EOSP",
-		"AP_PS_DBGID_TRIGGER",
-		"AP_PS_DBGID_DUPLICATE_TRIGGER",
-		"AP_PS_DBGID_UAPSD_RESPONSE",
-		"AP_PS_DBGID_SEND_COMPLETE",
-		"AP_PS_DBGID_SEND_N_COMPLETE",
-		"AP_PS_DBGID_DETECT_OUT_OF_SYNC_STA",
-		"AP_PS_DBGID_DELIVER_CAB",
-	},
-	{
-		""              /* Block Ack */
-	},
-	/* Mgmt TxRx */
-	{
-		"MGMT_TXRX_DBGID_DEFINITION_START",
-		"MGMT_TXRX_FORWARD_TO_HOST",
-		"MGMT_TXRX_DBGID_DEFINITION_END",
-	},
-	{                       /* Data TxRx */
-		"DATA_TXRX_DBGID_DEFINITION_START",
-		"DATA_TXRX_DBGID_RX_DATA_SEQ_LEN_INFO",
-		"DATA_TXRX_DBGID_DEFINITION_END",
-	},
-	{""                     /* HTT */
-	},
-	{""                     /* HOST */
-	},
-	{""                     /* BEACON */
-	 "BEACON_EVENT_SWBA_SEND_FAILED",
-	 "BEACON_EVENT_EARLY_RX_BMISS_STATUS",
-	 "BEACON_EVENT_EARLY_RX_SLEEP_SLOP",
-	 "BEACON_EVENT_EARLY_RX_CONT_BMISS_TIMEOUT",
-	 "BEACON_EVENT_EARLY_RX_PAUSE_SKIP_BCN_NUM",
-	 "BEACON_EVENT_EARLY_RX_CLK_DRIFT",
-	 "BEACON_EVENT_EARLY_RX_AP_DRIFT",
-	 "BEACON_EVENT_EARLY_RX_BCN_TYPE",},
-	{                       /* Offload Mgr */
-		"OFFLOAD_MGR_DBGID_DEFINITION_START",
-		"OFFLOADMGR_REGISTER_OFFLOAD",
-		"OFFLOADMGR_DEREGISTER_OFFLOAD",
-		"OFFLOADMGR_NO_REG_DATA_HANDLERS",
-		"OFFLOADMGR_NO_REG_EVENT_HANDLERS",
-		"OFFLOADMGR_REG_OFFLOAD_FAILED",
-		"OFFLOADMGR_DBGID_DEFINITION_END",
-	},
-	{
-		"WAL_DBGID_DEFINITION_START",
-		"WAL_DBGID_FAST_WAKE_REQUEST",
-		"WAL_DBGID_FAST_WAKE_RELEASE",
-		"WAL_DBGID_SET_POWER_STATE",
-		"WAL_DBGID_MISSING",
-		"WAL_DBGID_CHANNEL_CHANGE_FORCE_RESET",
-		"WAL_DBGID_CHANNEL_CHANGE",
-		"WAL_DBGID_VDEV_START",
-		"WAL_DBGID_VDEV_STOP",
-		"WAL_DBGID_VDEV_UP",
-		"WAL_DBGID_VDEV_DOWN",
-		"WAL_DBGID_SW_WDOG_RESET",
-		"WAL_DBGID_TX_SCH_REGISTER_TIDQ",
-		"WAL_DBGID_TX_SCH_UNREGISTER_TIDQ",
-		"WAL_DBGID_TX_SCH_TICKLE_TIDQ",
-		"WAL_DBGID_XCESS_FAILURES",
-		"WAL_DBGID_AST_ADD_WDS_ENTRY",
-		"WAL_DBGID_AST_DEL_WDS_ENTRY",
-		"WAL_DBGID_AST_WDS_ENTRY_PEER_CHG",
-		"WAL_DBGID_AST_WDS_SRC_LEARN_FAIL",
-		"WAL_DBGID_STA_KICKOUT",
-		"WAL_DBGID_BAR_TX_FAIL",
-		"WAL_DBGID_BAR_ALLOC_FAIL",
-		"WAL_DBGID_LOCAL_DATA_TX_FAIL",
-		"WAL_DBGID_SECURITY_PM4_QUEUED",
-		"WAL_DBGID_SECURITY_GM1_QUEUED",
-		"WAL_DBGID_SECURITY_PM4_SENT",
-		"WAL_DBGID_SECURITY_ALLOW_DATA",
-		"WAL_DBGID_SECURITY_UCAST_KEY_SET",
-		"WAL_DBGID_SECURITY_MCAST_KEY_SET",
-		"WAL_DBGID_SECURITY_ENCR_EN",
-		"WAL_DBGID_BB_WDOG_TRIGGERED",
-		"WAL_DBGID_RX_LOCAL_BUFS_LWM",
-		"WAL_DBGID_RX_LOCAL_DROP_LARGE_MGMT",
-		"WAL_DBGID_VHT_ILLEGAL_RATE_PHY_ERR_DETECTED",
-		"WAL_DBGID_DEV_RESET",
-		"WAL_DBGID_TX_BA_SETUP",
-		"WAL_DBGID_RX_BA_SETUP",
-		"WAL_DBGID_DEV_TX_TIMEOUT",
-		"WAL_DBGID_DEV_RX_TIMEOUT",
-		"WAL_DBGID_STA_VDEV_XRETRY",
-		"WAL_DBGID_DCS",
-		"WAL_DBGID_MGMT_TX_FAIL",
-		"WAL_DBGID_SET_M4_SENT_MANUALLY",
-		"WAL_DBGID_PROCESS_4_WAY_HANDSHAKE",
-		"WAL_DBGID_WAL_CHANNEL_CHANGE_START",
-		"WAL_DBGID_WAL_CHANNEL_CHANGE_COMPLETE",
-		"WAL_DBGID_WHAL_CHANNEL_CHANGE_START",
-		"WAL_DBGID_WHAL_CHANNEL_CHANGE_COMPLETE",
-		"WAL_DBGID_TX_MGMT_DESCID_SEQ_TYPE_LEN",
-		"WAL_DBGID_TX_DATA_MSDUID_SEQ_TYPE_LEN",
-		"WAL_DBGID_TX_DISCARD",
-		"WAL_DBGID_TX_MGMT_COMP_DESCID_STATUS",
-		"WAL_DBGID_TX_DATA_COMP_MSDUID_STATUS",
-		"WAL_DBGID_RESET_PCU_CYCLE_CNT",
-		"WAL_DBGID_SETUP_RSSI_INTERRUPTS",
-		"WAL_DBGID_BRSSI_CONFIG",
-		"WAL_DBGID_CURRENT_BRSSI_AVE",
-		"WAL_DBGID_BCN_TX_COMP",
-		"WAL_DBGID_SET_HW_CHAINMASK",
-		"WAL_DBGID_SET_HW_CHAINMASK_TXRX_STOP_FAIL",
-		"WAL_DBGID_GET_HW_CHAINMASK",
-		"WAL_DBGID_SMPS_DISABLE",
-		"WAL_DBGID_SMPS_ENABLE_HW_CNTRL",
-		"WAL_DBGID_SMPS_SWSEL_CHAINMASK",
-		"WAL_DBGID_DEFINITION_END",
-	},
-	{
-		""              /* DE */
-	},
-	{
-		""              /* pcie lp */
-	},
-	{
-		/* RTT */
-		"RTT_CALL_FLOW",
-		"RTT_REQ_SUB_TYPE",
-		"RTT_MEAS_REQ_HEAD",
-		"RTT_MEAS_REQ_BODY",
-		"",
-		"",
-		"RTT_INIT_GLOBAL_STATE",
-		"",
-		"RTT_REPORT",
-		"",
-		"RTT_ERROR_REPORT",
-		"RTT_TIMER_STOP",
-		"RTT_SEND_TM_FRAME",
-		"RTT_V3_RESP_CNT",
-		"RTT_V3_RESP_FINISH",
-		"RTT_CHANNEL_SWITCH_REQ",
-		"RTT_CHANNEL_SWITCH_GRANT",
-		"RTT_CHANNEL_SWITCH_COMPLETE",
-		"RTT_CHANNEL_SWITCH_PREEMPT",
-		"RTT_CHANNEL_SWITCH_STOP",
-		"RTT_TIMER_START",
-	},
-	{                       /* RESOURCE */
-		"RESOURCE_DBGID_DEFINITION_START",
-		"RESOURCE_PEER_ALLOC",
-		"RESOURCE_PEER_FREE",
-		"RESOURCE_PEER_ALLOC_WAL_PEER",
-		"RESOURCE_PEER_NBRHOOD_MGMT_ALLOC",
-		"RESOURCE_PEER_NBRHOOD_MGMT_INFO," "RESOURCE_DBGID_DEFINITION_END",
-	},
-	{                       /* DCS */
-		"WLAN_DCS_DBGID_INIT",
-		"WLAN_DCS_DBGID_WMI_CWINT",
-		"WLAN_DCS_DBGID_TIMER",
-		"WLAN_DCS_DBGID_CMDG",
-		"WLAN_DCS_DBGID_CMDS",
-		"WLAN_DCS_DBGID_DINIT"
-	},
-	{                       /* CACHEMGR  */
-		""
-	},
-	{                       /* ANI  */
-		"ANI_DBGID_POLL",
-		"ANI_DBGID_CONTROL",
-		"ANI_DBGID_OFDM_PARAMS",
-		"ANI_DBGID_CCK_PARAMS",
-		"ANI_DBGID_RESET",
-		"ANI_DBGID_RESTART",
-		"ANI_DBGID_OFDM_LEVEL",
-		"ANI_DBGID_CCK_LEVEL",
-		"ANI_DBGID_FIRSTEP",
-		"ANI_DBGID_CYCPWR",
-		"ANI_DBGID_MRC_CCK",
-		"ANI_DBGID_SELF_CORR_LOW",
-		"ANI_DBGID_ENABLE",
-		"ANI_DBGID_CURRENT_LEVEL",
-		"ANI_DBGID_POLL_PERIOD",
-		"ANI_DBGID_LISTEN_PERIOD",
-		"ANI_DBGID_OFDM_LEVEL_CFG",
-		"ANI_DBGID_CCK_LEVEL_CFG"
-	},
-	{
-		"P2P_DBGID_DEFINITION_START",
-		"P2P_DEV_REGISTER",
-		"P2P_HANDLE_NOA",
-		"P2P_UPDATE_SCHEDULE_OPPS",
-		"P2P_UPDATE_SCHEDULE",
-		"P2P_UPDATE_START_TIME",
-		"P2P_UPDATE_START_TIME_DIFF_TSF32",
-		"P2P_UPDATE_START_TIME_FINAL",
-		"P2P_SETUP_SCHEDULE_TIMER",
-		"P2P_PROCESS_SCHEDULE_AFTER_CALC",
-		"P2P_PROCESS_SCHEDULE_STARTED_TIMER",
-		"P2P_CALC_SCHEDULES_FIRST_CALL_ALL_NEXT_EVENT",
-		"P2P_CALC_SCHEDULES_FIRST_VALUE",
-		"P2P_CALC_SCHEDULES_EARLIEST_NEXT_EVENT",
-		"P2P_CALC_SCHEDULES_SANITY_COUNT",
-		"P2P_CALC_SCHEDULES_CALL_ALL_NEXT_EVENT_FROM_WHILE_LOOP",
-		"P2P_CALC_SCHEDULES_TIMEOUT_1",
-		"P2P_CALC_SCHEDULES_TIMEOUT_2",
-		"P2P_FIND_ALL_NEXT_EVENTS_REQ_EXPIRED",
-		"P2P_FIND_ALL_NEXT_EVENTS_REQ_ACTIVE",
-		"P2P_FIND_NEXT_EVENT_REQ_NOT_STARTED",
-		"P2P_FIND_NEXT_EVENT_REQ_COMPLETE_NON_PERIODIC",
-		"P2P_FIND_NEXT_EVENT_IN_MID_OF_NOA",
-		"P2P_FIND_NEXT_EVENT_REQ_COMPLETE",
-		"P2P_SCHEDULE_TIMEOUT",
-		"P2P_CALC_SCHEDULES_ENTER",
-		"P2P_PROCESS_SCHEDULE_ENTER",
-		"P2P_FIND_ALL_NEXT_EVENTS_INDIVIDUAL_REQ_AFTER_CHANGE",
-		"P2P_FIND_ALL_NEXT_EVENTS_INDIVIDUAL_REQ_BEFORE_CHANGE",
-		"P2P_FIND_ALL_NEXT_EVENTS_ENTER",
-		"P2P_FIND_NEXT_EVENT_ENTER",
-		"P2P_NOA_GO_PRESENT",
-		"P2P_NOA_GO_ABSENT",
-		"P2P_GO_NOA_NOTIF",
-		"P2P_GO_TBTT_OFFSET",
-		"P2P_GO_GET_NOA_INFO",
-		"P2P_GO_ADD_ONE_SHOT_NOA",
-		"P2P_GO_GET_NOA_IE",
-		"P2P_GO_BCN_TX_COMP",
-		"P2P_DBGID_DEFINITION_END",
-	},
-	{
-		"CSA_DBGID_DEFINITION_START",
-		"CSA_OFFLOAD_POOL_INIT",
-		"CSA_OFFLOAD_REGISTER_VDEV",
-		"CSA_OFFLOAD_DEREGISTER_VDEV",
-		"CSA_DEREGISTER_VDEV_ERROR",
-		"CSA_OFFLOAD_BEACON_RECEIVED",
-		"CSA_OFFLOAD_BEACON_CSA_RECV",
-		"CSA_OFFLOAD_CSA_RECV_ERROR_IE",
-		"CSA_OFFLOAD_CSA_TIMER_ERROR",
-		"CSA_OFFLOAD_CSA_TIMER_EXP",
-		"CSA_OFFLOAD_WMI_EVENT_ERROR",
-		"CSA_OFFLOAD_WMI_EVENT_SENT",
-		"CSA_OFFLOAD_WMI_CHANSWITCH_RECV",
-		"CSA_DBGID_DEFINITION_END",
-	},
-	{                       /* NLO offload */
-		""
-	},
-	{
-		"WLAN_CHATTER_DBGID_DEFINITION_START",
-		"WLAN_CHATTER_ENTER",
-		"WLAN_CHATTER_EXIT",
-		"WLAN_CHATTER_FILTER_HIT",
-		"WLAN_CHATTER_FILTER_MISS",
-		"WLAN_CHATTER_FILTER_FULL",
-		"WLAN_CHATTER_FILTER_TM_ADJ",
-		"WLAN_CHATTER_BUFFER_FULL",
-		"WLAN_CHATTER_TIMEOUT",
-		"WLAN_CHATTER_DBGID_DEFINITION_END",
-	},
-	{
-		"WOW_DBGID_DEFINITION_START",
-		"WOW_ENABLE_CMDID",
-		"WOW_RECV_DATA_PKT",
-		"WOW_WAKE_HOST_DATA",
-		"WOW_RECV_MGMT",
-		"WOW_WAKE_HOST_MGMT",
-		"WOW_RECV_EVENT",
-		"WOW_WAKE_HOST_EVENT",
-		"WOW_INIT",
-		"WOW_RECV_MAGIC_PKT",
-		"WOW_RECV_BITMAP_PATTERN",
-		"WOW_AP_VDEV_DISALLOW",
-		"WOW_STA_VDEV_DISALLOW",
-		"WOW_P2PGO_VDEV_DISALLOW",
-		"WOW_NS_OFLD_ENABLE",
-		"WOW_ARP_OFLD_ENABLE",
-		"WOW_NS_ARP_OFLD_DISABLE",
-		"WOW_NS_RECEIVED",
-		"WOW_NS_REPLIED",
-		"WOW_ARP_RECEIVED",
-		"WOW_ARP_REPLIED",
-		"WOW_DBGID_DEFINITION_END",
-	},
-	{                       /* WAL VDEV  */
-		""
-	},
-	{                       /* WAL PDEV  */
-		""
-	},
-	{                       /* TEST  */
-		"TP_CHANGE_CHANNEL",
-		"TP_LOCAL_SEND",
-	},
-	{                       /* STA SMPS  */
-		"STA_SMPS_DBGID_DEFINITION_START",
-		"STA_SMPS_DBGID_CREATE_PDEV_INSTANCE",
-		"STA_SMPS_DBGID_CREATE_VIRTUAL_CHAN_INSTANCE",
-		"STA_SMPS_DBGID_DELETE_VIRTUAL_CHAN_INSTANCE",
-		"STA_SMPS_DBGID_CREATE_STA_INSTANCE",
-		"STA_SMPS_DBGID_DELETE_STA_INSTANCE",
-		"STA_SMPS_DBGID_VIRTUAL_CHAN_SMPS_START",
-		"STA_SMPS_DBGID_VIRTUAL_CHAN_SMPS_STOP",
-		"STA_SMPS_DBGID_SEND_SMPS_ACTION_FRAME",
-		"STA_SMPS_DBGID_HOST_FORCED_MODE",
-		"STA_SMPS_DBGID_FW_FORCED_MODE",
-		"STA_SMPS_DBGID_RSSI_THRESHOLD_CROSSED",
-		"STA_SMPS_DBGID_SMPS_ACTION_FRAME_COMPLETION",
-		"STA_SMPS_DBGID_DTIM_EBT_EVENT_CHMASK_UPDATE",
-		"STA_SMPS_DBGID_DTIM_CHMASK_UPDATE",
-		"STA_SMPS_DBGID_DTIM_BEACON_EVENT_CHMASK_UPDATE",
-		"STA_SMPS_DBGID_DTIM_POWER_STATE_CHANGE",
-		"STA_SMPS_DBGID_DTIM_CHMASK_UPDATE_SLEEP",
-		"STA_SMPS_DBGID_DTIM_CHMASK_UPDATE_AWAKE",
-		"SMPS_DBGID_DEFINITION_END",
-	},
-	{                       /* SWBMISS */
-		"SWBMISS_DBGID_DEFINITION_START",
-		"SWBMISS_ENABLED",
-		"SWBMISS_DISABLED",
-		"SWBMISS_DBGID_DEFINITION_END",
-	},
-	{                       /* WMMAC */
-		""
-	},
-	{                       /* TDLS */
-		"TDLS_DBGID_DEFINITION_START",
-		"TDLS_DBGID_VDEV_CREATE",
-		"TDLS_DBGID_VDEV_DELETE",
-		"TDLS_DBGID_ENABLED_PASSIVE",
-		"TDLS_DBGID_ENABLED_ACTIVE",
-		"TDLS_DBGID_DISABLED",
-		"TDLS_DBGID_CONNTRACK_TIMER",
-		"TDLS_DBGID_WAL_SET",
-		"TDLS_DBGID_WAL_GET",
-		"TDLS_DBGID_WAL_PEER_UPDATE_SET",
-		"TDLS_DBGID_WAL_PEER_UPDATE_EVT",
-		"TDLS_DBGID_WAL_VDEV_CREATE",
-		"TDLS_DBGID_WAL_VDEV_DELETE",
-		"TDLS_DBGID_WLAN_EVENT",
-		"TDLS_DBGID_WLAN_PEER_UPDATE_SET",
-		"TDLS_DBGID_PEER_EVT_DRP_THRESH",
-		"TDLS_DBGID_PEER_EVT_DRP_RATE",
-		"TDLS_DBGID_PEER_EVT_DRP_RSSI",
-		"TDLS_DBGID_PEER_EVT_DISCOVER",
-		"TDLS_DBGID_PEER_EVT_DELETE",
-		"TDLS_DBGID_PEER_CAP_UPDATE",
-		"TDLS_DBGID_UAPSD_SEND_PTI_FRAME",
-		"TDLS_DBGID_UAPSD_SEND_PTI_FRAME2PEER",
-		"TDLS_DBGID_UAPSD_START_PTR_TIMER",
-		"TDLS_DBGID_UAPSD_CANCEL_PTR_TIMER",
-		"TDLS_DBGID_UAPSD_PTR_TIMER_TIMEOUT",
-		"TDLS_DBGID_UAPSD_STA_PS_EVENT_HANDLER",
-		"TDLS_DBGID_UAPSD_PEER_EVENT_HANDLER",
-		"TDLS_DBGID_UAPSD_PS_DEFAULT_SETTINGS",
-		"TDLS_DBGID_UAPSD_GENERIC",
-	},
-	{                       /* HB */
-		"WLAN_HB_DBGID_DEFINITION_START",
-		"WLAN_HB_DBGID_INIT",
-		"WLAN_HB_DBGID_TCP_GET_TXBUF_FAIL",
-		"WLAN_HB_DBGID_TCP_SEND_FAIL",
-		"WLAN_HB_DBGID_BSS_PEER_NULL",
-		"WLAN_HB_DBGID_UDP_GET_TXBUF_FAIL",
-		"WLAN_HB_DBGID_UDP_SEND_FAIL",
-		"WLAN_HB_DBGID_WMI_CMD_INVALID_PARAM",
-		"WLAN_HB_DBGID_WMI_CMD_INVALID_OP",
-		"WLAN_HB_DBGID_WOW_NOT_ENTERED",
-		"WLAN_HB_DBGID_ALLOC_SESS_FAIL",
-		"WLAN_HB_DBGID_CTX_NULL",
-		"WLAN_HB_DBGID_CHKSUM_ERR",
-		"WLAN_HB_DBGID_UDP_TX",
-		"WLAN_HB_DBGID_TCP_TX",
-		"WLAN_HB_DBGID_DEFINITION_END",
-	},
-	{                       /* TXBF */
-		"TXBFEE_DBGID_START",
-		"TXBFEE_DBGID_NDPA_RECEIVED",
-		"TXBFEE_DBGID_HOST_CONFIG_TXBFEE_TYPE",
-		"TXBFER_DBGID_SEND_NDPA",
-		"TXBFER_DBGID_GET_NDPA_BUF_FAIL",
-		"TXBFER_DBGID_SEND_NDPA_FAIL",
-		"TXBFER_DBGID_GET_NDP_BUF_FAIL",
-		"TXBFER_DBGID_SEND_NDP_FAIL",
-		"TXBFER_DBGID_GET_BRPOLL_BUF_FAIL",
-		"TXBFER_DBGID_SEND_BRPOLL_FAIL",
-		"TXBFER_DBGID_HOST_CONFIG_CMDID",
-		"TXBFEE_DBGID_HOST_CONFIG_CMDID",
-		"TXBFEE_DBGID_ENABLED_ENABLED_UPLOAD_H",
-		"TXBFEE_DBGID_UPLOADH_CV_TAG",
-		"TXBFEE_DBGID_UPLOADH_H_TAG",
-		"TXBFEE_DBGID_CAPTUREH_RECEIVED",
-		"TXBFEE_DBGID_PACKET_IS_STEERED",
-		"TXBFEE_UPLOADH_EVENT_ALLOC_MEM_FAIL",
-		"TXBFEE_DBGID_END",
-	},
-	{                       /*BATCH SCAN */
-	},
-	{                       /*THERMAL MGR */
-		"THERMAL_MGR_DBGID_DEFINITION_START",
-		"THERMAL_MGR_NEW_THRESH",
-		"THERMAL_MGR_THRESH_CROSSED",
-		"THERMAL_MGR_DBGID_DEFINITION END",
-	},
-	{                       /* WLAN_MODULE_PHYERR_DFS */
-		""
-	},
-	{
-		/* WLAN_MODULE_RMC */
-		"RMC_DBGID_DEFINITION_START",
-		"RMC_CREATE_INSTANCE",
-		"RMC_DELETE_INSTANCE",
-		"RMC_LDR_SEL",
-		"RMC_NO_LDR",
-		"RMC_LDR_NOT_SEL",
-		"RMC_LDR_INF_SENT",
-		"RMC_PEER_ADD",
-		"RMC_PEER_DELETE",
-		"RMC_PEER_UNKNOWN",
-		"RMC_SET_MODE",
-		"RMC_SET_ACTION_PERIOD",
-		"RMC_ACRION_FRAME_RX",
-		"RMC_DBGID_DEFINITION_END",
-	},
-	{
-		/* WLAN_MODULE_STATS */
-		"WLAN_STATS_DBGID_DEFINITION_START",
-		"WLAN_STATS_DBGID_EST_LINKSPEED_VDEV_EN_DIS",
-		"WLAN_STATS_DBGID_EST_LINKSPEED_CHAN_TIME_START",
-		"WLAN_STATS_DBGID_EST_LINKSPEED_CHAN_TIME_END",
-		"WLAN_STATS_DBGID_EST_LINKSPEED_CALC",
-		"WLAN_STATS_DBGID_EST_LINKSPEED_UPDATE_HOME_CHAN",
-		"WLAN_STATS_DBGID_DEFINITION_END",
-	},
-	{
-		/* WLAN_MODULE_NAN */
-	},
-	{
-		/* WLAN_MODULE_IBSS_PWRSAVE */
-		"IBSS_PS_DBGID_DEFINITION_START",
-		"IBSS_PS_DBGID_PEER_CREATE",
-		"IBSS_PS_DBGID_PEER_DELETE",
-		"IBSS_PS_DBGID_VDEV_CREATE",
-		"IBSS_PS_DBGID_VDEV_DELETE",
-		"IBSS_PS_DBGID_VDEV_EVENT",
-		"IBSS_PS_DBGID_PEER_EVENT",
-		"IBSS_PS_DBGID_DELIVER_CAB",
-		"IBSS_PS_DBGID_DELIVER_UC_DATA",
-		"IBSS_PS_DBGID_DELIVER_UC_DATA_ERROR",
-		"IBSS_PS_DBGID_UC_INACTIVITY_TMR_RESTART",
-		"IBSS_PS_DBGID_MC_INACTIVITY_TMR_RESTART",
-		"IBSS_PS_DBGID_NULL_TX_COMPLETION",
-		"IBSS_PS_DBGID_ATIM_TIMER_START",
-		"IBSS_PS_DBGID_UC_ATIM_SEND",
-		"IBSS_PS_DBGID_BC_ATIM_SEND",
-		"IBSS_PS_DBGID_UC_TIMEOUT",
-		"IBSS_PS_DBGID_PWR_COLLAPSE_ALLOWED",
-		"IBSS_PS_DBGID_PWR_COLLAPSE_NOT_ALLOWED",
-		"IBSS_PS_DBGID_SET_PARAM",
-		"IBSS_PS_DBGID_HOST_TX_PAUSE",
-		"IBSS_PS_DBGID_HOST_TX_UNPAUSE",
-		"IBSS_PS_DBGID_PS_DESC_BIN_HWM",
-		"IBSS_PS_DBGID_PS_DESC_BIN_LWM",
-		"IBSS_PS_DBGID_PS_KICKOUT_PEER",
-		"IBSS_PS_DBGID_SET_PEER_PARAM",
-		"IBSS_PS_DBGID_BCN_ATIM_WIN_MISMATCH",
-		"IBSS_PS_DBGID_RX_CHAINMASK_CHANGE",
-	},
-	{
-		/* HIF UART Interface DBGIDs */
-		"HIF_UART_DBGID_START",
-		"HIF_UART_DBGID_POWER_STATE",
-		"HIF_UART_DBGID_TXRX_FLOW",
-		"HIF_UART_DBGID_TXRX_CTRL_CHAR",
-		"HIF_UART_DBGID_TXRX_BUF_DUMP",
-	},
-	{
-		/* LPI */
-		""
-	},
-	{
-		/* EXTSCAN DBGIDs */
-		"EXTSCAN_START",
-		"EXTSCAN_STOP",
-		"EXTSCAN_CLEAR_ENTRY_CONTENT",
-		"EXTSCAN_GET_FREE_ENTRY_SUCCESS",
-		"EXTSCAN_GET_FREE_ENTRY_INCONSISTENT",
-		"EXTSCAN_GET_FREE_ENTRY_NO_MORE_ENTRIES",
-		"EXTSCAN_CREATE_ENTRY_SUCCESS",
-		"EXTSCAN_CREATE_ENTRY_ERROR",
-		"EXTSCAN_SEARCH_SCAN_ENTRY_QUEUE",
-		"EXTSCAN_SEARCH_SCAN_ENTRY_KEY_FOUND",
-		"EXTSCAN_SEARCH_SCAN_ENTRY_KEY_NOT_FOUND",
-		"EXTSCAN_ADD_ENTRY",
-		"EXTSCAN_BUCKET_SEND_OPERATION_EVENT",
-		"EXTSCAN_BUCKET_SEND_OPERATION_EVENT_FAILED",
-		"EXTSCAN_BUCKET_START_SCAN_CYCLE",
-		"EXTSCAN_BUCKET_PERIODIC_TIMER",
-		"EXTSCAN_SEND_START_STOP_EVENT",
-		"EXTSCAN_NOTIFY_WLAN_CHANGE",
-		"EXTSCAN_NOTIFY_WLAN_HOTLIST_MATCH",
-		"EXTSCAN_MAIN_RECEIVED_FRAME",
-		"EXTSCAN_MAIN_NO_SSID_IE",
-		"EXTSCAN_MAIN_MALFORMED_FRAME",
-		"EXTSCAN_FIND_BSSID_BY_REFERENCE",
-		"EXTSCAN_FIND_BSSID_BY_REFERENCE_ERROR",
-		"EXTSCAN_NOTIFY_TABLE_USAGE",
-		"EXTSCAN_FOUND_RSSI_ENTRY",
-		"EXTSCAN_BSSID_FOUND_RSSI_SAMPLE",
-		"EXTSCAN_BSSID_ADDED_RSSI_SAMPLE",
-		"EXTSCAN_BSSID_REPLACED_RSSI_SAMPLE",
-		"EXTSCAN_BSSID_TRANSFER_CURRENT_SAMPLES",
-		"EXTSCAN_BUCKET_PROCESS_SCAN_EVENT",
-		"EXTSCAN_BUCKET_CANNOT_FIND_BUCKET",
-		"EXTSCAN_START_SCAN_REQUEST_FAILED",
-		"EXTSCAN_BUCKET_STOP_CURRENT_SCANS",
-		"EXTSCAN_BUCKET_SCAN_STOP_REQUEST",
-		"EXTSCAN_BUCKET_PERIODIC_TIMER_ERROR",
-		"EXTSCAN_BUCKET_START_OPERATION",
-		"EXTSCAN_START_INTERNAL_ERROR",
-		"EXTSCAN_NOTIFY_HOTLIST_MATCH",
-		"EXTSCAN_CONFIG_HOTLIST_TABLE",
-		"EXTSCAN_CONFIG_WLAN_CHANGE_TABLE",
-	},
-	{                       /* UNIT_TEST */
-		"UNIT_TEST_GEN",
-	},
-	{                       /* MLME */
-		"MLME_DEBUG_CMN",
-		"MLME_IF",
-		"MLME_AUTH",
-		"MLME_REASSOC",
-		"MLME_DEAUTH",
-		"MLME_DISASSOC",
-		"MLME_ROAM",
-		"MLME_RETRY",
-		"MLME_TIMER",
-		"MLME_FRMPARSE",
-	},
-	{                       /*SUPPLICANT */
-		"SUPPL_INIT",
-		"SUPPL_RECV_EAPOL",
-		"SUPPL_RECV_EAPOL_TIMEOUT",
-		"SUPPL_SEND_EAPOL",
-		"SUPPL_MIC_MISMATCH",
-		"SUPPL_FINISH",
-	},
-};
+#include "dbglog_tables.h"
 
 int dbglog_module_log_enable(wmi_unified_t wmi_handle, A_UINT32 mod_id,
 			     bool isenable)
@@ -1659,6 +485,129 @@ dbglog_debugfs_raw_data(wmi_unified_t wmi_handle, const uint8_t *buf,
 
 	return true;
 }
+
+static void dbglog_ring_copy_in(struct fwdebug *fwlog, uint32_t pos,
+				const void *src, uint32_t len)
+{
+	uint32_t off = pos & (DBGLOG_RING_SIZE - 1);
+	uint32_t first = min_t(uint32_t, len, DBGLOG_RING_SIZE - off);
+
+	memcpy(fwlog->ring + off, src, first);
+	memcpy(fwlog->ring, (const uint8_t *)src + first, len - first);
+}
+
+static void dbglog_ring_copy_out(struct fwdebug *fwlog, uint32_t pos,
+				 void *dst, uint32_t len)
+{
+	uint32_t off = pos & (DBGLOG_RING_SIZE - 1);
+	uint32_t first = min_t(uint32_t, len, DBGLOG_RING_SIZE - off);
+
+	memcpy(dst, fwlog->ring + off, first);
+	memcpy((uint8_t *)dst + first, fwlog->ring, len - first);
+}
+
+/**
+ * dbglog_ring_write() - append a raw debug log event to the binary ring
+ * @wmi_handle: wmi handle
+ * @buf: WMI_DEBUG_MESG_EVENTID payload after the dropped count
+ * @length: length of @buf in bytes
+ * @dropped: number of buffers dropped by the firmware
+ *
+ * In DBGLOG_PROCESS_RING_RAW mode the event is copied unparsed into a
+ * preallocated byte ring, so nothing is allocated or formatted on the
+ * WMI event path. When the reader falls behind the oldest records are
+ * overwritten, as the dbglog_block queue does, and accounted for in the
+ * dropped field of the next record.
+ *
+ * Return: 0 on success, -ENODEV if the ring is not available
+ */
+static int
+dbglog_ring_write(wmi_unified_t wmi_handle, const uint8_t *buf,
+		  A_UINT32 length, A_UINT32 dropped)
+{
+	static const uint8_t pad[3];
+	struct fwdebug *fwlog = &wmi_handle->dbglog;
+	struct dbglog_slot slot, old;
+	uint32_t rec_len = DBGLOG_RING_REC_LEN(length);
+	uint32_t head;
+
+	if (rec_len > DBGLOG_RING_SIZE)
+		return -ENODEV;
+
+	slot.diag_type = (A_UINT32) DIAG_TYPE_FW_DEBUG_MSG;
+	slot.timestamp = cpu_to_le32(jiffies);
+	slot.length = cpu_to_le32(length);
+
+	spin_lock_bh(&fwlog->ring_lock);
+
+	if (!fwlog->ring) {
+		spin_unlock_bh(&fwlog->ring_lock);
+		return -ENODEV;
+	}
+
+	while (DBGLOG_RING_SIZE - (fwlog->ring_head - fwlog->ring_tail) <
+	       rec_len) {
+		dbglog_ring_copy_out(fwlog, fwlog->ring_tail, &old,
+				     sizeof(old));
+		fwlog->ring_tail +=
+			DBGLOG_RING_REC_LEN(le32_to_cpu(old.length));
+		fwlog->ring_lost++;
+	}
+
+	slot.dropped = cpu_to_le32(dropped + fwlog->ring_lost);
+	fwlog->ring_lost = 0;
+
+	head = fwlog->ring_head;
+	dbglog_ring_copy_in(fwlog, head, &slot, sizeof(slot));
+	head += sizeof(slot);
+	dbglog_ring_copy_in(fwlog, head, buf, length);
+	head += length;
+	dbglog_ring_copy_in(fwlog, head, pad, rec_len - sizeof(slot) - length);
+	fwlog->ring_head += rec_len;
+
+	spin_unlock_bh(&fwlog->ring_lock);
+
+	wake_up_interruptible(&fwlog->ring_wq);
+
+	return 0;
+}
+
+static int dbglog_ring_alloc(wmi_unified_t wmi_handle)
+{
+	struct fwdebug *fwlog = &wmi_handle->dbglog;
+	uint8_t *ring;
+
+	if (fwlog->ring)
+		return 0;
+
+	ring = vmalloc(DBGLOG_RING_SIZE);
+	if (!ring)
+		return -ENOMEM;
+
+	spin_lock_bh(&fwlog->ring_lock);
+	fwlog->ring_head = 0;
+	fwlog->ring_tail = 0;
+	fwlog->ring_lost = 0;
+	fwlog->ring = ring;
+	spin_unlock_bh(&fwlog->ring_lock);
+
+	return 0;
+}
+
+static void dbglog_ring_free(wmi_unified_t wmi_handle)
+{
+	struct fwdebug *fwlog = &wmi_handle->dbglog;
+	uint8_t *ring;
+
+	spin_lock_bh(&fwlog->ring_lock);
+	ring = fwlog->ring;
+	fwlog->ring = NULL;
+	fwlog->ring_head = 0;
+	fwlog->ring_tail = 0;
+	spin_unlock_bh(&fwlog->ring_lock);
+
+	vfree(ring);
+}
 #endif /* WLAN_OPEN_SOURCE */
 
 /*
@@ -2014,6 +963,11 @@ int dbglog_parse_debug_logs(ol_scn_t scn, uint8_t *data, uint32_t datalen)
 					       (A_UINT8 *) buffer, len,
 					       dropped);
 	}
+
+	if (dbglog_process_type == DBGLOG_PROCESS_RING_RAW) {
+		return dbglog_ring_write((wmi_unified_t) wma->wmi_handle,
+					 (A_UINT8 *) buffer, len, dropped);
+	}
 #endif /* WLAN_OPEN_SOURCE */
 
 	while ((count + 2) < length) {
@@ -4091,6 +3045,102 @@ static const struct file_operations fops_dbglog_block = {
 	.llseek = default_llseek,
 };
 
+static int dbglog_ring_open(struct inode *inode, struct file *file)
+{
+	struct fwdebug *fwlog = inode->i_private;
+
+	if (test_and_set_bit(0, &fwlog->ring_open))
+		return -EBUSY;
+
+	file->private_data = inode->i_private;
+	return 0;
+}
+
+static int dbglog_ring_release(struct inode *inode, struct file *file)
+{
+	struct fwdebug *fwlog = inode->i_private;
+
+	clear_bit(0, &fwlog->ring_open);
+
+	return 0;
+}
+
+/*
+ * Returns as many whole records as fit in the user buffer, blocking
+ * until at least one is available. The buffer must be able to hold
+ * DBGLOG_RING_REC_LEN() of the largest event.
+ */
+static ssize_t dbglog_ring_read(struct file *file,
+				char __user *user_buf,
+				size_t count, loff_t *ppos)
+{
+	struct fwdebug *fwlog = file->private_data;
+	struct dbglog_slot slot;
+	uint32_t tail, rec_len;
+	size_t len = 0;
+	ssize_t ret_cnt;
+	char *buf;
+	int ret;
+
+	count = min_t(size_t, count, DBGLOG_RING_SIZE);
+
+	buf = vmalloc(count);
+	if (!buf)
+		return -ENOMEM;
+
+	ret = wait_event_interruptible(fwlog->ring_wq,
+				       fwlog->ring_head != fwlog->ring_tail);
+	if (ret) {
+		vfree(buf);
+		return ret;
+	}
+
+	spin_lock_bh(&fwlog->ring_lock);
+
+	tail = fwlog->ring_tail;
+	while (fwlog->ring && tail != fwlog->ring_head) {
+		dbglog_ring_copy_out(fwlog, tail, &slot, sizeof(slot));
+		rec_len = DBGLOG_RING_REC_LEN(le32_to_cpu(slot.length));
+		if (rec_len > count - len)
+			break;
+
+		dbglog_ring_copy_out(fwlog, tail, buf + len, rec_len);
+		len += rec_len;
+		tail += rec_len;
+	}
+	if (fwlog->ring)
+		fwlog->ring_tail = tail;
+
+	spin_unlock_bh(&fwlog->ring_lock);
+
+	if (len == 0) {
+		ret_cnt = -EINVAL;
+		goto out;
+	}
+
+	if (copy_to_user(user_buf, buf, len)) {
+		ret_cnt = -EFAULT;
+		goto out;
+	}
+
+	*ppos = *ppos + len;
+
+	ret_cnt = len;
+
+out:
+	vfree(buf);
+
+	return ret_cnt;
+}
+
+static const struct file_operations fops_dbglog_ring = {
+	.open = dbglog_ring_open,
+	.release = dbglog_ring_release,
+	.read = dbglog_ring_read,
+	.owner = THIS_MODULE,
+	.llseek = no_llseek,
+};
+
 int dbglog_debugfs_init(wmi_unified_t wmi_handle)
 {
 
@@ -4102,6 +3152,10 @@ int dbglog_debugfs_init(wmi_unified_t wmi_handle)
 			    wmi_handle->debugfs_phy, &wmi_handle->dbglog,
 			    &fops_dbglog_block);
 
+	debugfs_create_file(DEBUGFS_RING_NAME, S_IRUSR,
+			    wmi_handle->debugfs_phy, &wmi_handle->dbglog,
+			    &fops_dbglog_ring);
+
 	return true;
 }
 
@@ -4375,6 +3429,19 @@ int dbglog_parser_type_init(wmi_unified_t wmi_handle, int type)
 		return A_ERROR;
 	}
 
+	if (type == DBGLOG_PROCESS_RING_RAW) {
+#ifdef WLAN_OPEN_SOURCE
+		if (dbglog_ring_alloc(wmi_handle)) {
+			AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+					("%s: ring allocation failed\n",
+					 __func__));
+			return A_ERROR;
+		}
+#else
+		return A_ERROR;
+#endif /* WLAN_OPEN_SOURCE */
+	}
+
 	dbglog_process_type = type;
 	gprint_limiter = false;
 
@@ -4433,6 +3500,13 @@ int dbglog_init(wmi_unified_t wmi_handle)
 	skb_queue_head_init(&wmi_handle->dbglog.fwlog_queue);
 	init_completion(&wmi_handle->dbglog.fwlog_completion);
 
+	/* Initialize the binary ring, allocated when the mode is selected */
+	spin_lock_init(&wmi_handle->dbglog.ring_lock);
+	init_waitqueue_head(&wmi_handle->dbglog.ring_wq);
+	if (dbglog_process_type == DBGLOG_PROCESS_RING_RAW &&
+	    dbglog_ring_alloc(wmi_handle))
+		dbglog_process_type = DBGLOG_PROCESS_NET_RAW;
+
 	/* Initialize debugfs */
 	dbglog_debugfs_init(wmi_handle);
 #endif /* WLAN_OPEN_SOURCE */
@@ -4451,6 +3525,7 @@ int dbglog_deinit(wmi_unified_t wmi_handle)
 
 	/* Deinitialize the debugfs */
 	dbglog_debugfs_remove(wmi_handle);
+	dbglog_ring_free(wmi_handle);
 #endif /* WLAN_OPEN_SOURCE */
 
 	res =
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2015 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Userspace decoder for DBGLOG_PROCESS_RING_RAW firmware debug logs.
+ *
+ * Reads the record stream of the cld/dbglog_ring debugfs file, or a file
+ * captured from it, and prints one line per firmware debug message using
+ * the module and message tables of the in-kernel decoder.
+ *
+ * Build from the top of the driver tree:
+ *   cc -o dbglog_ring_decode -Iuapi/linux -Itarget/inc \
+ *      core/utils/fwlog/tools/dbglog_ring_decode.c
+ *
+ * Usage: dbglog_ring_decode [file]
+ */
+
+#include <endian.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define __packed __attribute__((packed))
+
+#include "a_types.h"
+#include "dbglog_common.h"
+#include "../dbglog_tables.h"
+
+#define DBGLOG_RING_DEFAULT_PATH "/sys/kernel/debug/cld/dbglog_ring"
+#define DBGLOG_DECODE_BUF_SIZE   (64 * 1024)
+
+static const char *dbglog_msg_str(A_UINT32 moduleid, A_UINT32 debugid)
+{
+	if (moduleid < WLAN_MODULE_ID_MAX && debugid < MAX_DBG_MSGS &&
+	    DBG_MSG_ARR[moduleid][debugid] &&
+	    DBG_MSG_ARR[moduleid][debugid][0] != '\0')
+		return DBG_MSG_ARR[moduleid][debugid];
+
+	return NULL;
+}
+
+/* Same walk as dbglog_parse_debug_logs() in the driver */
+static void dbglog_decode_payload(const A_UINT32 *buffer, A_UINT32 length)
+{
+	A_UINT32 count = 0, timestamp, debugid, moduleid, i;
+	A_UINT16 vapid, numargs;
+	const char *msg;
+
+	while ((count + 2) < length) {
+		timestamp = DBGLOG_GET_TIME_STAMP(le32toh(buffer[count]));
+		debugid = DBGLOG_GET_DBGID(le32toh(buffer[count + 1]));
+		moduleid = DBGLOG_GET_MODULEID(le32toh(buffer[count + 1]));
+		vapid = DBGLOG_GET_VDEVID(le32toh(buffer[count + 1]));
+		numargs = DBGLOG_GET_NUMARGS(le32toh(buffer[count + 1]));
+
+		if ((count + 2 + numargs) > length)
+			return;
+
+		if (moduleid >= WLAN_MODULE_ID_MAX)
+			return;
+
+		printf(DBGLOG_PRINT_PREFIX "[%u] ", timestamp);
+		if (vapid < DBGLOG_MAX_VDEVID)
+			printf("vap-%u ", vapid);
+
+		msg = dbglog_msg_str(moduleid, debugid);
+		if (msg)
+			printf("%s %s ( ", dbglog_get_module_str(moduleid),
+			       msg);
+		else
+			printf("%s UNKNOWN %u:%u ( ",
+			       dbglog_get_module_str(moduleid), moduleid,
+			       debugid);
+
+		for (i = 0; i < numargs; i++)
+			printf("%#x%s", le32toh(buffer[count + 2 + i]),
+			       (i + 1) < numargs ? ", " : "");
+		printf(" )\n");
+
+		count += numargs + 2;   /* 32 bit Time stamp + 32 bit Dbg header */
+	}
+}
+
+/* Decode all complete records in buf, return the bytes consumed */
+static size_t dbglog_decode_records(const uint8_t *buf, size_t len)
+{
+	const struct dbglog_slot *slot;
+	A_UINT32 payload_len, dropped;
+	size_t off = 0, rec_len;
+
+	while (len - off >= sizeof(*slot)) {
+		slot = (const struct dbglog_slot *)(buf + off);
+		payload_len = le32toh(slot->length);
+		rec_len = DBGLOG_RING_REC_LEN(payload_len);
+		if (len - off < rec_len)
+			break;
+
+		dropped = le32toh(slot->dropped);
+		if (dropped)
+			printf(DBGLOG_PRINT_PREFIX "%u log buffers dropped\n",
+			       dropped);
+
+		dbglog_decode_payload((const A_UINT32 *)slot->payload,
+				      payload_len >> 2);
+		off += rec_len;
+	}
+
+	return off;
+}
+
+int main(int argc, char **argv)
+{
+	static uint8_t buf[DBGLOG_DECODE_BUF_SIZE];
+	const char *path = argc > 1 ? argv[1] : DBGLOG_RING_DEFAULT_PATH;
+	size_t len = 0, used;
+	ssize_t ret;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		fprintf(stderr, "%s: %s\n", path, strerror(errno));
+		return 1;
+	}
+
+	for (;;) {
+		ret = read(fd, buf + len, sizeof(buf) - len);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			fprintf(stderr, "%s: %s\n", path, strerror(errno));
+			break;
+		}
+		if (ret == 0)
+			break;
+
+		len += ret;
+		used = dbglog_decode_records(buf, len);
+		memmove(buf, buf + used, len - used);
+		len -= used;
+		fflush(stdout);
+	}
+
+	close(fd);
+	return len ? 1 : 0;
+}
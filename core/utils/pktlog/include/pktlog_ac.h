@@ -62,6 +62,9 @@ typedef struct ol_ath_generic_softc_t *ol_ath_generic_softc_handle;
 extern void pktlog_disable_adapter_logging(struct ol_softc *scn);
 extern int pktlog_alloc_buf(struct ol_softc *scn);
 extern void pktlog_release_buf(struct ol_softc *scn);
+extern int pktlog_alloc_rings(struct ath_pktlog_info *pl_info);
+extern void pktlog_release_rings(struct ath_pktlog_info *pl_info);
+extern void pktlog_reset_rings(struct ath_pktlog_info *pl_info);
 
 ssize_t pktlog_read_proc_entry(char *buf, size_t nbytes, loff_t *ppos,
 		struct ath_pktlog_info *pl_info, bool *read_complete);
@@ -97,7 +100,7 @@ struct ol_pktlog_dev_t {
 	osdev_t sc_osdev;
 };
 
-#define PKTLOG_SYSCTL_SIZE      14
+#define PKTLOG_SYSCTL_SIZE      15
 
 /*
  * Linux specific pktlog state information
@@ -106,6 +109,7 @@ struct ath_pktlog_info_lnx {
 	struct ath_pktlog_info info;
 	struct ctl_table sysctls[PKTLOG_SYSCTL_SIZE];
 	struct proc_dir_entry *proc_entry;
+	struct proc_dir_entry *ring_proc_entry;
 	struct ctl_table_header *sysctl_header;
 };
 
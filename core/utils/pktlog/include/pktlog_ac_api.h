@@ -95,6 +95,11 @@ struct ath_pktlog_info {
 	uint32_t trigger_interval;
 	uint32_t start_time_thruput;
 	uint32_t start_time_per;
+
+	/* Size of each per-CPU ring in bytes, 0 to log into buf */
+	int32_t ring_size;
+	/* Per-CPU rings indexed by CPU id, NULL unless ring_size is set */
+	struct ath_pktlog_ring_ctl **rings;
 };
 #endif /* _PKTLOG_INFO */
 #else                           /* REMOVE_PKT_LOG */
@@ -56,6 +56,7 @@ void pktlog_getbuf_intsafe(struct ath_pktlog_arg *plarg);
 char *pktlog_getbuf(struct ol_pktlog_dev_t *pl_dev,
 		    struct ath_pktlog_info *pl_info,
 		    size_t log_size, struct ath_pktlog_hdr *pl_hdr);
+void pktlog_commit(struct ath_pktlog_info *pl_info, char *buf);
 
 A_STATUS process_tx_info(struct ol_txrx_pdev_t *pdev, void *data);
 A_STATUS process_rx_info(void *pdev, void *data);
@@ -40,6 +40,7 @@
 #include <linux/module.h>
 #include <linux/vmalloc.h>
 #include <linux/proc_fs.h>
+#include <linux/log2.h>
 #include <pktlog_ac_i.h>
 #include <pktlog_ac_fmt.h>
 #include <pktlog_ac.h>
@@ -55,6 +56,7 @@
 
 /* Permissions for creating proc entries */
 #define PKTLOG_PROC_PERM        0444
+#define PKTLOG_RING_PROC_PERM   0600
 #define PKTLOG_PROCSYS_DIR_PERM 0555
 #define PKTLOG_PROCSYS_PERM     0644
 
@@ -79,6 +81,7 @@ static void pktlog_detach(struct ol_softc *sc);
 static int pktlog_open(struct inode *i, struct file *f);
 static int pktlog_release(struct inode *i, struct file *f);
 static int pktlog_mmap(struct file *f, struct vm_area_struct *vma);
+static int pktlog_ring_mmap(struct file *f, struct vm_area_struct *vma);
 static ssize_t pktlog_read(struct file *file, char *buf, size_t nbytes,
 			   loff_t *ppos);
 
@@ -89,6 +92,12 @@ static struct file_operations pktlog_fops = {
 	read:  pktlog_read,
 };
 
+static struct file_operations pktlog_ring_fops = {
+	open:  pktlog_open,
+	release:pktlog_release,
+	mmap:  pktlog_ring_mmap,
+};
+
 /*
  * Linux implementation of helper functions
  */
@@ -200,6 +209,106 @@ void pktlog_release_buf(struct ol_softc *scn)
 	pl_info->buf = NULL;
 }
 
+/**
+ * pktlog_alloc_rings() - allocate the per-CPU pktlog rings
+ * @pl_info: pktlog info with ring_size set
+ *
+ * Each ring is a control page followed by ring_size bytes of record
+ * space, allocated with vmalloc_user() so that it can be handed to
+ * userspace with remap_vmalloc_range().
+ *
+ * Return: 0 on success, -ENOMEM otherwise
+ */
+int pktlog_alloc_rings(struct ath_pktlog_info *pl_info)
+{
+	struct ath_pktlog_ring_ctl *ctl;
+	int cpu;
+
+	pl_info->rings = kzalloc(nr_cpu_ids * sizeof(*pl_info->rings),
+				 GFP_KERNEL);
+	if (!pl_info->rings)
+		return -ENOMEM;
+
+	for_each_possible_cpu(cpu) {
+		ctl = vmalloc_user(PAGE_SIZE + pl_info->ring_size);
+		if (!ctl) {
+			printk(PKTLOG_TAG "%s: Unable to allocate ring for "
+			       "cpu %d\n", __func__, cpu);
+			pktlog_release_rings(pl_info);
+			return -ENOMEM;
+		}
+		ctl->magic_num = PKTLOG_RING_MAGIC_NUM;
+		ctl->version = PKTLOG_RING_VER;
+		ctl->cpu = cpu;
+		ctl->data_size = pl_info->ring_size;
+		ctl->data_offset = PAGE_SIZE;
+		pl_info->rings[cpu] = ctl;
+	}
+
+	return 0;
+}
+
+void pktlog_release_rings(struct ath_pktlog_info *pl_info)
+{
+	int cpu;
+
+	if (!pl_info->rings)
+		return;
+
+	for_each_possible_cpu(cpu)
+		vfree(pl_info->rings[cpu]);
+
+	kfree(pl_info->rings);
+	pl_info->rings = NULL;
+}
+
+void pktlog_reset_rings(struct ath_pktlog_info *pl_info)
+{
+	struct ath_pktlog_ring_ctl *ctl;
+	int cpu;
+
+	if (!pl_info->rings)
+		return;
+
+	for_each_possible_cpu(cpu) {
+		ctl = pl_info->rings[cpu];
+		ctl->head = 0;
+		ctl->tail = 0;
+		ctl->dropped = 0;
+	}
+}
+
+/**
+ * pktlog_set_ring_size() - change the size of the per-CPU rings
+ * @pl_info: pktlog info
+ * @size: bytes of record space per CPU, 0 to log into the shared buffer
+ *
+ * The rings are (re)allocated on the next pktlog enable.
+ *
+ * Return: 0 on success, -EINVAL for a bad size or while logging
+ */
+static int pktlog_set_ring_size(struct ath_pktlog_info *pl_info,
+				int32_t size)
+{
+	if (size < 0 || (size && (size < PAGE_SIZE || !is_power_of_2(size) ||
+				  size > PKTLOG_RING_REC_LEN_MASK)))
+		return -EINVAL;
+
+	if (size == pl_info->ring_size)
+		return 0;
+
+	if (pl_info->log_state) {
+		printk(PKTLOG_TAG
+		       "Logging should be disabled before changing ring size\n");
+		return -EINVAL;
+	}
+
+	pktlog_release_rings(pl_info);
+	pl_info->ring_size = size;
+
+	return 0;
+}
+
 void pktlog_cleanup(struct ath_pktlog_info *pl_info)
 {
 	pl_info->log_state = 0;
@@ -306,6 +415,51 @@ ath_sysctl_decl(ath_sysctl_pktlog_size, ctl, write, filp, buffer, lenp, ppos)
 	return ret;
 }
 
+/* sysctl procfs handler to set/get the per-CPU ring size */
+static int
+ath_sysctl_decl(ath_sysctl_pktlog_ring_size, ctl, write, filp, buffer, lenp,
+		ppos)
+{
+	int ret, size;
+	ol_ath_generic_softc_handle scn;
+	struct ol_pktlog_dev_t *pl_dev;
+
+	scn = (ol_ath_generic_softc_handle) ctl->extra1;
+
+	if (!scn) {
+		printk("%s: Invalid scn context\n", __func__);
+		ASSERT(0);
+		return -EINVAL;
+	}
+
+	pl_dev = get_pl_handle((struct ol_softc *)scn);
+
+	if (!pl_dev) {
+		printk("%s: Invalid pktlog handle\n", __func__);
+		ASSERT(0);
+		return -ENODEV;
+	}
+
+	ctl->data = &size;
+	ctl->maxlen = sizeof(size);
+
+	if (write) {
+		ret = ATH_SYSCTL_PROC_DOINTVEC(ctl, write, filp, buffer,
+					       lenp, ppos);
+		if (ret == 0)
+			ret = pktlog_set_ring_size(pl_dev->pl_info, size);
+	} else {
+		size = pl_dev->pl_info->ring_size;
+		ret = ATH_SYSCTL_PROC_DOINTVEC(ctl, write, filp, buffer,
+					       lenp, ppos);
+	}
+
+	ctl->data = NULL;
+	ctl->maxlen = 0;
+
+	return ret;
+}
+
 /* Register sysctl table */
 static int pktlog_sysctl_register(struct ol_softc *scn)
 {
@@ -332,6 +486,8 @@ static int pktlog_sysctl_register(struct ol_softc *scn)
 	 * /proc/sys/PKTLOG_PROC_DIR/<adapter>/enable for enabling/disabling
 	 * pktlog
 	 * /proc/sys/PKTLOG_PROC_DIR/<adapter>/size for changing the buffer size
+	 * /proc/sys/PKTLOG_PROC_DIR/<adapter>/ring_size for switching to the
+	 * per-CPU rings
 	 */
 	memset(pl_info_lnx->sysctls, 0, sizeof(pl_info_lnx->sysctls));
 	set_ctl_name(0, CTL_AUTO);
@@ -407,7 +563,13 @@ static int pktlog_sysctl_register(struct ol_softc *scn)
 	pl_info_lnx->sysctls[12].data = &pl_info_lnx->info.trigger_interval;
 	pl_info_lnx->sysctls[12].maxlen =
 		sizeof(pl_info_lnx->info.trigger_interval);
-	/* [13] is NULL terminator */
+
+	set_ctl_name(13, CTL_AUTO);
+	pl_info_lnx->sysctls[13].procname = "ring_size";
+	pl_info_lnx->sysctls[13].mode = PKTLOG_PROCSYS_PERM;
+	pl_info_lnx->sysctls[13].proc_handler = ath_sysctl_pktlog_ring_size;
+	pl_info_lnx->sysctls[13].extra1 = scn;
+	/* [14] is NULL terminator */
 
 	/* and register everything */
 	/* register_sysctl_table changed from 2.6.21 onwards */
@@ -466,6 +628,7 @@ static int pktlog_attach(struct ol_softc *scn)
 	 */
 	/* pl_dev->tgt_pktlog_enabled = false; */
 	pl_info_lnx->proc_entry = NULL;
+	pl_info_lnx->ring_proc_entry = NULL;
 	pl_info_lnx->sysctl_header = NULL;
 
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(3, 10, 0)
@@ -497,6 +660,26 @@ static int pktlog_attach(struct ol_softc *scn)
 
 	pl_info_lnx->proc_entry = proc_entry;
 
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(3, 10, 0)
+	proc_entry = proc_create_data(WLANDEV_RING_NAME, PKTLOG_RING_PROC_PERM,
+				      g_pktlog_pde, &pktlog_ring_fops,
+				      &pl_info_lnx->info);
+#else
+	proc_entry = create_proc_entry(WLANDEV_RING_NAME,
+				       PKTLOG_RING_PROC_PERM, g_pktlog_pde);
+	if (proc_entry) {
+		proc_entry->data = &pl_info_lnx->info;
+		proc_entry->proc_fops = &pktlog_ring_fops;
+	}
+#endif
+
+	/* The per-CPU rings are optional, carry on without them */
+	if (proc_entry == NULL)
+		printk(PKTLOG_TAG "%s: create_proc_entry failed for %s\n",
+		       __func__, WLANDEV_RING_NAME);
+
+	pl_info_lnx->ring_proc_entry = proc_entry;
+
 	if (pktlog_sysctl_register(scn)) {
 		printk(PKTLOG_TAG "%s: sysctl register failed for %s\n",
 		       __func__, proc_name);
@@ -505,6 +688,8 @@ static int pktlog_attach(struct ol_softc *scn)
 	return 0;
 
 attach_fail2:
+	if (pl_info_lnx->ring_proc_entry)
+		remove_proc_entry(WLANDEV_RING_NAME, g_pktlog_pde);
 	remove_proc_entry(proc_name, g_pktlog_pde);
 
 attach_fail1:
@@ -545,6 +730,8 @@ static void pktlog_detach(struct ol_softc *scn)
 	}
 
 	pl_info = pl_dev->pl_info;
+	if (PL_INFO_LNX(pl_info)->ring_proc_entry)
+		remove_proc_entry(WLANDEV_RING_NAME, g_pktlog_pde);
 	remove_proc_entry(WLANDEV_BASENAME, g_pktlog_pde);
 	pktlog_sysctl_unregister(pl_dev);
 	pktlog_cleanup(pl_info);
@@ -552,6 +739,8 @@ static void pktlog_detach(struct ol_softc *scn)
 	if (pl_info->buf)
 		pktlog_release_buf(scn);
 
+	pktlog_release_rings(pl_info);
+
 	if (pl_dev) {
 		kfree(pl_info);
 		pl_dev->pl_info = NULL;
@@ -1129,6 +1318,59 @@ static int pktlog_mmap(struct file *file, struct vm_area_struct *vma)
 	return 0;
 }
 
+static struct vm_operations_struct pktlog_ring_vmops = {
+	open:  pktlog_vopen,
+	close:pktlog_vclose,
+};
+
+/**
+ * pktlog_ring_mmap() - map one per-CPU ring to userspace
+ * @file: ring proc file
+ * @vma: mapping; vm_pgoff selects the CPU
+ *
+ * Ring N lives at file offset N * (PAGE_SIZE + ring_size), see
+ * struct ath_pktlog_ring_ctl. The control page is mapped writable so
+ * that the consumer can publish its tail.
+ *
+ * Return: 0 on success, negative errno otherwise
+ */
+static int pktlog_ring_mmap(struct file *file, struct vm_area_struct *vma)
+{
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(3, 10, 0)
+	struct ath_pktlog_info *pl_info = (struct ath_pktlog_info *)
+					  PDE_DATA(file->f_dentry->d_inode);
+#else
+	struct proc_dir_entry *proc_entry = PDE(file->f_dentry->d_inode);
+	struct ath_pktlog_info *pl_info = (struct ath_pktlog_info *)
+					  proc_entry->data;
+#endif
+	unsigned long ring_pages, cpu;
+	int ret;
+
+	if (!pl_info->rings) {
+		printk(PKTLOG_TAG "%s: Log rings unavailable\n", __func__);
+		return -ENOMEM;
+	}
+
+	ring_pages = (PAGE_SIZE + pl_info->ring_size) >> PAGE_SHIFT;
+	cpu = vma->vm_pgoff / ring_pages;
+
+	if ((vma->vm_pgoff % ring_pages) || cpu >= nr_cpu_ids ||
+	    !pl_info->rings[cpu])
+		return -EINVAL;
+
+	if (vma->vm_end - vma->vm_start > (ring_pages << PAGE_SHIFT))
+		return -EINVAL;
+
+	ret = remap_vmalloc_range(vma, pl_info->rings[cpu], 0);
+	if (ret)
+		return ret;
+
+	vma->vm_ops = &pktlog_ring_vmops;
+	pktlog_vopen(vma);
+	return 0;
+}
+
 int pktlogmod_init(void *context)
 {
 	int ret;
@@ -383,6 +383,13 @@ int pktlog_enable(struct ol_softc *scn, int32_t log_state)
 		pl_info->buf->msg_index = 1;
 		pl_info->buf->offset = PKTLOG_READ_OFFSET;
 
+		if (pl_info->ring_size && !pl_info->rings) {
+			error = pktlog_alloc_rings(pl_info);
+			if (error != 0)
+				return error;
+		}
+		pktlog_reset_rings(pl_info);
+
 		pl_info->start_time_thruput = os_get_timestamp();
 		pl_info->start_time_per = pl_info->start_time_thruput;
 
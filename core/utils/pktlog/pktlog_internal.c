@@ -159,6 +159,95 @@ void pktlog_check_threshold(struct ath_pktlog_info *pl_info,
 	PKTLOG_UNLOCK(pl_info);
 }
 
+/**
+ * pktlog_ring_reserve() - reserve a record in this CPU's pktlog ring
+ * @pl_info: pktlog info with rings allocated
+ * @log_size: size of the record payload
+ * @pl_hdr: packet log header to store in the record
+ *
+ * Only the CPU owning a ring advances its head, and it does so with
+ * interrupts disabled, so producers never contend on a lock. The record
+ * stays marked busy until pktlog_commit() so that the consumer does not
+ * read a half written payload. The control page is shared with
+ * userspace, so head is only ever used masked by the ring size.
+ *
+ * Return: pointer to the payload, or NULL if the ring is full
+ */
+static char *pktlog_ring_reserve(struct ath_pktlog_info *pl_info,
+				 size_t log_size,
+				 struct ath_pktlog_hdr *pl_hdr)
+{
+	struct ath_pktlog_ring_ctl *ctl;
+	struct ath_pktlog_ring_rec *rec;
+	char *data;
+	uint32_t size = pl_info->ring_size;
+	uint32_t head, used, off, pad, len;
+	unsigned long flags;
+
+	len = ALIGN(sizeof(*rec) + log_size, PKTLOG_RING_REC_ALIGN);
+
+	local_irq_save(flags);
+	ctl = pl_info->rings[smp_processor_id()];
+	data = (char *)ctl + PAGE_SIZE;
+
+	head = ctl->head;
+	used = head - ctl->tail;
+	off = head & (size - 1);
+	pad = (size - off < len) ? size - off : 0;
+
+	if (len > size || used > size || size - used < pad + len ||
+	    (head & (PKTLOG_RING_REC_ALIGN - 1))) {
+		ctl->dropped++;
+		local_irq_restore(flags);
+		return NULL;
+	}
+
+	if (pad) {
+		rec = (struct ath_pktlog_ring_rec *)(data + off);
+		rec->len_flags = pad | PKTLOG_RING_REC_PAD;
+		head += pad;
+		off = 0;
+	}
+
+	rec = (struct ath_pktlog_ring_rec *)(data + off);
+	rec->len_flags = len | PKTLOG_RING_REC_BUSY;
+	rec->version = PKTLOG_RING_VER;
+	rec->hdr_len = sizeof(*rec);
+	rec->hdr = *pl_hdr;
+	rec->hdr.size = (uint16_t)log_size;
+
+	/* Record headers must be visible before the new head */
+	smp_wmb();
+	ctl->head = head + len;
+	local_irq_restore(flags);
+
+	return (char *)(rec + 1);
+}
+
+/**
+ * pktlog_commit() - publish a record returned by pktlog_getbuf()
+ * @pl_info: pktlog info the record was reserved from
+ * @buf: payload pointer returned by pktlog_getbuf(), may be NULL
+ *
+ * Records in the shared log buffer are visible as soon as they are
+ * copied, so this only has work to do for the per-CPU rings.
+ *
+ * Return: None
+ */
+void pktlog_commit(struct ath_pktlog_info *pl_info, char *buf)
+{
+	struct ath_pktlog_ring_rec *rec;
+
+	if (!pl_info->rings || !buf)
+		return;
+
+	rec = (struct ath_pktlog_ring_rec *)buf - 1;
+
+	/* Payload must be visible before the record is */
+	smp_wmb();
+	rec->len_flags &= ~PKTLOG_RING_REC_BUSY;
+}
+
 char *pktlog_getbuf(struct ol_pktlog_dev_t *pl_dev,
 		    struct ath_pktlog_info *pl_info,
 		    size_t log_size, struct ath_pktlog_hdr *pl_hdr)
@@ -166,6 +255,11 @@ char *pktlog_getbuf(struct ol_pktlog_dev_t *pl_dev,
 	struct ath_pktlog_arg plarg = { 0, };
 	uint8_t flags = 0;
 
+	if (pl_info->rings) {
+		plarg.buf = pktlog_ring_reserve(pl_info, log_size, pl_hdr);
+		goto out;
+	}
+
 	plarg.pl_info = pl_info;
 	plarg.log_type = pl_hdr->log_type;
 	plarg.log_size = log_size;
@@ -187,6 +281,7 @@ char *pktlog_getbuf(struct ol_pktlog_dev_t *pl_dev,
 		PKTLOG_UNLOCK(pl_info);
 	}
 
+out:
 	/*
 	 * We do not want to do this packet stats related processing when
 	 * packet log tool is run. i.e., we want this processing to be
@@ -347,11 +442,8 @@ A_STATUS process_tx_info(struct ol_txrx_pdev_t *txrx_pdev, void *data)
 								 log_size,
 								 &pl_hdr);
 
-		if (!txctl_log.txdesc_hdr_ctl) {
-			printk
-				("failed to get buf for txctl_log.txdesc_hdr_ctl\n");
+		if (!txctl_log.txdesc_hdr_ctl)
 			return A_ERROR;
-		}
 
 		/*
 		 * frm hdr is currently Valid only for local frames
@@ -365,18 +457,21 @@ A_STATUS process_tx_info(struct ol_txrx_pdev_t *txrx_pdev, void *data)
 		cdf_assert(txctl_log.txdesc_hdr_ctl);
 		cdf_mem_copy(txctl_log.txdesc_hdr_ctl, &txctl_log.priv,
 			     sizeof(txctl_log.priv));
+		pktlog_commit(pl_info, txctl_log.txdesc_hdr_ctl);
 		/* Add Protocol information and HT specific information */
 #else
 		size_t log_size = sizeof(frm_hdr) + pl_hdr.size;
 		void *txdesc_hdr_ctl = (void *)
 		pktlog_getbuf(pl_dev, pl_info, log_size, &pl_hdr);
-		cdf_assert(txdesc_hdr_ctl);
+		if (!txdesc_hdr_ctl)
+			return A_ERROR;
 		cdf_assert(pl_hdr.size < (370 * sizeof(u_int32_t)));
 
 		cdf_mem_copy(txdesc_hdr_ctl, &frm_hdr, sizeof(frm_hdr));
 		cdf_mem_copy((char *)txdesc_hdr_ctl + sizeof(frm_hdr),
 					((void *)data + sizeof(struct ath_pktlog_hdr)),
 					 pl_hdr.size);
+		pktlog_commit(pl_info, txdesc_hdr_ctl);
 #endif /* !defined(HELIUMPLUS) */
 	}
 
@@ -386,10 +481,12 @@ A_STATUS process_tx_info(struct ol_txrx_pdev_t *txrx_pdev, void *data)
 
 		txstat_log.ds_status = (void *)
 				       pktlog_getbuf(pl_dev, pl_info, log_size, &pl_hdr);
-		cdf_assert(txstat_log.ds_status);
+		if (!txstat_log.ds_status)
+			return A_ERROR;
 		cdf_mem_copy(txstat_log.ds_status,
 			     ((void *)data + sizeof(struct ath_pktlog_hdr)),
 			     pl_hdr.size);
+		pktlog_commit(pl_info, txstat_log.ds_status);
 	}
 
 	if (pl_hdr.log_type == PKTLOG_TYPE_TX_MSDU_ID) {
@@ -473,11 +570,14 @@ A_STATUS process_tx_info(struct ol_txrx_pdev_t *txrx_pdev, void *data)
 		}
 		pl_msdu_info.ath_msdu_info = pktlog_getbuf(pl_dev, pl_info,
 							   log_size, &pl_hdr);
+		if (!pl_msdu_info.ath_msdu_info)
+			return A_ERROR;
 		cdf_mem_copy((void *)&pl_msdu_info.priv.msdu_id_info,
 			     ((void *)data + sizeof(struct ath_pktlog_hdr)),
 			     sizeof(pl_msdu_info.priv.msdu_id_info));
 		cdf_mem_copy(pl_msdu_info.ath_msdu_info, &pl_msdu_info.priv,
 			     sizeof(pl_msdu_info.priv));
+		pktlog_commit(pl_info, pl_msdu_info.ath_msdu_info);
 	}
 	return A_OK;
 }
@@ -528,8 +628,12 @@ A_STATUS process_rx_info_remote(void *pdev, cdf_nbuf_t amsdu)
 #endif /* !defined(HELIUMPLUS) */
 		rxstat_log.rx_desc = (void *)pktlog_getbuf(pl_dev, pl_info,
 							   log_size, &pl_hdr);
-		cdf_mem_copy(rxstat_log.rx_desc, (void *)rx_desc +
-			     sizeof(struct htt_host_fw_desc_base), pl_hdr.size);
+		if (rxstat_log.rx_desc) {
+			cdf_mem_copy(rxstat_log.rx_desc, (void *)rx_desc +
+				     sizeof(struct htt_host_fw_desc_base),
+				     pl_hdr.size);
+			pktlog_commit(pl_info, rxstat_log.rx_desc);
+		}
 		msdu = cdf_nbuf_next(msdu);
 	}
 	return A_OK;
@@ -566,9 +670,12 @@ A_STATUS process_rx_info(void *pdev, void *data)
 	log_size = pl_hdr.size;
 	rxstat_log.rx_desc = (void *)pktlog_getbuf(pl_dev, pl_info,
 						   log_size, &pl_hdr);
+	if (!rxstat_log.rx_desc)
+		return A_ERROR;
 
 	cdf_mem_copy(rxstat_log.rx_desc,
 		     (void *)data + sizeof(struct ath_pktlog_hdr), pl_hdr.size);
+	pktlog_commit(pl_info, rxstat_log.rx_desc);
 
 	return A_OK;
 }
@@ -619,10 +726,13 @@ A_STATUS process_rate_find(void *pdev, void *data)
 	log_size = pl_hdr.size;
 	rcf_log.rcFind = (void *)pktlog_getbuf(pl_dev, pl_info,
 					       log_size, &pl_hdr);
+	if (!rcf_log.rcFind)
+		return A_ERROR;
 
 	cdf_mem_copy(rcf_log.rcFind,
 				 ((char *)data + sizeof(struct ath_pktlog_hdr)),
 				 pl_hdr.size);
+	pktlog_commit(pl_info, rcf_log.rcFind);
 
 	return A_OK;
 }
@@ -672,9 +782,12 @@ A_STATUS process_rate_update(void *pdev, void *data)
 	 */
 	rcu_log.txRateCtrl = (void *)pktlog_getbuf(pl_dev, pl_info,
 						   log_size, &pl_hdr);
+	if (!rcu_log.txRateCtrl)
+		return A_ERROR;
 	cdf_mem_copy(rcu_log.txRateCtrl,
 		     ((char *)data + sizeof(struct ath_pktlog_hdr)),
 		     pl_hdr.size);
+	pktlog_commit(pl_info, rcu_log.txRateCtrl);
 	return A_OK;
 }
 #endif /*REMOVE_PKT_LOG */
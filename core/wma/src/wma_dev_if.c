@@ -943,6 +943,80 @@ wmi_unified_vdev_set_param_send(wmi_unified_t wmi_handle, uint32_t if_id,
 	return ret;
 }
 
+/* most vdev parameters wma_vdev_set_params_send() sends in one batch */
+#define WMA_VDEV_PARAM_BATCH_MAX 8
+
+/**
+ * struct wma_vdev_param - one parameter of a vdev parameter batch
+ * @param_id: parameter id
+ * @param_value: parameter value
+ */
+struct wma_vdev_param {
+	uint32_t param_id;
+	uint32_t param_value;
+};
+
+/**
+ * wma_vdev_set_params_send() - set several vdev params in fw in one batch
+ * @wmi_handle: wmi handle
+ * @if_id: vdev id
+ * @params: parameters to set, in order
+ * @num_params: number of entries in @params, at most
+ *	WMA_VDEV_PARAM_BATCH_MAX
+ *
+ * Sends one WMI_VDEV_SET_PARAM_CMDID per parameter, handed to WMI as a
+ * single wmi_unified_cmd_send_multi() batch.
+ *
+ * Return: 0 if all the parameters were sent, error code otherwise
+ */
+static int wma_vdev_set_params_send(wmi_unified_t wmi_handle, uint32_t if_id,
+				    struct wma_vdev_param *params,
+				    int num_params)
+{
+	struct wmi_cmd_desc cmds[WMA_VDEV_PARAM_BATCH_MAX];
+	wmi_vdev_set_param_cmd_fixed_param *cmd;
+	uint16_t len = sizeof(*cmd);
+	int num_cmds, sent, i;
+
+	if (num_params > WMA_VDEV_PARAM_BATCH_MAX) {
+		WMA_LOGE("%s: too many params %d", __func__, num_params);
+		return -EINVAL;
+	}
+
+	for (num_cmds = 0; num_cmds < num_params; num_cmds++) {
+		cmds[num_cmds].buf = wmi_buf_alloc(wmi_handle, len);
+		if (!cmds[num_cmds].buf) {
+			WMA_LOGE("%s:wmi_buf_alloc failed", __func__);
+			break;
+		}
+		cmds[num_cmds].len = len;
+		cmds[num_cmds].cmd_id = WMI_VDEV_SET_PARAM_CMDID;
+
+		cmd = (wmi_vdev_set_param_cmd_fixed_param *)
+			wmi_buf_data(cmds[num_cmds].buf);
+		WMITLV_SET_HDR(&cmd->tlv_header,
+			       WMITLV_TAG_STRUC_wmi_vdev_set_param_cmd_fixed_param,
+			       WMITLV_GET_STRUCT_TLVLEN
+				       (wmi_vdev_set_param_cmd_fixed_param));
+		cmd->vdev_id = if_id;
+		cmd->param_id = params[num_cmds].param_id;
+		cmd->param_value = params[num_cmds].param_value;
+		WMA_LOGD("Setting vdev %d param = %x, value = %u",
+			 if_id, cmd->param_id, cmd->param_value);
+	}
+
+	sent = wmi_unified_cmd_send_multi(wmi_handle, cmds, num_cmds);
+	if (sent < 0)
+		sent = 0;
+	for (i = sent; i < num_cmds; i++) {
+		WMA_LOGE("Failed to send set param %x of vdev %d",
+			 params[i].param_id, if_id);
+		wmi_buf_free(cmds[i].buf);
+	}
+
+	return (sent == num_params) ? 0 : -EIO;
+}
+
 /**
  * wmi_unified_peer_flush_tids_send() - flush peer tids packets in fw
  * @wmi: wmi handle
@@ -1678,6 +1752,8 @@ ol_txrx_vdev_handle wma_vdev_attach(tp_wma_handle wma_handle,
 	int ret;
 	tSirMacHTCapabilityInfo *phtCapInfo;
 	cds_msg_t sme_msg = { 0 };
+	struct wma_vdev_param vdev_params[WMA_VDEV_PARAM_BATCH_MAX];
+	int num_vdev_params = 0;
 
 	if (NULL == mac) {
 		WMA_LOGE("%s: Failed to get mac", __func__);
@@ -1797,40 +1873,31 @@ ol_txrx_vdev_handle wma_vdev_attach(tp_wma_handle wma_handle,
 		}
 	}
 
-	ret = wmi_unified_vdev_set_param_send(wma_handle->wmi_handle,
-				self_sta_req->session_id,
-				WMI_VDEV_PARAM_MCC_RTSCTS_PROTECTION_ENABLE,
-				mac->roam.configParam.mcc_rts_cts_prot_enable);
-	if (ret)
-		WMA_LOGE("Failed to set WMI VDEV MCC_RTSCTS_PROTECTION_ENABLE");
+	/* the initial vdev parameters go to the firmware as one batch */
+	vdev_params[num_vdev_params].param_id =
+		WMI_VDEV_PARAM_MCC_RTSCTS_PROTECTION_ENABLE;
+	vdev_params[num_vdev_params++].param_value =
+		mac->roam.configParam.mcc_rts_cts_prot_enable;
 
-	ret = wmi_unified_vdev_set_param_send(wma_handle->wmi_handle,
-			self_sta_req->session_id,
-			WMI_VDEV_PARAM_MCC_BROADCAST_PROBE_ENABLE,
-			mac->roam.configParam.mcc_bcast_prob_resp_enable);
-	if (ret)
-		WMA_LOGE("Failed to set WMI VDEV MCC_BROADCAST_PROBE_ENABLE");
+	vdev_params[num_vdev_params].param_id =
+		WMI_VDEV_PARAM_MCC_BROADCAST_PROBE_ENABLE;
+	vdev_params[num_vdev_params++].param_value =
+		mac->roam.configParam.mcc_bcast_prob_resp_enable;
 
 	if (wlan_cfg_get_int(mac, WNI_CFG_RTS_THRESHOLD,
 			     &cfg_val) == eSIR_SUCCESS) {
-		ret = wmi_unified_vdev_set_param_send(wma_handle->wmi_handle,
-						      self_sta_req->session_id,
-						      WMI_VDEV_PARAM_RTS_THRESHOLD,
-						      cfg_val);
-		if (ret)
-			WMA_LOGE("Failed to set WMI_VDEV_PARAM_RTS_THRESHOLD");
+		vdev_params[num_vdev_params].param_id =
+			WMI_VDEV_PARAM_RTS_THRESHOLD;
+		vdev_params[num_vdev_params++].param_value = cfg_val;
 	} else {
 		WMA_LOGE("Failed to get value for WNI_CFG_RTS_THRESHOLD, leaving unchanged");
 	}
 
 	if (wlan_cfg_get_int(mac, WNI_CFG_FRAGMENTATION_THRESHOLD,
 			     &cfg_val) == eSIR_SUCCESS) {
-		ret = wmi_unified_vdev_set_param_send(wma_handle->wmi_handle,
-						      self_sta_req->session_id,
-						      WMI_VDEV_PARAM_FRAGMENTATION_THRESHOLD,
-						      cfg_val);
-		if (ret)
-			WMA_LOGE("Failed to set WMI_VDEV_PARAM_FRAGMENTATION_THRESHOLD");
+		vdev_params[num_vdev_params].param_id =
+			WMI_VDEV_PARAM_FRAGMENTATION_THRESHOLD;
+		vdev_params[num_vdev_params++].param_value = cfg_val;
 	} else {
 		WMA_LOGE("Failed to get value for WNI_CFG_FRAGMENTATION_THRESHOLD, leaving unchanged");
 	}
@@ -1838,12 +1905,9 @@ ol_txrx_vdev_handle wma_vdev_attach(tp_wma_handle wma_handle,
 	if (wlan_cfg_get_int(mac, WNI_CFG_HT_CAP_INFO, &cfg_val) == eSIR_SUCCESS) {
 		val16 = (uint16_t) cfg_val;
 		phtCapInfo = (tSirMacHTCapabilityInfo *) &cfg_val;
-		ret = wmi_unified_vdev_set_param_send(wma_handle->wmi_handle,
-						      self_sta_req->session_id,
-						      WMI_VDEV_PARAM_TX_STBC,
-						      phtCapInfo->txSTBC);
-		if (ret)
-			WMA_LOGE("Failed to set WMI_VDEV_PARAM_TX_STBC");
+		vdev_params[num_vdev_params].param_id = WMI_VDEV_PARAM_TX_STBC;
+		vdev_params[num_vdev_params++].param_value =
+			phtCapInfo->txSTBC;
 	} else {
 		WMA_LOGE("Failed to get value of HT_CAP, TX STBC unchanged");
 	}
@@ -1851,13 +1915,19 @@ ol_txrx_vdev_handle wma_vdev_attach(tp_wma_handle wma_handle,
 	if ((self_sta_req->type == WMI_VDEV_TYPE_STA) &&
 	    (self_sta_req->sub_type == 0)) {
 		wma_handle->roam_offload_enabled = true;
-		wmi_unified_vdev_set_param_send(wma_handle->wmi_handle,
-						self_sta_req->session_id,
-						WMI_VDEV_PARAM_ROAM_FW_OFFLOAD,
-						(WMI_ROAM_FW_OFFLOAD_ENABLE_FLAG |
-						 WMI_ROAM_BMISS_FINAL_SCAN_ENABLE_FLAG));
+		vdev_params[num_vdev_params].param_id =
+			WMI_VDEV_PARAM_ROAM_FW_OFFLOAD;
+		vdev_params[num_vdev_params++].param_value =
+			(WMI_ROAM_FW_OFFLOAD_ENABLE_FLAG |
+			 WMI_ROAM_BMISS_FINAL_SCAN_ENABLE_FLAG);
 	}
 
+	ret = wma_vdev_set_params_send(wma_handle->wmi_handle,
+				       self_sta_req->session_id,
+				       vdev_params, num_vdev_params);
+	if (ret)
+		WMA_LOGE("Failed to set the initial vdev params");
+
 	/* Initialize BMISS parameters */
 	if ((self_sta_req->type == WMI_VDEV_TYPE_STA) &&
 	    (self_sta_req->sub_type == 0))
@@ -43,121 +43,92 @@
 #include "wma_api.h"
 #include "wma.h"
 #include "mac_trace.h"
+#include "cdf_threads.h"
 
 #define WMI_MIN_HEAD_ROOM 64
 
 #ifdef WMI_INTERFACE_EVENT_LOGGING
+/*
+ * The debug logs below are written without a lock.  A writer claims a
+ * slot by atomically incrementing the log's index and then fills in that
+ * slot only, so concurrent writers never share a slot.  The index keeps
+ * counting up; the log sizes are powers of 2 and the slot is the index
+ * masked with the log size - 1.
+ */
+#define WMI_LOG_RECORD(log, log_idx, log_size, id_field, a, b) {	\
+		uint32_t _slot;						\
+		_slot = (cdf_atomic_inc_return(&(log_idx)) - 1) &	\
+			((log_size) - 1);				\
+		(log)[_slot].id_field = a;				\
+		cdf_mem_copy((log)[_slot].data, b, 16);			\
+		(log)[_slot].time = cdf_get_log_timestamp();		\
+}
+
 /* WMI commands */
-uint32_t g_wmi_command_buf_idx = 0;
+cdf_atomic_t g_wmi_command_buf_idx;
 struct wmi_command_debug wmi_command_log_buffer[WMI_EVENT_DEBUG_MAX_ENTRY];
 
 /* WMI commands TX completed */
-uint32_t g_wmi_command_tx_cmp_buf_idx = 0;
+cdf_atomic_t g_wmi_command_tx_cmp_buf_idx;
 struct wmi_command_debug
 	wmi_command_tx_cmp_log_buffer[WMI_EVENT_DEBUG_MAX_ENTRY];
 
 /* WMI events when processed */
-uint32_t g_wmi_event_buf_idx = 0;
+cdf_atomic_t g_wmi_event_buf_idx;
 struct wmi_event_debug wmi_event_log_buffer[WMI_EVENT_DEBUG_MAX_ENTRY];
 
 /* WMI events when queued */
-uint32_t g_wmi_rx_event_buf_idx = 0;
+cdf_atomic_t g_wmi_rx_event_buf_idx;
 struct wmi_event_debug wmi_rx_event_log_buffer[WMI_EVENT_DEBUG_MAX_ENTRY];
 
-#define WMI_COMMAND_RECORD(a, b) {					\
-		if (WMI_EVENT_DEBUG_MAX_ENTRY <= g_wmi_command_buf_idx)		\
-			g_wmi_command_buf_idx = 0;				\
-		wmi_command_log_buffer[g_wmi_command_buf_idx].command = a;	\
-		cdf_mem_copy(wmi_command_log_buffer[g_wmi_command_buf_idx].data, b, 16); \
-		wmi_command_log_buffer[g_wmi_command_buf_idx].time =		\
-			cdf_get_log_timestamp();					\
-		g_wmi_command_buf_idx++;					\
-}
+#define WMI_COMMAND_RECORD(a, b)					\
+	WMI_LOG_RECORD(wmi_command_log_buffer, g_wmi_command_buf_idx,	\
+		       WMI_EVENT_DEBUG_MAX_ENTRY, command, a, b)
 
-#define WMI_COMMAND_TX_CMP_RECORD(a, b) {				\
-		if (WMI_EVENT_DEBUG_MAX_ENTRY <= g_wmi_command_tx_cmp_buf_idx)	\
-			g_wmi_command_tx_cmp_buf_idx = 0;			\
-		wmi_command_tx_cmp_log_buffer[g_wmi_command_tx_cmp_buf_idx].command = a; \
-		cdf_mem_copy(wmi_command_tx_cmp_log_buffer			\
-			     [g_wmi_command_tx_cmp_buf_idx].data, b, 16);	     \
-		wmi_command_tx_cmp_log_buffer[g_wmi_command_tx_cmp_buf_idx].time = \
-			cdf_get_log_timestamp();					\
-		g_wmi_command_tx_cmp_buf_idx++;					\
-}
+#define WMI_COMMAND_TX_CMP_RECORD(a, b)					\
+	WMI_LOG_RECORD(wmi_command_tx_cmp_log_buffer,			\
+		       g_wmi_command_tx_cmp_buf_idx,			\
+		       WMI_EVENT_DEBUG_MAX_ENTRY, command, a, b)
 
-#define WMI_EVENT_RECORD(a, b) {					\
-		if (WMI_EVENT_DEBUG_MAX_ENTRY <= g_wmi_event_buf_idx)		\
-			g_wmi_event_buf_idx = 0;				\
-		wmi_event_log_buffer[g_wmi_event_buf_idx].event = a;		\
-		cdf_mem_copy(wmi_event_log_buffer[g_wmi_event_buf_idx].data, b, 16); \
-		wmi_event_log_buffer[g_wmi_event_buf_idx].time =		\
-			cdf_get_log_timestamp();					\
-		g_wmi_event_buf_idx++;						\
-}
+#define WMI_EVENT_RECORD(a, b)						\
+	WMI_LOG_RECORD(wmi_event_log_buffer, g_wmi_event_buf_idx,	\
+		       WMI_EVENT_DEBUG_MAX_ENTRY, event, a, b)
+
+#define WMI_RX_EVENT_RECORD(a, b)					\
+	WMI_LOG_RECORD(wmi_rx_event_log_buffer, g_wmi_rx_event_buf_idx,	\
+		       WMI_EVENT_DEBUG_MAX_ENTRY, event, a, b)
 
-#define WMI_RX_EVENT_RECORD(a,b) {					\
-		if (WMI_EVENT_DEBUG_MAX_ENTRY <= g_wmi_rx_event_buf_idx)	\
-			g_wmi_rx_event_buf_idx = 0;					\
-		wmi_rx_event_log_buffer[g_wmi_rx_event_buf_idx].event = a;	\
-		cdf_mem_copy(wmi_rx_event_log_buffer[g_wmi_rx_event_buf_idx].data, b, 16); \
-		wmi_rx_event_log_buffer[g_wmi_rx_event_buf_idx].time =		\
-			cdf_get_log_timestamp();					\
-		g_wmi_rx_event_buf_idx++;					\
-}
 /* wmi_mgmt commands */
 #define WMI_MGMT_EVENT_DEBUG_MAX_ENTRY (256)
 
-uint32_t g_wmi_mgmt_command_buf_idx = 0;
+cdf_atomic_t g_wmi_mgmt_command_buf_idx;
 struct
 wmi_command_debug wmi_mgmt_command_log_buffer[WMI_MGMT_EVENT_DEBUG_MAX_ENTRY];
 
 /* wmi_mgmt commands TX completed */
-uint32_t g_wmi_mgmt_command_tx_cmp_buf_idx = 0;
+cdf_atomic_t g_wmi_mgmt_command_tx_cmp_buf_idx;
 struct wmi_command_debug
 wmi_mgmt_command_tx_cmp_log_buffer[WMI_MGMT_EVENT_DEBUG_MAX_ENTRY];
 
 /* wmi_mgmt events when processed */
-uint32_t g_wmi_mgmt_event_buf_idx = 0;
+cdf_atomic_t g_wmi_mgmt_event_buf_idx;
 struct wmi_event_debug
 wmi_mgmt_event_log_buffer[WMI_MGMT_EVENT_DEBUG_MAX_ENTRY];
 
-#define WMI_MGMT_COMMAND_RECORD(a, b) {					     \
-	if (WMI_MGMT_EVENT_DEBUG_MAX_ENTRY <=				     \
-		g_wmi_mgmt_command_buf_idx)				     \
-		g_wmi_mgmt_command_buf_idx = 0;				     \
-	wmi_mgmt_command_log_buffer[g_wmi_mgmt_command_buf_idx].command = a; \
-	cdf_mem_copy(							     \
-		wmi_mgmt_command_log_buffer[g_wmi_mgmt_command_buf_idx].data,\
-		b, 16);							     \
-	wmi_mgmt_command_log_buffer[g_wmi_mgmt_command_buf_idx].time =	     \
-		cdf_get_log_timestamp();				     \
-	g_wmi_mgmt_command_buf_idx++;					     \
-}
+#define WMI_MGMT_COMMAND_RECORD(a, b)					\
+	WMI_LOG_RECORD(wmi_mgmt_command_log_buffer,			\
+		       g_wmi_mgmt_command_buf_idx,			\
+		       WMI_MGMT_EVENT_DEBUG_MAX_ENTRY, command, a, b)
 
-#define WMI_MGMT_COMMAND_TX_CMP_RECORD(a, b) {				     \
-	if (WMI_MGMT_EVENT_DEBUG_MAX_ENTRY <=				     \
-	    g_wmi_mgmt_command_tx_cmp_buf_idx)				     \
-		g_wmi_mgmt_command_tx_cmp_buf_idx = 0;			     \
-	wmi_mgmt_command_tx_cmp_log_buffer[g_wmi_mgmt_command_tx_cmp_buf_idx].\
-								command = a; \
-	cdf_mem_copy(wmi_mgmt_command_tx_cmp_log_buffer			     \
-		     [g_wmi_mgmt_command_tx_cmp_buf_idx].data, b, 16);	     \
-	wmi_mgmt_command_tx_cmp_log_buffer[g_wmi_mgmt_command_tx_cmp_buf_idx].\
-									time =\
-		cdf_get_log_timestamp();				      \
-	g_wmi_mgmt_command_tx_cmp_buf_idx++;				      \
-}
+#define WMI_MGMT_COMMAND_TX_CMP_RECORD(a, b)				\
+	WMI_LOG_RECORD(wmi_mgmt_command_tx_cmp_log_buffer,		\
+		       g_wmi_mgmt_command_tx_cmp_buf_idx,		\
+		       WMI_MGMT_EVENT_DEBUG_MAX_ENTRY, command, a, b)
 
-#define WMI_MGMT_EVENT_RECORD(a, b) {					      \
-	if (WMI_MGMT_EVENT_DEBUG_MAX_ENTRY <= g_wmi_mgmt_event_buf_idx)       \
-		g_wmi_mgmt_event_buf_idx = 0;				      \
-	wmi_mgmt_event_log_buffer[g_wmi_mgmt_event_buf_idx].event = a;	      \
-	cdf_mem_copy(wmi_mgmt_event_log_buffer[g_wmi_mgmt_event_buf_idx].data,\
-		     b, 16);						      \
-	wmi_mgmt_event_log_buffer[g_wmi_mgmt_event_buf_idx].time =	      \
-		cdf_get_log_timestamp();				      \
-	g_wmi_mgmt_event_buf_idx++;					      \
-}
+#define WMI_MGMT_EVENT_RECORD(a, b)					\
+	WMI_LOG_RECORD(wmi_mgmt_event_log_buffer,			\
+		       g_wmi_mgmt_event_buf_idx,			\
+		       WMI_MGMT_EVENT_DEBUG_MAX_ENTRY, event, a, b)
 
 #endif /*WMI_INTERFACE_EVENT_LOGGING */
 
@@ -761,13 +732,133 @@ static inline void wma_log_cmd_id(WMI_CMD_ID cmd_id)
 }
 #endif
 
-/* WMI command API */
-int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, int len,
-			 WMI_CMD_ID cmd_id)
+/**
+ * wmi_htc_pkt_pool_init() - preallocate the HTC packets of WMI commands
+ * @wmi_handle: handle to WMI
+ *
+ * If the pool cannot be allocated, each command allocates its own HTC
+ * packet when it is sent, as it does once the pool is exhausted.
+ *
+ * Return: None
+ */
+static void wmi_htc_pkt_pool_init(struct wmi_unified *wmi_handle)
+{
+	int i;
+
+	cdf_spinlock_init(&wmi_handle->htc_pkt_lock);
+	INIT_HTC_PACKET_QUEUE(&wmi_handle->htc_pkt_free_q);
+	wmi_handle->htc_pkt_pool =
+		cdf_mem_malloc(WMI_HTC_PKT_POOL_SIZE * sizeof(HTC_PACKET));
+	if (!wmi_handle->htc_pkt_pool) {
+		pr_err("%s: failed to alloc %d HTC packets\n", __func__,
+		       WMI_HTC_PKT_POOL_SIZE);
+		return;
+	}
+	for (i = 0; i < WMI_HTC_PKT_POOL_SIZE; i++)
+		HTC_PACKET_ENQUEUE(&wmi_handle->htc_pkt_free_q,
+				   &wmi_handle->htc_pkt_pool[i]);
+}
+
+/**
+ * wmi_htc_pkt_pool_deinit() - free the HTC packets of WMI commands
+ * @wmi_handle: handle to WMI
+ *
+ * Commands still queued in HTC hold packets of the pool until their tx
+ * completion. Wait up to WMI_HTC_PKT_POOL_DRAIN_MS for all of them to be
+ * returned; if some are still outstanding after that, the pool is leaked
+ * rather than freed under HTC.
+ *
+ * Return: None
+ */
+static void wmi_htc_pkt_pool_deinit(struct wmi_unified *wmi_handle)
+{
+	int outstanding;
+	int wait_ms = 0;
+
+	if (wmi_handle->htc_pkt_pool) {
+		for (;;) {
+			cdf_spin_lock_bh(&wmi_handle->htc_pkt_lock);
+			outstanding = WMI_HTC_PKT_POOL_SIZE -
+				HTC_PACKET_QUEUE_DEPTH(
+					&wmi_handle->htc_pkt_free_q);
+			cdf_spin_unlock_bh(&wmi_handle->htc_pkt_lock);
+			if (!outstanding ||
+			    wait_ms >= WMI_HTC_PKT_POOL_DRAIN_MS)
+				break;
+			cdf_sleep(WMI_HTC_PKT_POOL_DRAIN_STEP_MS);
+			wait_ms += WMI_HTC_PKT_POOL_DRAIN_STEP_MS;
+		}
+		if (outstanding) {
+			pr_err("%s: %d HTC packets in use, pool leaked\n",
+			       __func__, outstanding);
+			return;
+		}
+		cdf_mem_free(wmi_handle->htc_pkt_pool);
+		wmi_handle->htc_pkt_pool = NULL;
+	}
+	INIT_HTC_PACKET_QUEUE(&wmi_handle->htc_pkt_free_q);
+	cdf_spinlock_destroy(&wmi_handle->htc_pkt_lock);
+}
+
+/**
+ * wmi_htc_pkt_alloc() - get an HTC packet for a WMI command
+ * @wmi_handle: handle to WMI
+ *
+ * Return: HTC packet from the pool, or a newly allocated one if the pool
+ *	is empty; NULL if out of memory
+ */
+static HTC_PACKET *wmi_htc_pkt_alloc(struct wmi_unified *wmi_handle)
+{
+	HTC_PACKET *pkt;
+
+	cdf_spin_lock_bh(&wmi_handle->htc_pkt_lock);
+	pkt = htc_packet_dequeue(&wmi_handle->htc_pkt_free_q);
+	cdf_spin_unlock_bh(&wmi_handle->htc_pkt_lock);
+	if (pkt)
+		return pkt;
+
+	return cdf_mem_malloc(sizeof(*pkt));
+}
+
+/**
+ * wmi_htc_pkt_free() - release the HTC packet of a WMI command
+ * @wmi_handle: handle to WMI
+ * @pkt: HTC packet from wmi_htc_pkt_alloc()
+ *
+ * Return: None
+ */
+static void wmi_htc_pkt_free(struct wmi_unified *wmi_handle, HTC_PACKET *pkt)
+{
+	HTC_PACKET *pool = wmi_handle->htc_pkt_pool;
+
+	if (pool && pkt >= pool && pkt < pool + WMI_HTC_PKT_POOL_SIZE) {
+		cdf_spin_lock_bh(&wmi_handle->htc_pkt_lock);
+		HTC_PACKET_ENQUEUE(&wmi_handle->htc_pkt_free_q, pkt);
+		cdf_spin_unlock_bh(&wmi_handle->htc_pkt_lock);
+		return;
+	}
+	cdf_mem_free(pkt);
+}
+
+/**
+ * wmi_unified_cmd_prepare() - turn a WMI command buffer into an HTC packet
+ * @wmi_handle: handle to WMI
+ * @buf: WMI command buffer
+ * @len: length of the command, excluding the WMI header
+ * @cmd_id: WMI command id
+ * @htc_pkt: set to the HTC packet ready to be sent
+ *
+ * Checks the command, adds the WMI header, accounts the command as
+ * pending and records it in the WMI command log.
+ *
+ * Return: EOK, or a negative error code with the command not accounted
+ *	as pending if the command cannot be sent
+ */
+static int wmi_unified_cmd_prepare(wmi_unified_t wmi_handle, wmi_buf_t buf,
+				   int len, WMI_CMD_ID cmd_id,
+				   HTC_PACKET **htc_pkt)
 {
 	HTC_PACKET *pkt;
-	A_STATUS status;
-	struct ol_softc *scn;
 
 	if (cdf_atomic_read(&wmi_handle->is_target_suspended) &&
 	    ((WMI_WOW_HOSTWAKEUP_FROM_SLEEP_CMDID != cmd_id) &&
@@ -799,21 +890,18 @@ int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, int len,
 
 	WMI_SET_FIELD(cdf_nbuf_data(buf), WMI_CMD_HDR, COMMANDID, cmd_id);
 
-	cdf_atomic_inc(&wmi_handle->pending_cmds);
-	if (cdf_atomic_read(&wmi_handle->pending_cmds) >= WMI_MAX_CMDS) {
-		scn = cds_get_context(CDF_MODULE_ID_HIF);
+	if (cdf_atomic_inc_return(&wmi_handle->pending_cmds) >=
+	    WMI_MAX_CMDS) {
 		pr_err("\n%s: hostcredits = %d\n", __func__,
 		       wmi_get_host_credits(wmi_handle));
 		htc_dump_counter_info(wmi_handle->htc_handle);
-		/* dump_ce_register(scn); */
-		/* dump_ce_debug_register(scn->hif_sc); */
 		cdf_atomic_dec(&wmi_handle->pending_cmds);
 		pr_err("%s: MAX 1024 WMI Pending cmds reached.\n", __func__);
 		CDF_BUG(0);
 		return -EBUSY;
 	}
 
-	pkt = cdf_mem_malloc(sizeof(*pkt));
+	pkt = wmi_htc_pkt_alloc(wmi_handle);
 	if (!pkt) {
 		cdf_atomic_dec(&wmi_handle->pending_cmds);
 		pr_err("%s, Failed to alloc htc packet %x, no memory\n",
@@ -832,7 +920,6 @@ int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, int len,
 	wma_log_cmd_id(cmd_id);
 
 #ifdef WMI_INTERFACE_EVENT_LOGGING
-	cdf_spin_lock_bh(&wmi_handle->wmi_record_lock);
 	/*Record 16 bytes of WMI cmd data - exclude TLV and WMI headers */
 	if (cmd_id == WMI_MGMT_TX_SEND_CMDID) {
 		WMI_MGMT_COMMAND_RECORD(cmd_id,
@@ -841,13 +928,28 @@ int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, int len,
 		WMI_COMMAND_RECORD(cmd_id, ((uint32_t *) cdf_nbuf_data(buf) +
 					    2));
 	}
-
-	cdf_spin_unlock_bh(&wmi_handle->wmi_record_lock);
 #endif
 
+	*htc_pkt = pkt;
+	return EOK;
+}
+
+/* WMI command API */
+int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, int len,
+			 WMI_CMD_ID cmd_id)
+{
+	HTC_PACKET *pkt;
+	A_STATUS status;
+	int ret;
+
+	ret = wmi_unified_cmd_prepare(wmi_handle, buf, len, cmd_id, &pkt);
+	if (ret != EOK)
+		return ret;
+
 	status = htc_send_pkt(wmi_handle->htc_handle, pkt);
 
 	if (A_OK != status) {
+		wmi_htc_pkt_free(wmi_handle, pkt);
 		cdf_atomic_dec(&wmi_handle->pending_cmds);
 		pr_err("%s %d, htc_send_pkt failed\n", __func__, __LINE__);
 	}
@@ -855,6 +957,56 @@ int wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, int len,
 	return ((status == A_OK) ? EOK : -1);
 }
 
+/**
+ * wmi_unified_cmd_send_multi() - send a batch of WMI commands
+ * @wmi_handle: handle to WMI
+ * @cmds: commands to send, in order
+ * @num_cmds: number of entries in @cmds
+ *
+ * Prepares all the commands and hands them to HTC as one packet queue, so
+ * that HTC runs a single htc_try_send() pass over the batch instead of one
+ * send call per command. If a command cannot be prepared, the commands
+ * before it are still sent and the command and those after it are not.
+ *
+ * Return: number of commands sent, which the caller no longer owns the
+ *	buffers of; -1 if HTC rejected the batch, in which case the caller
+ *	still owns all the buffers
+ */
+int wmi_unified_cmd_send_multi(wmi_unified_t wmi_handle,
+			       struct wmi_cmd_desc *cmds, int num_cmds)
+{
+	HTC_PACKET_QUEUE queue;
+	HTC_PACKET *pkt;
+	A_STATUS status;
+	int i, sent;
+
+	INIT_HTC_PACKET_QUEUE(&queue);
+	for (i = 0; i < num_cmds; i++) {
+		if (wmi_unified_cmd_prepare(wmi_handle, cmds[i].buf,
+					    cmds[i].len, cmds[i].cmd_id,
+					    &pkt) != EOK)
+			break;
+		HTC_PACKET_ENQUEUE(&queue, pkt);
+	}
+
+	sent = HTC_PACKET_QUEUE_DEPTH(&queue);
+	if (!sent)
+		return 0;
+
+	status = htc_send_pkts_multiple(wmi_handle->htc_handle, &queue);
+	if (A_OK != status) {
+		while ((pkt = htc_packet_dequeue(&queue)) != NULL) {
+			wmi_htc_pkt_free(wmi_handle, pkt);
+			cdf_atomic_dec(&wmi_handle->pending_cmds);
+		}
+		pr_err("%s %d, htc_send_pkts_multiple failed\n",
+		       __func__, __LINE__);
+		return -1;
+	}
+
+	return sent;
+}
+
 /* WMI Event handler register API */
 int wmi_unified_get_event_handler_ix(wmi_unified_t wmi_handle,
 				     WMI_EVT_ID event_id)
@@ -996,10 +1148,10 @@ static void wmi_process_fw_event_worker_thread_ctx
 	id = WMI_GET_FIELD(cdf_nbuf_data(evt_buf), WMI_CMD_HDR, COMMANDID);
 	data = cdf_nbuf_data(evt_buf);
 
-	cdf_spin_lock_bh(&wmi_handle->wmi_record_lock);
+#ifdef WMI_INTERFACE_EVENT_LOGGING
 	/* Exclude 4 bytes of TLV header */
 	WMI_RX_EVENT_RECORD(id, ((uint8_t *) data + 4));
-	cdf_spin_unlock_bh(&wmi_handle->wmi_record_lock);
+#endif
 	cdf_spin_lock_bh(&wmi_handle->eventq_lock);
 	cdf_nbuf_queue_add(&wmi_handle->event_queue, evt_buf);
 	cdf_spin_unlock_bh(&wmi_handle->eventq_lock);
@@ -1096,14 +1248,12 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 			goto end;
 		}
 #ifdef WMI_INTERFACE_EVENT_LOGGING
-		cdf_spin_lock_bh(&wmi_handle->wmi_record_lock);
 		/* Exclude 4 bytes of TLV header */
 		if (id == WMI_MGMT_TX_COMPLETION_EVENTID) {
 			WMI_MGMT_EVENT_RECORD(id, ((uint8_t *) data + 4));
 		} else {
 			WMI_EVENT_RECORD(id, ((uint8_t *) data + 4));
 		}
-		cdf_spin_unlock_bh(&wmi_handle->wmi_record_lock);
 #endif
 		/* Call the WMI registered event handler */
 		wmi_handle->event_handler[idx] (wmi_handle->scn_handle,
@@ -1178,9 +1328,7 @@ void *wmi_unified_attach(ol_scn_t scn_handle,
 #else
 	INIT_WORK(&wmi_handle->rx_event_work, wmi_rx_event_work);
 #endif
-#ifdef WMI_INTERFACE_EVENT_LOGGING
-	cdf_spinlock_init(&wmi_handle->wmi_record_lock);
-#endif
+	wmi_htc_pkt_pool_init(wmi_handle);
 	wmi_handle->wma_process_fw_event_handler_cbk = func;
 	return wmi_handle;
 }
@@ -1198,6 +1346,7 @@ void wmi_unified_detach(struct wmi_unified *wmi_handle)
 	}
 	cdf_spin_unlock_bh(&wmi_handle->eventq_lock);
 	if (wmi_handle != NULL) {
+		wmi_htc_pkt_pool_deinit(wmi_handle);
 		OS_FREE(wmi_handle);
 		wmi_handle = NULL;
 	}
@@ -1251,7 +1400,6 @@ void wmi_htc_tx_complete(void *ctx, HTC_PACKET *htc_pkt)
 		 get_wmi_cmd_string(cmd_id), cmd_id);
 #endif
 
-	cdf_spin_lock_bh(&wmi_handle->wmi_record_lock);
 	/* Record 16 bytes of WMI cmd tx complete data
 	   - exclude TLV and WMI headers */
 	if (cmd_id == WMI_MGMT_TX_SEND_CMDID) {
@@ -1261,11 +1409,9 @@ void wmi_htc_tx_complete(void *ctx, HTC_PACKET *htc_pkt)
 		WMI_COMMAND_TX_CMP_RECORD(cmd_id,
 				((uint32_t *) cdf_nbuf_data(wmi_cmd_buf) + 2));
 	}
-
-	cdf_spin_unlock_bh(&wmi_handle->wmi_record_lock);
 #endif
 	cdf_nbuf_free(wmi_cmd_buf);
-	cdf_mem_free(htc_pkt);
+	wmi_htc_pkt_free(wmi_handle, htc_pkt);
 	cdf_atomic_dec(&wmi_handle->pending_cmds);
 }
 
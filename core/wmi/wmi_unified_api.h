@@ -95,6 +95,31 @@ int
 wmi_unified_cmd_send(wmi_unified_t wmi_handle, wmi_buf_t buf, int buflen,
 		     WMI_CMD_ID cmd_id);
 
+/**
+ * struct wmi_cmd_desc - one command of a wmi_unified_cmd_send_multi batch
+ * @buf: wmi command buffer
+ * @len: wmi command buffer length
+ * @cmd_id: wmi command id
+ */
+struct wmi_cmd_desc {
+	wmi_buf_t buf;
+	int len;
+	WMI_CMD_ID cmd_id;
+};
+
+/**
+ * send a batch of unified WMI commands to HTC in one go
+ *
+ *  @param wmi_handle      : handle to WMI.
+ *  @param cmds            : commands to send, in order
+ *  @param num_cmds        : number of commands
+ *  @return number of commands sent, the first ones of the batch; their
+ *          buffers are owned by WMI. -ve on failure, with no command sent.
+ */
+int
+wmi_unified_cmd_send_multi(wmi_unified_t wmi_handle,
+			   struct wmi_cmd_desc *cmds, int num_cmds);
+
 /**
  * WMI event handler register function
  *
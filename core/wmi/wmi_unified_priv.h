@@ -38,6 +38,11 @@
 
 #define WMI_UNIFIED_MAX_EVENT 0x100
 #define WMI_MAX_CMDS  1024
+/* HTC packets preallocated for WMI commands, see wmi_htc_pkt_alloc() */
+#define WMI_HTC_PKT_POOL_SIZE 256
+/* time detach waits for HTC to complete the commands that hold pool packets */
+#define WMI_HTC_PKT_POOL_DRAIN_MS 100
+#define WMI_HTC_PKT_POOL_DRAIN_STEP_MS 10
 
 typedef cdf_nbuf_t wmi_buf_t;
 
@@ -64,6 +69,16 @@ struct fwdebug {
 	struct sk_buff_head fwlog_queue;
 	struct completion fwlog_completion;
 	A_BOOL fwlog_open;
+
+	/* DBGLOG_PROCESS_RING_RAW records, see dbglog_ring_write() */
+	uint8_t *ring;
+	uint32_t ring_head;
+	uint32_t ring_tail;
+	uint32_t ring_lost;
+	spinlock_t ring_lock;
+	wait_queue_head_t ring_wq;
+	/* bit 0 set while the ring file is open, single reader only */
+	unsigned long ring_open;
 };
 #endif /* WLAN_OPEN_SOURCE */
 
@@ -84,9 +99,9 @@ struct wmi_unified {
 	struct dentry *debugfs_phy;
 #endif /* WLAN_OPEN_SOURCE */
 
-#ifdef WMI_INTERFACE_EVENT_LOGGING
-	cdf_spinlock_t wmi_record_lock;
-#endif /*WMI_INTERFACE_EVENT_LOGGING */
+	HTC_PACKET *htc_pkt_pool;
+	HTC_PACKET_QUEUE htc_pkt_free_q;
+	cdf_spinlock_t htc_pkt_lock;
 
 	cdf_atomic_t is_target_suspended;
 	int (*wma_process_fw_event_handler_cbk)(struct wmi_unified *wmi_handle,
@@ -69,6 +69,7 @@ typedef enum {
 	DBGLOG_PROCESS_PRINT_RAW,       /* print them in debug view */
 	DBGLOG_PROCESS_POOL_RAW,        /* user buffer pool to save them */
 	DBGLOG_PROCESS_NET_RAW,         /* user buffer pool to save them */
+	DBGLOG_PROCESS_RING_RAW,        /* binary ring read via debugfs */
 	DBGLOG_PROCESS_MAX,
 } dbglog_process_t;
 
@@ -113,6 +114,18 @@ struct dbglog_slot {
 	uint8_t payload[0];
 } __packed;
 
+/*
+ * In DBGLOG_PROCESS_RING_RAW mode the cld/dbglog_ring debugfs file
+ * returns a stream of records, each a struct dbglog_slot followed by
+ * length bytes of raw WMI_DEBUG_MESG_EVENTID payload padded to a
+ * multiple of four bytes. Unlike cld/dbglog_block the payload is not
+ * padded to ATH6KL_FWLOG_PAYLOAD_SIZE. dropped counts both the buffers
+ * dropped by the firmware and the records overwritten in the ring
+ * since the previous record.
+ */
+#define DBGLOG_RING_REC_LEN(_len) \
+	(sizeof(struct dbglog_slot) + (((_len) + 3) & ~3))
+
 typedef struct event_report_s {
 	unsigned int diag_type;
 	unsigned short event_id;
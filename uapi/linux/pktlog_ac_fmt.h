@@ -36,6 +36,7 @@
 #define PKTLOG_PROC_DIR "ath_pktlog"
 #define PKTLOG_PROC_SYSTEM "system"
 #define WLANDEV_BASENAME "cld"
+#define WLANDEV_RING_NAME "cld_ring"
 #endif
 
 #ifdef WIN32
@@ -263,5 +264,64 @@ struct ath_pktlog_buf {
 				sizeof(struct ath_pktlog_hdr)) ? _rd_offset : 0; \
 	} while(0)
 
+/*
+ * Per-CPU pktlog ring
+ *
+ * When /proc/sys/ath_pktlog/<dev>/ring_size is non-zero, records are
+ * written into one ring per CPU instead of the shared ath_pktlog_buf.
+ * The rings are exported through /proc/ath_pktlog/<dev>_ring. Each
+ * ring is one control page followed by ring_size bytes of record space
+ * starting at data_offset; ring N is mapped at file offset
+ * N * (data_offset + ring_size).
+ *
+ * The producer (the CPU owning the ring) only ever advances head; the
+ * consumer only ever advances tail. Positions are free running 32 bit
+ * byte counts, the offset into the record space is
+ * pos & (data_size - 1) and head - tail is the number of bytes queued.
+ * A consumer drains a ring as follows:
+ *
+ *   while (tail != head) {
+ *       rec = data + (tail & (data_size - 1));
+ *       if (rec->len_flags & PKTLOG_RING_REC_BUSY)
+ *           break;
+ *       if (!(rec->len_flags & PKTLOG_RING_REC_PAD))
+ *           consume(rec);
+ *       tail += rec->len_flags & PKTLOG_RING_REC_LEN_MASK;
+ *   }
+ *
+ * with a read barrier after loading head and a full barrier before
+ * storing tail. Records never wrap; the producer fills the end of the
+ * record space with a PAD record instead.
+ */
+#define PKTLOG_RING_MAGIC_NUM     0x504c5247      /* "PLRG" */
+#define PKTLOG_RING_VER           1
+#define PKTLOG_RING_REC_ALIGN     8
+#define PKTLOG_RING_REC_BUSY      0x80000000
+#define PKTLOG_RING_REC_PAD       0x40000000
+#define PKTLOG_RING_REC_LEN_MASK  0x3fffffff
+
+struct ath_pktlog_ring_ctl {
+	uint32_t magic_num;     /* PKTLOG_RING_MAGIC_NUM */
+	uint32_t version;       /* PKTLOG_RING_VER */
+	uint32_t cpu;
+	uint32_t data_size;     /* bytes of record space, power of 2 */
+	uint32_t data_offset;   /* offset of record space in the mapping */
+	volatile uint32_t head; /* written by the driver */
+	volatile uint32_t tail; /* written by the consumer */
+	volatile uint32_t dropped;      /* records lost to a full ring */
+};
+
+/*
+ * Each ring record starts with this header, followed by hdr.size bytes
+ * of payload laid out exactly as in ath_pktlog_buf. hdr_len lets older
+ * readers skip fields appended to the header by later versions.
+ */
+struct ath_pktlog_ring_rec {
+	volatile uint32_t len_flags;    /* record length incl. padding */
+	uint16_t version;       /* PKTLOG_RING_VER */
+	uint16_t hdr_len;       /* offset of the payload */
+	struct ath_pktlog_hdr hdr;
+};
+
 #endif /* _PKTLOG_FMT_H_ */
 #endif /* REMOVE_PKT_LOG */